@@ -0,0 +1,116 @@
+/*
+ * Arduino.h
+ * minimal host replacement, just enough to compile the decoders and Audio.cpp on a PC for the checks in this folder
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <ctype.h>
+#include <assert.h>
+#include <limits.h>
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <chrono>
+#include <thread>
+
+#define PROGMEM
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define pgm_read_byte(a) (*(const uint8_t*)(a))
+#define pgm_read_word(a) (*(const uint16_t*)(a))
+#define PI 3.1415926535897932384626433832795
+
+typedef bool    boolean;
+typedef uint8_t byte;
+template <class A, class B> typename std::common_type<A, B>::type min(A a, B b) { return a < b ? a : b; } // size_t is 64 bit here
+template <class A, class B> typename std::common_type<A, B>::type max(A a, B b) { return a < b ? b : a; }
+
+#define MALLOC_CAP_DEFAULT  (1 << 0)
+#define MALLOC_CAP_INTERNAL (1 << 1)
+#define MALLOC_CAP_SPIRAM   (1 << 2)
+#define MALLOC_CAP_8BIT     (1 << 3)
+inline void*  heap_caps_malloc(size_t size, uint32_t) { return malloc(size); }
+inline void*  heap_caps_calloc(size_t n, size_t size, uint32_t) { return calloc(n, size); }
+inline void*  heap_caps_realloc(void* ptr, size_t size, uint32_t) { return realloc(ptr, size); }
+inline void*  heap_caps_malloc_prefer(size_t size, int, ...) { return malloc(size); }
+inline void*  heap_caps_calloc_prefer(size_t n, size_t size, int, ...) { return calloc(n, size); }
+inline void*  heap_caps_realloc_prefer(void* ptr, size_t size, int, ...) { return realloc(ptr, size); }
+inline size_t heap_caps_get_free_size(uint32_t) { return 4 << 20; }
+inline size_t heap_caps_get_largest_free_block(uint32_t) { return 4 << 20; }
+inline void*  ps_malloc(size_t size) { return malloc(size); }
+inline void*  ps_calloc(size_t n, size_t size) { return calloc(n, size); }
+inline void*  ps_realloc(void* ptr, size_t size) { return realloc(ptr, size); }
+inline bool   psramInit() { return true; }
+inline bool   psramFound() { return true; }
+
+#define log_e(fmt, ...) fprintf(stderr, "E " fmt "\n", ##__VA_ARGS__)
+#define log_w(fmt, ...) fprintf(stderr, "W " fmt "\n", ##__VA_ARGS__)
+#define log_i(fmt, ...)
+#define log_d(fmt, ...)
+#define log_v(fmt, ...)
+
+// Audio.cpp only -------------------------------------------------------------------------------------------------------
+#define ESP_IDF_VERSION_MAJOR 4
+#define ESP_ARDUINO_VERSION_MAJOR 2
+#define ESP_OK   0
+#define ESP_FAIL -1
+typedef int esp_err_t;
+
+inline uint32_t millis() {
+    static auto t0 = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+}
+inline void     delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline long     random(long max) { return max > 0 ? rand() % max : 0; }
+inline char     toLowerCase(char c) { return tolower(c); }
+inline char*    lltoa(long long val, char* buf, int) { sprintf(buf, "%lld", val); return buf; }
+inline float    pow10f(float x) { return powf(10, x); }
+
+typedef void* SemaphoreHandle_t;
+typedef void* TaskHandle_t;
+#define portMAX_DELAY 0xFFFFFFFF
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return (void*)1; } // the checks run on one thread
+inline int               xSemaphoreTake(SemaphoreHandle_t, uint32_t) { return 1; }
+inline int               xSemaphoreGive(SemaphoreHandle_t) { return 1; }
+inline int               xSemaphoreTakeRecursive(SemaphoreHandle_t, uint32_t) { return 1; }
+inline int               xSemaphoreGiveRecursive(SemaphoreHandle_t) { return 1; }
+inline void              vSemaphoreDelete(SemaphoreHandle_t) {}
+inline void              vTaskDelay(uint32_t) {}
+inline int               uxTaskGetStackHighWaterMark(void*) { return 1000; }
+
+struct EspClass {
+    uint32_t getFreeHeap() { return 200000; }
+    uint32_t getFreePsram() { return 4 << 20; }
+    uint32_t getMaxAllocHeap() { return 100000; }
+};
+inline EspClass ESP;
+
+class String {
+  public:
+    String(const char* s = "") : m_s(s ? s : "") {}
+    const char* c_str() const { return m_s.c_str(); }
+    int         length() const { return m_s.length(); }
+  private:
+    std::string m_s;
+};
+
+struct Print {
+    virtual ~Print() {}
+    virtual size_t write(const uint8_t* buf, size_t len) { return fwrite(buf, 1, len, stdout); }
+    size_t         write(uint8_t c) { return write(&c, 1); }
+    size_t         print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t         printf(const char* fmt, ...) {
+        char    buf[1024];
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(buf, sizeof(buf), fmt, args);
+        va_end(args);
+        return write((const uint8_t*)buf, min(n, (int)sizeof(buf) - 1));
+    }
+};
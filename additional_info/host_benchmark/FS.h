@@ -0,0 +1,59 @@
+/*
+ * FS.h
+ * host replacement, fs::FS opens the files below a root folder of the PC, File counts the bytes read from it
+ */
+#pragma once
+#include "Arduino.h"
+#include <memory>
+#include <string>
+
+namespace fs {
+class File {
+  public:
+    File() {}
+    File(FILE* f, const char* name) : m_f(f, fclose), m_name(name) {}
+    operator bool() const { return m_f != nullptr; }
+    size_t      size() { long p = ftell(m_f.get()); fseek(m_f.get(), 0, SEEK_END); long s = ftell(m_f.get()); fseek(m_f.get(), p, SEEK_SET); return s; }
+    size_t      position() { return ftell(m_f.get()); }
+    bool        seek(uint32_t pos) { return fseek(m_f.get(), pos, SEEK_SET) == 0; }
+    int         read() { return fgetc(m_f.get()); }
+    size_t      read(uint8_t* buf, size_t len) { return readBytes((char*)buf, len); }
+    size_t      readBytes(char* buf, size_t len) {
+        size_t n = fread(buf, 1, len, m_f.get());
+        if(n) *m_readEnd = max(*m_readEnd, (size_t)ftell(m_f.get()));
+        return n;
+    }
+    int         available() { return size() - position(); }
+    const char* name() { return m_name.c_str(); }
+    void        close() { m_f.reset(); }
+    size_t      write(const uint8_t*, size_t) { return 0; }
+    size_t      readEnd() { return *m_readEnd; }              // end of the furthest read
+    void        clearReadEnd() { *m_readEnd = 0; }
+
+  private:
+    std::shared_ptr<FILE>   m_f;
+    std::string             m_name;
+    std::shared_ptr<size_t> m_readEnd = std::make_shared<size_t>(0); // shared by the copies of a File
+};
+
+class FS {
+  public:
+    FS(const char* root) : m_root(root) {}
+    File open(const char* path, const char* mode = "r") {
+        FILE* f = fopen((m_root + path).c_str(), *mode == 'w' ? "wb" : "rb");
+        return f ? File(f, path) : File();
+    }
+    bool exists(const char* path) {
+        FILE* f = fopen((m_root + path).c_str(), "rb");
+        if(f) fclose(f);
+        return f != NULL;
+    }
+    bool remove(const char* path) { return ::remove((m_root + path).c_str()) == 0; }
+
+  private:
+    std::string m_root;
+};
+} // namespace fs
+using fs::File;
+#define FILE_READ  "r"
+#define FILE_WRITE "w"
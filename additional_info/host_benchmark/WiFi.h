@@ -0,0 +1,31 @@
+/*
+ * WiFi.h
+ * host replacement without network, the checks in this folder play local files
+ */
+#pragma once
+#include "Arduino.h"
+
+class WiFiClient : public Print {
+  public:
+    virtual ~WiFiClient() {}
+    virtual int connect(const char*, uint16_t) { return 0; }
+    virtual int connect(const char*, uint16_t, int32_t) { return 0; }
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int read(uint8_t*, size_t) { return -1; }
+    size_t      readBytes(uint8_t*, size_t) { return 0; }
+    size_t      readBytes(char*, size_t) { return 0; }
+    virtual void    stop() {}
+    virtual uint8_t connected() { return 0; }
+    virtual int     peek() { return -1; }
+    virtual void    flush() {}
+    int             setTimeout(uint32_t) { return 0; }
+    void            setNoDelay(bool) {}
+    size_t          write(const uint8_t*, size_t) override { return 0; }
+};
+
+struct WiFiClass {
+    int status() { return 0; }
+};
+inline WiFiClass WiFi;
+#define WL_CONNECTED 3
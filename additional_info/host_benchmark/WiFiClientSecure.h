@@ -0,0 +1,11 @@
+/*
+ * WiFiClientSecure.h
+ * host replacement without network
+ */
+#pragma once
+#include "WiFi.h"
+
+class WiFiClientSecure : public WiFiClient {
+  public:
+    void setInsecure() {}
+};
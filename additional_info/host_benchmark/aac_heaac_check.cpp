@@ -0,0 +1,106 @@
+/*
+ * aac_heaac_check.cpp
+ * host decode check of HE-AAC (SBR), full rate output against downsampled SBR (AACDecoder_SetSBRDownsampled)
+ *
+ * build and run on a PC from this folder, AAC_ENABLE_SBR_NO_PSRAM compiles SBR without the ESP32-S3 and PSRAM defines:
+ *     g++ -std=gnu++17 -O2 -I. -DAAC_ENABLE_SBR_NO_PSRAM aac_heaac_check.cpp -o aac_heaac_check
+ *     ./aac_heaac_check ../Testfiles/test_heaac_mono.aac
+ *
+ * test_heaac_mono.aac: 300 ADTS frames, 22.05kHz mono core (noise substitution up to 3kHz), SBR from 3kHz to 11kHz
+ * both modes must decode every frame, at twice and at the core sample rate, the SBR band lies below the Nyquist
+ * frequency of the core, so the downsampled output keeps the level of the full rate output (within 2dB,
+ * the core alone, without AAC_ENABLE_SBR, is about 18dB lower)
+ */
+#include "../../src/aac_decoder/aac_decoder.cpp"
+#include <vector>
+#include <chrono>
+
+//----------------------------------------------------------------------------------------------------------------------
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    FILE* f = fopen(path, "rb");
+    if(!f) return false;
+    fseek(f, 0, SEEK_END);
+    data.resize(ftell(f));
+    fseek(f, 0, SEEK_SET);
+    bool ok = fread(data.data(), 1, data.size(), f) == data.size();
+    fclose(f);
+    return ok;
+}
+//----------------------------------------------------------------------------------------------------------------------
+static bool decodeFile(std::vector<uint8_t> data, bool downsampled, std::vector<short>& pcm, int* sampRate, double* usPerFrame) {
+    static short outbuf[2 * 2048];
+    long         frames = 0;
+    AACDecoder_FreeBuffers(); // new decoder state for each mode
+    if(!AACDecoder_AllocateBuffers()) return false;
+    AACDecoder_SetSBRDownsampled(downsampled);
+    pcm.clear();
+    uint8_t* buf = data.data();
+    int      bytesLeft = data.size();
+    auto     t0 = std::chrono::steady_clock::now();
+    while(bytesLeft > 7) {
+        int offset = AACFindSyncWord(buf, bytesLeft);
+        if(offset < 0) break;
+        buf += offset;
+        bytesLeft -= offset;
+        int before = bytesLeft;
+        int err = AACDecode(buf, &bytesLeft, outbuf);
+        if(err) {
+            printf("frame %ld: decode error %i\n", frames, err);
+            return false;
+        }
+        buf += before - bytesLeft;
+        pcm.insert(pcm.end(), outbuf, outbuf + AACGetOutputSamps());
+        frames++;
+    }
+    *usPerFrame = frames ? std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / frames : 0;
+    *sampRate = AACGetSampRate();
+    printf("%-11s %ld frames, %d ch, %d Hz, %d samples per frame, %.0f us per frame\n", downsampled ? "downsampled" : "full rate", frames,
+           AACGetChannels(), AACGetSampRate(), AACGetOutputSamps(), *usPerFrame);
+    return frames > 0;
+}
+//----------------------------------------------------------------------------------------------------------------------
+static double levelDB(const std::vector<short>& pcm) {
+    double sum = 0;
+    for(short s : pcm) sum += (double)s * s;
+    return pcm.size() ? 10 * log10(sum / pcm.size() + 1e-9) : -90;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        printf("usage: %s file.aac\n", argv[0]);
+        return 1;
+    }
+    std::vector<uint8_t> data;
+    if(!readFile(argv[1], data)) {
+        printf("%s: can't read the file\n", argv[1]);
+        return 1;
+    }
+    std::vector<short> pcm[2];
+    int                sampRate[2];
+    double             usPerFrame[2];
+    for(int ds = 0; ds < 2; ds++) {
+        if(!decodeFile(data, ds, pcm[ds], &sampRate[ds], &usPerFrame[ds])) {
+            printf("FAIL: %s decode\n", ds ? "downsampled" : "full rate");
+            return 1;
+        }
+    }
+    AACDecoder_FreeBuffers();
+
+    bool ok = true;
+    if(sampRate[0] != 2 * sampRate[1]) {
+        printf("FAIL: full rate %d Hz is not twice the downsampled rate %d Hz, no SBR in the stream?\n", sampRate[0], sampRate[1]);
+        ok = false;
+    }
+    if(pcm[0].size() != 2 * pcm[1].size()) {
+        printf("FAIL: %zu samples full rate, %zu samples downsampled\n", pcm[0].size(), pcm[1].size());
+        ok = false;
+    }
+    double diff = levelDB(pcm[1]) - levelDB(pcm[0]);
+    printf("level full rate %.1f dB, downsampled %.1f dB\n", levelDB(pcm[0]), levelDB(pcm[1]));
+    if(fabs(diff) > 2.0) {
+        printf("FAIL: the downsampled output is %.1f dB off, the SBR band is missing\n", diff);
+        ok = false;
+    }
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
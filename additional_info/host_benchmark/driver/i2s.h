@@ -0,0 +1,41 @@
+/*
+ * i2s.h
+ * host replacement of the IDF 4 I2S driver, i2s_write() counts the PCM bytes in i2sBytesWritten
+ */
+#pragma once
+#include "../Arduino.h"
+
+typedef int i2s_port_t;
+#define I2S_NUM_0         0
+#define I2S_PIN_NO_CHANGE -1
+typedef enum { I2S_MODE_MASTER = 1, I2S_MODE_TX = 4, I2S_MODE_DAC_BUILT_IN = 16 } i2s_mode_t;
+typedef enum { I2S_BITS_PER_SAMPLE_16BIT = 16 } i2s_bits_per_sample_t;
+typedef enum { I2S_CHANNEL_FMT_RIGHT_LEFT, I2S_CHANNEL_FMT_ONLY_LEFT } i2s_channel_fmt_t;
+typedef enum { I2S_COMM_FORMAT_STAND_I2S = 1, I2S_COMM_FORMAT_STAND_MSB = 2, I2S_COMM_FORMAT_STAND_PCM_SHORT = 4 } i2s_comm_format_t;
+typedef enum { I2S_DAC_CHANNEL_DISABLE, I2S_DAC_CHANNEL_RIGHT_EN, I2S_DAC_CHANNEL_LEFT_EN, I2S_DAC_CHANNEL_BOTH_EN } i2s_dac_mode_t;
+typedef enum { I2S_MCLK_MULTIPLE_DEFAULT = 0, I2S_MCLK_MULTIPLE_128 = 128 } i2s_mclk_multiple_t;
+#define ESP_INTR_FLAG_LEVEL1 2
+typedef struct {
+    int  mode, sample_rate, bits_per_sample, channel_format, communication_format, intr_alloc_flags, dma_buf_count, dma_buf_len;
+    bool use_apll, tx_desc_auto_clear;
+    int  fixed_mclk, mclk_multiple, bits_per_chan;
+} i2s_config_t;
+typedef struct {
+    int mck_io_num, bck_io_num, ws_io_num, data_out_num, data_in_num;
+} i2s_pin_config_t;
+
+inline size_t    i2sBytesWritten = 0;
+inline esp_err_t i2s_driver_install(i2s_port_t, const i2s_config_t*, int, void*) { return ESP_OK; }
+inline esp_err_t i2s_driver_uninstall(i2s_port_t) { return ESP_OK; }
+inline esp_err_t i2s_set_pin(i2s_port_t, const i2s_pin_config_t*) { return ESP_OK; }
+inline esp_err_t i2s_set_dac_mode(i2s_dac_mode_t) { return ESP_OK; }
+inline esp_err_t i2s_set_sample_rates(i2s_port_t, uint32_t) { return ESP_OK; }
+inline esp_err_t i2s_set_clk(i2s_port_t, uint32_t, uint32_t, int) { return ESP_OK; }
+inline esp_err_t i2s_start(i2s_port_t) { return ESP_OK; }
+inline esp_err_t i2s_stop(i2s_port_t) { return ESP_OK; }
+inline esp_err_t i2s_zero_dma_buffer(i2s_port_t) { return ESP_OK; }
+inline esp_err_t i2s_write(i2s_port_t, const void*, size_t size, size_t* written, uint32_t) {
+    i2sBytesWritten += size;
+    *written = size;
+    return ESP_OK;
+}
@@ -0,0 +1,5 @@
+/*
+ * esp32-hal-log.h
+ * host replacement, the log macros are in Arduino.h
+ */
+#pragma once
@@ -0,0 +1,10 @@
+/*
+ * cencode.h
+ * host replacement, the checks in this folder do not send credentials
+ */
+#pragma once
+typedef struct { int step; char result; int stepcount; } base64_encodestate;
+inline void base64_init_encodestate(base64_encodestate*) {}
+inline int  base64_encode_block(const char*, int, char*, base64_encodestate*) { return 0; }
+inline int  base64_encode_blockend(char*, base64_encodestate*) { return 0; }
+inline int  base64_encode_expected_len(int n) { return 4 * n / 3 + 4; }
@@ -0,0 +1,132 @@
+/*
+ * m4a_seek_check.cpp
+ * host check of m4a_seekTableLookup() at the end of the track, plays an M4A file with the sample tables (stts, stsz)
+ *
+ * build and run on a PC from this folder, -fno-access-control gives the check access to the M4A cursors of Audio:
+ *     g++ -std=gnu++17 -O1 -fpermissive -w -fno-access-control -I. m4a_seek_check.cpp ../../src/Audio.cpp \
+ *         ../../src/aac_decoder/aac_decoder.cpp ../../src/flac_decoder/flac_decoder.cpp ../../src/mp3_decoder/mp3_decoder.cpp \
+ *         ../../src/ogg_demuxer/ogg_demuxer.cpp ../../src/opus_decoder/opus_decoder.cpp ../../src/opus_decoder/celt.cpp \
+ *         ../../src/vorbis_decoder/vorbis_decoder.cpp -o m4a_seek_check
+ *     ./m4a_seek_check ../Testfiles Miss-Marple.m4a
+ *
+ * seeks to the duration (rounded up), to the whole second in front of it (duration - e) and, with the stsz table cut
+ * short by 10 access units (stts then describes more units than stsz), to the duration again. Each seek must land on
+ * the expected access unit, the playback must run to the end of the file without decoding errors, and neither the
+ * cursors nor the file reads may go past the last access unit in stsz.
+ */
+#include "../../src/Audio.h"
+
+static bool f_eof = false;
+void        audio_eof_mp3(const char*) { f_eof = true; }
+
+struct seekCase_t {
+    const char* name;
+    uint32_t    cutSamples; // access units taken from the end of stsz
+    bool        f_lastSec;  // seek to the whole second in front of the duration, else to the duration rounded up
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+static bool runCase(fs::FS& fs, const char* path, const seekCase_t& sc) {
+    Audio audio;
+    f_eof = false;
+    i2sBytesWritten = 0;
+    if(!audio.connecttoFS(fs, path)) {
+        printf("%s: can't open %s\n", sc.name, path);
+        return false;
+    }
+    for(int i = 0; i < 1000 && !(audio.m_f_m4aTables && i2sBytesWritten); i++) audio.loop(); // header, first frames
+    if(!audio.m_f_m4aTables || !audio.m_m4aTimescale || audio.m_m4aNumSamples <= sc.cutSamples) {
+        printf("%s: no M4A sample tables\n", sc.name);
+        return false;
+    }
+    audio.m_m4aNumSamples -= sc.cutSamples; // the sizes of the remaining access units are still valid
+    uint32_t numSamples = audio.m_m4aNumSamples;
+
+    uint64_t duration = 0, lastStart = 0; // in units of the timescale
+    uint32_t n = 0;
+    for(auto& e : audio.m_m4aStts) {
+        for(uint32_t i = 0; i < e.sampleCount; i++, n++) {
+            if(n < numSamples) lastStart = duration;
+            duration += e.sampleDelta;
+        }
+    }
+    uint32_t timescale = audio.m_m4aTimescale;
+    uint32_t sec = sc.f_lastSec ? (duration - 1) / timescale : (duration + timescale - 1) / timescale;
+    uint64_t target = (uint64_t)sec * timescale;
+    uint32_t expSample = numSamples - 1; // access unit that contains target
+    uint64_t expStart = lastStart;
+    if(target < lastStart) {
+        uint64_t t = 0;
+        n = 0;
+        for(auto& e : audio.m_m4aStts) {
+            if(target < t + (uint64_t)e.sampleCount * e.sampleDelta) {
+                expSample = n + (target - t) / e.sampleDelta;
+                expStart = t + (target - t) / e.sampleDelta * e.sampleDelta;
+                break;
+            }
+            t += (uint64_t)e.sampleCount * e.sampleDelta;
+            n += e.sampleCount;
+        }
+    }
+    else target = lastStart; // at or behind the last access unit: from its start
+    Audio::m4aCursor_t last = audio.m_m4aCheckpoints[(numSamples - 1) / audio.m_m4aCheckStep];
+    while(last.sample < numSamples - 1) audio.m4a_nextSample(last);
+    uint32_t lastEnd = last.pos + last.size;
+
+    bool ok = audio.m4a_seekTableLookup(sec);
+    if(!ok) printf("%s: m4a_seekTableLookup(%lu) refused\n", sc.name, (long unsigned int)sec);
+    uint32_t sr = audio.getSampleRate();
+    if(ok && (audio.m_seekIdxSample != expStart * sr / timescale || audio.m_samplesToSkip != (target - expStart) * sr / timescale)) {
+        printf("%s: seek to sample %lu + %lu, expected %lu + %lu\n", sc.name, (long unsigned int)audio.m_seekIdxSample,
+               (long unsigned int)audio.m_samplesToSkip, (long unsigned int)(expStart * sr / timescale),
+               (long unsigned int)((target - expStart) * sr / timescale));
+        ok = false;
+    }
+    audio.audiofile.clearReadEnd();
+    audio.loop(); // processLocalFile() sets the cursors, the decoding starts with the next calls
+    if(ok && audio.m_m4aDec.sample != expSample) {
+        printf("%s: lands on access unit %lu, expected %lu\n", sc.name, (long unsigned int)audio.m_m4aDec.sample, (long unsigned int)expSample);
+        ok = false;
+    }
+    uint32_t maxSample = 0, decoded = 0, prev = audio.m_m4aDec.sample;
+    for(int i = 0; i < 100000 && !f_eof && audio.isRunning(); i++) {
+        audio.loop();
+        maxSample = max(maxSample, max(audio.m_m4aRd.sample, audio.m_m4aDec.sample));
+        if(audio.m_m4aDec.sample != prev) decoded += audio.m_m4aDec.sample - prev;
+        prev = audio.m_m4aDec.sample;
+    }
+    size_t readEnd = audio.audiofile.readEnd();
+    printf("%s: %lu s of %.3f s, access unit %lu of %lu, %lu decoded, file read up to %zu, last unit ends at %lu\n", sc.name,
+           (long unsigned int)sec, (double)duration / timescale, (long unsigned int)expSample, (long unsigned int)numSamples,
+           (long unsigned int)decoded, readEnd, (long unsigned int)lastEnd);
+    if(!f_eof) {
+        printf("%s: the end of the file was not reached\n", sc.name);
+        ok = false;
+    }
+    if(maxSample > numSamples || readEnd > lastEnd) {
+        printf("%s: read past the last access unit in stsz\n", sc.name);
+        ok = false;
+    }
+    if(decoded != numSamples - expSample) {
+        printf("%s: %lu access units decoded, expected %lu\n", sc.name, (long unsigned int)decoded, (long unsigned int)(numSamples - expSample));
+        ok = false;
+    }
+    return ok;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int main(int argc, char** argv) {
+    if(argc < 3) {
+        printf("usage: %s folder file.m4a\n", argv[0]);
+        return 1;
+    }
+    fs::FS           fs(argv[1]);
+    const seekCase_t cases[] = {
+        {"duration", 0, false},
+        {"duration - e", 0, true},
+        {"stsz short, duration", 10, false},
+    };
+    bool ok = true;
+    for(auto& sc : cases) ok &= runCase(fs, argv[2], sc);
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
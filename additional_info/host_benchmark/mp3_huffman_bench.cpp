@@ -0,0 +1,108 @@
+/*
+ * mp3_huffman_bench.cpp
+ * host benchmark of the MP3 big values Huffman decoding, Helix tables against the first level lookup tables (MP3_HUFFMAN_LUT)
+ *
+ * build and run on a PC from this folder:
+ *     g++ -std=gnu++17 -O2 -I. mp3_huffman_bench.cpp -o mp3_huffman_bench
+ *     ./mp3_huffman_bench ../Testfiles/Olsen-Banden.mp3 [more mp3 files]
+ *
+ * every file is decoded 31 times with both paths in turn, each frame counts with its fastest run (removes the noise of
+ * the host), shown is the mean in cycles (x86 TSC) per frame, the PCM output of both paths must be bit-identical
+ */
+#include "../../src/mp3_decoder/mp3_decoder.cpp"
+#include <vector>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define BENCH_UNIT "cycles"
+static uint64_t benchTicks() { return __rdtsc(); }
+#else
+    #define BENCH_UNIT "ns"
+static uint64_t benchTicks() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+#endif
+
+const int BENCH_RUNS = 31;
+
+//----------------------------------------------------------------------------------------------------------------------
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    FILE* f = fopen(path, "rb");
+    if(!f) return false;
+    fseek(f, 0, SEEK_END);
+    data.resize(ftell(f));
+    fseek(f, 0, SEEK_SET);
+    bool ok = fread(data.data(), 1, data.size(), f) == data.size();
+    fclose(f);
+    return ok;
+}
+//----------------------------------------------------------------------------------------------------------------------
+static void decodeFile(std::vector<uint8_t>& data, std::vector<short>& pcm, std::vector<uint64_t>& ticks) { // fastest MP3Decode() per frame
+    static short outbuf[2 * 1152];
+    size_t       frames = 0;
+    pcm.clear();
+    MP3Decoder_ClearBuffer();
+    unsigned char* buf = data.data();
+    int            bytesLeft = data.size();
+    int            offset = MP3FindSyncWord(buf, bytesLeft);
+    while(offset >= 0 && bytesLeft > 4) {
+        buf += offset;
+        bytesLeft -= offset;
+        int      before = bytesLeft;
+        uint64_t t0 = benchTicks();
+        int      err = MP3Decode(buf, &bytesLeft, outbuf, 0);
+        uint64_t t = benchTicks() - t0;
+        buf += before - bytesLeft;
+        if(err) { // skip the damaged frame, search the next syncword
+            offset = MP3FindSyncWord(buf + 1, bytesLeft - 1);
+            if(offset >= 0) offset++;
+            continue;
+        }
+        pcm.insert(pcm.end(), outbuf, outbuf + MP3GetOutputSamps());
+        if(frames == ticks.size()) ticks.push_back(t);
+        else if(t < ticks[frames]) ticks[frames] = t;
+        frames++;
+        offset = 0;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        printf("usage: %s file.mp3 [file.mp3 ...]\n", argv[0]);
+        return 1;
+    }
+    if(!MP3Decoder_AllocateBuffers() || !m_huffLUT) {
+        printf("can't allocate the decoder buffers\n");
+        return 1;
+    }
+    uint16_t* huffLUT = m_huffLUT;
+    int       result = 0;
+
+    for(int i = 1; i < argc; i++) {
+        std::vector<uint8_t> data;
+        if(!readFile(argv[i], data)) {
+            printf("%s: can't read the file\n", argv[i]);
+            result = 1;
+            continue;
+        }
+        std::vector<short>    pcm[2];
+        std::vector<uint64_t> ticks[2];
+        double                perFrame[2] = {0, 0};
+        for(int r = 0; r < BENCH_RUNS; r++) {
+            for(int lut = 0; lut < 2; lut++) {
+                m_huffLUT = lut ? huffLUT : NULL; // NULL: DecodeHuffmanPairs() walks the Helix tables only
+                decodeFile(data, pcm[lut], ticks[lut]);
+            }
+        }
+        size_t frames = ticks[0].size();
+        for(int lut = 0; lut < 2; lut++) {
+            for(uint64_t t : ticks[lut]) perFrame[lut] += t;
+            if(frames) perFrame[lut] /= frames;
+        }
+        bool identical = pcm[0] == pcm[1] && ticks[0].size() == ticks[1].size();
+        printf("%s: %zu frames, helix %.0f, lut %.0f %s per frame, %.1f%% faster, pcm %s\n", argv[i], frames, perFrame[0], perFrame[1],
+               BENCH_UNIT, perFrame[0] ? 100.0 * (perFrame[0] - perFrame[1]) / perFrame[0] : 0, identical ? "bit-identical" : "DIFFERENT");
+        if(!identical) result = 1;
+    }
+    m_huffLUT = huffLUT;
+    MP3Decoder_FreeBuffers();
+    return result;
+}
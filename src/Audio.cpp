@@ -14,6 +14,7 @@
 #include "mp3_decoder/mp3_decoder.h"
 #include "opus_decoder/opus_decoder.h"
 #include "vorbis_decoder/vorbis_decoder.h"
+#include "ogg_demuxer/ogg_demuxer.h"
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 AudioBuffer::AudioBuffer(size_t maxBlockSize) {
@@ -57,12 +58,28 @@ size_t AudioBuffer::init() {
     return m_buffSize;
 }
 
-void AudioBuffer::changeMaxBlockSize(uint16_t mbs) {
+bool AudioBuffer::changeMaxBlockSize(uint32_t mbs) {
+    // the reserved space behind m_endPtr must take one block, it is enlarged if necessary (e.g. FLAC with 16384 samples
+    // per block). The ring part and its content stay as they are
+    size_t* resBuffSize = m_f_psram ? &m_resBuffSizePSRAM : &m_resBuffSizeRAM;
+    if(m_buffer && mbs > *resBuffSize) {
+        size_t   writePos = m_writePtr - m_buffer;
+        size_t   readPos = m_readPtr - m_buffer;
+        uint8_t* tmp = NULL;
+        if(m_f_psram) tmp = (uint8_t*)ps_realloc(m_buffer, m_buffSize + mbs);
+        else tmp = (uint8_t*)heap_caps_realloc(m_buffer, m_buffSize + mbs, MALLOC_CAP_DEFAULT | MALLOC_CAP_INTERNAL);
+        if(!tmp) return false;
+        m_buffer = tmp;
+        m_writePtr = m_buffer + writePos;
+        m_readPtr = m_buffer + readPos;
+        m_endPtr = m_buffer + m_buffSize;
+        *resBuffSize = mbs;
+    }
     m_maxBlockSize = mbs;
-    return;
+    return true;
 }
 
-uint16_t AudioBuffer::getMaxBlockSize() { return m_maxBlockSize; }
+uint32_t AudioBuffer::getMaxBlockSize() { return m_maxBlockSize; }
 
 size_t AudioBuffer::freeSpace() {
     if(m_readPtr >= m_writePtr) { m_freeSpace = (m_readPtr - m_writePtr); }
@@ -147,7 +164,7 @@ Audio::Audio(bool internalDAC /* = false */, uint8_t channelEnabled /* = I2S_SLO
     if(m_f_psramFound) m_chbufSize = 4096; else m_chbufSize = 512 + 64;
     if(m_f_psramFound) m_ibuffSize = 4096; else m_ibuffSize = 512 + 64;
     m_lastHost = (char*)__malloc_heap_psram(512);
-    m_outBuff = (int16_t*)__malloc_heap_psram(2048 * 2 * sizeof(int16_t));
+    m_outBuff = (int16_t*)__malloc_heap_psram(m_outBuffSize * sizeof(int16_t));
     m_chbuf = (char*)__malloc_heap_psram(m_chbufSize);
     m_ibuff = (char*)__malloc_heap_psram(m_ibuffSize);
 
@@ -303,6 +320,7 @@ void Audio::setDefaults() {
     AACDecoder_FreeBuffers();
     OPUSDecoder_FreeBuffers();
     VORBISDecoder_FreeBuffers();
+    OGGDemuxer_FreeBuffers();
     if(m_playlistBuff) {
         free(m_playlistBuff);
         m_playlistBuff = NULL;
@@ -311,10 +329,14 @@ void Audio::setDefaults() {
     vector_clear_and_shrink(m_playlistContent);
     m_hashQueue.clear();
     m_hashQueue.shrink_to_fit(); // uint32_t vector
+    m_fmp4Samples.clear();
+    m_fmp4Samples.shrink_to_fit();
+    m_fmp4InitHash = 0;
     client.stop();
     clientsecure.stop();
     _client = static_cast<WiFiClient*>(&client); /* default to *something* so that no NULL deref can happen */
     ts_parsePacket(0, 0, 0);                     // reset ts routine
+    fmp4_parse(NULL, 0);                         // reset fMP4 routine
     if(m_lastM3U8host) {
         free(m_lastM3U8host);
         m_lastM3U8host = NULL;
@@ -323,6 +345,8 @@ void Audio::setDefaults() {
 
     m_f_timeout = false;
     m_f_chunked = false; // Assume not chunked
+    m_f_acceptRanges = false;
+    m_f_rangeRequest = false;
     m_f_firstmetabyte = false;
     m_f_playing = false;
     m_f_ssl = false;
@@ -338,7 +362,13 @@ void Audio::setDefaults() {
     m_f_m3u8data = false; // set again in processM3U8entries() if necessary
     m_f_continue = false;
     m_f_ts = false;
+    m_f_fmp4 = false;
+    m_f_oggContainer = false;
     m_f_m4aID3dataAreRead = false;
+    m_m4aObjectType = 0;
+    m_m4aNumChannels = 0;
+    m_m4aFrameLength = 1024;
+    m_m4aSampleRate = 0;
 
     m_streamType = ST_NONE;
     m_codec = CODEC_NONE;
@@ -362,6 +392,37 @@ void Audio::setDefaults() {
     m_streamTitleHash = 0;
     m_file_size = 0;
     m_ID3Size = 0;
+    m_mp3SeekTable.clear();
+    m_mp3SeekTable.shrink_to_fit();
+    m_mp3SeekTableStep = 0;
+    m_mp3VbrStart = 0;
+    m_mp3VbrBitrate = 0;
+    m_mp3VbrDuration = 0;
+    m_f_mp3VbrChecked = false;
+    m_seekIdx.clear();
+    m_seekIdx.shrink_to_fit();
+    m_flacSeekTable.clear();
+    m_flacSeekTable.shrink_to_fit();
+    m4a_freeSampleTables();
+    m_m4aMdatPos = 0;
+    m_m4aMdatSize = 0;
+    m_rangeSkip = 0;
+    m_samplesToSkip = 0;
+    if(m_seekIdxPath) {
+        free(m_seekIdxPath);
+        m_seekIdxPath = NULL;
+    }
+    m_seekIdxFS = NULL;
+    m_seekIdxSample = 0;
+    m_seekIdxSampleRate = 0;
+    m_f_seekIdxBuild = false;
+    m_f_seekIdxComplete = false;
+    m_f_seekIdxFrameStart = true;
+    m_f_seekIdxHit = false;
+    m_tConnect = millis(); // startup timing, see reportStartupTimes()
+    m_tFirstByte = 0;
+    m_tFirstFrame = 0;
+    m_tFirstDMA = 0;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -370,6 +431,85 @@ void Audio::setConnectionTimeout(uint16_t timeout_ms, uint16_t timeout_ms_ssl) {
     if(timeout_ms_ssl) m_timeout_ms_ssl = timeout_ms_ssl;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::setStartupPolicy(uint8_t policy, uint8_t blocks) {
+    // how much input is buffered before decoding starts. A block is the largest input the codec takes for one frame,
+    // InBuff.getMaxBlockSize() bytes (e.g. 1800 for MP3), the count is in bytes of InBuff, not in decoded frames
+    // STARTUP_DEFAULT:     files fill the whole inputbuffer, streams start with one block (default)
+    // STARTUP_MIN_LATENCY: start decoding as soon as one block is buffered
+    // STARTUP_BALANCED:    start decoding if two blocks are buffered
+    // STARTUP_ROBUST:      fill the whole inputbuffer before decoding (slow start, survives long network gaps)
+    // blocks > 0 overrides the number of blocks of the policy for all sources
+    if(policy > STARTUP_ROBUST) {
+        log_e("unknown startup policy %i", policy);
+        return;
+    }
+    m_startupPolicy = policy;
+    m_startupBlocks = blocks;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::setSeekIndex(uint8_t intervalSec, bool sidecar) {
+    // While a local MP3, AAC or FLAC file is playing, the file position of a frame is recorded every intervalSec
+    // seconds. setAudioPlayPosition() uses these entries and jumps exactly to the frame, without searching the
+    // syncword. If sidecar is true, the complete index is stored beside the audio file ("<name>.sidx") and is
+    // loaded by the next connecttoFS(), so it is also available before the file has been played once.
+    // Takes effect with the next connecttoFS(), intervalSec = 0 disables the seek index.
+    m_seekIdxInterval = intervalSec;
+    m_f_seekIdxSidecar = sidecar;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::setMP3OutputRate(uint8_t divider) {
+    // MP3 quality tier for low power and voice installs: 1 full rate, 2 half rate (e.g. 22.05kHz, the lower 16 subbands
+    // are synthesized with a 16-point DCT), 4 quarter rate (e.g. 11.025kHz, lower 8 subbands, 8-point DCT).
+    // CPU: the synthesis (DCT + polyphase filter) needs about 55% (half rate) or 25..30% (quarter rate) of the full rate.
+    // Quality: the band is cut by the slopes of the subband filters, not by a steep lowpass. Compared with the full rate
+    // output lowpassed and decimated the SNR is about 39dB (half) or 34dB (quarter), the error is aliasing just below
+    // the new Nyquist frequency. Fine for speech, audible on bright music. Takes effect with the next connect
+    if(divider != 2 && divider != 4) divider = 1;
+    m_mp3RateDivider = divider;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::setAACDownsampledSBR(bool ds) {
+    // HE-AAC quality tier for low power and voice installs: SBR with a 32-subband synthesis filterbank, the output stays
+    // at the core sample rate (e.g. 24kHz instead of 48kHz), half the synthesis work. Takes effect with the next connect
+    // Boards without PSRAM decode SBR only with AAC_ENABLE_SBR_NO_PSRAM in the build flags (aac_decoder.h)
+    m_f_aacSBRDownsampled = ds;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::setFLACCrcCheck(bool check) {
+    // a frame with a wrong CRC (e.g. after a seek or a network glitch) is not played, the decoder searches the next
+    // frame header. Costs a table lookup per byte of the compressed data. Takes effect with the next connect
+    m_f_flacCrcCheck = check;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::startupBufferReady(bool f_dataComplete, bool f_file) {
+    // true if enough audio data are buffered to start decoding, depends on the startup policy
+    // f_file: local file or web file, f_dataComplete: there will be no more data
+    const uint32_t maxBlockSize = InBuff.getMaxBlockSize();
+    uint32_t blocks = m_startupBlocks;
+    if(!blocks) {
+        switch(m_startupPolicy) {
+            case STARTUP_MIN_LATENCY: blocks = 1; break;
+            case STARTUP_BALANCED:    blocks = 2; break;
+            case STARTUP_DEFAULT:     if(!f_file) return InBuff.bufferFilled() > maxBlockSize; // stream: one block
+                                      break;                                                  // file: fill the buffer
+            default:                  break;                                                  // robust: fill the buffer
+        }
+    }
+    if(f_dataComplete) return true;
+    if(!blocks || (blocks + 1) * maxBlockSize >= (uint32_t)InBuff.getBufsize()) { // fill the whole buffer
+        return InBuff.freeSpace() <= maxBlockSize;
+    }
+    return InBuff.bufferFilled() > blocks * maxBlockSize;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::reportStartupTimes() {
+    // called once per connection when the first sample has been written to the I2S DMA buffer
+    const char* pol[4] = {"default", "min-latency", "balanced", "robust"};
+    AUDIO_INFO("startup (%s): connect->first byte %lu ms, ->first frame %lu ms, ->first DMA %lu ms", pol[m_startupPolicy],
+               (long unsigned int)(m_tFirstByte - m_tConnect), (long unsigned int)(m_tFirstFrame - m_tConnect),
+               (long unsigned int)(m_tFirstDMA - m_tConnect));
+}
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool Audio::connecttohost(const char* host, const char* user, const char* pwd) {
     // user and pwd for authentification only, can be empty
@@ -510,6 +650,7 @@ bool Audio::connecttohost(const char* host, const char* user, const char* pwd) {
     if(res) {
         _client->print(rqh);
         if(endsWith(extension, ".mp3" )) m_expectedCodec  = CODEC_MP3;
+        if(endsWith(extension, ".mp2" )) m_expectedCodec  = CODEC_MP3;
         if(endsWith(extension, ".aac" )) m_expectedCodec  = CODEC_AAC;
         if(endsWith(extension, ".wav" )) m_expectedCodec  = CODEC_WAV;
         if(endsWith(extension, ".m4a" )) m_expectedCodec  = CODEC_M4A;
@@ -556,8 +697,9 @@ bool Audio::connecttohost(const char* host, const char* user, const char* pwd) {
     return res;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-bool Audio::httpPrint(const char* host) {
+bool Audio::httpPrint(const char* host, int32_t rangeFirst) {
     // user and pwd for authentification only, can be empty
+    // rangeFirst >= 0: request the file from this byte position to the end (HTTP range request)
 
     if(host == NULL) {
         AUDIO_INFO("Hostaddress is empty");
@@ -608,7 +750,7 @@ bool Audio::httpPrint(const char* host) {
 
     AUDIO_INFO("new request: \"%s\"", host);
 
-    char rqh[strlen(h_host) + 200]; // http request header
+    char rqh[strlen(h_host) + 240]; // http request header
     rqh[0] = '\0';
 
     strcat(rqh, "GET ");
@@ -618,6 +760,11 @@ bool Audio::httpPrint(const char* host) {
     strcat(rqh, hostwoext);
     strcat(rqh, "\r\n");
     strcat(rqh, "Accept-Encoding: identity;q=1,*;q=0\r\n");
+    if(rangeFirst >= 0) {
+        char range[40];
+        sprintf(range, "Range: bytes=%li-\r\n", (long int)rangeFirst);
+        strcat(rqh, range);
+    }
     //    strcat(rqh, "User-Agent: Mozilla/5.0\r\n"); #363
     strcat(rqh, "Connection: keep-alive\r\n\r\n");
 
@@ -638,9 +785,12 @@ bool Audio::httpPrint(const char* host) {
     _client->print(rqh);
 
     if(endsWith(extension, ".mp3"))       m_expectedCodec  = CODEC_MP3;
+    if(endsWith(extension, ".mp2"))       m_expectedCodec  = CODEC_MP3;
     if(endsWith(extension, ".aac"))       m_expectedCodec  = CODEC_AAC;
     if(endsWith(extension, ".wav"))       m_expectedCodec  = CODEC_WAV;
     if(endsWith(extension, ".m4a"))       m_expectedCodec  = CODEC_M4A;
+    if(endsWith(extension, ".m4s"))       m_expectedCodec  = CODEC_M4A;
+    if(endsWith(extension, ".mp4"))       m_expectedCodec  = CODEC_M4A;
     if(endsWith(extension, ".flac"))      m_expectedCodec  = CODEC_FLAC;
     if(endsWith(extension, ".asx"))       m_expectedPlsFmt = FORMAT_ASX;
     if(endsWith(extension, ".m3u"))       m_expectedPlsFmt = FORMAT_M3U;
@@ -667,6 +817,22 @@ bool Audio::httpPrint(const char* host) {
     return true;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::webFileRange(uint32_t pos) {
+    // continue a web file at pos: the rest of the current response is dropped and the file is requested again from
+    // pos on, parseHttpResponseHeader() switches back to AUDIO_DATA without a new decoder initialization
+    if(m_streamType != ST_WEBFILE || !m_f_acceptRanges || m_f_chunked) return false;
+    _client->stop();
+    InBuff.resetBuffer();
+    m_byteCounter = pos;
+    m_rangeSkip = 0;
+    m_f_rangeRequest = true;
+    if(!httpPrint(m_lastHost, pos)) {
+        m_f_rangeRequest = false;
+        return false;
+    }
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool Audio::setFileLoop(bool input) {
     if(m_codec == CODEC_M4A) return 0;
     m_f_loop = input;
@@ -756,6 +922,7 @@ bool Audio::connecttoFS(fs::FS& fs, const char* path, int32_t resumeFilePos) {
     for(uint8_t i = dotPos + 1; i < strlen(afn); i++) { afn[i] = toLowerCase(afn[i]); }
 
     if(endsWith(afn, ".mp3")) m_codec = CODEC_MP3; // m_codec is by default CODEC_NONE
+    if(endsWith(afn, ".mp2")) m_codec = CODEC_MP3; // MPEG Layer II, decoded by the mp3 decoder
     if(endsWith(afn, ".m4a")) m_codec = CODEC_M4A;
     if(endsWith(afn, ".aac")) m_codec = CODEC_AAC;
     if(endsWith(afn, ".wav")) m_codec = CODEC_WAV;
@@ -766,6 +933,19 @@ bool Audio::connecttoFS(fs::FS& fs, const char* path, int32_t resumeFilePos) {
 
     if(m_codec == CODEC_NONE) AUDIO_INFO("The %s format is not supported", afn + dotPos);
 
+    if(m_seekIdxInterval && (m_codec == CODEC_MP3 || m_codec == CODEC_AAC || m_codec == CODEC_FLAC)) {
+        m_seekIdxFS = &fs;
+        m_f_seekIdxBuild = true;
+        if(m_f_seekIdxSidecar) {
+            m_seekIdxPath = (char*)malloc(strlen(audioName) + 6);
+            if(m_seekIdxPath) {
+                strcpy(m_seekIdxPath, audioName);
+                strcat(m_seekIdxPath, ".sidx");
+                if(seekIndex_load()) m_f_seekIdxBuild = false; // nothing more to record
+            }
+        }
+    }
+
     if(afn) {
         free(afn);
         afn = NULL;
@@ -1295,6 +1475,8 @@ int Audio::read_FLAC_Header(uint8_t* data, size_t len) {
     static size_t headerSize;
     static size_t retvalue = 0;
     static bool   f_lastMetaBlock;
+    static size_t seekPoints;    // SEEKTABLE, seekpoints still to read
+    static size_t seekRest;      // SEEKTABLE, bytes behind the last seekpoint
 
     if(retvalue) {
         if(retvalue > len) { // if returnvalue > bufferfillsize
@@ -1374,12 +1556,11 @@ int Audio::read_FLAC_Header(uint8_t* data, size_t len) {
         m_flacMaxFrameSize = bigEndian(data + 10, 3);
         if(m_flacMaxFrameSize) { AUDIO_INFO("FLAC maxFrameSize: %u", m_flacMaxFrameSize); }
         else { AUDIO_INFO("FLAC maxFrameSize: N/A"); }
-        if(m_flacMaxFrameSize > InBuff.getMaxBlockSize()) {
-            log_e("FLAC maxFrameSize too large!");
+        if(m_flacMaxBlockSize > MAX_BLOCKSIZE) {
+            log_e("FLAC maxBlockSize too large!");
             stopSong();
             return -1;
         }
-        //        InBuff.changeMaxBlockSize(m_flacMaxFrameSize);
         vTaskDelay(2);
         uint32_t nextval = bigEndian(data + 13, 3);
         m_flacSampleRate = nextval >> 4;
@@ -1397,6 +1578,17 @@ int Audio::read_FLAC_Header(uint8_t* data, size_t len) {
             return -1;
         }
         AUDIO_INFO("FLAC bitsPerSample: %u", m_flacBitsPerSample);
+        if(m_flacMaxBlockSize) { // size the decoder and the buffers for the largest frame of this stream
+            uint32_t maxFrameSize = m_flacMaxFrameSize;
+            if(!maxFrameSize) maxFrameSize = (uint32_t)m_flacMaxBlockSize * m_flacNumChannels * bps / 8 + 64; // verbatim frame
+            if(maxFrameSize < m_frameSizeFLAC) maxFrameSize = m_frameSizeFLAC;
+            if(!FLACDecoder_SetMaxBlockSize(m_flacMaxBlockSize, maxFrameSize) || !setOutBuffSize(m_flacMaxBlockSize * 2) ||
+               !InBuff.changeMaxBlockSize(maxFrameSize)) {
+                log_e("not enough memory for FLAC blocksize %u", m_flacMaxBlockSize);
+                stopSong();
+                return -1;
+            }
+        }
         m_flacTotalSamplesInStream = bigEndian(data + 17, 4);
         if(m_flacTotalSamplesInStream) { AUDIO_INFO("total samples in stream: %lu", (long unsigned int)m_flacTotalSamplesInStream); }
         else { AUDIO_INFO("total samples in stream: N/A"); }
@@ -1425,12 +1617,41 @@ int Audio::read_FLAC_Header(uint8_t* data, size_t len) {
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     if(m_controlCounter == FLAC_SEEK) { /* SEEKTABLE */
         size_t l = bigEndian(data, 3);
-        m_controlCounter = FLAC_MBH;
-        retvalue = l + 3;
+        // seekpoints: sample number (8 bytes), offset from the first frame header (8 bytes), samples in frame (2 bytes)
+        seekPoints = l / 18;
+        seekRest = l % 18;
+        m_flacSeekTable.clear();
+        m_flacSeekTable.reserve(seekPoints);
+        m_controlCounter = FLAC_SEEKPOINTS;
+        retvalue = 3;
         headerSize += retvalue;
         return 0;
     }
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    if(m_controlCounter == FLAC_SEEKPOINTS) { /* SEEKTABLE, the seekpoints in the buffer, the table can be larger */
+        size_t n = len / 18;
+        if(!n) n = 1; // len ends at the wrap of InBuff, getReadPtr() has completed the block behind it
+        if(n > seekPoints) n = seekPoints;
+        for(size_t i = 0; i < n; i++) {
+            uint8_t* p = data + i * 18;
+            if(bigEndian(p, 4) || bigEndian(p + 8, 4)) continue; // placeholder point (0xFFFF...) or beyond 4GB
+            seekIdxEntry_t e;
+            e.sample = bigEndian(p + 4, 4);
+            e.pos = bigEndian(p + 12, 4);
+            if(m_flacSeekTable.size() && e.sample <= m_flacSeekTable.back().sample) continue; // must be ascending
+            m_flacSeekTable.push_back(e);
+        }
+        seekPoints -= n;
+        headerSize += n * 18;
+        if(!seekPoints) {
+            if(m_f_Log) log_i("FLAC seektable, %i seekpoints", m_flacSeekTable.size());
+            m_controlCounter = FLAC_MBH;
+            retvalue = seekRest;
+            headerSize += retvalue;
+        }
+        return n * 18;
+    }
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     if(m_controlCounter == FLAC_VORBIS) { /* VORBIS COMMENT */ // field names
         const char fn[7][12] = {"TITLE", "VERSION", "ALBUM", "TRACKNUMBER", "ARTIST", "PERFORMER", "GENRE"};
         int        offset;
@@ -1780,6 +2001,111 @@ int Audio::read_ID3_Header(uint8_t* data, size_t len) {
     return 0;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::read_MP3_VBR_Header(uint8_t* data, size_t len) {
+    // The first frame of a MP3 file can carry a Xing/Info (LAME) or a VBRI (Fraunhofer) header instead of audio data.
+    // It contains the number of frames and the length of the stream in bytes, so the duration is exact also for VBR.
+    // The seek table (Xing: 100 entries TOC in percent of the duration, VBRI: size of each segment) is stored in
+    // m_mp3SeekTable as byte offsets relative to the begin of this frame
+    if(len < 4 || data[0] != 0xFF || (data[1] & 0xE0) != 0xE0) return false;
+    uint8_t ver = (data[1] >> 3) & 0x03;   // 0: MPEG2.5, 1: reserved, 2: MPEG2, 3: MPEG1
+    uint8_t layer = (data[1] >> 1) & 0x03; // 1: layer III
+    uint8_t srIdx = (data[2] >> 2) & 0x03;
+    uint8_t chMode = (data[3] >> 6) & 0x03; // 3: mono
+    if(ver == 1 || layer != 1 || srIdx == 3) return false;
+
+    const uint32_t srTab[3] = {44100, 48000, 32000};
+    uint32_t       sampleRate = srTab[srIdx] >> ((ver == 3) ? 0 : (ver == 2) ? 1 : 2); // MPEG1, MPEG2: /2, MPEG2.5: /4
+    uint16_t       samplesPerFrame = (ver == 3) ? 1152 : 576;
+    uint8_t        sideInfoSize = (ver == 3) ? ((chMode == 3) ? 17 : 32) : ((chMode == 3) ? 9 : 17);
+    uint32_t       frames = 0, bytes = 0, delay = 0, padding = 0;
+    uint8_t*       p = NULL;
+
+    m_mp3SeekTable.clear();
+    m_mp3SeekTableStep = 0;
+
+    size_t pos = 4 + sideInfoSize; // Xing or Info follows the side info
+    if(pos + 8 <= len && (memcmp(data + pos, "Xing", 4) == 0 || memcmp(data + pos, "Info", 4) == 0)) {
+        p = data + pos + 4;
+        uint32_t flags = bigEndian(p, 4);
+        p += 4;
+        if((flags & 0x01) && p + 4 <= data + len) { frames = bigEndian(p, 4); p += 4; }
+        if((flags & 0x02) && p + 4 <= data + len) { bytes = bigEndian(p, 4); p += 4; }
+        if((flags & 0x04) && p + 100 <= data + len) {
+            if(frames && bytes) { // TOC: entry i is the file position at i percent of the duration in 1/256 of bytes
+                m_mp3SeekTable.reserve(101);
+                for(int i = 0; i < 100; i++) m_mp3SeekTable.push_back(((uint64_t)p[i] * bytes) >> 8);
+                m_mp3SeekTable.push_back(bytes);
+            }
+            p += 100;
+        }
+        if(flags & 0x08) { // quality indicator, the LAME tag follows
+            p += 4;
+            if(p + 24 <= data + len && memcmp(p, "LAME", 4) == 0) {
+                delay = (p[21] << 4) | (p[22] >> 4);
+                padding = ((p[22] & 0x0F) << 8) | p[23];
+                AUDIO_INFO("LAME tag found, encoder delay %lu, padding %lu", (long unsigned int)delay, (long unsigned int)padding);
+            }
+        }
+        if(frames && m_mp3SeekTable.size()) m_mp3SeekTableStep = (float)frames * samplesPerFrame / sampleRate / 100;
+        AUDIO_INFO("%s header found, frames %lu, bytes %lu", (data[pos] == 'X') ? "Xing" : "Info", (long unsigned int)frames,
+                   (long unsigned int)bytes);
+    }
+    else if(36 + 26 <= len && memcmp(data + 36, "VBRI", 4) == 0) { // VBRI is always 32 bytes behind the frame header
+        p = data + 36;
+        bytes = bigEndian(p + 10, 4);
+        frames = bigEndian(p + 14, 4);
+        uint16_t entries = bigEndian(p + 18, 2);
+        uint16_t scale = bigEndian(p + 20, 2);
+        uint16_t entrySize = bigEndian(p + 22, 2);
+        uint16_t framesPerEntry = bigEndian(p + 24, 2);
+        p += 26;
+        if(entrySize >= 1 && entrySize <= 4 && framesPerEntry && p + entries * entrySize <= data + len) {
+            uint32_t offset = 0;
+            m_mp3SeekTable.reserve(entries + 1);
+            m_mp3SeekTable.push_back(0);
+            for(int i = 0; i < entries; i++) {
+                offset += bigEndian(p, entrySize) * scale;
+                p += entrySize;
+                m_mp3SeekTable.push_back(offset);
+            }
+            m_mp3SeekTableStep = (float)framesPerEntry * samplesPerFrame / sampleRate;
+        }
+        AUDIO_INFO("VBRI header found, frames %lu, bytes %lu", (long unsigned int)frames, (long unsigned int)bytes);
+    }
+    if(!frames) return false;
+
+    uint64_t samples = (uint64_t)frames * samplesPerFrame;
+    if(samples > delay + padding) samples -= delay + padding;
+    m_mp3VbrDuration = (float)samples / sampleRate;
+    if(!bytes) bytes = m_audioDataSize;
+    m_mp3VbrBitrate = (m_mp3VbrDuration > 0) ? (uint32_t)(8.0f * bytes / m_mp3VbrDuration) : 0;
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint32_t Audio::mp3_vbrPosFromTime(float sec) {
+    // file position for a time, taken from the Xing TOC or the VBRI table, linear interpolation between the entries
+    if(m_mp3SeekTable.size() < 2 || m_mp3SeekTableStep <= 0) return 0;
+    float    idx = sec / m_mp3SeekTableStep;
+    uint32_t i = (uint32_t)idx;
+    if(i >= m_mp3SeekTable.size() - 1) return m_mp3VbrStart + m_mp3SeekTable.back();
+    float frac = idx - i;
+    return m_mp3VbrStart + m_mp3SeekTable[i] + (uint32_t)(frac * (m_mp3SeekTable[i + 1] - m_mp3SeekTable[i]));
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float Audio::mp3_vbrTimeFromPos(uint32_t pos) {
+    // the inverse of mp3_vbrPosFromTime()
+    if(m_mp3SeekTable.size() < 2 || m_mp3SeekTableStep <= 0) return 0;
+    if(pos <= m_mp3VbrStart) return 0;
+    pos -= m_mp3VbrStart;
+    for(uint32_t i = 0; i < m_mp3SeekTable.size() - 1; i++) {
+        if(pos >= m_mp3SeekTable[i + 1]) continue;
+        uint32_t segSize = m_mp3SeekTable[i + 1] - m_mp3SeekTable[i];
+        float    frac = segSize ? (float)(pos - m_mp3SeekTable[i]) / segSize : 0;
+        return (i + frac) * m_mp3SeekTableStep;
+    }
+    return (m_mp3SeekTable.size() - 1) * m_mp3SeekTableStep;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 int Audio::read_M4A_Header(uint8_t* data, size_t len) {
     /*
          ftyp
@@ -1793,6 +2119,7 @@ int Audio::read_M4A_Header(uint8_t* data, size_t len) {
     static size_t retvalue = 0;
     static size_t atomsize = 0;
     static size_t audioDataPos = 0;
+    static bool   f_moov = false; // moov has been seen
 
     if(m_controlCounter == M4A_BEGIN) retvalue = 0;
     static size_t cnt = 0;
@@ -1818,6 +2145,7 @@ int Audio::read_M4A_Header(uint8_t* data, size_t len) {
         retvalue = 0;
         atomsize = 0;
         audioDataPos = 0;
+        f_moov = false;
         m_controlCounter = M4A_FTYP;
         return 0;
     }
@@ -1848,6 +2176,7 @@ int Audio::read_M4A_Header(uint8_t* data, size_t len) {
     if(m_controlCounter == M4A_CHK) {  /* check  Tag */
         atomsize = bigEndian(data, 4); // length of this atom
         if(specialIndexOf(data, "moov", 10) == 4) {
+            f_moov = true;
             m_controlCounter = M4A_MOOV;
             return 0;
         }
@@ -1857,6 +2186,12 @@ int Audio::read_M4A_Header(uint8_t* data, size_t len) {
             return 0;
         }
         else if(specialIndexOf(data, "mdat", 10) == 4) {
+            if(!f_moov && m_streamType == ST_WEBFILE && m_f_acceptRanges && headerSize + atomsize < m_contentlength) {
+                m_m4aMdatPos = headerSize; // moov follows mdat, processWebFile() requests moov first and then mdat
+                m_m4aMdatSize = atomsize;
+                headerSize += atomsize;
+                return 0;
+            }
             m_controlCounter = M4A_MDAT;
             return 0;
         }
@@ -1927,36 +2262,7 @@ int Audio::read_M4A_Header(uint8_t* data, size_t len) {
             uint32_t avrBr = bigEndian(pos + 30, 4); // avg bitrate
             AUDIO_INFO("avr bitrate: %lu", (long unsigned int)avrBr);
 
-            uint16_t ASC = bigEndian(pos + 39, 2);
-
-            uint8_t objectType = ASC >> 11; // first 5 bits
-
-            if(objectType == 1) { AUDIO_INFO("AudioObjectType: AAC Main"); } // Audio Object Types
-            else if(objectType == 2) { AUDIO_INFO("AudioObjectType: AAC Low Complexity"); }
-            else if(objectType == 3) { AUDIO_INFO("AudioObjectType: AAC Scalable Sample Rate"); }
-            else if(objectType == 4) { AUDIO_INFO("AudioObjectType: AAC Long Term Prediction"); }
-            else if(objectType == 5) { AUDIO_INFO("AudioObjectType: AAC Spectral Band Replication"); }
-            else if(objectType == 6) { AUDIO_INFO("AudioObjectType: AAC Scalable"); }
-            else { AUDIO_INFO("unknown Audio Type %x", audioType); }
-
-            const uint32_t samplingFrequencies[13] = {96000, 88200, 64000, 48000, 44100, 32000, 24000, 22050, 16000, 12000, 11025, 8000, 7350};
-            uint8_t        sRate = (ASC & 0x0600) >> 7; // next 4 bits Sampling Frequencies
-            AUDIO_INFO("Sampling Frequency: %lu", (long unsigned int)samplingFrequencies[sRate]);
-
-            uint8_t chConfig = (ASC & 0x78) >> 3; // next 4 bits
-            if(chConfig == 0) AUDIO_INFO("Channel Configurations: AOT Specifc Config");
-            if(chConfig == 1) AUDIO_INFO("Channel Configurations: front-center");
-            if(chConfig == 2) AUDIO_INFO("Channel Configurations: front-left, front-right");
-            if(chConfig > 2) { log_e("Channel Configurations with more than 2 channels is not allowed!"); }
-
-            uint8_t frameLengthFlag = (ASC & 0x04);
-            uint8_t dependsOnCoreCoder = (ASC & 0x02);
-            (void)dependsOnCoreCoder;
-            uint8_t extensionFlag = (ASC & 0x01);
-            (void)extensionFlag;
-
-            if(frameLengthFlag == 0) AUDIO_INFO("AAC FrameLength: 1024 bytes");
-            if(frameLengthFlag == 1) AUDIO_INFO("AAC FrameLength: 960 bytes");
+            m4a_parseASC(pos + 39); // AudioSpecificConfig
         }
         if(specialIndexOf(data, "mp4a", len) > 0) {
             int offset = specialIndexOf(data, "mp4a", len);
@@ -2038,6 +2344,65 @@ int Audio::read_M4A_Header(uint8_t* data, size_t len) {
     return 0;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::m4a_parseASC(const uint8_t* asc) {
+    // AudioSpecificConfig (ISO/IEC 14496-3 1.6.2.1), object type and sampling frequency index can be escaped
+    // sets m_m4aObjectType, m_m4aSampleRate (core sample rate), m_m4aNumChannels and m_m4aFrameLength
+    uint16_t ascBit = 0;
+    auto     ascBits = [&](uint8_t n) -> uint32_t {
+        uint32_t v = 0;
+        while(n--) { v = (v << 1) | ((asc[ascBit >> 3] >> (7 - (ascBit & 7))) & 1); ascBit++; }
+        return v;
+    };
+
+    uint8_t objectType = ascBits(5);
+    if(objectType == 31) objectType = 32 + ascBits(6);
+
+    if(objectType == 1) { AUDIO_INFO("AudioObjectType: AAC Main"); } // Audio Object Types
+    else if(objectType == 2) { AUDIO_INFO("AudioObjectType: AAC Low Complexity"); }
+    else if(objectType == 3) { AUDIO_INFO("AudioObjectType: AAC Scalable Sample Rate"); }
+    else if(objectType == 4) { AUDIO_INFO("AudioObjectType: AAC Long Term Prediction"); }
+    else if(objectType == 5) { AUDIO_INFO("AudioObjectType: AAC Spectral Band Replication"); }
+    else if(objectType == 6) { AUDIO_INFO("AudioObjectType: AAC Scalable"); }
+    else if(objectType == 23) { AUDIO_INFO("AudioObjectType: ER AAC Low Delay"); }
+    else if(objectType == 29) { AUDIO_INFO("AudioObjectType: AAC Parametric Stereo"); }
+    else if(objectType == 39) { log_e("AudioObjectType: ER AAC Enhanced Low Delay is not supported"); }
+    else { AUDIO_INFO("unknown Audio Object Type %i", objectType); }
+
+    const uint32_t samplingFrequencies[13] = {96000, 88200, 64000, 48000, 44100, 32000, 24000, 22050, 16000, 12000, 11025, 8000, 7350};
+    uint8_t        sRate = ascBits(4); // Sampling Frequency Index, 15: explicit 24 bit value
+    uint32_t       sampleRate = (sRate == 15) ? ascBits(24) : (sRate < 13 ? samplingFrequencies[sRate] : 0);
+    AUDIO_INFO("Sampling Frequency: %lu", (long unsigned int)sampleRate);
+
+    uint8_t chConfig = ascBits(4);
+    if(chConfig == 0) AUDIO_INFO("Channel Configurations: AOT Specifc Config");
+    if(chConfig == 1) AUDIO_INFO("Channel Configurations: front-center");
+    if(chConfig == 2) AUDIO_INFO("Channel Configurations: front-left, front-right");
+    if(chConfig > 2) { log_e("Channel Configurations with more than 2 channels is not allowed!"); }
+
+    m_m4aObjectType = objectType;
+    m_m4aSampleRate = sampleRate;
+    m_m4aNumChannels = chConfig;
+    m_m4aFrameLength = 1024;
+
+    if(objectType != 5 && objectType != 29 && objectType != 39) { // GASpecificConfig, ELD has its own config
+        uint8_t frameLengthFlag = ascBits(1);
+        uint8_t dependsOnCoreCoder = ascBits(1);
+        if(dependsOnCoreCoder) ascBits(14); // coreCoderDelay
+        uint8_t extensionFlag = ascBits(1);
+        uint8_t resilienceFlags = 0;
+        if(extensionFlag && objectType >= 17) resilienceFlags = ascBits(3); // section, scalefactor, spectral data
+        if(objectType == 23) {
+            m_m4aFrameLength = frameLengthFlag ? 480 : 512;
+            if(resilienceFlags) log_e("AAC-LD error resilience tools are not supported");
+        }
+        else {
+            m_m4aFrameLength = frameLengthFlag ? 960 : 1024;
+            if(frameLengthFlag) log_e("AAC frame length 960 is not supported");
+        }
+        AUDIO_INFO("AAC FrameLength: %i samples", m_m4aFrameLength);
+    }
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 size_t Audio::process_m3u8_ID3_Header(uint8_t* packet) {
     uint8_t  ID3version;
     size_t   id3Size;
@@ -2093,6 +2458,7 @@ uint32_t Audio::stopSong() {
         if(getDatamode() == AUDIO_LOCALFILE) {
             m_streamType = ST_NONE;
             pos = getFilePos() - inBufferFilled();
+            if(m_f_m4aTables) pos = m_m4aDec.pos; // InBuff holds access units only, not the file data in between
             audiofile.close();
             AUDIO_INFO("Closing audio file");
         }
@@ -2103,7 +2469,7 @@ uint32_t Audio::stopSong() {
         AUDIO_INFO("Closing audio file");
         log_w("Closing audio file"); // for debug
     }
-    memset(m_outBuff, 0, 2048 * 2 * sizeof(uint16_t)); // Clear OutputBuffer
+    memset(m_outBuff, 0, m_outBuffSize * sizeof(int16_t)); // Clear OutputBuffer
     m_validSamples = 0;
     return pos;
 }
@@ -2115,7 +2481,7 @@ bool Audio::pauseResume() {
         m_f_running = !m_f_running;
         retVal = true;
         if(!m_f_running) {
-            memset(m_outBuff, 0, 2048 * 2 * sizeof(uint16_t)); // Clear OutputBuffer
+            memset(m_outBuff, 0, m_outBuffSize * sizeof(int16_t)); // Clear OutputBuffer
             m_validSamples = 0;
         }
     }
@@ -2232,8 +2598,9 @@ void Audio::loop() {
 
                 break;
             case AUDIO_DATA:
-                if(m_f_ts) { processWebStreamTS(); } // aac or aacp with ts packets
-                else { processWebStreamHLS(); }      // aac or aacp normal stream
+                if(m_f_ts) { processWebStreamTS(); }            // aac or aacp with ts packets
+                else if(m_f_fmp4) { processWebStreamFMP4(); }   // aac or aacp in fragmented mp4 (CMAF)
+                else { processWebStreamHLS(); }                 // aac or aacp normal stream
 
                 if(m_f_continue) { // at this point m_f_continue is true, means processWebStream() needs more data
                     setDatamode(AUDIO_PLAYLISTDATA);
@@ -2523,6 +2890,33 @@ const char* Audio::parsePlaylist_M3U8() {
             if(startsWith(m_playlistContent[i], "#EXT-X-INDEPENDENT-SEGMENTS")) continue;
             if(startsWith(m_playlistContent[i], "#EXT-X-PROGRAM-DATE-TIME:")) continue;
 
+            if(startsWith(m_playlistContent[i], "#EXT-X-MAP:")) { // fMP4 init segment, e.g. #EXT-X-MAP:URI="init.mp4"
+                int pos1 = indexOf(m_playlistContent[i], "URI=\"", 0);
+                if(pos1 < 0) continue;
+                char* uri = strdup(m_playlistContent[i] + pos1 + 5);
+                int   pos2 = indexOf(uri, "\"", 0);
+                if(pos2 >= 0) uri[pos2] = '\0';
+                char* tmp = nullptr;
+                if(!startsWith(uri, "http")) { // relative to the playlist URL
+                    const char* base = m_lastM3U8host ? m_lastM3U8host : m_lastHost;
+                    tmp = (char*)malloc(strlen(base) + strlen(uri) + 1);
+                    strcpy(tmp, base);
+                    int idx = lastIndexOf(tmp, "/");
+                    strcpy(tmp + idx + 1, uri);
+                }
+                else { tmp = strdup(uri); }
+                free(uri);
+                uint32_t hash = simpleHash(tmp);
+                if(hash != m_fmp4InitHash) { // new decoder configuration, is loaded before the following segments
+                    m_fmp4InitHash = hash;
+                    m_playlistURL.insert(m_playlistURL.begin(), strdup(tmp));
+                    if(m_f_Log) log_i("fMP4 init segment %s", tmp);
+                }
+                free(tmp);
+                m_f_fmp4 = true;
+                continue;
+            }
+
             if(!f_mediaSeq_found) {
                 xMedSeq = m3u8_findMediaSeqInURL();
                 if(xMedSeq == UINT64_MAX) {
@@ -2858,17 +3252,25 @@ void Audio::processLocalFile() {
     availableBytes = 16 * 1024; // set some large value
 
     availableBytes = min(availableBytes, (uint32_t)InBuff.writeSpace());
-    availableBytes = min(availableBytes, audiofile.size() - m_byteCounter);
-    if(m_contentlength) {
-        if(m_contentlength > getFilePos()) availableBytes = min(availableBytes, m_contentlength - getFilePos());
+    int32_t bytesAddedToBuffer = 0;
+    if(m_f_m4aTables && m_controlCounter == 100) { // the access units of the audio track, in the order of the sample tables
+        bytesAddedToBuffer = m4a_readSamples(InBuff.getWritePtr(), availableBytes);
+        if(m_m4aRd.sample >= m_m4aNumSamples) availableBytes = 0;
     }
-    if(m_audioDataSize) { availableBytes = min(availableBytes, m_audioDataSize + m_audioDataStart - m_byteCounter); }
+    else {
+        availableBytes = min(availableBytes, audiofile.size() - m_byteCounter);
+        if(m_contentlength) {
+            if(m_contentlength > getFilePos()) availableBytes = min(availableBytes, m_contentlength - getFilePos());
+        }
+        if(m_audioDataSize) { availableBytes = min(availableBytes, m_audioDataSize + m_audioDataStart - m_byteCounter); }
 
-    int32_t bytesAddedToBuffer = audiofile.read(InBuff.getWritePtr(), availableBytes);
+        bytesAddedToBuffer = audiofile.read(InBuff.getWritePtr(), availableBytes);
+    }
 
     if(bytesAddedToBuffer > 0) {
         m_byteCounter += bytesAddedToBuffer; // Pull request #42
         InBuff.bytesWritten(bytesAddedToBuffer);
+        if(!m_tFirstByte) m_tFirstByte = millis();
     }
     if(!f_stream) {
         if(m_codec == CODEC_OGG) { // log_i("determine correct codec here");
@@ -2899,12 +3301,19 @@ void Audio::processLocalFile() {
             }
             if(InBuff.bufferFilled() > maxFrameSize) { // read the file header first
                 InBuff.bytesWasRead(readAudioHeader(InBuff.getMaxAvailableBytes()));
+                if(m_controlCounter == 100 && m_f_m4aTables) { // mdat reached, from now on the sample tables say what to read
+                    m4a_firstSample(m_m4aRd);
+                    m_m4aDec = m_m4aRd;
+                    m_m4aRdOffs = 0;
+                    InBuff.resetBuffer();
+                    m_byteCounter = m_m4aRd.pos;
+                }
             }
             return;
         }
         else {
-            if((InBuff.freeSpace() > maxFrameSize) && (m_file_size - m_byteCounter) > maxFrameSize && availableBytes) {
-                // fill the buffer before playing
+            if(!startupBufferReady((m_file_size - m_byteCounter) <= maxFrameSize || !availableBytes, true)) {
+                // fill the buffer before playing, depends on the startup policy
                 return;
             }
 
@@ -2917,16 +3326,31 @@ void Audio::processLocalFile() {
     if(m_resumeFilePos >= 0) {
         if(m_resumeFilePos < m_audioDataStart) m_resumeFilePos = m_audioDataStart;
         if(m_resumeFilePos > m_file_size) m_resumeFilePos = m_file_size;
-        if(m_codec == CODEC_M4A) m_resumeFilePos = m4a_correctResumeFilePos(m_resumeFilePos);
-        if(m_codec == CODEC_WAV) {
-            while((m_resumeFilePos % 4) != 0) m_resumeFilePos++;
-        } // must be divisible by four
-        if(m_codec == CODEC_FLAC) {
-            m_resumeFilePos = flac_correctResumeFilePos(m_resumeFilePos);
-            FLACDecoderReset();
+        if(m_f_seekIdxHit) { // frame position from the seek index, no need to search the next syncword
+            if(m_codec == CODEC_FLAC) FLACDecoderReset();
+            if(m_codec == CODEC_MP3) MP3Decoder_ClearBuffer();
+            if(m_codec == CODEC_M4A) m4a_correctResumeFilePos(m_resumeFilePos); // set the cursors
+            uint32_t sr = getSampleRate();
+            if(!sr) sr = m_seekIdxSampleRate;
+            if(sr) m_audioCurrentTime = (float)(m_seekIdxSample + m_samplesToSkip) / sr;
+            m_f_seekIdxFrameStart = true;
+            m_f_seekIdxHit = false;
+        }
+        else {
+            if(m_codec == CODEC_M4A) m_resumeFilePos = m4a_correctResumeFilePos(m_resumeFilePos);
+            if(m_codec == CODEC_WAV) {
+                while((m_resumeFilePos % 4) != 0) m_resumeFilePos++;
+            } // must be divisible by four
+            if(m_codec == CODEC_FLAC) {
+                m_resumeFilePos = flac_correctResumeFilePos(m_resumeFilePos);
+                FLACDecoderReset();
+            }
+            if(m_codec == CODEC_MP3) { m_resumeFilePos = mp3_correctResumeFilePos(m_resumeFilePos); }
+            if(m_codec == CODEC_MP3 && m_mp3SeekTable.size()) m_audioCurrentTime = mp3_vbrTimeFromPos(m_resumeFilePos);
+            else if(m_codec == CODEC_M4A && m_m4aTimescale) m_audioCurrentTime = m4a_sampleTime(m_m4aDec.sample);
+            else if(m_avr_bitrate) m_audioCurrentTime = ((double)(m_resumeFilePos - m_audioDataStart) / m_avr_bitrate) * 8;
+            m_f_seekIdxBuild = false; // sample position is unknown now
         }
-        if(m_codec == CODEC_MP3) { m_resumeFilePos = mp3_correctResumeFilePos(m_resumeFilePos); }
-        if(m_avr_bitrate) m_audioCurrentTime = ((double)(m_resumeFilePos - m_audioDataStart) / m_avr_bitrate) * 8;
         audiofile.seek(m_resumeFilePos);
         InBuff.resetBuffer();
         m_byteCounter = m_resumeFilePos;
@@ -2943,8 +3367,15 @@ void Audio::processLocalFile() {
     }
 
     // end of file reached? - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    if(f_fileDataComplete && m_f_m4aTables) { // decode the access units left in InBuff
+        if(f_stream && (m_validSamples || (m_m4aDec.sample < m_m4aNumSamples &&
+                                           (InBuff.bufferFilled() >= m_m4aDec.size || m_m4aDec.size > m_frameSizeAAC)))) {
+            playAudioData();
+            return;
+        }
+    }
     if(f_fileDataComplete && InBuff.bufferFilled() < InBuff.getMaxBlockSize()) {
-        if(InBuff.bufferFilled()) {
+        if(InBuff.bufferFilled() && !m_f_m4aTables) {
             if(!readID3V1Tag()) {
                 if(m_validSamples) {
                     playChunk();
@@ -2962,6 +3393,7 @@ void Audio::processLocalFile() {
                 AUDIO_INFO("audio file is corrupt --> send EOF"); // no return, fall through
             }
         }
+        seekIndex_finish();
 
         if(m_f_loop && f_stream) {                                                                                      // eof
             AUDIO_INFO("loop from: %lu to: %lu", (long unsigned int)getFilePos(), (long unsigned int)m_audioDataStart); // loop
@@ -2982,9 +3414,11 @@ void Audio::processLocalFile() {
         if(m_codec == CODEC_MP3) MP3Decoder_FreeBuffers();
         if(m_codec == CODEC_AAC) AACDecoder_FreeBuffers();
         if(m_codec == CODEC_M4A) AACDecoder_FreeBuffers();
+        if(m_codec == CODEC_M4A) m4a_freeSampleTables();
         if(m_codec == CODEC_FLAC) FLACDecoder_FreeBuffers();
         if(m_codec == CODEC_OPUS) OPUSDecoder_FreeBuffers();
         if(m_codec == CODEC_VORBIS) VORBISDecoder_FreeBuffers();
+        if(m_f_oggContainer) OGGDemuxer_FreeBuffers();
         AUDIO_INFO("End of file \"%s\"", afn);
         if(audio_eof_mp3) audio_eof_mp3(afn);
         if(afn) {
@@ -2994,15 +3428,20 @@ void Audio::processLocalFile() {
         return;
     }
 
-    if(m_byteCounter == audiofile.size()) { f_fileDataComplete = true; }
-    if(m_byteCounter == m_audioDataSize + m_audioDataStart) { f_fileDataComplete = true; }
+    if(m_f_m4aTables && m_controlCounter == 100) {
+        if(m_m4aRd.sample >= m_m4aNumSamples) { f_fileDataComplete = true; } // all access units are read
+    }
+    else {
+        if(m_byteCounter == audiofile.size()) { f_fileDataComplete = true; }
+        if(m_byteCounter == m_audioDataSize + m_audioDataStart) { f_fileDataComplete = true; }
+    }
 
     // play audio data - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     if(f_stream) { playAudioData(); }
 }
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::processWebStream() {
-    const uint16_t  maxFrameSize = InBuff.getMaxBlockSize(); // every mp3/aac frame is not bigger
+    const uint32_t  maxFrameSize = InBuff.getMaxBlockSize(); // every mp3/aac frame is not bigger
     static bool     f_stream;                                // first audio data received
     static uint32_t chunkSize;                               // chunkcount read from stream
 
@@ -3046,9 +3485,10 @@ void Audio::processWebStream() {
             if(m_f_metadata) m_metacount -= bytesAddedToBuffer;
             if(m_f_chunked) chunkSize -= bytesAddedToBuffer;
             InBuff.bytesWritten(bytesAddedToBuffer);
+            if(!m_tFirstByte) m_tFirstByte = millis();
         }
 
-        if(InBuff.bufferFilled() > maxFrameSize && !f_stream) { // waiting for buffer filled
+        if(!f_stream && startupBufferReady(false, false)) { // waiting for buffer filled
             f_stream = true;                                    // ready to play the audio data
             AUDIO_INFO("stream ready");
         }
@@ -3094,6 +3534,7 @@ void Audio::processWebFile() {
         f_stream = false;
         chunkSize = 0;
         audioDataCount = 0;
+        m_resumeFilePos = -1;
     }
 
     if(!m_contentlength && !m_f_tts) {
@@ -3102,6 +3543,30 @@ void Audio::processWebFile() {
         return;
     } // guard
 
+    auto rangeRequest = [&](uint32_t pos) { // continue the file at pos, parseHttpResponseHeader() comes back to AUDIO_DATA
+        f_stream = false;
+        f_webFileDataComplete = false;
+        chunkSize = 0;
+        return webFileRange(pos);
+    };
+
+    // new file position from setFilePos(), the decoder searches the next syncword there - - - - - - - - - - - - - - - -
+    if(m_resumeFilePos >= 0) {
+        uint32_t pos = m_resumeFilePos;
+        m_resumeFilePos = -1;
+        if(m_codec == CODEC_WAV) {
+            while((pos % 4) != 0) pos++;
+        } // must be divisible by four
+        if(m_codec == CODEC_FLAC) FLACDecoderReset();
+        if(m_codec == CODEC_MP3) MP3Decoder_ClearBuffer();
+        if(m_codec == CODEC_MP3 && m_mp3SeekTable.size()) m_audioCurrentTime = mp3_vbrTimeFromPos(pos);
+        else if(m_avr_bitrate) m_audioCurrentTime = ((double)(pos - m_audioDataStart) / m_avr_bitrate) * 8;
+        m_f_playing = false;
+        if(m_f_Log) log_i("web file continues at %lu", (long unsigned int)pos);
+        rangeRequest(pos);
+        return;
+    }
+
     uint32_t availableBytes = _client->available(); // available from stream
 
     // chunked data tramsfer - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -3121,6 +3586,12 @@ void Audio::processWebFile() {
     availableBytes = min(m_contentlength - m_byteCounter, availableBytes);
     if(m_audioDataSize) availableBytes = min(m_audioDataSize - (m_byteCounter - m_audioDataStart), availableBytes);
 
+    if(m_rangeSkip) { // the server sends the whole file instead of the range, drop everything in front of m_byteCounter
+        int32_t bytesSkipped = _client->read(InBuff.getWritePtr(), min(m_rangeSkip, availableBytes));
+        if(bytesSkipped > 0) m_rangeSkip -= bytesSkipped;
+        return;
+    }
+
     int16_t bytesAddedToBuffer = _client->read(InBuff.getWritePtr(), availableBytes);
 
     if(bytesAddedToBuffer > 0) {
@@ -3128,10 +3599,11 @@ void Audio::processWebFile() {
         if(m_f_chunked) m_chunkcount -= bytesAddedToBuffer;
         if(m_controlCounter == 100) audioDataCount += bytesAddedToBuffer;
         InBuff.bytesWritten(bytesAddedToBuffer);
+        if(!m_tFirstByte) m_tFirstByte = millis();
     }
 
     if(!f_stream) {
-        if((InBuff.freeSpace() > maxFrameSize) && (m_byteCounter < m_contentlength)) return;
+        if(!startupBufferReady(m_byteCounter >= m_contentlength, true)) return;
         f_stream = true; // ready to play the audio data
         uint16_t filltime = millis() - m_t0;
         AUDIO_INFO("stream ready, buffer filled in %d ms", filltime);
@@ -3140,10 +3612,26 @@ void Audio::processWebFile() {
 
     // we have a webfile, read the file header first - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     if(m_controlCounter != 100) {
-        if(InBuff.bufferFilled() > maxFrameSize) { // read the file header first
-            int32_t bytesRead = readAudioHeader(InBuff.getMaxAvailableBytes());
+        if(InBuff.bufferFilled() > maxFrameSize || (m_byteCounter == m_contentlength && InBuff.bufferFilled())) { // read the file header first
+            uint32_t bytes = InBuff.getMaxAvailableBytes();
+            if(m_byteCounter == m_contentlength && InBuff.bufferFilled() == bytes + 1) bytes++; // end of file, the last byte must be parsed too
+            int32_t bytesRead = readAudioHeader(bytes);
             if(bytesRead > 0) InBuff.bytesWasRead(bytesRead);
         }
+        if(m_m4aMdatPos) { // M4A, moov follows mdat
+            if(m_byteCounter < m_m4aMdatPos + m_m4aMdatSize) { // skip mdat, read moov behind it
+                rangeRequest(m_m4aMdatPos + m_m4aMdatSize);
+                return;
+            }
+            if(m_byteCounter == m_contentlength && !InBuff.bufferFilled()) { // moov is read, go back to the audio data
+                m_audioDataStart = m_m4aMdatPos + 8;
+                m_audioDataSize = m_m4aMdatSize - 8;
+                m_m4aMdatPos = 0;
+                m_controlCounter = M4A_OKAY;
+                AUDIO_INFO("Audio-Length: %lu", (long unsigned int)m_audioDataSize);
+                rangeRequest(m_audioDataStart);
+            }
+        }
         return;
     }
 
@@ -3192,6 +3680,7 @@ void Audio::processWebFile() {
         if(m_codec == CODEC_FLAC) FLACDecoder_FreeBuffers();
         if(m_codec == CODEC_OPUS) OPUSDecoder_FreeBuffers();
         if(m_codec == CODEC_VORBIS) VORBISDecoder_FreeBuffers();
+        if(m_f_oggContainer) OGGDemuxer_FreeBuffers();
 
         if(m_f_tts) {
             AUDIO_INFO("End of speech: \"%s\"", m_lastHost);
@@ -3213,7 +3702,7 @@ void Audio::processWebFile() {
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::processWebStreamTS() {
-    const uint16_t  maxFrameSize = InBuff.getMaxBlockSize(); // every mp3/aac frame is not bigger
+    const uint32_t  maxFrameSize = InBuff.getMaxBlockSize(); // every mp3/aac frame is not bigger
     uint32_t        availableBytes;                          // available bytes in stream
     static bool     f_stream;                                // first audio data received
     static bool     f_firstPacket;
@@ -3282,6 +3771,7 @@ void Audio::processWebStreamTS() {
                     memcpy(InBuff.getWritePtr(), &ts_packet[ws + ts_packetStart], ts_packetLength - ws);
                     InBuff.bytesWritten(ts_packetLength - ws);
                 }
+                if(!m_tFirstByte) m_tFirstByte = millis();
             }
             if (m_byteCounter == m_contentlength || m_byteCounter == chunkSize) {
                 f_chunkFinished = true;
@@ -3310,7 +3800,7 @@ void Audio::processWebStreamTS() {
 
     // buffer fill routine  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     if(true) {                                                  // statement has no effect
-        if(InBuff.bufferFilled() > maxFrameSize && !f_stream) { // waiting for buffer filled
+        if(!f_stream && startupBufferReady(f_chunkFinished, false)) { // waiting for buffer filled
             f_stream = true;                                    // ready to play the audio data
             uint16_t filltime = millis() - m_t0;
             if(m_f_Log) AUDIO_INFO("stream ready");
@@ -3324,8 +3814,87 @@ void Audio::processWebStreamTS() {
     return;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::processWebStreamFMP4() {
+    uint32_t        availableBytes = 0; // available bytes in stream
+    static bool     f_stream;           // first audio data received
+    static bool     f_chunkFinished;
+    static size_t   chunkSize = 0;
+    static uint8_t  segBuff[1024]; // bytes from the segment, not yet consumed by fmp4_parse()
+    static uint16_t segBuffLen = 0;
+    static uint16_t segBuffPtr = 0;
+
+    // first call, set some values to default - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    if(m_f_firstCall) { // runs only ont time per connection, prepare for start
+        f_stream = false;
+        f_chunkFinished = false;
+        chunkSize = 0;
+        segBuffLen = 0;
+        segBuffPtr = 0;
+        m_t0 = millis();
+        m_controlCounter = 0;
+        m_f_firstCall = false;
+        fmp4_parse(NULL, 0); // a new segment begins
+    }
+
+    if(getDatamode() != AUDIO_DATA) return; // guard
+
+    if(segBuffPtr == segBuffLen && !f_chunkFinished) { // all bytes are consumed, read the next block
+        segBuffPtr = 0;
+        segBuffLen = 0;
+        availableBytes = _client->available();
+        if(availableBytes) {
+            uint8_t readedBytes = 0;
+            if(m_f_chunked && !chunkSize) {
+                chunkSize = chunkedDataTransfer(&readedBytes);
+                m_byteCounter += readedBytes;
+            }
+            if(availableBytes > sizeof(segBuff)) availableBytes = sizeof(segBuff);
+            int res = _client->read(segBuff, availableBytes);
+            if(res > 0) {
+                segBuffLen = res;
+                m_byteCounter += res;
+                if(!m_tFirstByte) m_tFirstByte = millis();
+            }
+        }
+    }
+    if(segBuffPtr < segBuffLen) segBuffPtr += fmp4_parse(segBuff + segBuffPtr, segBuffLen - segBuffPtr);
+
+    if(segBuffPtr == segBuffLen && m_byteCounter && (m_byteCounter == m_contentlength || m_byteCounter == chunkSize)) {
+        f_chunkFinished = true;
+        m_byteCounter = 0;
+    }
+    if(f_chunkFinished) {
+        if(m_f_psramFound) {
+            if(InBuff.bufferFilled() < 50000) {
+                f_chunkFinished = false;
+                m_f_continue = true;
+            }
+        }
+        else {
+            f_chunkFinished = false;
+            m_f_continue = true;
+        }
+    }
+
+    // if the buffer is often almost empty issue a warning - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    if(f_stream) {
+        if(streamDetection(availableBytes)) return;
+    }
+
+    // buffer fill routine  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    if(!f_stream && startupBufferReady(f_chunkFinished || m_f_continue, false)) { // waiting for buffer filled
+        f_stream = true;                                                   // ready to play the audio data
+        uint16_t filltime = millis() - m_t0;
+        if(m_f_Log) AUDIO_INFO("stream ready");
+        if(m_f_Log) AUDIO_INFO("buffer filled in %d ms", filltime);
+    }
+
+    // play audio data - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    if(f_stream) { playAudioData(); }
+    return;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::processWebStreamHLS() {
-    const uint16_t maxFrameSize = InBuff.getMaxBlockSize(); // every mp3/aac frame is not bigger
     uint16_t       ID3BuffSize = 1024;
     if(m_f_psramFound) ID3BuffSize = 4096;
     uint32_t        availableBytes; // available bytes in stream
@@ -3403,6 +3972,7 @@ void Audio::processWebStreamHLS() {
         }
         else { bytesWasWritten = _client->read(InBuff.getWritePtr(), InBuff.writeSpace()); }
         InBuff.bytesWritten(bytesWasWritten);
+        if(!m_tFirstByte && bytesWasWritten) m_tFirstByte = millis();
 
         m_byteCounter += bytesWasWritten;
 
@@ -3430,7 +4000,7 @@ void Audio::processWebStreamHLS() {
         if(streamDetection(availableBytes)) return;
     }
 
-    if(InBuff.bufferFilled() > maxFrameSize && !f_stream) { // waiting for buffer filled
+    if(!f_stream && startupBufferReady(f_chunkFinished, false)) { // waiting for buffer filled
         f_stream = true;                                    // ready to play the audio data
         uint16_t filltime = millis() - m_t0;
         if(m_f_Log) AUDIO_INFO("stream ready");
@@ -3448,6 +4018,19 @@ void Audio::playAudioData() {
         return;
     } // play samples first
 
+    if(m_f_m4aTables) { // M4A: one access unit per call, its size comes from the sample tables
+        while(m_m4aDec.sample < m_m4aNumSamples && (!m_m4aDec.size || m_m4aDec.size > m_frameSizeAAC)) {
+            if(m_m4aDec.size) log_w("m4a access unit %lu is too big, skipped", (long unsigned int)m_m4aDec.sample);
+            m4a_nextSample(m_m4aDec); // m4a_readSamples() has not read it
+        }
+        if(m_m4aDec.sample >= m_m4aNumSamples) return;
+        if(InBuff.bufferFilled() < m_m4aDec.size) return; // guard
+        if(sendBytes(InBuff.getReadPtr(), m_m4aDec.size) == 0) return; // decoder is set up, decode with the next call
+        InBuff.bytesWasRead(m_m4aDec.size); // decoded or concealed, the next access unit follows in any case
+        m4a_nextSample(m_m4aDec);
+        return;
+    }
+
     if(InBuff.bufferFilled() < InBuff.getMaxBlockSize()) return; // guard
 
     int bytesDecoded = sendBytes(InBuff.getReadPtr(), InBuff.getMaxBlockSize());
@@ -3492,8 +4075,11 @@ bool Audio::parseHttpResponseHeader() { // this is the response to a GET / reque
     }
     f_time = false;
 
-    char rhl[512] = {0}; // responseHeaderline
-    bool ct_seen = false;
+    char    rhl[512] = {0}; // responseHeaderline
+    bool    ct_seen = false;
+    int32_t rangeFirst = -1; // first byte of a partial content (content-range)
+    int32_t rangeTotal = 0;  // length of the whole file (content-range)
+    bool    f_wholeFile = false; // the server answers a range request with the whole file
 
     while(true) { // outer while
         uint16_t pos = 0;
@@ -3506,7 +4092,7 @@ bool Audio::parseHttpResponseHeader() { // this is the response to a GET / reque
             uint8_t b = _client->read();
             if(b == '\n') {
                 if(!pos) { // empty line received, is the last line of this responseHeader
-                    if(ct_seen) goto lastToDo;
+                    if(ct_seen || m_f_rangeRequest) goto lastToDo;
                     else goto exit;
                 }
                 break;
@@ -3548,13 +4134,18 @@ bool Audio::parseHttpResponseHeader() { // this is the response to a GET / reque
                 if(audio_showstreamtitle) audio_showstreamtitle(rhl);
                 goto exit;
             }
+            if(m_f_rangeRequest && sc >= 200 && sc < 300 && sc != 206) { // e.g. HTTP/1.1 200 OK, the whole file follows
+                log_w("range request is not accepted, status %i, the file is read from the beginning", sc);
+                f_wholeFile = true;
+            }
         }
 
         else if(startsWith(rhl, "content-type:")) { // content-type: text/html; charset=UTF-8
             // log_i("cT: %s", rhl);
             int idx = indexOf(rhl + 13, ";");
             if(idx > 0) rhl[13 + idx] = '\0';
-            if(parseContentType(rhl + 13)) ct_seen = true;
+            if(m_f_rangeRequest) ct_seen = true; // the codec is already known
+            else if(parseContentType(rhl + 13)) ct_seen = true;
             else goto exit;
         }
 
@@ -3571,12 +4162,17 @@ bool Audio::parseHttpResponseHeader() { // this is the response to a GET / reque
                                 strcpy(m_lastHost, c_host);
                                 m_f_m3u8data = true;
                             }
-                            httpPrint(c_host);
+                            httpPrint(c_host, m_f_rangeRequest ? (int32_t)m_byteCounter : -1);
                             while(_client->available()) _client->read(); // empty client buffer
                             return true;
                         }
                     }
                     AUDIO_INFO("redirect to new host \"%s\"", c_host);
+                    if(m_f_rangeRequest) { // the range continues there, connecttohost() would start the file from byte 0
+                        _client->stop();   // m_lastHost is kept, the next range request is redirected again
+                        httpPrint(c_host, m_byteCounter);
+                        return true;
+                    }
                     connecttohost(c_host);
                     return true;
                 }
@@ -3609,11 +4205,21 @@ bool Audio::parseHttpResponseHeader() { // this is the response to a GET / reque
         //         startsWith(rhl, "expires:")       ||
         //         startsWith(rhl, "cache-control:") ||
         //         startsWith(rhl, "icy-pub:")       ||
-        //         startsWith(rhl, "p3p:")           ||
-        //         startsWith(rhl, "accept-ranges:") ){
+        //         startsWith(rhl, "p3p:")           ){
         //     ; // do nothing
         // }
 
+        else if(startsWith(rhl, "accept-ranges:")) { // accept-ranges: bytes
+            if(indexOf(rhl, "bytes", 0) > 0) m_f_acceptRanges = true;
+        }
+
+        else if(startsWith(rhl, "content-range:")) { // content-range: bytes 1000-49999/50000
+            int idx = indexOf(rhl, "bytes", 0);
+            if(idx > 0) rangeFirst = atoi(rhl + idx + 6);
+            idx = indexOf(rhl, "/", 0);
+            if(idx > 0) rangeTotal = atoi(rhl + idx + 1); // "*" if the total is unknown, gives 0
+        }
+
         else if(startsWith(rhl, "connection:")) {
             if(indexOf(rhl, "close", 0) >= 0) { ; /* do nothing */ }
         }
@@ -3697,6 +4303,7 @@ bool Audio::parseHttpResponseHeader() { // this is the response to a GET / reque
     } // outer while
 
 exit: // termination condition
+    m_f_rangeRequest = false;
     if(audio_showstation) audio_showstation("");
     if(audio_icydescription) audio_icydescription("");
     if(audio_icyurl) audio_icyurl("");
@@ -3707,6 +4314,36 @@ exit: // termination condition
     return false;
 
 lastToDo:
+    if(m_f_rangeRequest) { // the web file continues at m_byteCounter, the decoder is already initialized
+        m_f_rangeRequest = false;
+        if(f_wholeFile) { // processWebFile() drops the bytes in front of m_byteCounter
+            if(m_f_chunked || m_contentlength <= m_byteCounter) {
+                log_e("the whole file without content-length can't be read from position %lu", (long unsigned int)m_byteCounter);
+                goto exit;
+            }
+            m_rangeSkip = m_byteCounter;
+            m_streamType = ST_WEBFILE;
+            setDatamode(AUDIO_DATA);
+            return true;
+        }
+        if(rangeFirst == -1 && m_contentlength) { // some servers omit content-range, the requested position is assumed
+            log_w("partial content without content-range, assume it starts at %lu", (long unsigned int)m_byteCounter);
+            rangeFirst = m_byteCounter;
+        }
+        if(rangeFirst != (int32_t)m_byteCounter) {
+            log_e("content-range %li does not match the requested position %lu", (long int)rangeFirst, (long unsigned int)m_byteCounter);
+            goto exit;
+        }
+        if(rangeTotal > 0) m_contentlength = rangeTotal;
+        else if(m_contentlength) m_contentlength += m_byteCounter; // content-length is the length of the remaining part
+        else {
+            log_e("partial content without content-range total and content-length");
+            goto exit;
+        }
+        m_streamType = ST_WEBFILE; // httpPrint() has set ST_WEBSTREAM
+        setDatamode(AUDIO_DATA);
+        return true;
+    }
     if(m_codec != CODEC_NONE) {
         setDatamode(AUDIO_DATA); // Expecting data now
         if(!initializeDecoder()) return false;
@@ -3726,6 +4363,19 @@ lastToDo:
     return true;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::setOutBuffSize(size_t samples) {
+    // FLACDecode() writes a whole block at once, the buffer follows the largest block of the stream
+    if(samples < 2048 * 2) samples = 2048 * 2;
+    if(samples == m_outBuffSize) return true;
+    int16_t* tmp = (int16_t*)__malloc_heap_psram(samples * sizeof(int16_t));
+    if(!tmp) return false;
+    memcpy(tmp, m_outBuff, (samples < m_outBuffSize ? samples : m_outBuffSize) * sizeof(int16_t));
+    free(m_outBuff);
+    m_outBuff = tmp;
+    m_outBuffSize = samples;
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool Audio::initializeDecoder() {
     uint32_t gfH = 0;
     uint32_t hWM = 0;
@@ -3738,6 +4388,8 @@ bool Audio::initializeDecoder() {
             gfH = ESP.getFreeHeap();
             hWM = uxTaskGetStackHighWaterMark(NULL);
             AUDIO_INFO("MP3Decoder has been initialized, free Heap: %lu bytes , free stack %lu DWORDs", (long unsigned int)gfH, (long unsigned int)hWM);
+            MP3Decoder_SetDownmix(m_f_forceMono); // mono output: mix the channels before the synthesis
+            MP3Decoder_SetRateDivider(m_mp3RateDivider);
             InBuff.changeMaxBlockSize(m_frameSizeMP3);
             break;
         case CODEC_AAC:
@@ -3751,6 +4403,7 @@ bool Audio::initializeDecoder() {
                 AUDIO_INFO("AACDecoder has been initialized, free Heap: %lu bytes , free stack %lu DWORDs", (long unsigned int)gfH, (long unsigned int)hWM);
                 InBuff.changeMaxBlockSize(m_frameSizeAAC);
             }
+            AACDecoder_SetSBRDownsampled(m_f_aacSBRDownsampled);
             break;
         case CODEC_M4A:
             if(!AACDecoder_IsInit()) {
@@ -3763,6 +4416,7 @@ bool Audio::initializeDecoder() {
                 AUDIO_INFO("AACDecoder has been initialized, free Heap: %lu bytes , free stack %lu DWORDs", (long unsigned int)gfH, (long unsigned int)hWM);
                 InBuff.changeMaxBlockSize(m_frameSizeAAC);
             }
+            AACDecoder_SetSBRDownsampled(m_f_aacSBRDownsampled);
             break;
         case CODEC_FLAC:
             if(!psramFound()) {
@@ -3773,9 +4427,18 @@ bool Audio::initializeDecoder() {
                 AUDIO_INFO("The FLACDecoder could not be initialized");
                 goto exit;
             }
+            if(!setOutBuffSize(DEFAULT_MAX_BLOCKSIZE * 2)) { // until STREAMINFO is read
+                AUDIO_INFO("The FLACDecoder could not be initialized");
+                goto exit;
+            }
+            FLACDecoder_SetCRCCheck(m_f_flacCrcCheck);
+            OGGDemuxer_ClearBuffer(); // Ogg FLAC is detected in findNextSync()
             gfH = ESP.getFreeHeap();
             hWM = uxTaskGetStackHighWaterMark(NULL);
-            InBuff.changeMaxBlockSize(m_frameSizeFLAC);
+            if(!InBuff.changeMaxBlockSize(m_frameSizeFLAC)) {
+                AUDIO_INFO("The FLACDecoder could not be initialized");
+                goto exit;
+            }
             AUDIO_INFO("FLACDecoder has been initialized, free Heap: %lu bytes , free stack %lu DWORDs", (long unsigned int)gfH, (long unsigned int)hWM);
             break;
         case CODEC_OPUS:
@@ -3783,6 +4446,8 @@ bool Audio::initializeDecoder() {
                 AUDIO_INFO("The OPUSDecoder could not be initialized");
                 goto exit;
             }
+            m_f_oggContainer = true;
+            OGGDemuxer_ClearBuffer();
             gfH = ESP.getFreeHeap();
             hWM = uxTaskGetStackHighWaterMark(NULL);
             AUDIO_INFO("OPUSDecoder has been initialized, free Heap: %lu bytes , free stack %lu DWORDs", (long unsigned int)gfH, (long unsigned int)hWM);
@@ -3797,6 +4462,8 @@ bool Audio::initializeDecoder() {
                 AUDIO_INFO("The VORBISDecoder could not be initialized");
                 goto exit;
             }
+            m_f_oggContainer = true;
+            OGGDemuxer_ClearBuffer();
             gfH = ESP.getFreeHeap();
             hWM = uxTaskGetStackHighWaterMark(NULL);
             AUDIO_INFO("VORBISDecoder has been initialized, free Heap: %lu bytes,  free stack %lu DWORDs", (long unsigned int)gfH, (long unsigned int)hWM);
@@ -3836,6 +4503,8 @@ bool Audio::parseContentType(char* ct) {
     else if(!strcmp(ct, "audio/mp4"))                     ct_val = CT_M4A;
     else if(!strcmp(ct, "audio/m4a"))                     ct_val = CT_M4A;
     else if(!strcmp(ct, "audio/x-m4a"))                   ct_val = CT_M4A;
+    else if(!strcmp(ct, "video/mp4"))                     ct_val = CT_M4A;  // fMP4 HLS segments
+    else if(!strcmp(ct, "video/iso.segment"))             ct_val = CT_M4A;
     else if(!strcmp(ct, "audio/wav"))                     ct_val = CT_WAV;
     else if(!strcmp(ct, "audio/x-wav"))                   ct_val = CT_WAV;
     else if(!strcmp(ct, "audio/flac"))                    ct_val = CT_FLAC;
@@ -3908,6 +4577,10 @@ bool Audio::parseContentType(char* ct) {
                 m_codec = CODEC_MP3;
                 if(m_f_Log) log_i("set ct from M3U8 to MP3");
             }
+            if(m_expectedCodec == CODEC_M4A) {
+                m_codec = CODEC_M4A;
+                if(m_f_Log) log_i("set ct from M3U8 to M4A");
+            }
 
             if(m_expectedPlsFmt == FORMAT_ASX) {
                 m_playlistFormat = FORMAT_ASX;
@@ -4120,23 +4793,48 @@ int Audio::findNextSync(uint8_t* data, size_t len) {
         m_f_playing = true;
         nextSync = 0;
     }
-    if(m_codec == CODEC_MP3) { nextSync = MP3FindSyncWord(data, len); }
+    if(m_codec == CODEC_MP3) {
+        nextSync = MP3FindSyncWord(data, len);
+        if(nextSync >= 0 && !m_f_mp3VbrChecked && (getDatamode() == AUDIO_LOCALFILE || m_streamType == ST_WEBFILE)) {
+            m_f_mp3VbrChecked = true; // only the first frame can contain a Xing/VBRI header
+            m_mp3VbrStart = getFilePos() - InBuff.bufferFilled() + nextSync;
+            read_MP3_VBR_Header(data + nextSync, len - nextSync);
+        }
+    }
     if(m_codec == CODEC_AAC) { nextSync = AACFindSyncWord(data, len); }
     if(m_codec == CODEC_M4A) {
-        AACSetRawBlockParams(0, 2, 44100, 1);
+        if(m_m4aObjectType == 39) { // AAC-ELD needs the low delay filterbank and LD-SBR, the decoder has neither
+            log_e("AAC-ELD is not supported");
+            stopSong();
+            return len;
+        }
+        if(m_m4aObjectType == 23) { // AAC-LD
+            AACDecoder_SetFrameLength(m_m4aFrameLength);
+            if(AACSetRawBlockParams(0, m_m4aNumChannels, m_m4aSampleRate, m_m4aObjectType - 1)) {
+                log_e("AAC-LD: %i samples per frame, %i channels, %lu Hz not supported", m_m4aFrameLength, m_m4aNumChannels,
+                      (long unsigned int)m_m4aSampleRate);
+            }
+        }
+        else {
+            AACDecoder_SetFrameLength(1024); // the decoder may still be set up for a previous AAC-LD file
+            AACSetRawBlockParams(0, 2, 44100, 1);
+        }
         m_f_playing = true;
         nextSync = 0;
     }
     if(m_codec == CODEC_FLAC) {
-        FLACSetRawBlockParams(m_flacNumChannels, m_flacSampleRate, m_flacBitsPerSample, m_flacTotalSamplesInStream, m_audioDataSize);
-        nextSync = FLACFindSyncWord(data, len);
-    }
-    if(m_codec == CODEC_OPUS) {
-        nextSync = OPUSFindSyncWord(data, len);
-        if(nextSync == -1) return len; // OggS not found, search next block
+        if(!m_f_oggContainer && specialIndexOf(data, "OggS", 5) == 0) m_f_oggContainer = true;
+        if(m_f_oggContainer) { // STREAMINFO comes with the first Ogg packet
+            nextSync = OGGFindSyncWord(data, len);
+            if(nextSync == -1) return len; // OggS not found, search next block
+        }
+        else {
+            FLACSetRawBlockParams(m_flacNumChannels, m_flacSampleRate, m_flacBitsPerSample, m_flacTotalSamplesInStream, m_audioDataSize);
+            nextSync = FLACFindSyncWord(data, len);
+        }
     }
-    if(m_codec == CODEC_VORBIS) {
-        nextSync = VORBISFindSyncWord(data, len);
+    if(m_codec == CODEC_OPUS || m_codec == CODEC_VORBIS) {
+        nextSync = OGGFindSyncWord(data, len);
         if(nextSync == -1) return len; // OggS not found, search next block
     }
     if(nextSync == -1) {
@@ -4208,6 +4906,7 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
     int         nextSync = 0;
     if(!m_f_playing) {
         f_setDecodeParamsOnce = true;
+        m_f_seekIdxFrameStart = true;
         nextSync = findNextSync(data, len);
         if(nextSync == 0) { m_f_playing = true; }
         return nextSync;
@@ -4215,16 +4914,21 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
     // m_f_playing is true at this pos
     bytesLeft = len;
     m_decodeError = 0;
-    int bytesDecoded = 0;
+    int  bytesDecoded = 0;
+    bool f_frameStart = m_f_seekIdxFrameStart; // data begins with a new frame (FLAC: not after reading the frame header only)
 
     switch(m_codec) {
         case CODEC_WAV:  m_decodeError = 0; bytesLeft = 0; break;
         case CODEC_MP3:  m_decodeError = MP3Decode(data, &bytesLeft, m_outBuff, 0); break;
         case CODEC_AAC:  m_decodeError = AACDecode(data, &bytesLeft, m_outBuff); break;
-        case CODEC_M4A:  m_decodeError = AACDecode(data, &bytesLeft, m_outBuff); break;
-        case CODEC_FLAC: m_decodeError = FLACDecode(data, &bytesLeft, m_outBuff); break;
-        case CODEC_OPUS: m_decodeError = OPUSDecode(data, &bytesLeft, m_outBuff); break;
-        case CODEC_VORBIS: m_decodeError = VORBISDecode(data, &bytesLeft, m_outBuff); break;
+        case CODEC_M4A:  m_decodeError = AACDecode(data, &bytesLeft, m_outBuff);
+                         if(m_f_m4aTables) bytesLeft = 0; // exactly one access unit, including padding bits
+                         break;
+        case CODEC_FLAC: if(m_f_oggContainer) m_decodeError = decodeOggPacket(data, &bytesLeft);
+                         else m_decodeError = FLACDecode(data, &bytesLeft, m_outBuff);
+                         break;
+        case CODEC_OPUS: m_decodeError = decodeOggPacket(data, &bytesLeft); break;
+        case CODEC_VORBIS: m_decodeError = decodeOggPacket(data, &bytesLeft); break;
         default: {
             log_e("no valid codec found codec = %d", m_codec);
             stopSong();
@@ -4236,6 +4940,8 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
     //                 100: the decoder needs more data
     //                 < 0: there has been an error
 
+    m_f_seekIdxFrameStart = (m_decodeError == 0);
+
     if(m_decodeError < 0) { // Error, skip the frame...
                             //        i2s_zero_dma_buffer((i2s_port_t)m_i2s_num);
         if(!getChannels() && m_codec == CODEC_MP3 && (m_decodeError == -2)) {
@@ -4243,7 +4949,12 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
         }
         else {
             printDecodeError(m_decodeError);
-            m_f_playing = false; // seek for new syncword
+            m_f_seekIdxBuild = false; // a frame is lost, sample position is unknown now
+            if(!f_setDecodeParamsOnce && (m_codec == CODEC_MP3 || m_codec == CODEC_AAC || m_codec == CODEC_M4A)) {
+                int frameBytes = concealFrame(data, len);
+                if(frameBytes > 0) return frameBytes; // the next frame follows directly, skip the damaged one
+            }
+            m_f_playing = false;      // seek for new syncword
             if(m_codec == CODEC_FLAC) {
                 if(m_decodeError == ERR_FLAC_BITS_PER_SAMPLE_TOO_BIG) stopSong();
                 if(m_decodeError == ERR_FLAC_RESERVED_CHANNEL_ASSIGNMENT) stopSong();
@@ -4260,9 +4971,10 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
     }
     bytesDecoded = len - bytesLeft;
 
-    if(bytesDecoded == 0 && m_decodeError == 0) { // unlikely framesize
+    if(bytesDecoded == 0 && m_decodeError == 0 && !m_f_oggContainer) { // unlikely framesize, Ogg: packet decoded in place
         if(audio_info) audio_info("framesize is 0, start decoding again");
         m_f_playing = false; // seek for new syncword
+        m_f_seekIdxBuild = false;
         // we're here because there was a wrong sync word so skip one byte and seek for the next
         return 1;
     }
@@ -4272,11 +4984,14 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
                             if(getBitsPerSample() == 16) m_validSamples = len / (2 * getChannels());
                             if(getBitsPerSample() == 8) m_validSamples = len / 2;
                             break;
-        case CODEC_MP3:     m_validSamples = MP3GetOutputSamps() / getChannels();
+        case CODEC_MP3:     if(MP3GetChannels() != getChannels()) setChannels(MP3GetChannels()); // forceMono() switched the downmix
+                            m_validSamples = MP3GetOutputSamps() / getChannels();
                             break;
-        case CODEC_AAC:     m_validSamples = AACGetOutputSamps() / getChannels();
+        case CODEC_AAC:     if(AACGetChannels() != getChannels()) setChannels(AACGetChannels()); // parametric stereo turns mono into stereo
+                            m_validSamples = AACGetOutputSamps() / getChannels();
                             break;
-        case CODEC_M4A:     m_validSamples = AACGetOutputSamps() / getChannels();
+        case CODEC_M4A:     if(AACGetChannels() != getChannels()) setChannels(AACGetChannels()); // parametric stereo turns mono into stereo
+                            m_validSamples = AACGetOutputSamps() / getChannels();
                             break;
         case CODEC_FLAC:    if(m_decodeError == FLAC_PARSE_OGG_DONE) return bytesDecoded; // nothing to play
                             m_validSamples = FLACGetOutputSamps() / getChannels();
@@ -4304,6 +5019,21 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
         f_setDecodeParamsOnce = false;
         setDecoderItems();
         m_PlayingStartTime = millis();
+        if(!m_tFirstFrame) m_tFirstFrame = m_PlayingStartTime;
+    }
+
+    if(m_f_seekIdxBuild) seekIndex_add(f_frameStart);
+
+    if(m_samplesToSkip) { // exact seek, discard the decoded samples in front of the target
+        if(m_samplesToSkip >= (uint32_t)m_validSamples) {
+            m_samplesToSkip -= m_validSamples;
+            m_validSamples = 0;
+            return bytesDecoded;
+        }
+        int16_t ch = getChannels();
+        memmove(m_outBuff, m_outBuff + m_samplesToSkip * ch, (m_validSamples - m_samplesToSkip) * ch * sizeof(int16_t));
+        m_validSamples -= m_samplesToSkip;
+        m_samplesToSkip = 0;
     }
 
     compute_audioCurrentTime(bytesDecoded);
@@ -4318,6 +5048,97 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
     return bytesDecoded;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int Audio::decodeOggPacket(uint8_t* data, int* bytesLeft) {
+    // FLAC, OPUS, VORBIS in an Ogg container: the demuxer hands out one packet per call, the codec decodes it in place
+    // return: as the codec, 100 (PARSE_OGG_DONE) if there is nothing to play yet
+    uint8_t* packet = NULL;
+    int      packetLen = 0;
+    int      ret = OGGGetPacket(data, bytesLeft, &packet, &packetLen);
+
+    if(ret == OGG_NEW_STREAM) { // chained stream, the next logical bitstream can have another codec
+        uint8_t codec = determineOggCodec(data, *bytesLeft);
+        if(codec == CODEC_NONE) {
+            AUDIO_INFO("chained Ogg stream with unknown codec is skipped");
+            OGGSkipStream();
+            return OGG_PARSE_DONE;
+        }
+        AUDIO_INFO("chained Ogg stream, codec %s", codecname[codec]);
+        if(m_codec == CODEC_FLAC) FLACDecoder_FreeBuffers();
+        if(m_codec == CODEC_OPUS) OPUSDecoder_FreeBuffers();
+        if(m_codec == CODEC_VORBIS) VORBISDecoder_FreeBuffers();
+        m_codec = codec;
+        if(!initializeDecoder()) return OGG_PARSE_DONE; // song is stopped
+        m_f_playing = false; // findNextSync() finds the BOS page at pos 0, the decoder items are set again
+        return OGG_PARSE_DONE;
+    }
+    if(ret < 0) { // no OggS at pos 0 or CRC mismatch, resync
+        if(ret == ERR_OGG_CRC_MISMATCH) log_w("Ogg page CRC mismatch, resync");
+        if(m_codec == CODEC_FLAC) return ERR_FLAC_DECODER_ASYNC;
+        if(m_codec == CODEC_OPUS) return ERR_OPUS_DECODER_ASYNC;
+        return ERR_VORBIS_DECODER_ASYNC;
+    }
+    if(ret != ERR_OGG_NONE) return OGG_PARSE_DONE; // page header read, no packet yet
+
+    int left = packetLen;
+    switch(m_codec) {
+        case CODEC_FLAC:   ret = FLACDecodeOggPacket(packet, &left, m_outBuff);
+                           if(ret == FLAC_PARSE_OGG_STREAMINFO) { // size as read_FLAC_Header() does, InBuff stays, the demuxer
+                               ret = FLAC_PARSE_OGG_DONE;         // collects packets larger than its window
+                               m_flacMaxBlockSize = FLACGetMaxBlockSize();
+                               m_flacMaxFrameSize = FLACGetMaxFrameSize();
+                               AUDIO_INFO("FLAC maxBlockSize: %u", m_flacMaxBlockSize);
+                               if(m_flacMaxBlockSize > MAX_BLOCKSIZE) {
+                                   log_e("FLAC maxBlockSize too large!");
+                                   stopSong();
+                                   break;
+                               }
+                               if(m_flacMaxBlockSize) {
+                                   uint32_t maxFrameSize = m_flacMaxFrameSize;
+                                   if(!maxFrameSize) maxFrameSize = (uint32_t)m_flacMaxBlockSize * FLACGetChannels() * FLACGetBitsPerSample() / 8 + 64;
+                                   if(maxFrameSize < m_frameSizeFLAC) maxFrameSize = m_frameSizeFLAC;
+                                   if(!FLACDecoder_SetMaxBlockSize(m_flacMaxBlockSize, maxFrameSize) || !setOutBuffSize(m_flacMaxBlockSize * 2)) {
+                                       log_e("not enough memory for FLAC blocksize %u", m_flacMaxBlockSize);
+                                       stopSong();
+                                   }
+                               }
+                           }
+                           break;
+        case CODEC_OPUS:   ret = OPUSDecode(packet, &left, m_outBuff); break;
+        case CODEC_VORBIS: ret = VORBISDecode(packet, &left, m_outBuff); break;
+    }
+    OGGPacketUsed(packet, packetLen - left, bytesLeft); // OPUS code 3 leaves the frames that follow for the next call
+    return ret;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int Audio::concealFrame(uint8_t* data, size_t len) {
+    // Packet loss concealment, MP3 and AAC only. A frame that could not be decoded is replaced by one that fades out
+    // the last good frame (AAC: the overlap part of the last IMDCT, otherwise a short muting ramp), the decoder fades
+    // in the next good frame. This avoids the gap and the click of a skipped frame.
+    // Return: > 0 the length of the damaged frame, the next frame header lies exactly there
+    //           0 the next header was not found, seek for a new syncword
+    int samples = 0;
+    int frameBytes = -1;
+    switch(m_codec) {
+        case CODEC_MP3: samples = MP3ConcealFrame(m_outBuff); frameBytes = MP3ResyncNextFrame(data, len); break;
+        case CODEC_AAC: samples = AACConcealFrame(m_outBuff); frameBytes = AACResyncNextFrame(data, len); break;
+        case CODEC_M4A: samples = AACConcealFrame(m_outBuff); // raw blocks have no header to resync on
+                        if(m_f_m4aTables) frameBytes = len;   // but the access unit size is known
+                        break;
+        default: break;
+    }
+    if(frameBytes > 0) compute_audioCurrentTime(frameBytes);
+    if(samples > 0 && getChannels()) {
+        m_validSamples = samples / getChannels();
+        bool continueI2S = !audio_process_extern;
+        if(audio_process_extern) audio_process_extern(m_outBuff, m_validSamples, &continueI2S);
+        if(continueI2S) {
+            m_curSample = 0;
+            playChunk();
+        }
+    }
+    return (frameBytes > 0 ? frameBytes : 0);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::compute_audioCurrentTime(int bd) {
     static uint16_t loop_counter = 0;
     static int      old_bitrate = 0;
@@ -4344,7 +5165,7 @@ void Audio::compute_audioCurrentTime(int bd) {
     //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
     if((old_bitrate != getBitRate()) && f_CBR) {
-        if(audio_info) audio_info("VBR recognized, audioFileDuration is estimated");
+        if(audio_info && !m_mp3VbrBitrate) audio_info("VBR recognized, audioFileDuration is estimated");
         f_CBR = false; // variable bitrate
     }
     old_bitrate = getBitRate();
@@ -4354,12 +5175,15 @@ void Audio::compute_audioCurrentTime(int bd) {
         m_avr_bitrate = sum_bitrate / loop_counter;
         loop_counter++;
     }
+    if(m_mp3VbrBitrate) m_avr_bitrate = m_mp3VbrBitrate; // exact value from Xing/VBRI header
 
     m_audioCurrentTime += ((float)bd / m_avr_bitrate) * 8;
 
     if(cnt == 1) {
-        m_audioCurrentTime = ((float)(getFilePos() - m_audioDataStart - inBufferFilled()) / m_avr_bitrate) * 8; // #293
+        if(m_mp3SeekTable.size()) m_audioCurrentTime = mp3_vbrTimeFromPos(getFilePos() - inBufferFilled());
+        else m_audioCurrentTime = ((float)(getFilePos() - m_audioDataStart - inBufferFilled()) / m_avr_bitrate) * 8; // #293
     }
+    if(m_codec == CODEC_M4A && m_m4aTimescale) m_audioCurrentTime = m4a_sampleTime(m_m4aDec.sample + 1); // exact, from stts
     cnt++;
     if(cnt == 100) cnt = 0;
 }
@@ -4429,6 +5253,7 @@ void Audio::printDecodeError(int r) {
             case ERR_FLAC_WRONG_RICE_PARTITION_NR: e = "WRONG RICE PARTITION NR"; break;
             case ERR_FLAC_BITS_PER_SAMPLE_TOO_BIG: e = "BITS PER SAMPLE > 16"; break;
             case ERR_FLAG_BITS_PER_SAMPLE_UNKNOWN: e = "BITS PER SAMPLE UNKNOWN"; break;
+            case ERR_FLAC_CRC_MISMATCH: e = "CRC MISMATCH"; break;
             default: e = "ERR_UNKNOWN";
         }
         AUDIO_INFO("FLAC decode error %d : %s", r, e);
@@ -4465,7 +5290,6 @@ void Audio::printDecodeError(int r) {
             case ERR_VORBIS_INVALID_SAMPLERATE: e = "INVALID SAMPLERATE"; break;
             case ERR_VORBIS_EXTRA_CHANNELS_UNSUPPORTED: e = "EXTRA CHANNELS UNSUPPORTED"; break;
             case ERR_VORBIS_DECODER_ASYNC: e = "DECODER ASYNC"; break;
-            case ERR_VORBIS_OGG_SYNC_NOT_FOUND: e = "SYNC NOT FOUND"; break;
             case ERR_VORBIS_BAD_HEADER: e = "BAD HEADER"; break;
             case ERR_VORBIS_NOT_AUDIO: e = "NOT AUDIO"; break;
             case ERR_VORBIS_BAD_PACKET: e = "BAD PACKET"; break;
@@ -4535,7 +5359,9 @@ uint32_t Audio::getAudioFileDuration() {
         if(!m_contentlength) return 0;
     }
 
-    if(m_avr_bitrate && m_codec == CODEC_MP3) m_audioFileDuration = 8 * ((float)m_audioDataSize / m_avr_bitrate); // #289
+    if(m_m4aTimescale && m_codec == CODEC_M4A) m_audioFileDuration = m4a_sampleTime(m_m4aNumSamples); // stts
+    else if(m_mp3VbrDuration && m_codec == CODEC_MP3) m_audioFileDuration = m_mp3VbrDuration; // Xing/VBRI header
+    else if(m_avr_bitrate && m_codec == CODEC_MP3) m_audioFileDuration = 8 * ((float)m_audioDataSize / m_avr_bitrate); // #289
     else if(m_avr_bitrate && m_codec == CODEC_WAV) m_audioFileDuration = 8 * ((float)m_audioDataSize / m_avr_bitrate);
     else if(m_avr_bitrate && m_codec == CODEC_M4A) m_audioFileDuration = 8 * ((float)m_audioDataSize / m_avr_bitrate);
     else if(m_avr_bitrate && m_codec == CODEC_AAC) m_audioFileDuration = 8 * ((float)m_audioDataSize / m_avr_bitrate);
@@ -4554,7 +5380,11 @@ bool Audio::setAudioPlayPosition(uint16_t sec) {
     // Jump to an absolute position in time within an audio file
     // e.g. setAudioPlayPosition(300) sets the pointer at pos 5 min
     if(sec > getAudioFileDuration()) sec = getAudioFileDuration();
+    if(flac_seekTableLookup(sec)) return true; // sample accurate position from the FLAC SEEKTABLE
+    if(m4a_seekTableLookup(sec)) return true; // access unit from the M4A sample tables
+    if(seekIndex_lookup(sec)) return true; // exact frame position from the seek index
     uint32_t filepos = m_audioDataStart + (m_avr_bitrate * sec / 8);
+    if(m_codec == CODEC_MP3 && m_mp3SeekTable.size()) filepos = mp3_vbrPosFromTime(sec); // Xing TOC or VBRI table
     return setFilePos(filepos);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -4577,7 +5407,18 @@ bool Audio::setTimeOffset(int sec) {
     // fast forward or rewind the current position in seconds
     // audiosource must be a mp3, aac or wav file
 
-    if(!audiofile || !m_avr_bitrate) return false;
+    if((!audiofile && m_streamType != ST_WEBFILE) || !m_avr_bitrate) return false;
+
+    if(m_codec == CODEC_FLAC && m_flacSeekTable.size()) {
+        int32_t t = (int32_t)getAudioCurrentTime() + sec;
+        if(t < 0) t = 0;
+        if(flac_seekTableLookup(t)) return true;
+    }
+    if(m_codec == CODEC_M4A && m_f_m4aTables) {
+        int32_t t = (int32_t)getAudioCurrentTime() + sec;
+        if(t < 0) t = 0;
+        if(m4a_seekTableLookup(t)) return true;
+    }
 
     uint32_t oneSec = m_avr_bitrate / 8;                 // bytes decoded in one sec
     int32_t  offset = oneSec * sec;                      // bytes to be wind/rewind
@@ -4598,11 +5439,20 @@ bool Audio::setTimeOffset(int sec) {
 bool Audio::setFilePos(uint32_t pos) {
     if(m_codec == CODEC_OPUS) return false;   // not impl. yet
     if(m_codec == CODEC_VORBIS) return false; // not impl. yet
-    if(!audiofile) return false;
+    uint32_t fileSize = m_file_size;
+    if(!audiofile) { // web file, processWebFile() continues with a HTTP range request at pos
+        if(m_streamType != ST_WEBFILE || !m_f_acceptRanges || m_f_chunked) return false;
+        if(m_codec == CODEC_M4A || m_controlCounter != 100) return false; // raw AAC blocks have no syncword
+        fileSize = m_audioDataStart + m_audioDataSize;
+        if(!m_audioDataSize) fileSize = m_contentlength;
+        fileSize--; // the range must not start behind the last byte
+    }
     if(pos < m_audioDataStart) pos = m_audioDataStart; // issue #96
-    if(pos > m_file_size) pos = m_file_size;
+    if(pos > fileSize) pos = fileSize;
     m_resumeFilePos = pos;
-    memset(m_outBuff, 0, 2048 * 2 * sizeof(int16_t));
+    m_f_seekIdxHit = false;
+    m_samplesToSkip = 0;
+    memset(m_outBuff, 0, m_outBuffSize * sizeof(int16_t));
     m_validSamples = 0;
     return true;
 }
@@ -4758,6 +5608,11 @@ uint16_t Audio::getVUlevel() {
     return (m_vuLeft << 8) + m_vuRight;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint32_t Audio::getFLACCrcErrors() {
+    if(m_codec != CODEC_FLAC) return 0;
+    return FLACGetCRCErrors();
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool Audio::playSample(int16_t sample[2]) {
     if(getBitsPerSample() == 8) { // Upsample from unsigned 8 bits to signed 16 bits
         sample[LEFTCHANNEL] = ((sample[LEFTCHANNEL] & 0xff) - 128) << 8;
@@ -4801,6 +5656,10 @@ bool Audio::playSample(int16_t sample[2]) {
     if(m_i2s_bytesWritten < 4) { // no more space in dma buffer  --> break and try it later
         return false;
     }
+    if(!m_tFirstDMA) {
+        m_tFirstDMA = millis();
+        reportStartupTimes();
+    }
     return true;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -4834,6 +5693,7 @@ void Audio::setTone(int8_t gainLowPass, int8_t gainBandPass, int8_t gainHighPass
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::forceMono(bool m) { // #100 mono option
     m_f_forceMono = m;          // false stereo, true mono
+    MP3Decoder_SetDownmix(m);   // MP3: only one synthesis, takes effect with the next frame
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::setBalance(int8_t bal) { // bal -16...16
@@ -5341,6 +6201,282 @@ bool Audio::ts_parsePacket(uint8_t* packet, uint8_t* packetStart, uint8_t* packe
     return false;
 }
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+size_t Audio::fmp4_parse(uint8_t* data, size_t len) {
+    // fragmented MP4 (fMP4, CMAF) HLS segments. The init segment (#EXT-X-MAP: ftyp, moov) contains the decoder
+    // configuration, a media segment consists of moof (tfhd, trun: access unit sizes) and mdat. The access units are
+    // taken from mdat as they arrive and written to InBuff with an ADTS header, a segment is never buffered as a whole.
+    // Returns the number of bytes consumed, less than len if InBuff has no space for the next access unit.
+    // fmp4_parse(NULL, 0) resets the parser, is called at the beginning of each segment
+
+    enum : uint8_t { FMP4_HDR, FMP4_LARGESIZE, FMP4_SKIP, FMP4_COLLECT, FMP4_TRUN, FMP4_TRUNSAMPLE, FMP4_MDAT };
+    const uint32_t  samplingFrequencies[13] = {96000, 88200, 64000, 48000, 44100, 32000, 24000, 22050, 16000, 12000, 11025, 8000, 7350};
+    static uint8_t  state = FMP4_HDR;
+    static uint8_t  box[512];       // box header, trun fields or a small box (stsd, tfhd, trex) that is parsed as a whole
+    static uint16_t boxLen = 0;     // bytes in box[]
+    static uint16_t boxNeed = 0;    // bytes to collect in box[]
+    static uint32_t boxType = 0;    // fourcc of the current box
+    static uint64_t remain = 0;     // bytes of the current box not consumed yet
+    static uint64_t segPos = 0;     // bytes consumed in this segment
+    static uint64_t baseOffset = 0; // tfhd base data offset or position of the moof
+    static uint64_t dataPos = 0;    // position of the first access unit of the moof
+    static uint32_t tfhdSize = 0;   // tfhd default sample size
+    static uint32_t trexSize = 0;   // trex default sample size (init segment)
+    static uint32_t trunFlags = 0;
+    static uint32_t trunCount = 0;  // access units of the trun not read yet
+    static uint32_t auIdx = 0;      // next access unit in m_fmp4Samples
+    static uint32_t auLeft = 0;     // bytes of the current access unit not consumed yet
+    static bool     f_auSkip = false;
+    static bool     f_config = false; // ADTS parameters are known
+    static uint8_t  profile = 1;    // ADTS: audio object type - 1, AAC LC
+    static uint8_t  sfIdx = 4;      // ADTS: sampling frequency index, 44100 Hz
+    static uint8_t  chConfig = 2;   // ADTS: channel configuration, stereo
+
+    if(data == NULL) {
+        state = FMP4_HDR;
+        boxLen = 0;
+        remain = 0;
+        segPos = 0;
+        baseOffset = 0;
+        dataPos = 0;
+        tfhdSize = 0;
+        auIdx = 0;
+        auLeft = 0;
+        m_fmp4Samples.clear();
+        return 0;
+    }
+
+    auto put = [&](const uint8_t* p, size_t k) { // the caller has checked InBuff.freeSpace()
+        size_t ws = InBuff.writeSpace();
+        if(ws > k) ws = k;
+        memcpy(InBuff.getWritePtr(), p, ws);
+        InBuff.bytesWritten(ws);
+        if(k > ws) {
+            memcpy(InBuff.getWritePtr(), p + ws, k - ws);
+            InBuff.bytesWritten(k - ws);
+        }
+    };
+
+    auto fourcc = [](const char* t) -> uint32_t { return (uint32_t)t[0] << 24 | (uint32_t)t[1] << 16 | (uint32_t)t[2] << 8 | (uint32_t)t[3]; };
+
+    auto beginBox = [&](uint8_t hdrSize) { // box header is read, remain is the payload size
+        uint64_t boxPos = segPos - hdrSize;
+        state = FMP4_SKIP;
+        if(boxType == fourcc("moov") || boxType == fourcc("trak") || boxType == fourcc("mdia") || boxType == fourcc("minf") ||
+           boxType == fourcc("stbl") || boxType == fourcc("mvex") || boxType == fourcc("moof") || boxType == fourcc("traf")) {
+            state = FMP4_HDR; // container, continue with the first child
+            if(boxType == fourcc("moov")) trexSize = 0;
+            if(boxType == fourcc("moof")) {
+                m_fmp4Samples.clear();
+                auIdx = 0;
+                dataPos = 0;
+                baseOffset = boxPos;
+            }
+            if(boxType == fourcc("traf")) tfhdSize = 0;
+        }
+        else if(boxType == fourcc("stsd") || boxType == fourcc("tfhd") || boxType == fourcc("trex")) {
+            if(remain <= sizeof(box)) {
+                state = FMP4_COLLECT;
+                boxNeed = remain;
+            }
+            else log_w("fMP4: box too big (%llu bytes)", (long long unsigned int)remain);
+        }
+        else if(boxType == fourcc("trun") && remain >= 8) {
+            state = FMP4_TRUN;
+            boxNeed = 8; // version, flags, sample count
+        }
+        else if(boxType == fourcc("mdat")) {
+            state = FMP4_MDAT;
+            if(!f_config && m_fmp4Samples.size()) log_w("fMP4: no init segment, assume AAC LC 44100 Hz stereo");
+        }
+        boxLen = 0;
+    };
+
+    auto parseBox = [&]() { // collected box is complete
+        if(boxType == fourcc("stsd")) { // mp4a sample entry -> esds -> AudioSpecificConfig
+            int esds = specialIndexOf(box, "esds", boxLen);
+            if(esds < 0) return; // not an audio track
+            uint16_t p = esds + 8; // 'esds', version, flags
+            auto descLen = [&]() {
+                for(int i = 0; i < 4 && p < boxLen; i++) {
+                    if(!(box[p++] & 0x80)) break;
+                }
+            };
+            if(p >= boxLen || box[p++] != 0x03) return; // ES_Descriptor
+            descLen();
+            p += 2; // ES_ID
+            uint8_t esFlags = box[p++];
+            if(esFlags & 0x80) p += 2;                // dependsOn_ES_ID
+            if(esFlags & 0x40) p += 1 + box[p];       // URL
+            if(esFlags & 0x20) p += 2;                // OCR_ES_Id
+            if(p >= boxLen || box[p++] != 0x04) return; // DecoderConfigDescriptor
+            descLen();
+            p += 13; // objectTypeIndication, streamType, bufferSizeDB, maxBitrate, avgBitrate
+            if(p >= boxLen || box[p++] != 0x05) return; // DecoderSpecificInfo
+            descLen();
+            if(p + 2 > boxLen) return;
+            m4a_parseASC(box + p);
+            uint8_t aot = m_m4aObjectType;
+            if(aot == 5 || aot == 29) aot = 2; // SBR, PS: ADTS carries the AAC LC core, the decoder finds the extension
+            f_config = false;
+            if(aot < 1 || aot > 4) {
+                log_e("fMP4: audio object type %i can't be transported in ADTS", m_m4aObjectType);
+                return;
+            }
+            for(int i = 0; i < 13; i++) {
+                if(samplingFrequencies[i] == m_m4aSampleRate) {
+                    profile = aot - 1;
+                    sfIdx = i;
+                    chConfig = m_m4aNumChannels;
+                    f_config = true;
+                }
+            }
+            if(!f_config) log_e("fMP4: sample rate %lu is not supported", (long unsigned int)m_m4aSampleRate);
+        }
+        if(boxType == fourcc("tfhd")) {
+            uint32_t flags = bigEndian(box + 1, 3);
+            uint16_t p = 8; // version, flags, track_ID
+            if(flags & 0x01) { // base_data_offset
+                baseOffset = (uint64_t)bigEndian(box + p, 4) << 32 | bigEndian(box + p + 4, 4);
+                p += 8;
+            }
+            if(flags & 0x02) p += 4; // sample_description_index
+            if(flags & 0x08) p += 4; // default_sample_duration
+            if(flags & 0x10) tfhdSize = bigEndian(box + p, 4);
+        }
+        if(boxType == fourcc("trex") && boxLen >= 20) trexSize = bigEndian(box + 16, 4);
+    };
+
+    size_t n = 0;
+    while(n < len) {
+        size_t k = len - n;
+        if(k > remain && state != FMP4_HDR && state != FMP4_LARGESIZE) k = remain;
+        switch(state) {
+            case FMP4_HDR: // size and type
+                box[boxLen++] = data[n++];
+                segPos++;
+                if(boxLen < 8) break;
+                remain = bigEndian(box, 4);
+                boxType = bigEndian(box + 4, 4);
+                if(remain == 1) { // 64 bit largesize follows
+                    state = FMP4_LARGESIZE;
+                    break;
+                }
+                if(remain == 0) remain = UINT64_MAX; // box extends to the end of the segment
+                else if(remain < 8) {
+                    log_e("fMP4: invalid box size, skip the rest of the segment");
+                    boxLen = 0;
+                    remain = UINT64_MAX;
+                    state = FMP4_SKIP;
+                    break;
+                }
+                else remain -= 8;
+                beginBox(8);
+                break;
+            case FMP4_LARGESIZE:
+                box[boxLen++] = data[n++];
+                segPos++;
+                if(boxLen < 16) break;
+                remain = ((uint64_t)bigEndian(box + 8, 4) << 32 | bigEndian(box + 12, 4)) - 16;
+                beginBox(16);
+                break;
+            case FMP4_SKIP:
+                n += k;
+                segPos += k;
+                remain -= k;
+                if(!remain) state = FMP4_HDR;
+                break;
+            case FMP4_COLLECT:
+            case FMP4_TRUN:
+            case FMP4_TRUNSAMPLE:
+                if(k > (size_t)(boxNeed - boxLen)) k = boxNeed - boxLen;
+                memcpy(box + boxLen, data + n, k);
+                boxLen += k;
+                n += k;
+                segPos += k;
+                remain -= k;
+                if(boxLen < boxNeed) break;
+                if(state == FMP4_COLLECT) {
+                    parseBox();
+                    boxLen = 0;
+                    state = FMP4_HDR;
+                    break;
+                }
+                if(state == FMP4_TRUN) {
+                    trunFlags = bigEndian(box + 1, 3);
+                    uint16_t need = 8 + ((trunFlags & 0x01) ? 4 : 0) + ((trunFlags & 0x04) ? 4 : 0);
+                    if(boxLen < need) { // data_offset and first_sample_flags
+                        boxNeed = need;
+                        break;
+                    }
+                    trunCount = bigEndian(box + 4, 4);
+                    if((trunFlags & 0x01) && m_fmp4Samples.empty()) dataPos = baseOffset + (int32_t)bigEndian(box + 8, 4);
+                    uint8_t recSize = 0; // per sample: duration, size, flags, composition time offset
+                    for(int i = 0; i < 4; i++) {
+                        if(trunFlags & (0x100 << i)) recSize += 4;
+                    }
+                    if(m_fmp4Samples.size() + trunCount > 8192 || (uint64_t)trunCount * recSize > remain) {
+                        log_e("fMP4: invalid trun, %lu samples", (long unsigned int)trunCount);
+                        trunCount = 0;
+                    }
+                    if(!(trunFlags & 0x200)) { // all access units have the default size
+                        uint32_t size = tfhdSize ? tfhdSize : trexSize;
+                        m_fmp4Samples.insert(m_fmp4Samples.end(), trunCount, size);
+                        trunCount = 0;
+                    }
+                    boxLen = 0;
+                    boxNeed = recSize;
+                    state = trunCount ? FMP4_TRUNSAMPLE : (remain ? FMP4_SKIP : FMP4_HDR);
+                    break;
+                }
+                m_fmp4Samples.push_back(bigEndian(box + ((trunFlags & 0x100) ? 4 : 0), 4)); // FMP4_TRUNSAMPLE
+                boxLen = 0;
+                if(!--trunCount) state = remain ? FMP4_SKIP : FMP4_HDR;
+                break;
+            case FMP4_MDAT:
+                if(!remain) {
+                    state = FMP4_HDR;
+                    break;
+                }
+                if(!auLeft) {
+                    if(segPos < dataPos || auIdx >= m_fmp4Samples.size()) { // no access unit at this position
+                        if(segPos < dataPos && k > dataPos - segPos) k = dataPos - segPos;
+                        n += k;
+                        segPos += k;
+                        remain -= k;
+                        break;
+                    }
+                    uint32_t size = m_fmp4Samples[auIdx];
+                    bool     f_skip = (!size || size + 7 > 0x1FFF); // ADTS frame length has 13 bits
+                    if(!f_skip && InBuff.freeSpace() < size + 7) return n; // the decoder has to make room first
+                    auIdx++;
+                    auLeft = size;
+                    f_auSkip = f_skip;
+                    if(!f_auSkip) {
+                        uint16_t frameLen = size + 7;
+                        uint8_t  adts[7];
+                        adts[0] = 0xFF; // syncword, MPEG-4, layer 0, no CRC
+                        adts[1] = 0xF1;
+                        adts[2] = (profile << 6) | (sfIdx << 2) | (chConfig >> 2);
+                        adts[3] = ((chConfig & 3) << 6) | (frameLen >> 11);
+                        adts[4] = (frameLen >> 3) & 0xFF;
+                        adts[5] = ((frameLen & 7) << 5) | 0x1F; // buffer fullness 0x7FF: VBR
+                        adts[6] = 0xFC;
+                        put(adts, 7);
+                    }
+                    if(!size) break;
+                }
+                if(k > auLeft) k = auLeft;
+                if(!f_auSkip) put(data + n, k);
+                n += k;
+                segPos += k;
+                remain -= k;
+                auLeft -= k;
+                break;
+        }
+    }
+    return n;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 //    W E B S T R E A M  -  H E L P   F U N C T I O N S
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint16_t Audio::readMetadata(uint16_t maxBytes, bool first) {
@@ -5688,19 +6824,21 @@ void Audio::seek_m4a_stsz() {
     // stsz says what size each sample is in bytes. This is important for the decoder to be able to start at a chunk,
     // and then go through each sample by its size. The stsz atom can be behind the audio block. Therefore, searching
     // for the stsz atom is only applicable to local files.
+    // Together with stts, stsc and stco/co64 of the audio track the file position of every access unit is known, the
+    // decoder then gets exactly one access unit per call, see m4a_readSampleTables()
 
     /* atom hierarchy (example)_________________________________________________________________________________________
 
       ftyp -> moov -> trak -> tkhd
-              free    udta    mdia -> mdhd
-              mdat                    hdlr
+              free    udta    mdia -> mdhd -> timescale of stts
+              mdat                    hdlr -> handler type, 'soun' is the audio track
               mvhd                    minf -> smhd
                                               dinf
                                               stbl -> stsd
-                                                      stts
-                                                      stsc
+                                                      stts -> duration of each sample
+                                                      stsc -> samples per chunk
                                                       stsz -> determine and return the position and number of entries
-                                                      stco
+                                                      stco -> file position of each chunk (co64: 64 bit)
       __________________________________________________________________________________________________________________*/
 
     struct m4a_Atom {
@@ -5721,10 +6859,35 @@ void Audio::seek_m4a_stsz() {
         atom.pos = startPos;
         return atom;
     };
+    auto isSoundTrak = [&](m4a_Atom trak) { // trak -> mdia -> hdlr, handler type 'soun'
+        int pos = trak.pos + 8;
+        while(pos < trak.pos + trak.size) {
+            m4a_Atom mdia = atomItems(pos);
+            pos += mdia.size;
+            if(strcmp(mdia.name, "mdia") != 0) continue;
+            int p = mdia.pos + 8;
+            while(p < mdia.pos + mdia.size) {
+                m4a_Atom hdlr = atomItems(p);
+                p += hdlr.size;
+                if(strcmp(hdlr.name, "hdlr") != 0) continue;
+                char type[5] = {0};
+                audiofile.seek(hdlr.pos + 16); // size, name, version + flags, pre_defined
+                audiofile.readBytes(type, 4);
+                return strcmp(type, "soun") == 0;
+            }
+        }
+        return false;
+    };
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
     uint32_t stsdPos = 0;
     uint16_t stsdSize = 0;
+    uint32_t mdhdPos = 0;
+    uint32_t sttsPos = 0;
+    uint32_t stscPos = 0;
+    uint32_t stcoPos = 0;
+    bool     co64 = false;
+    bool     f_soundTrak = false;
     boolean  found = false;
     uint32_t seekpos = 0;
     uint32_t filesize = getFileSize();
@@ -5739,18 +6902,34 @@ void Audio::seek_m4a_stsz() {
 
     for(int i = 0; i < 6; i++) {
         found = false;
-        while(seekpos < at.pos + at.size) {
+        uint32_t parentEnd = at.pos + at.size; // at changes when the atom is found
+        while(seekpos < parentEnd) {
             tmp = atomItems(seekpos);
             seekpos += tmp.size;
             if(strcmp(tmp.name, name[i]) == 0) {
-                memcpy((void*)&at, (void*)&tmp, sizeof(tmp));
-                found = true;
+                bool f_take = !found;
+                if(i == 1 && !f_soundTrak && isSoundTrak(tmp)) f_take = f_soundTrak = true; // prefer the audio track
+                if(f_take) {
+                    memcpy((void*)&at, (void*)&tmp, sizeof(tmp));
+                    found = true;
+                }
             }
             if(m_f_Log) log_i("name %s pos %d, size %d", tmp.name, tmp.pos, tmp.size);
             if(strcmp(tmp.name, "stsd") == 0) { // in stsd we can found mp4a atom that contains the audioitems
                 stsdPos = tmp.pos;
                 stsdSize = tmp.size;
             }
+            if(i == 3 && strcmp(tmp.name, "mdhd") == 0) mdhdPos = tmp.pos;
+            if(i == 5) {
+                if(strcmp(tmp.name, "stts") == 0) sttsPos = tmp.pos;
+                if(strcmp(tmp.name, "stsc") == 0) stscPos = tmp.pos;
+                if(strcmp(tmp.name, "stco") == 0) stcoPos = tmp.pos;
+                if(strcmp(tmp.name, "co64") == 0) {
+                    stcoPos = tmp.pos;
+                    co64 = true;
+                }
+            }
+            if(found && i < 5 && (i != 1 || f_soundTrak)) break; // stbl: all children are needed
         }
         if(!found) goto noSuccess;
         seekpos = at.pos + 8; // 4 bytes size + 4 bytes name
@@ -5778,6 +6957,18 @@ void Audio::seek_m4a_stsz() {
             AUDIO_INFO("ch; %i, bps: %i, sr: %i", channel, bps, srate);
         }
     }
+    if(m4a_readSampleTables(sttsPos, stscPos, at.pos, stcoPos, co64)) {
+        if(mdhdPos && m_m4aStts.size()) {
+            uint8_t v[4] = {0};
+            audiofile.seek(mdhdPos + 8);
+            audiofile.readBytes((char*)v, 1);                   // version, 1: 64 bit creation and modification time
+            audiofile.seek(mdhdPos + 12 + (v[0] == 1 ? 16 : 8)); // size, name, version + flags, times
+            audiofile.readBytes((char*)v, 4);
+            m_m4aTimescale = bigEndian(v, 4);
+        }
+        m_f_m4aTables = true;
+        AUDIO_INFO("m4a sample tables: %lu access units, %u chunk jumps", (long unsigned int)m_m4aNumSamples, (unsigned int)m_m4aJumps.size());
+    }
     audiofile.seek(0);
     return;
 
@@ -5789,54 +6980,349 @@ noSuccess:
     return;
 }
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::m4a_readSampleTables(uint32_t stts, uint32_t stsc, uint32_t stsz, uint32_t stco, bool co64) {
+    // Reads the sample tables of the audio track, the arguments are the file positions of the atoms (0: not found).
+    // The sizes are held as zigzag coded differences to the previous size: 1 byte up to +-63, 2 bytes up to about
+    // +-16k (0x80 | high byte, low byte), else 0xFF followed by 4 bytes. Of the chunk offsets only those are held
+    // where a chunk does not start directly behind the previous one, an audio only file needs one entry.
+    // Return: false if a table is missing, inconsistent or there is not enough memory, mdat is then fed as before
+
+    uint8_t  buf[256];
+    uint16_t bufPos = 0, bufLen = 0;
+    uint32_t n = 0, i = 0;
+
+    auto rdSeek = [&](uint32_t pos) {
+        audiofile.seek(pos);
+        bufPos = 0;
+        bufLen = 0;
+    };
+    auto rd32 = [&]() -> uint32_t { // big endian, all table entries are 32 bit values
+        if(bufPos + 4 > bufLen) {
+            int len = audiofile.read(buf, sizeof(buf));
+            bufLen = (len > 0) ? len : 0;
+            bufPos = 0;
+            if(bufLen < 4) return 0;
+        }
+        uint32_t v = bigEndian(buf + bufPos, 4);
+        bufPos += 4;
+        return v;
+    };
+    auto zigzag = [](uint32_t diff) -> uint32_t { return (diff << 1) ^ (uint32_t)((int32_t)diff >> 31); };
+    auto codeLen = [](uint32_t z) -> uint8_t { return (z < 0x80) ? 1 : (z < 0x7F00 ? 2 : 5); };
+    auto fail = [&](const char* atomName) {
+        log_e("m4a atom %s is invalid, no sample tables", atomName);
+        m4a_freeSampleTables();
+        return false;
+    };
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    m4a_freeSampleTables();
+    if(!stsc || !stsz || !stco) return false;
+
+    if(stts) { // time to sample, optional, without it the time is computed from the bitrate
+        rdSeek(stts + 12); // size, name, version + flags
+        n = rd32();
+        if(n > m_file_size / 8) return fail("stts");
+        for(i = 0; i < n; i++) {
+            m4aSttsEntry_t e;
+            e.sampleCount = rd32();
+            e.sampleDelta = rd32();
+            m_m4aStts.push_back(e);
+        }
+    }
+
+    rdSeek(stsc + 12); // sample to chunk
+    n = rd32();
+    if(!n || n > m_file_size / 12) return fail("stsc");
+    for(i = 0; i < n; i++) {
+        m4aStscEntry_t e;
+        e.firstChunk = rd32();
+        e.samplesPerChunk = rd32();
+        rd32(); // sample description index
+        if(!e.samplesPerChunk) return fail("stsc");
+        if(i == 0 && e.firstChunk != 1) return fail("stsc");
+        if(i > 0 && e.firstChunk <= m_m4aStsc.back().firstChunk) return fail("stsc");
+        m_m4aStsc.push_back(e);
+    }
+
+    rdSeek(stsz + 12); // sample sizes
+    m_m4aFixedSize = rd32();
+    m_m4aNumSamples = rd32();
+    if(!m_m4aNumSamples) return fail("stsz");
+    if(!m_m4aFixedSize) {
+        if(m_m4aNumSamples > m_file_size / 4) return fail("stsz");
+        uint32_t len = 0, prev = 0, size = 0;
+        for(i = 0; i < m_m4aNumSamples; i++) { // first pass, length of the coded sizes
+            size = rd32();
+            len += codeLen(zigzag(size - prev));
+            prev = size;
+        }
+        m_m4aSizes = (uint8_t*)__malloc_heap_psram(len);
+        if(!m_m4aSizes) {
+            log_e("not enough memory for the m4a sample tables (%lu bytes)", (long unsigned int)len);
+            m4a_freeSampleTables();
+            return false;
+        }
+        rdSeek(stsz + 20);
+        len = 0;
+        prev = 0;
+        for(i = 0; i < m_m4aNumSamples; i++) {
+            size = rd32();
+            uint32_t z = zigzag(size - prev);
+            prev = size;
+            if(z < 0x80) { m_m4aSizes[len++] = z; }
+            else if(z < 0x7F00) {
+                m_m4aSizes[len++] = 0x80 | (z >> 8);
+                m_m4aSizes[len++] = z & 0xFF;
+            }
+            else {
+                m_m4aSizes[len++] = 0xFF;
+                for(int8_t j = 3; j >= 0; j--) m_m4aSizes[len++] = (z >> (8 * j)) & 0xFF;
+            }
+        }
+    }
+
+    rdSeek(stco + 12); // chunk offsets, keep the jumps only
+    n = rd32();
+    if(!n || n > m_file_size / (co64 ? 8 : 4)) return fail(co64 ? "co64" : "stco");
+    m4aCursor_t c = {};
+    uint32_t    sample = 0, end = 0, stscIdx = 0;
+    for(uint32_t chunk = 1; chunk <= n && sample < m_m4aNumSamples; chunk++) {
+        if(co64 && rd32()) return fail("co64"); // beyond 4GB
+        uint32_t offset = rd32();
+        if(chunk == 1 || offset != end) {
+            m4aChunkJump_t j;
+            j.chunk = chunk;
+            j.offset = offset;
+            m_m4aJumps.push_back(j);
+        }
+        if(stscIdx + 1 < m_m4aStsc.size() && m_m4aStsc[stscIdx + 1].firstChunk <= chunk) stscIdx++;
+        end = offset;
+        for(i = 0; i < m_m4aStsc[stscIdx].samplesPerChunk && sample < m_m4aNumSamples; i++, sample++) end += m4a_sampleSize(c);
+        if(end < offset || end > m_file_size) return fail(co64 ? "co64" : "stco");
+    }
+    if(sample < m_m4aNumSamples) return fail(co64 ? "co64" : "stco"); // the chunks do not hold all access units
+
+    m_m4aCheckpoints.reserve(m_m4aNumSamples / m_m4aCheckStep + 1); // seek index, one pass through the tables
+    m4a_firstSample(c);
+    while(true) {
+        if(c.sample % m_m4aCheckStep == 0) m_m4aCheckpoints.push_back(c);
+        if(c.sample + 1 >= m_m4aNumSamples) break;
+        m4a_nextSample(c);
+    }
+    return true;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::m4a_freeSampleTables() {
+    if(m_m4aSizes) {
+        free(m_m4aSizes);
+        m_m4aSizes = NULL;
+    }
+    m_m4aStsc.clear();
+    m_m4aStsc.shrink_to_fit();
+    m_m4aJumps.clear();
+    m_m4aJumps.shrink_to_fit();
+    m_m4aStts.clear();
+    m_m4aStts.shrink_to_fit();
+    m_m4aCheckpoints.clear();
+    m_m4aCheckpoints.shrink_to_fit();
+    m_m4aFixedSize = 0;
+    m_m4aNumSamples = 0;
+    m_m4aTimescale = 0;
+    m_f_m4aTables = false;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint32_t Audio::m4a_sampleSize(m4aCursor_t& c) {
+    // size of the next access unit, the coded difference is added to the previous size in c.size
+    if(m_m4aFixedSize) return c.size = m_m4aFixedSize;
+    uint32_t z = m_m4aSizes[c.sizeIdx++];
+    if(z >= 0x80) {
+        if(z < 0xFF) { z = ((z & 0x7F) << 8) | m_m4aSizes[c.sizeIdx++]; }
+        else {
+            z = bigEndian(m_m4aSizes + c.sizeIdx, 4);
+            c.sizeIdx += 4;
+        }
+    }
+    c.size += (z >> 1) ^ (0 - (z & 1));
+    return c.size;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::m4a_firstSample(m4aCursor_t& c) {
+    memset(&c, 0, sizeof(c));
+    c.chunk = 1;
+    c.chunkLeft = m_m4aStsc[0].samplesPerChunk - 1;
+    c.pos = m_m4aJumps[0].offset;
+    c.jumpIdx = 1;
+    m4a_sampleSize(c);
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::m4a_nextSample(m4aCursor_t& c) {
+    if(c.sample >= m_m4aNumSamples) return; // end of the track
+    c.pos += c.size;
+    c.sample++;
+    if(c.sample == m_m4aNumSamples) {
+        c.size = 0;
+        return;
+    }
+    if(c.chunkLeft) { c.chunkLeft--; }
+    else { // next chunk, it follows directly or is in the jump table
+        c.chunk++;
+        if(c.stscIdx + 1 < m_m4aStsc.size() && m_m4aStsc[c.stscIdx + 1].firstChunk <= c.chunk) c.stscIdx++;
+        c.chunkLeft = m_m4aStsc[c.stscIdx].samplesPerChunk - 1;
+        if(c.jumpIdx < m_m4aJumps.size() && m_m4aJumps[c.jumpIdx].chunk == c.chunk) c.pos = m_m4aJumps[c.jumpIdx++].offset;
+    }
+    m4a_sampleSize(c);
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+size_t Audio::m4a_readSamples(uint8_t* buff, size_t len) {
+    // Copies the access units from m_m4aRd on into buff, access units that follow one another in the file are read
+    // together, everything between the chunks (other tracks, free atoms) is skipped. Empty access units and those
+    // bigger than an AAC frame can be are left out, the decoder skips them as well.
+    size_t bytes = 0;
+    while(bytes < len && m_m4aRd.sample < m_m4aNumSamples) {
+        if(!m_m4aRd.size || m_m4aRd.size > m_frameSizeAAC) {
+            m4a_nextSample(m_m4aRd);
+            continue;
+        }
+        uint32_t    pos = m_m4aRd.pos + m_m4aRdOffs;
+        uint32_t    end = m_m4aRd.pos + m_m4aRd.size;
+        m4aCursor_t c = m_m4aRd;
+        while(end - pos < len - bytes) {
+            m4a_nextSample(c);
+            if(c.sample >= m_m4aNumSamples || c.pos != end || !c.size || c.size > m_frameSizeAAC) break;
+            end += c.size;
+        }
+        uint32_t n = min((uint32_t)(len - bytes), end - pos);
+        if(audiofile.position() != pos) audiofile.seek(pos);
+        int32_t res = audiofile.read(buff + bytes, n);
+        if(res > 0) {
+            bytes += res;
+            m_m4aRdOffs += res;
+            while(m_m4aRd.sample < m_m4aNumSamples && m_m4aRdOffs >= m_m4aRd.size) {
+                m_m4aRdOffs -= m_m4aRd.size;
+                m4a_nextSample(m_m4aRd);
+            }
+        }
+        if(res < (int32_t)n) { // the file is shorter than the sample tables say
+            log_e("m4a access unit %lu can't be read", (long unsigned int)m_m4aRd.sample);
+            m_m4aRd.sample = m_m4aNumSamples;
+            break;
+        }
+    }
+    return bytes;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float Audio::m4a_sampleTime(uint32_t sample) {
+    // start time of an access unit in seconds, from stts
+    if(!m_m4aTimescale) return 0;
+    uint64_t t = 0;
+    for(size_t i = 0; i < m_m4aStts.size() && sample; i++) {
+        uint32_t cnt = min(sample, m_m4aStts[i].sampleCount);
+        t += (uint64_t)cnt * m_m4aStts[i].sampleDelta;
+        sample -= cnt;
+    }
+    return (float)t / m_m4aTimescale;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint32_t Audio::m4a_correctResumeFilePos(uint32_t resumeFilePos) {
     // In order to jump within an m4a file, the exact beginning of an aac block must be found. Since m4a cannot be
     // streamed, i.e. there is no syncword, an imprecise jump can lead to a crash.
 
-    if(!m_stsz_position) return m_audioDataStart; // guard
+    if(m_f_m4aTables) { // the first access unit at or behind resumeFilePos, reading and decoding start there
+        uint32_t lo = 0, hi = m_m4aCheckpoints.size() - 1; // binary search, the last checkpoint in front of it
+        while(lo < hi) {
+            uint32_t mid = (lo + hi + 1) / 2;
+            if(m_m4aCheckpoints[mid].pos < resumeFilePos) lo = mid;
+            else hi = mid - 1;
+        }
+        m4aCursor_t c = m_m4aCheckpoints[lo];
+        while(c.pos < resumeFilePos && c.sample + 1 < m_m4aNumSamples) m4a_nextSample(c); // less than m_m4aCheckStep
+        m_m4aRd = c;
+        m_m4aDec = c;
+        m_m4aRdOffs = 0;
+        return c.pos;
+    }
 
-    typedef union {
-        uint8_t  u8[4];
-        uint32_t u32;
-    } tu;
-    tu uu;
+    if(!m_stsz_position) return m_audioDataStart; // guard
 
+    uint8_t  buf[256];
     uint32_t i = 0, pos = m_audioDataStart;
     audiofile.seek(m_stsz_position);
 
     while(i < m_stsz_numEntries) {
-        i++;
-        uu.u8[3] = audiofile.read();
-        uu.u8[2] = audiofile.read();
-        uu.u8[1] = audiofile.read();
-        uu.u8[0] = audiofile.read();
-        pos += uu.u32;
-        if(pos >= resumeFilePos) break;
+        int n = audiofile.read(buf, sizeof(buf)) / 4;
+        if(n <= 0) break;
+        for(int j = 0; j < n && i < m_stsz_numEntries; j++, i++) {
+            pos += bigEndian(buf + 4 * j, 4);
+            if(pos >= resumeFilePos) return pos;
+        }
     }
     return pos;
 }
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::m4a_seekTableLookup(uint32_t sec) {
+    // M4A sample tables: stts gives the access unit that contains sec, the checkpoints its file position within
+    // m_m4aCheckStep steps. The decoded samples in front of sec are discarded in sendBytes().
+    if(m_codec != CODEC_M4A || !m_f_m4aTables || !m_m4aTimescale) return false;
+    uint64_t target = (uint64_t)sec * m_m4aTimescale; // in units of the timescale
+    uint64_t t = 0;                                   // start of the access unit
+    uint32_t sample = 0;
+    uint64_t duration = 0;
+    for(size_t i = 0; i < m_m4aStts.size(); i++) duration += (uint64_t)m_m4aStts[i].sampleCount * m_m4aStts[i].sampleDelta;
+    if(!duration) return false;
+    bool f_lastUnit = (target >= duration); // sec == duration (or rounded up): from the start of the last access unit
+    if(f_lastUnit) target = duration - 1;
+    for(size_t i = 0; i < m_m4aStts.size(); i++) {
+        uint64_t runLen = (uint64_t)m_m4aStts[i].sampleCount * m_m4aStts[i].sampleDelta;
+        if(target < t + runLen) {
+            uint32_t n = (target - t) / m_m4aStts[i].sampleDelta;
+            sample += n;
+            t += (uint64_t)n * m_m4aStts[i].sampleDelta;
+            break;
+        }
+        t += runLen;
+        sample += m_m4aStts[i].sampleCount;
+    }
+    if(sample >= m_m4aNumSamples) { // stts describes more access units than stsz, the last one in stsz
+        sample = m_m4aNumSamples - 1;
+        uint32_t n = sample;
+        t = 0;
+        for(size_t i = 0; i < m_m4aStts.size() && n; i++) {
+            uint32_t cnt = min(n, m_m4aStts[i].sampleCount);
+            t += (uint64_t)cnt * m_m4aStts[i].sampleDelta;
+            n -= cnt;
+        }
+        f_lastUnit = true;
+    }
+    if(f_lastUnit) target = t;
+
+    m4aCursor_t c = m_m4aCheckpoints[sample / m_m4aCheckStep];
+    while(c.sample < sample) m4a_nextSample(c);
+    if(!setFilePos(c.pos)) return false; // processLocalFile() sets the cursors to this access unit
+    uint32_t sr = getSampleRate();
+    if(sr) {
+        m_seekIdxSample = t * sr / m_m4aTimescale;
+        m_samplesToSkip = (target - t) * sr / m_m4aTimescale;
+        m_f_seekIdxHit = true;
+    }
+    return true;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint32_t Audio::flac_correctResumeFilePos(uint32_t resumeFilePos) {
-    // The starting point is the next FLAC syncword
-    uint8_t  p1, p2;
-    boolean  found = false;
+    // The starting point is the next FLAC syncword with a valid frame header (CRC-8), a syncword alone can also
+    // be found inside the audio data
+    uint8_t  buf[256 + 16];
     uint32_t pos = resumeFilePos;
-    audiofile.seek(pos);
 
-    p1 = audiofile.read();
-    p2 = audiofile.read();
-    pos += 2;
-    while(!found || pos == m_file_size) {
-        if(p1 == 0xFF && p2 == 0xF8) {
-            found = true;
-            break;
+    while(pos + 16 < m_file_size) {
+        audiofile.seek(pos);
+        int n = audiofile.read(buf, sizeof(buf));
+        if(n < 16) break;
+        for(int i = 0; i < n - 16; i++) {
+            if(buf[i] == 0xFF && (buf[i + 1] & 0xFE) == 0xF8 && FLACCheckFrameHeader(buf + i, n - i)) return pos + i;
         }
-        p1 = p2;
-        p2 = audiofile.read();
-        pos++;
+        pos += n - 16; // the last 16 bytes are checked again with the next block
     }
-
-    if(found) return (pos - 2);
     return m_audioDataStart;
 }
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -5885,3 +7371,118 @@ uint8_t Audio::determineOggCodec(uint8_t* data, uint16_t len) {
     return CODEC_NONE;
 }
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::seekIndex_add(bool frameStart) {
+    // called by sendBytes() for every decoded block, records the frame position every m_seekIdxInterval seconds
+    if(frameStart && getSampleRate()) {
+        if(!m_seekIdxSampleRate) m_seekIdxSampleRate = getSampleRate();
+        if(m_seekIdxSample >= (uint64_t)m_seekIdx.size() * m_seekIdxInterval * m_seekIdxSampleRate) {
+            seekIdxEntry_t e;
+            e.sample = m_seekIdxSample;
+            e.pos = getFilePos() - InBuff.bufferFilled(); // data begins at the read pointer of InBuff
+            m_seekIdx.push_back(e);
+        }
+    }
+    m_seekIdxSample += m_validSamples;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::seekIndex_lookup(uint32_t sec) {
+    // sets the file position to the last recorded frame at or before sec, returns false if sec is not covered yet
+    if(getDatamode() != AUDIO_LOCALFILE || !m_seekIdxInterval) return false;
+    if(m_seekIdx.empty() || !m_seekIdxSampleRate) return false;
+    uint64_t target = (uint64_t)sec * m_seekIdxSampleRate;
+    if(!m_f_seekIdxComplete && target >= m_seekIdx.back().sample + (uint64_t)m_seekIdxInterval * m_seekIdxSampleRate) return false;
+
+    uint32_t lo = 0, hi = m_seekIdx.size() - 1; // binary search
+    while(lo < hi) {
+        uint32_t mid = (lo + hi + 1) / 2;
+        if(m_seekIdx[mid].sample <= target) lo = mid;
+        else hi = mid - 1;
+    }
+    if(!setFilePos(m_seekIdx[lo].pos)) return false;
+    m_seekIdxSample = m_seekIdx[lo].sample;
+    m_samplesToSkip = target - m_seekIdx[lo].sample;
+    m_f_seekIdxHit = true;
+    return true;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::flac_seekTableLookup(uint32_t sec) {
+    // FLAC SEEKTABLE: set the file position to the nearest seekpoint before sec, the samples between the seekpoint
+    // and the target are decoded and discarded in sendBytes(), this gives a sample accurate position
+    if(m_codec != CODEC_FLAC || getDatamode() != AUDIO_LOCALFILE) return false;
+    if(m_flacSeekTable.empty() || !m_flacSampleRate) return false;
+    uint64_t target = (uint64_t)sec * m_flacSampleRate;
+    if(m_flacTotalSamplesInStream && target >= m_flacTotalSamplesInStream) return false;
+    if(target < m_flacSeekTable[0].sample) return false;
+
+    uint32_t lo = 0, hi = m_flacSeekTable.size() - 1; // binary search
+    while(lo < hi) {
+        uint32_t mid = (lo + hi + 1) / 2;
+        if(m_flacSeekTable[mid].sample <= target) lo = mid;
+        else hi = mid - 1;
+    }
+    if(!setFilePos(m_audioDataStart + m_flacSeekTable[lo].pos)) return false;
+    m_seekIdxSample = m_flacSeekTable[lo].sample;
+    m_samplesToSkip = target - m_flacSeekTable[lo].sample;
+    m_f_seekIdxHit = true;
+    return true;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::seekIndex_finish() {
+    // end of file, if the entries were recorded without interruption the seek index is complete now
+    if(!m_f_seekIdxBuild) return;
+    m_f_seekIdxBuild = false;
+    if(m_seekIdx.empty()) return;
+    m_f_seekIdxComplete = true;
+    AUDIO_INFO("seek index complete, %lu entries", (long unsigned int)m_seekIdx.size());
+    if(m_f_seekIdxSidecar) seekIndex_save();
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::seekIndex_load() {
+    if(!m_seekIdxFS || !m_seekIdxPath) return false;
+    if(!m_seekIdxFS->exists(m_seekIdxPath)) return false;
+    File idxFile = m_seekIdxFS->open(m_seekIdxPath);
+    if(!idxFile) return false;
+
+    seekIdxHeader_t h;
+    bool ok = idxFile.read((uint8_t*)&h, sizeof(h)) == sizeof(h);
+    ok = ok && memcmp(h.magic, "SIDX", 4) == 0 && h.fileSize == m_file_size && h.sampleRate && h.numEntries;
+    ok = ok && idxFile.size() == sizeof(h) + h.numEntries * sizeof(seekIdxEntry_t);
+    if(ok) {
+        m_seekIdx.resize(h.numEntries);
+        ok = idxFile.read((uint8_t*)m_seekIdx.data(), h.numEntries * sizeof(seekIdxEntry_t)) == h.numEntries * sizeof(seekIdxEntry_t);
+    }
+    idxFile.close();
+    if(!ok) {
+        log_w("seek index %s is invalid", m_seekIdxPath);
+        m_seekIdx.clear();
+        return false;
+    }
+    m_seekIdxSampleRate = h.sampleRate;
+    m_f_seekIdxComplete = true;
+    AUDIO_INFO("seek index loaded, %lu entries", (long unsigned int)m_seekIdx.size());
+    return true;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::seekIndex_save() {
+    if(!m_seekIdxFS || !m_seekIdxPath || m_seekIdx.empty()) return false;
+    File idxFile = m_seekIdxFS->open(m_seekIdxPath, FILE_WRITE);
+    if(!idxFile) {
+        log_e("can't create %s", m_seekIdxPath);
+        return false;
+    }
+    seekIdxHeader_t h;
+    memcpy(h.magic, "SIDX", 4);
+    h.fileSize = m_file_size;
+    h.sampleRate = m_seekIdxSampleRate;
+    h.numEntries = m_seekIdx.size();
+    size_t bw = idxFile.write((uint8_t*)&h, sizeof(h));
+    bw += idxFile.write((uint8_t*)m_seekIdx.data(), h.numEntries * sizeof(seekIdxEntry_t));
+    idxFile.close();
+    if(bw != sizeof(h) + h.numEntries * sizeof(seekIdxEntry_t)) {
+        log_e("write error %s", m_seekIdxPath);
+        m_seekIdxFS->remove(m_seekIdxPath);
+        return false;
+    }
+    return true;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -84,8 +84,8 @@ public:
     bool     isInitialized() { return m_f_init; };
     void     setBufsize(int ram, int psram);
     int32_t  getBufsize();
-    void     changeMaxBlockSize(uint16_t mbs);  // is default 1600 for mp3 and aac, set 16384 for FLAC
-    uint16_t getMaxBlockSize();                 // returns maxBlockSize
+    bool     changeMaxBlockSize(uint32_t mbs);  // is default 1600 for mp3 and aac, >= 16384 for FLAC, can enlarge the reserve
+    uint32_t getMaxBlockSize();                 // returns maxBlockSize
     size_t   freeSpace();                       // number of free bytes to overwrite
     size_t   writeSpace();                      // space fom writepointer to bufferend
     size_t   bufferFilled();                    // returns the number of filled bytes
@@ -124,6 +124,8 @@ class Audio : private AudioBuffer{
     AudioBuffer InBuff; // instance of input buffer
 
 public:
+    enum : uint8_t { STARTUP_DEFAULT = 0, STARTUP_MIN_LATENCY = 1, STARTUP_BALANCED = 2, STARTUP_ROBUST = 3 }; // see setStartupPolicy()
+
     Audio(bool internalDAC = false, uint8_t channelEnabled = 3, uint8_t i2sPort = I2S_NUM_0); // #99
     ~Audio();
     void setBufsize(int rambuf_sz, int psrambuf_sz);
@@ -132,6 +134,11 @@ public:
     bool connecttoFS(fs::FS &fs, const char* path, int32_t resumeFilePos = -1);
     bool setFileLoop(bool input);//TEST loop
     void setConnectionTimeout(uint16_t timeout_ms, uint16_t timeout_ms_ssl);
+    void setStartupPolicy(uint8_t policy, uint8_t blocks = 0); // blocks = 0: default of the policy
+    void setSeekIndex(uint8_t intervalSec, bool sidecar = false); // local mp3/aac/flac, intervalSec = 0: off
+    void setMP3OutputRate(uint8_t divider); // 1: full, 2: half, 4: quarter sample rate (less CPU load)
+    void setAACDownsampledSBR(bool ds); // HE-AAC output at the core sample rate (less CPU load)
+    void setFLACCrcCheck(bool check); // drop FLAC frames with a CRC mismatch and resync (default: on)
     bool setAudioPlayPosition(uint16_t sec);
     bool setFilePos(uint32_t pos);
     bool audioFileSeek(const float speed);
@@ -160,6 +167,7 @@ public:
     uint32_t getAudioCurrentTime();
     uint32_t getTotalPlayingTime();
     uint16_t getVUlevel();
+    uint32_t getFLACCrcErrors(); // FLAC frames dropped because of a CRC mismatch, current stream
 
     uint32_t inBufferFilled(); // returns the number of stored bytes in the inputbuffer
     uint32_t inBufferFree();   // returns the number of free bytes in the inputbuffer
@@ -182,13 +190,17 @@ private:
     bool latinToUTF8(char* buff, size_t bufflen);
     void setDefaults(); // free buffers and set defaults
     void initInBuff();
-    bool httpPrint(const char* host);
+    bool httpPrint(const char* host, int32_t rangeFirst = -1);
+    bool webFileRange(uint32_t pos);
     void processLocalFile();
     void processWebStream();
     void processWebFile();
     void processWebStreamTS();
+    void processWebStreamFMP4();
     void processWebStreamHLS();
     void playAudioData();
+    bool startupBufferReady(bool f_dataComplete, bool f_file);
+    void reportStartupTimes();
     bool readPlayListData();
     const char* parsePlaylist_M3U();
     const char* parsePlaylist_PLS();
@@ -200,6 +212,8 @@ private:
     void showCodecParams();
     int  findNextSync(uint8_t* data, size_t len);
     int  sendBytes(uint8_t* data, size_t len);
+    int  decodeOggPacket(uint8_t* data, int* bytesLeft);
+    int  concealFrame(uint8_t* data, size_t len);
     void setDecoderItems();
     void compute_audioCurrentTime(int bd);
     void printDecodeError(int r);
@@ -209,6 +223,7 @@ private:
     int  read_FLAC_Header(uint8_t *data, size_t len);
     int  read_ID3_Header(uint8_t* data, size_t len);
     int  read_M4A_Header(uint8_t* data, size_t len);
+    bool read_MP3_VBR_Header(uint8_t* data, size_t len);
     size_t process_m3u8_ID3_Header(uint8_t* packet);
     bool setSampleRate(uint32_t hz);
     bool setBitsPerSample(int bits);
@@ -223,6 +238,7 @@ private:
     bool parseContentType(char* ct);
     bool parseHttpResponseHeader();
     bool initializeDecoder();
+    bool setOutBuffSize(size_t samples);
     esp_err_t I2Sstart(uint8_t i2s_num);
     esp_err_t I2Sstop(uint8_t i2s_num);
     void urlencode(char* buff, uint16_t buffLen, bool spacesOnly = false);
@@ -234,6 +250,7 @@ private:
     inline uint32_t streamavail(){ return _client ? _client->available() : 0;}
     void IIR_calculateCoefficients(int8_t G1, int8_t G2, int8_t G3);
     bool ts_parsePacket(uint8_t* packet, uint8_t* packetStart, uint8_t* packetLength);
+    size_t fmp4_parse(uint8_t* data, size_t len);
 
 //+++ W E B S T R E A M  -  H E L P   F U N C T I O N S +++
     uint16_t readMetadata(uint16_t b, bool first = false);
@@ -243,9 +260,23 @@ private:
     void     seek_m4a_stsz();
     void     seek_m4a_ilst();
     uint32_t m4a_correctResumeFilePos(uint32_t resumeFilePos);
+    bool     m4a_readSampleTables(uint32_t stts, uint32_t stsc, uint32_t stsz, uint32_t stco, bool co64);
+    void     m4a_freeSampleTables();
+    size_t   m4a_readSamples(uint8_t* buff, size_t len);
+    float    m4a_sampleTime(uint32_t sample);
+    bool     m4a_seekTableLookup(uint32_t sec);
+    void     m4a_parseASC(const uint8_t* asc);
     uint32_t flac_correctResumeFilePos(uint32_t resumeFilePos);
     uint32_t mp3_correctResumeFilePos(uint32_t resumeFilePos);
+    uint32_t mp3_vbrPosFromTime(float sec);
+    float    mp3_vbrTimeFromPos(uint32_t pos);
     uint8_t  determineOggCodec(uint8_t* data, uint16_t len);
+    void     seekIndex_add(bool frameStart);
+    bool     seekIndex_lookup(uint32_t sec);
+    bool     flac_seekTableLookup(uint32_t sec);
+    void     seekIndex_finish();
+    bool     seekIndex_load();
+    bool     seekIndex_save();
 
 
 //++++ implement several function with respect to the index of string ++++
@@ -423,7 +454,8 @@ private:
     enum : int { AUDIO_NONE, HTTP_RESPONSE_HEADER, AUDIO_DATA, AUDIO_LOCALFILE,
                  AUDIO_PLAYLISTINIT, AUDIO_PLAYLISTHEADER,  AUDIO_PLAYLISTDATA};
     enum : int { FLAC_BEGIN = 0, FLAC_MAGIC = 1, FLAC_MBH =2, FLAC_SINFO = 3, FLAC_PADDING = 4, FLAC_APP = 5,
-                 FLAC_SEEK = 6, FLAC_VORBIS = 7, FLAC_CUESHEET = 8, FLAC_PICTURE = 9, FLAC_OKAY = 100};
+                 FLAC_SEEK = 6, FLAC_VORBIS = 7, FLAC_CUESHEET = 8, FLAC_PICTURE = 9, FLAC_SEEKPOINTS = 10,
+                 FLAC_OKAY = 100};
     enum : int { M4A_BEGIN = 0, M4A_FTYP = 1, M4A_CHK = 2, M4A_MOOV = 3, M4A_FREE = 4, M4A_TRAK = 5, M4A_MDAT = 6,
                  M4A_ILST = 7, M4A_MP4A = 8, M4A_AMRDY = 99, M4A_OKAY = 100};
     enum : int { CODEC_NONE = 0, CODEC_WAV = 1, CODEC_MP3 = 2, CODEC_AAC = 3, CODEC_M4A = 4, CODEC_FLAC = 5,
@@ -445,6 +477,48 @@ private:
         int pids[4];
     } pid_array;
 
+    typedef struct _seekIdxEntry{
+        uint32_t sample; // samples per channel from the begin of the audio data
+        uint32_t pos;    // file position of the frame that starts with this sample
+    } seekIdxEntry_t;
+
+    typedef struct _seekIdxHeader{ // sidecar file: header followed by the entries
+        char     magic[4];         // "SIDX"
+        uint32_t fileSize;         // size of the audio file, the index is invalid if it does not match
+        uint32_t sampleRate;
+        uint32_t numEntries;
+    } seekIdxHeader_t;
+
+    typedef struct _m4aStscEntry{ // stsc: from firstChunk on, every chunk holds samplesPerChunk access units
+        uint32_t firstChunk;      // 1-based, as in the atom
+        uint32_t samplesPerChunk;
+    } m4aStscEntry_t;
+
+    typedef struct _m4aChunkJump{ // stco/co64, only the chunks that do not directly follow the previous chunk
+        uint32_t chunk;           // 1-based
+        uint32_t offset;          // file position of the chunk
+    } m4aChunkJump_t;
+
+    typedef struct _m4aSttsEntry{
+        uint32_t sampleCount;
+        uint32_t sampleDelta;     // duration of one access unit in units of the mdhd timescale
+    } m4aSttsEntry_t;
+
+    typedef struct _m4aCursor{    // position within the sample tables
+        uint32_t sample;          // access unit, 0-based
+        uint32_t size;            // its size in bytes
+        uint32_t pos;             // its file position
+        uint32_t sizeIdx;         // read index of the next size in m_m4aSizes
+        uint32_t chunk;           // 1-based
+        uint32_t chunkLeft;       // access units that follow in this chunk
+        uint32_t stscIdx;         // current entry in m_m4aStsc
+        uint32_t jumpIdx;         // next entry in m_m4aJumps
+    } m4aCursor_t;
+
+    uint32_t m4a_sampleSize(m4aCursor_t& c); // these need the cursor type
+    void     m4a_firstSample(m4aCursor_t& c);
+    void     m4a_nextSample(m4aCursor_t& c);
+
     File                  audiofile;    // @suppress("Abstract class cannot be instantiated")
     WiFiClient            client;       // @suppress("Abstract class cannot be instantiated")
     WiFiClientSecure      clientsecure; // @suppress("Abstract class cannot be instantiated")
@@ -466,10 +540,19 @@ private:
     std::vector<char*>    m_playlistContent;  // m3u8 playlist buffer
     std::vector<char*>    m_playlistURL;      // m3u8 streamURLs buffer
     std::vector<uint32_t> m_hashQueue;
+    std::vector<uint32_t> m_fmp4Samples;      // fMP4: access unit sizes of the current moof (trun)
+    std::vector<uint32_t> m_mp3SeekTable;     // Xing TOC or VBRI table as byte offsets, relative to m_mp3VbrStart
+    std::vector<seekIdxEntry_t> m_seekIdx;    // sample position -> byte offset, see setSeekIndex()
+    std::vector<seekIdxEntry_t> m_flacSeekTable; // FLAC SEEKTABLE, byte offsets relative to m_audioDataStart
+    std::vector<m4aStscEntry_t> m_m4aStsc;    // sample to chunk runs of the audio track
+    std::vector<m4aChunkJump_t> m_m4aJumps;   // sparse chunk offsets, see m4a_readSampleTables()
+    std::vector<m4aSttsEntry_t> m_m4aStts;    // time to sample runs
+    std::vector<m4aCursor_t>    m_m4aCheckpoints; // cursor at every m_m4aCheckStep-th access unit, for seeking
 
     const size_t    m_frameSizeWav    = 2048;
-    const size_t    m_frameSizeMP3    = 1600;
+    const size_t    m_frameSizeMP3    = 1800; // layer II: up to 1728 bytes (384 kbit/s, 32 kHz)
     const size_t    m_frameSizeAAC    = 1600;
+    const uint16_t  m_m4aCheckStep    = 1024; // access units between two M4A checkpoints, about 23s at 44.1kHz
     const size_t    m_frameSizeFLAC   = 4096 * 4;
     const size_t    m_frameSizeOPUS   = 1024;
     const size_t    m_frameSizeVORBIS = 4096 * 2;
@@ -512,6 +595,7 @@ private:
     uint8_t         m_vuLeft = 0;                   // average value of samples, left channel
     uint8_t         m_vuRight = 0;                  // average value of samples, right channel
     int16_t*        m_outBuff = NULL;               // Interleaved L/R
+    size_t          m_outBuffSize = 2048 * 2;       // int16_t samples, FLAC needs a whole block
     std::atomic<int16_t>  m_validSamples = {0};     // #144
     std::atomic<int16_t>  m_curSample{0};
     std::atomic<uint16_t> m_datamode{0};            // Statemaschine
@@ -522,20 +606,49 @@ private:
     uint8_t         m_flacBitsPerSample = 0;        // bps should be 16
     uint8_t         m_flacNumChannels = 0;          // can be read out in the FLAC file header
     uint32_t        m_flacSampleRate = 0;           // can be read out in the FLAC file header
-    uint16_t        m_flacMaxFrameSize = 0;         // can be read out in the FLAC file header
+    uint32_t        m_flacMaxFrameSize = 0;         // can be read out in the FLAC file header
     uint16_t        m_flacMaxBlockSize = 0;         // can be read out in the FLAC file header
     uint32_t        m_flacTotalSamplesInStream = 0; // can be read out in the FLAC file header
+    uint8_t         m_m4aObjectType = 0;            // AudioSpecificConfig (esds): 2 LC, 5 SBR, 23 AAC-LD ...
+    uint8_t         m_m4aNumChannels = 0;           // AudioSpecificConfig: channel configuration
+    uint16_t        m_m4aFrameLength = 1024;        // AudioSpecificConfig: samples per frame, AAC-LD 512 or 480
+    uint32_t        m_m4aSampleRate = 0;            // AudioSpecificConfig: (core) sample rate
     uint32_t        m_metaint = 0;                  // Number of databytes between metadata
     uint32_t        m_chunkcount = 0 ;              // Counter for chunked transfer
     uint32_t        m_t0 = 0;                       // store millis(), is needed for a small delay
 	uint32_t        m_byteCounter = 0;              // count received data
     uint32_t        m_contentlength = 0;            // Stores the length if the stream comes from fileserver
+    uint32_t        m_rangeSkip = 0;                // the server ignored a range request, bytes to drop up to m_byteCounter
     uint32_t        m_bytesNotDecoded = 0;          // pictures or something else that comes with the stream
     uint32_t        m_PlayingStartTime = 0;         // Stores the milliseconds after the start of the audio
+    uint32_t        m_tConnect = 0;                 // startup timing: millis() at connecttohost/FS/speech
+    uint32_t        m_tFirstByte = 0;               // startup timing: first audio byte in InBuff
+    uint32_t        m_tFirstFrame = 0;              // startup timing: first frame decoded
+    uint32_t        m_tFirstDMA = 0;                // startup timing: first sample written to I2S DMA
     int32_t         m_resumeFilePos = -1;           // the return value from stopSong() can be entered here, (-1) is idle
     uint16_t        m_m3u8_targetDuration = 10;     //
     uint32_t        m_stsz_numEntries = 0;          // num of entries inside stsz atom (uint32_t)
     uint32_t        m_stsz_position = 0;            // pos of stsz atom within file
+    uint8_t*        m_m4aSizes = NULL;              // stsz as zigzag coded differences of the access unit sizes
+    uint32_t        m_m4aFixedSize = 0;             // stsz sample_size, all access units have this size (m_m4aSizes unused)
+    uint32_t        m_m4aNumSamples = 0;            // number of access units in the audio track
+    uint32_t        m_m4aTimescale = 0;             // mdhd, units per second of the stts deltas
+    uint32_t        m_m4aRdOffs = 0;                // bytes of the access unit m_m4aRd already in InBuff
+    uint32_t        m_m4aMdatPos = 0;               // web M4A with moov behind mdat: file position of mdat, 0 if not skipped
+    uint32_t        m_m4aMdatSize = 0;              // web M4A with moov behind mdat: size of the mdat atom
+    uint32_t        m_fmp4InitHash = 0;             // hash of the last fMP4 init segment URL (#EXT-X-MAP)
+    m4aCursor_t     m_m4aRd = {};                   // next access unit to read from the file into InBuff
+    m4aCursor_t     m_m4aDec = {};                  // next access unit to decode, it is at the read pointer of InBuff
+    uint32_t        m_mp3VbrStart = 0;              // file position of the frame with the Xing/VBRI header
+    uint32_t        m_mp3VbrBitrate = 0;            // average bitrate from Xing/VBRI header, 0 if there is no header
+    float           m_mp3VbrDuration = 0;           // exact duration in sec from Xing/VBRI header (frames, LAME delay/padding)
+    float           m_mp3SeekTableStep = 0;         // seconds between two entries of m_mp3SeekTable
+    fs::FS*         m_seekIdxFS = NULL;             // filesystem of the audio file, for the sidecar file
+    char*           m_seekIdxPath = NULL;           // path of the sidecar file (audiofile + ".sidx")
+    uint32_t        m_seekIdxSample = 0;            // samples per channel decoded since the begin of the audio data
+    uint32_t        m_seekIdxSampleRate = 0;
+    uint32_t        m_samplesToSkip = 0;            // discard so many decoded samples after a seek (exact position)
+    uint8_t         m_seekIdxInterval = 0;          // seconds between two seek index entries, 0: no seek index
     bool            m_f_metadata = false;           // assume stream without metadata
     bool            m_f_unsync = false;             // set within ID3 tag but not used
     bool            m_f_exthdr = false;             // ID3 extended header
@@ -544,6 +657,8 @@ private:
     bool            m_f_firstCall = false;          // InitSequence for processWebstream and processLokalFile
     bool            m_f_firstM3U8call = false;      // InitSequence for m3u8 parsing
     bool            m_f_chunked = false ;           // Station provides chunked transfer
+    bool            m_f_acceptRanges = false;       // fileserver sends "accept-ranges: bytes", a web file can be read from any position
+    bool            m_f_rangeRequest = false;       // a HTTP range request is pending, expect "206 Partial Content"
     bool            m_f_firstmetabyte = false;      // True if first metabyte (counter)
     bool            m_f_playing = false;            // valid mp3 stream recognized
     bool            m_f_tts = false;                // text to speech
@@ -555,10 +670,24 @@ private:
     bool            m_f_Log = false;                // set in platformio.ini  -DAUDIO_LOG and -DCORE_DEBUG_LEVEL=3 or 4
     bool            m_f_continue = false;           // next m3u8 chunk is available
     bool            m_f_ts = true;                  // transport stream
+    bool            m_f_fmp4 = false;               // fragmented mp4 (CMAF) segments, #EXT-X-MAP
     bool            m_f_m4aID3dataAreRead = false;  // has the m4a-ID3data already been read?
     bool            m_f_psramFound = false;         // set in constructor, result of psramInit()
     bool            m_f_timeout = false;            //
+    bool            m_f_mp3VbrChecked = false;      // first MP3 frame has been checked for a Xing/VBRI header
+    bool            m_f_seekIdxSidecar = false;     // load and save the seek index from/to a sidecar file
+    bool            m_f_seekIdxBuild = false;       // recording of seek index entries is running
+    bool            m_f_seekIdxComplete = false;    // seek index covers the whole file
+    bool            m_f_seekIdxFrameStart = true;   // next decode call starts with a new frame
+    bool            m_f_seekIdxHit = false;         // setAudioPlayPosition() found the position in the seek index
+    bool            m_f_m4aTables = false;          // sample tables are read, M4A is fed one access unit per decode call
     uint8_t         m_f_channelEnabled = 3;         // internal DAC, both channels
+    uint8_t         m_startupPolicy = STARTUP_DEFAULT;
+    uint8_t         m_startupBlocks = 0;            // start if so many max-size input blocks (bytes in InBuff) are buffered, 0: policy default
+    uint8_t         m_mp3RateDivider = 1;           // MP3 output sample rate = sample rate / m_mp3RateDivider
+    bool            m_f_aacSBRDownsampled = false;  // HE-AAC: downsampled SBR, output sample rate = core sample rate
+    bool            m_f_flacCrcCheck = true;        // FLAC: verify the CRC-8 / CRC-16 of every frame
+    bool            m_f_oggContainer = false;       // FLAC, OPUS, VORBIS: the pages are read by the ogg demuxer
     uint32_t        m_audioFileDuration = 0;
     float           m_audioCurrentTime = 0;
     uint32_t        m_audioDataStart = 0;           // in bytes
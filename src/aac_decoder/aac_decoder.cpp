@@ -16,6 +16,7 @@ const uint8_t  NUM_TERMS_RPI        = 5;
 const uint32_t LOG2_EXP_INV         = 0x58b90bfc;    /* 1/log2(e), Q31 */
 const uint8_t  SF_OFFSET            = 100;
 const uint8_t  AAC_PROFILE_LC       = 1;
+const uint8_t  AAC_PROFILE_LD       = 22;            /* ER AAC-LD, audio object type 23 */
 const uint8_t  NUM_TIME_SLOTS       = 16;
 const uint8_t  SAMPLES_PER_SLOT     = 2;             /* RATE in spec */
 const uint8_t  SYNCWORDH            = 0xff;          /* 12-bit syncword */
@@ -46,7 +47,7 @@ const uint32_t X0_OFF_2             = 0x60000000;    /* Q29:  3.0 */
 const uint32_t Q26_3                = 0x0c000000;    /* Q26:  3.0 */
 const uint8_t  EXT_SBR_DATA         = 0x0d;
 const uint8_t  EXT_SBR_DATA_CRC     = 0x0e;
-const uint8_t  NUM_SAMPLE_RATES_SBR = 9;             /* downsampled (single-rate) mode unsupported */
+const uint8_t  NUM_SAMPLE_RATES_SBR = 9;             /* single-rate mode unsupported */
 const uint8_t  MAX_NUM_PATCHES      = 5;
 const uint8_t  MAX_QMF_BANDS        = 48;            /* max QMF subbands covered by SBR (4.6.18.3.6) */
 const uint8_t  MAX_NUM_ENV          = 5;
@@ -70,11 +71,14 @@ const uint8_t  FBITS_OUT_DQ_ENV     = 29;            /* dequantized env scalefac
 const uint8_t  FBITS_GLIM_BOOST     = 24;
 const uint8_t  FBITS_QLIM_BOOST     = 14;
 const uint8_t  MIN_GBITS_IN_QMFS    = 2;
+const uint8_t  EXTENSION_ID_PS      = 2;
 const uint16_t nmdctTab[2]          = {128, 1024};
 const uint8_t  postSkip[2]          = {15, 1};
 const uint16_t nfftTab[2]           = {64, 512};
 const uint8_t  nfftlog2Tab[2]       = {6, 9};
 const uint8_t  cos4sin4tabOffset[2] = {0, 128};
+const uint16_t CONCEAL_RAMP         = 256;           /* samples per channel of the muting and fade-in ramps */
+const uint8_t  ADTS_SYNC_FRAMES     = 3;             /* ADTS headers behind a sync word that must agree before locking */
 
 PSInfoBase_t        *m_PSInfoBase;
 AACDecInfo_t        *m_AACDecInfo;
@@ -85,11 +89,22 @@ ProgConfigElement_t *m_pce[16];
 PulseInfo_t          m_pulseInfo[2]; // [MAX_NCHANS_ELEM]
 aac_BitStreamInfo_t  m_aac_BitStreamInfo;
 PSInfoSBR_t         *m_PSInfoSBR;
+uint8_t              m_sbrDownsampled = 0;  /* 1: downsampled SBR, 32-subband synthesis QMF, output at the core rate */
+short                m_aacConcealLast[2];   /* last pcm sample of each output channel, start of the muting ramp */
+int                  m_aacConcealChans = 0; /* output channels of the last good frame, 0: nothing decoded yet */
+int                  m_aacConcealSamps = 0; /* output samples per channel of the last good frame */
+uint8_t              m_aacConcealCore = 0;  /* 1: no SBR/PS in the last good frame, the overlap buffers hold its tail */
+int                  m_aacConcealFrames = 0; /* frames concealed since the last good frame, the next good frame is faded in */
 
 //----------------------------------------------------------------------------------------------------------------------
 inline int MULSHIFT32(int x, int y){
+#ifdef __XTENSA__ // signed multiply-high, one instruction instead of the 64-bit product
+    int z; asm ("mulsh %0, %1, %2" : "=a"(z) : "a"(x), "a"(y));
+    return z;
+#else
     int z; z = (int64_t)x * (int64_t)y >> 32;
     return z;
+#endif
 }
 inline int CLZ(int x){
 #ifdef __XTENSA__
@@ -691,6 +706,618 @@ const uint8_t bitrevtab[17 + 129] PROGMEM = {
 0x00,
 };
 
+/* AAC-LD inverse transform (n = 512 or 480 samples, DCT-IV via a complex FFT of n/2 points)
+ * ldIdx 0 = 512: FFT 256 = 4*4*4*4, ldIdx 1 = 480: FFT 240 = 5*3*4*4 (mixed-radix, decimation in time)
+ */
+const uint16_t nmdctTabLD[2] PROGMEM = {512, 480};
+const uint8_t  fftRadixLD[2][4] PROGMEM = {{4, 4, 4, 4}, {5, 3, 4, 4}};
+
+/* pre-twiddle: cos4sin4tabLD[2m], [2m+1] = (128/n) * (cos, sin)(pi * (m + 1/8) / n), format = Q31
+ * the 128/n factor, 1/2 per FFT pass and the 1/4 in cos1sin1tabLD give the gain of the long block DCT4, -1/(2n)
+ */
+const uint16_t cos4sin4tabLDOffset[2] PROGMEM = {0, 512};
+
+const int cos4sin4tabLD[512 + 480] PROGMEM = {
+    /* 512 */
+    0x1fffff62, 0x0006487f, 0x1fffce09, 0x00388c58, 0x1fff4dbc, 0x006acfa6, 0x1ffe7e7b, 0x009d11ec,
+    0x1ffd6049, 0x00cf52af, 0x1ffbf329, 0x01019172, 0x1ffa371e, 0x0133cdb9, 0x1ff82c2c, 0x01660709,
+    0x1ff5d259, 0x01983ce6, 0x1ff329aa, 0x01ca6ed4, 0x1ff03226, 0x01fc9c56, 0x1fecebd3, 0x022ec4f1,
+    0x1fe956bb, 0x0260e82a, 0x1fe572e7, 0x02930584, 0x1fe1405e, 0x02c51c84, 0x1fdcbf2d, 0x02f72caf,
+    0x1fd7ef5e, 0x03293588, 0x1fd2d0fc, 0x035b3695, 0x1fcd6416, 0x038d2f59, 0x1fc7a8b7, 0x03bf1f5b,
+    0x1fc19eef, 0x03f1061e, 0x1fbb46cb, 0x0422e327, 0x1fb4a05c, 0x0454b5fb, 0x1fadabb2, 0x04867e20,
+    0x1fa668df, 0x04b83b1a, 0x1f9ed7f4, 0x04e9ec70, 0x1f96f903, 0x051b91a5, 0x1f8ecc21, 0x054d2a40,
+    0x1f865161, 0x057eb5c7, 0x1f7d88d9, 0x05b033be, 0x1f74729d, 0x05e1a3ad, 0x1f6b0ec5, 0x06130518,
+    0x1f615d68, 0x06445787, 0x1f575e9d, 0x06759a7f, 0x1f4d127d, 0x06a6cd87, 0x1f427922, 0x06d7f026,
+    0x1f3792a6, 0x070901e2, 0x1f2c5f23, 0x073a0242, 0x1f20deb6, 0x076af0cd, 0x1f15117a, 0x079bcd0b,
+    0x1f08f78d, 0x07cc9683, 0x1efc910d, 0x07fd4cbc, 0x1eefde18, 0x082def3f, 0x1ee2decd, 0x085e7d94,
+    0x1ed5934e, 0x088ef742, 0x1ec7fbb9, 0x08bf5bd2, 0x1eba1832, 0x08efaacd, 0x1eabe8da, 0x091fe3bb,
+    0x1e9d6dd4, 0x09500625, 0x1e8ea744, 0x09801196, 0x1e7f954e, 0x09b00595, 0x1e703818, 0x09dfe1ad,
+    0x1e608fc8, 0x0a0fa568, 0x1e509c84, 0x0a3f5050, 0x1e405e73, 0x0a6ee1ef, 0x1e2fd5be, 0x0a9e59d0,
+    0x1e1f028e, 0x0acdb77e, 0x1e0de50b, 0x0afcfa83, 0x1dfc7d60, 0x0b2c226c, 0x1deacbb9, 0x0b5b2ec4,
+    0x1dd8d040, 0x0b8a1f17, 0x1dc68b22, 0x0bb8f2f0, 0x1db3fc8d, 0x0be7a9dd, 0x1da124ad, 0x0c16436b,
+    0x1d8e03b2, 0x0c44bf25, 0x1d7a99cb, 0x0c731c9a, 0x1d66e727, 0x0ca15b58, 0x1d52ebf7, 0x0ccf7aeb,
+    0x1d3ea86d, 0x0cfd7ae2, 0x1d2a1cba, 0x0d2b5acd, 0x1d154911, 0x0d591a38, 0x1d002da6, 0x0d86b8b5,
+    0x1ceacaad, 0x0db435d1, 0x1cd5205a, 0x0de1911e, 0x1cbf2ee3, 0x0e0eca2a, 0x1ca8f67e, 0x0e3be087,
+    0x1c927762, 0x0e68d3c5, 0x1c7bb1c6, 0x0e95a375, 0x1c64a5e2, 0x0ec24f29, 0x1c4d53f0, 0x0eeed672,
+    0x1c35bc29, 0x0f1b38e3, 0x1c1ddec7, 0x0f47760d, 0x1c05bc05, 0x0f738d85, 0x1bed541f, 0x0f9f7edd,
+    0x1bd4a750, 0x0fcb49a8, 0x1bbbb5d6, 0x0ff6ed7b, 0x1ba27fee, 0x102269ea, 0x1b8905d7, 0x104dbe8a,
+    0x1b6f47cf, 0x1078eaef, 0x1b554616, 0x10a3eeb0, 0x1b3b00ec, 0x10cec961, 0x1b207891, 0x10f97a9a,
+    0x1b05ad48, 0x112401f1, 0x1aea9f52, 0x114e5efd, 0x1acf4ef3, 0x11789156, 0x1ab3bc6d, 0x11a29893,
+    0x1a97e804, 0x11cc744c, 0x1a7bd1fe, 0x11f6241b, 0x1a5f7a9f, 0x121fa799, 0x1a42e22d, 0x1248fe5f,
+    0x1a2608f0, 0x12722807, 0x1a08ef2e, 0x129b242b, 0x19eb952e, 0x12c3f267, 0x19cdfb3b, 0x12ec9256,
+    0x19b0219b, 0x13150393, 0x1992089a, 0x133d45bb, 0x1973b081, 0x1365586b, 0x1955199b, 0x138d3b3f,
+    0x19364434, 0x13b4edd5, 0x19173098, 0x13dc6fcb, 0x18f7df13, 0x1403c0c1, 0x18d84ff3, 0x142ae053,
+    0x18b88386, 0x1451ce23, 0x18987a1a, 0x147889d0, 0x187833fd, 0x149f12fb, 0x1857b181, 0x14c56943,
+    0x1836f2f4, 0x14eb8c4c, 0x1815f8a9, 0x15117bb7, 0x17f4c2ef, 0x15373726, 0x17d35219, 0x155cbe3b,
+    0x17b1a67a, 0x1582109b, 0x178fc065, 0x15a72dea, 0x176da02d, 0x15cc15cb, 0x174b4626, 0x15f0c7e5,
+    0x1728b2a6, 0x161543db, 0x1705e601, 0x16398954, 0x16e2e08e, 0x165d97f8, 0x16bfa2a3, 0x16816f6b,
+    0x169c2c96, 0x16a50f58, 0x16787ec0, 0x16c87764, 0x16549978, 0x16eba73a, 0x16307d17, 0x170e9e81,
+    0x160c29f6, 0x17315ce5, 0x15e7a06e, 0x1753e20f, 0x15c2e0da, 0x17762daa, 0x159deb95, 0x17983f61,
+    0x1578c0fa, 0x17ba16e0, 0x15536163, 0x17dbb3d5, 0x152dcd2f, 0x17fd15eb, 0x150804b8, 0x181e3cd1,
+    0x14e2085d, 0x183f2835, 0x14bbd87c, 0x185fd7c5, 0x14957571, 0x18804b30, 0x146edf9d, 0x18a08228,
+    0x1448175f, 0x18c07c5c, 0x14211d15, 0x18e0397e, 0x13f9f121, 0x18ffb93e, 0x13d293e2, 0x191efb50,
+    0x13ab05bb, 0x193dff66, 0x1383470c, 0x195cc534, 0x135b5838, 0x197b4c6d, 0x133339a1, 0x199994c7,
+    0x130aebaa, 0x19b79df7, 0x12e26eb7, 0x19d567b2, 0x12b9c32c, 0x19f2f1b0, 0x1290e96c, 0x1a103ba7,
+    0x1267e1dd, 0x1a2d454e, 0x123eace4, 0x1a4a0e60, 0x12154ae7, 0x1a669693, 0x11ebbc4b, 0x1a82dda2,
+    0x11c20178, 0x1a9ee348, 0x11981ad4, 0x1abaa73e, 0x116e08c6, 0x1ad62941, 0x1143cbb7, 0x1af1690c,
+    0x1119640e, 0x1b0c665d, 0x10eed235, 0x1b2720f1, 0x10c41694, 0x1b419885, 0x10993195, 0x1b5bccd9,
+    0x106e23a1, 0x1b75bdac, 0x1042ed23, 0x1b8f6abe, 0x10178e86, 0x1ba8d3cf, 0x0fec0833, 0x1bc1f8a1,
+    0x0fc05a98, 0x1bdad8f6, 0x0f948620, 0x1bf37490, 0x0f688b36, 0x1c0bcb33, 0x0f3c6a47, 0x1c23dca3,
+    0x0f1023c1, 0x1c3ba8a4, 0x0ee3b810, 0x1c532efb, 0x0eb727a1, 0x1c6a6f6f, 0x0e8a72e4, 0x1c8169c5,
+    0x0e5d9a46, 0x1c981dc7, 0x0e309e36, 0x1cae8b3a, 0x0e037f23, 0x1cc4b1e9, 0x0dd63d7c, 0x1cda919c,
+    0x0da8d9b1, 0x1cf02a1e, 0x0d7b5432, 0x1d057b39, 0x0d4dad6f, 0x1d1a84b8, 0x0d1fe5d9, 0x1d2f4668,
+    0x0cf1fde1, 0x1d43c015, 0x0cc3f5f8, 0x1d57f18d, 0x0c95ce90, 0x1d6bda9f, 0x0c67881a, 0x1d7f7b18,
+    0x0c392309, 0x1d92d2c9, 0x0c0a9fcf, 0x1da5e181, 0x0bdbfedf, 0x1db8a713, 0x0bad40ab, 0x1dcb234e,
+    0x0b7e65a9, 0x1ddd5607, 0x0b4f6e4a, 0x1def3f10, 0x0b205b03, 0x1e00de3c, 0x0af12c48, 0x1e123361,
+    0x0ac1e28e, 0x1e233e53, 0x0a927e48, 0x1e33fee9, 0x0a62ffed, 0x1e4474f8, 0x0a3367f0, 0x1e54a05a,
+    0x0a03b6c9, 0x1e6480e5, 0x09d3eceb, 0x1e741672, 0x09a40ace, 0x1e8360db, 0x097410e8, 0x1e925ffb,
+    0x0943ffae, 0x1ea113ac, 0x0913d797, 0x1eaf7bc9, 0x08e3991b, 0x1ebd9831, 0x08b344af, 0x1ecb68be,
+    0x0882dacd, 0x1ed8ed51, 0x08525bea, 0x1ee625c6, 0x0821c87e, 0x1ef311fe, 0x07f12102, 0x1effb1d9,
+    0x07c065ee, 0x1f0c0538, 0x078f97b9, 0x1f180bfb, 0x075eb6dd, 0x1f23c606, 0x072dc3d1, 0x1f2f333b,
+    0x06fcbf0e, 0x1f3a537f, 0x06cba90f, 0x1f4526b5, 0x069a824a, 0x1f4facc4, 0x06694b3b, 0x1f59e591,
+    0x0638045a, 0x1f63d102, 0x0606ae20, 0x1f6d6f01, 0x05d54909, 0x1f76bf74, 0x05a3d58c, 0x1f7fc244,
+    0x05725426, 0x1f88775d, 0x0540c54f, 0x1f90dea7, 0x050f2981, 0x1f98f80f, 0x04dd8139, 0x1fa0c380,
+    0x04abccef, 0x1fa840e7, 0x047a0d1e, 0x1faf7031, 0x04484242, 0x1fb6514e, 0x04166cd5, 0x1fbce42c,
+    0x03e48d51, 0x1fc328ba, 0x03b2a433, 0x1fc91ee9, 0x0380b1f6, 0x1fcec6ab, 0x034eb713, 0x1fd41ff2,
+    0x031cb408, 0x1fd92ab0, 0x02eaa94f, 0x1fdde6d8, 0x02b89763, 0x1fe25461, 0x02867ec1, 0x1fe6733d,
+    0x02545fe4, 0x1fea4364, 0x02223b47, 0x1fedc4cb, 0x01f01166, 0x1ff0f76a, 0x01bde2bd, 0x1ff3db3a,
+    0x018bafc9, 0x1ff67033, 0x01597903, 0x1ff8b64e, 0x01273eea, 0x1ffaad86, 0x00f501f8, 0x1ffc55d7,
+    0x00c2c2a9, 0x1ffdaf3c, 0x0090817a, 0x1ffeb9b2, 0x005e3ee6, 0x1fff7536, 0x002bfb6a, 0x1fffe1c6,
+    /* 480 */
+    0x22222162, 0x0007261c, 0x2221e57f, 0x004056d8, 0x222149c9, 0x007986e0, 0x22204e42, 0x00b2b592,
+    0x221ef2ed, 0x00ebe24e, 0x221d37cf, 0x01250c75, 0x221b1ceb, 0x015e3364, 0x2218a248, 0x0197567d,
+    0x2215c7ed, 0x01d0751d, 0x22128de2, 0x02098ea7, 0x220ef42f, 0x0242a277, 0x220afadf, 0x027baff0,
+    0x2206a1fe, 0x02b4b670, 0x2201e996, 0x02edb557, 0x21fcd1b6, 0x0326ac05, 0x21f75a6c, 0x035f99db,
+    0x21f183c7, 0x03987e38, 0x21eb4dd8, 0x03d1587e, 0x21e4b8af, 0x040a280b, 0x21ddc460, 0x0442ec42,
+    0x21d670fe, 0x047ba481, 0x21cebe9e, 0x04b4502b, 0x21c6ad54, 0x04eceea0, 0x21be3d39, 0x05257f41,
+    0x21b56e63, 0x055e0170, 0x21ac40eb, 0x0596748d, 0x21a2b4eb, 0x05ced7fa, 0x2198ca7e, 0x06072b19,
+    0x218e81c0, 0x063f6d4c, 0x2183dacd, 0x06779df5, 0x2178d5c3, 0x06afbc76, 0x216d72c2, 0x06e7c832,
+    0x2161b1e9, 0x071fc08b, 0x21559359, 0x0757a4e4, 0x21491735, 0x078f74a0, 0x213c3d9f, 0x07c72f22,
+    0x212f06bc, 0x07fed3cf, 0x212172b0, 0x08366209, 0x211381a1, 0x086dd936, 0x210533b8, 0x08a538b8,
+    0x20f6891b, 0x08dc7ff6, 0x20e781f5, 0x0913ae53, 0x20d81e6f, 0x094ac334, 0x20c85eb4, 0x0981be00,
+    0x20b842f1, 0x09b89e1b, 0x20a7cb53, 0x09ef62eb, 0x2096f809, 0x0a260bd8, 0x2085c940, 0x0a5c9847,
+    0x20743f2b, 0x0a93079f, 0x206259f9, 0x0ac95948, 0x205019dd, 0x0aff8ca8, 0x203d7f0b, 0x0b35a129,
+    0x202a89b6, 0x0b6b9631, 0x20173a14, 0x0ba16b2a, 0x2003905c, 0x0bd71f7c, 0x1fef8cc3, 0x0c0cb291,
+    0x1fdb2f83, 0x0c4223d2, 0x1fc678d4, 0x0c7772a9, 0x1fb168f1, 0x0cac9e81, 0x1f9c0015, 0x0ce1a6c3,
+    0x1f863e7c, 0x0d168add, 0x1f702463, 0x0d4b4a38, 0x1f59b208, 0x0d7fe441, 0x1f42e7ab, 0x0db45864,
+    0x1f2bc58a, 0x0de8a60e, 0x1f144be7, 0x0e1cccac, 0x1efc7b05, 0x0e50cbab, 0x1ee45325, 0x0e84a27a,
+    0x1ecbd48b, 0x0eb85088, 0x1eb2ff7e, 0x0eebd542, 0x1e99d441, 0x0f1f3019, 0x1e80531c, 0x0f52607c,
+    0x1e667c56, 0x0f8565db, 0x1e4c5038, 0x0fb83fa8, 0x1e31cf0c, 0x0feaed54, 0x1e16f91b, 0x101d6e4f,
+    0x1dfbceb1, 0x104fc20e, 0x1de0501b, 0x1081e801, 0x1dc47da5, 0x10b3df9d, 0x1da8579e, 0x10e5a855,
+    0x1d8bde55, 0x1117419d, 0x1d6f1219, 0x1148aaeb, 0x1d51f33c, 0x1179e3b3, 0x1d34820f, 0x11aaeb6b,
+    0x1d16bee5, 0x11dbc18a, 0x1cf8aa11, 0x120c6586, 0x1cda43e8, 0x123cd6d7, 0x1cbb8cbf, 0x126d14f6,
+    0x1c9c84ed, 0x129d1f59, 0x1c7d2cc8, 0x12ccf57c, 0x1c5d84a9, 0x12fc96d7, 0x1c3d8ce8, 0x132c02e4,
+    0x1c1d45e0, 0x135b391f, 0x1bfcafea, 0x138a3903, 0x1bdbcb62, 0x13b9020c, 0x1bba98a6, 0x13e793b7,
+    0x1b991810, 0x1415ed81, 0x1b774a01, 0x14440ee7, 0x1b552ed7, 0x1471f769, 0x1b32c6f1, 0x149fa685,
+    0x1b1012b0, 0x14cd1bbc, 0x1aed1275, 0x14fa568d, 0x1ac9c6a4, 0x15275679, 0x1aa62f9e, 0x15541b03,
+    0x1a824dc8, 0x1580a3ad, 0x1a5e2186, 0x15aceff9, 0x1a39ab3f, 0x15d8ff6c, 0x1a14eb58, 0x1604d189,
+    0x19efe238, 0x163065d5, 0x19ca9049, 0x165bbbd7, 0x19a4f5f1, 0x1686d314, 0x197f139b, 0x16b1ab13,
+    0x1958e9b2, 0x16dc435d, 0x193278a0, 0x17069b7a, 0x190bc0d1, 0x1730b2f2, 0x18e4c2b3, 0x175a8950,
+    0x18bd7eb1, 0x17841e1f, 0x1895f53c, 0x17ad70e8, 0x186e26c1, 0x17d6813a, 0x184613b1, 0x17ff4e9f,
+    0x181dbc7b, 0x1827d8a6, 0x17f52192, 0x18501edd, 0x17cc4367, 0x187820d2, 0x17a3226d, 0x189fde16,
+    0x1779bf17, 0x18c75639, 0x175019da, 0x18ee88cc, 0x1726332a, 0x19157561, 0x16fc0b7e, 0x193c1b8a,
+    0x16d1a34a, 0x19627adc, 0x16a6fb08, 0x198892eb, 0x167c132e, 0x19ae634b, 0x1650ec34, 0x19d3eb92,
+    0x16258694, 0x19f92b58, 0x15f9e2c8, 0x1a1e2233, 0x15ce014a, 0x1a42cfbc, 0x15a1e296, 0x1a67338b,
+    0x15758727, 0x1a8b4d3b, 0x1548ef79, 0x1aaf1c67, 0x151c1c0b, 0x1ad2a0a9, 0x14ef0d59, 0x1af5d99e,
+    0x14c1c3e3, 0x1b18c6e3, 0x14944027, 0x1b3b6816, 0x146682a5, 0x1b5dbcd7, 0x14388bde, 0x1b7fc4c3,
+    0x140a5c52, 0x1ba17f7d, 0x13dbf484, 0x1bc2eca5, 0x13ad54f6, 0x1be40bdd, 0x137e7e2a, 0x1c04dcc9,
+    0x134f70a3, 0x1c255f0c, 0x13202ce7, 0x1c45924b, 0x12f0b37a, 0x1c65762c, 0x12c104e1, 0x1c850a54,
+    0x129121a1, 0x1ca44e6d, 0x12610a42, 0x1cc3421d, 0x1230bf4b, 0x1ce1e50d, 0x12004142, 0x1d0036e9,
+    0x11cf90b0, 0x1d1e375a, 0x119eae1e, 0x1d3be60d, 0x116d9a15, 0x1d5942ae, 0x113c551f, 0x1d764cea,
+    0x110adfc5, 0x1d930471, 0x10d93a94, 0x1daf68f1, 0x10a76616, 0x1dcb7a1b, 0x107562d7, 0x1de737a0,
+    0x10433164, 0x1e02a133, 0x1010d249, 0x1e1db685, 0x0fde4614, 0x1e38774c, 0x0fab8d53, 0x1e52e33c,
+    0x0f78a894, 0x1e6cfa0a, 0x0f459866, 0x1e86bb6f, 0x0f125d58, 0x1ea02720, 0x0edef7fb, 0x1eb93cd8,
+    0x0eab68de, 0x1ed1fc4f, 0x0e77b093, 0x1eea6541, 0x0e43cfaa, 0x1f027768, 0x0e0fc6b5, 0x1f1a3281,
+    0x0ddb9647, 0x1f319649, 0x0da73ef1, 0x1f48a27f, 0x0d72c146, 0x1f5f56e2, 0x0d3e1ddb, 0x1f75b332,
+    0x0d095542, 0x1f8bb731, 0x0cd46811, 0x1fa162a0, 0x0c9f56db, 0x1fb6b544, 0x0c6a2235, 0x1fcbaedf,
+    0x0c34cab6, 0x1fe04f37, 0x0bff50f2, 0x1ff49613, 0x0bc9b57f, 0x20088339, 0x0b93f8f5, 0x201c1671,
+    0x0b5e1beb, 0x202f4f85, 0x0b281ef6, 0x20422e3e, 0x0af202af, 0x2054b267, 0x0abbc7ae, 0x2066dbcd,
+    0x0a856e8c, 0x2078aa3d, 0x0a4ef7df, 0x208a1d84, 0x0a186443, 0x209b3571, 0x09e1b44f, 0x20abf1d5,
+    0x09aae89d, 0x20bc5280, 0x097401c7, 0x20cc5745, 0x093d0068, 0x20dbfff7, 0x0905e519, 0x20eb4c69,
+    0x08ceb075, 0x20fa3c71, 0x08976318, 0x2108cfe5, 0x085ffd9d, 0x2117069b, 0x0828809e, 0x2124e06c,
+    0x07f0ecb8, 0x21325d32, 0x07b94288, 0x213f7cc5, 0x078182a8, 0x214c3f02, 0x0749adb6, 0x2158a3c5,
+    0x0711c44e, 0x2164aaea, 0x06d9c70e, 0x21705450, 0x06a1b692, 0x217b9fd6, 0x06699379, 0x21868d5d,
+    0x06315e5e, 0x21911cc5, 0x05f917e1, 0x219b4df2, 0x05c0c0a0, 0x21a520c6, 0x05885938, 0x21ae9527,
+    0x054fe247, 0x21b7aaf8, 0x05175c6d, 0x21c06222, 0x04dec849, 0x21c8ba8b, 0x04a62677, 0x21d0b41c,
+    0x046d7799, 0x21d84ebf, 0x0434bc4d, 0x21df8a5e, 0x03fbf532, 0x21e666e6, 0x03c322e7, 0x21ece442,
+    0x038a460d, 0x21f30260, 0x03515f43, 0x21f8c130, 0x03186f28, 0x21fe20a1, 0x02df765c, 0x220320a4,
+    0x02a67580, 0x2207c12b, 0x026d6d33, 0x220c0229, 0x02345e15, 0x220fe393, 0x01fb48c7, 0x2213655d,
+    0x01c22de9, 0x2216877d, 0x01890e1b, 0x221949eb, 0x014fe9fe, 0x221bac9e, 0x0116c232, 0x221daf91,
+    0x00dd9757, 0x221f52be, 0x00a46a0e, 0x2220961f, 0x006b3af7, 0x222179b2, 0x00320ab4, 0x2221fd73,
+};
+
+/* post-twiddle: cos1sin1tabLD[2k], [2k+1] = (1/4) * (cos, sin)(pi * (k + 1/8) / n), format = Q31 */
+const int cos1sin1tabLD[512 + 480] PROGMEM = {
+    /* 512 */
+    0x1fffff62, 0x0006487f, 0x1fffce09, 0x00388c58, 0x1fff4dbc, 0x006acfa6, 0x1ffe7e7b, 0x009d11ec,
+    0x1ffd6049, 0x00cf52af, 0x1ffbf329, 0x01019172, 0x1ffa371e, 0x0133cdb9, 0x1ff82c2c, 0x01660709,
+    0x1ff5d259, 0x01983ce6, 0x1ff329aa, 0x01ca6ed4, 0x1ff03226, 0x01fc9c56, 0x1fecebd3, 0x022ec4f1,
+    0x1fe956bb, 0x0260e82a, 0x1fe572e7, 0x02930584, 0x1fe1405e, 0x02c51c84, 0x1fdcbf2d, 0x02f72caf,
+    0x1fd7ef5e, 0x03293588, 0x1fd2d0fc, 0x035b3695, 0x1fcd6416, 0x038d2f59, 0x1fc7a8b7, 0x03bf1f5b,
+    0x1fc19eef, 0x03f1061e, 0x1fbb46cb, 0x0422e327, 0x1fb4a05c, 0x0454b5fb, 0x1fadabb2, 0x04867e20,
+    0x1fa668df, 0x04b83b1a, 0x1f9ed7f4, 0x04e9ec70, 0x1f96f903, 0x051b91a5, 0x1f8ecc21, 0x054d2a40,
+    0x1f865161, 0x057eb5c7, 0x1f7d88d9, 0x05b033be, 0x1f74729d, 0x05e1a3ad, 0x1f6b0ec5, 0x06130518,
+    0x1f615d68, 0x06445787, 0x1f575e9d, 0x06759a7f, 0x1f4d127d, 0x06a6cd87, 0x1f427922, 0x06d7f026,
+    0x1f3792a6, 0x070901e2, 0x1f2c5f23, 0x073a0242, 0x1f20deb6, 0x076af0cd, 0x1f15117a, 0x079bcd0b,
+    0x1f08f78d, 0x07cc9683, 0x1efc910d, 0x07fd4cbc, 0x1eefde18, 0x082def3f, 0x1ee2decd, 0x085e7d94,
+    0x1ed5934e, 0x088ef742, 0x1ec7fbb9, 0x08bf5bd2, 0x1eba1832, 0x08efaacd, 0x1eabe8da, 0x091fe3bb,
+    0x1e9d6dd4, 0x09500625, 0x1e8ea744, 0x09801196, 0x1e7f954e, 0x09b00595, 0x1e703818, 0x09dfe1ad,
+    0x1e608fc8, 0x0a0fa568, 0x1e509c84, 0x0a3f5050, 0x1e405e73, 0x0a6ee1ef, 0x1e2fd5be, 0x0a9e59d0,
+    0x1e1f028e, 0x0acdb77e, 0x1e0de50b, 0x0afcfa83, 0x1dfc7d60, 0x0b2c226c, 0x1deacbb9, 0x0b5b2ec4,
+    0x1dd8d040, 0x0b8a1f17, 0x1dc68b22, 0x0bb8f2f0, 0x1db3fc8d, 0x0be7a9dd, 0x1da124ad, 0x0c16436b,
+    0x1d8e03b2, 0x0c44bf25, 0x1d7a99cb, 0x0c731c9a, 0x1d66e727, 0x0ca15b58, 0x1d52ebf7, 0x0ccf7aeb,
+    0x1d3ea86d, 0x0cfd7ae2, 0x1d2a1cba, 0x0d2b5acd, 0x1d154911, 0x0d591a38, 0x1d002da6, 0x0d86b8b5,
+    0x1ceacaad, 0x0db435d1, 0x1cd5205a, 0x0de1911e, 0x1cbf2ee3, 0x0e0eca2a, 0x1ca8f67e, 0x0e3be087,
+    0x1c927762, 0x0e68d3c5, 0x1c7bb1c6, 0x0e95a375, 0x1c64a5e2, 0x0ec24f29, 0x1c4d53f0, 0x0eeed672,
+    0x1c35bc29, 0x0f1b38e3, 0x1c1ddec7, 0x0f47760d, 0x1c05bc05, 0x0f738d85, 0x1bed541f, 0x0f9f7edd,
+    0x1bd4a750, 0x0fcb49a8, 0x1bbbb5d6, 0x0ff6ed7b, 0x1ba27fee, 0x102269ea, 0x1b8905d7, 0x104dbe8a,
+    0x1b6f47cf, 0x1078eaef, 0x1b554616, 0x10a3eeb0, 0x1b3b00ec, 0x10cec961, 0x1b207891, 0x10f97a9a,
+    0x1b05ad48, 0x112401f1, 0x1aea9f52, 0x114e5efd, 0x1acf4ef3, 0x11789156, 0x1ab3bc6d, 0x11a29893,
+    0x1a97e804, 0x11cc744c, 0x1a7bd1fe, 0x11f6241b, 0x1a5f7a9f, 0x121fa799, 0x1a42e22d, 0x1248fe5f,
+    0x1a2608f0, 0x12722807, 0x1a08ef2e, 0x129b242b, 0x19eb952e, 0x12c3f267, 0x19cdfb3b, 0x12ec9256,
+    0x19b0219b, 0x13150393, 0x1992089a, 0x133d45bb, 0x1973b081, 0x1365586b, 0x1955199b, 0x138d3b3f,
+    0x19364434, 0x13b4edd5, 0x19173098, 0x13dc6fcb, 0x18f7df13, 0x1403c0c1, 0x18d84ff3, 0x142ae053,
+    0x18b88386, 0x1451ce23, 0x18987a1a, 0x147889d0, 0x187833fd, 0x149f12fb, 0x1857b181, 0x14c56943,
+    0x1836f2f4, 0x14eb8c4c, 0x1815f8a9, 0x15117bb7, 0x17f4c2ef, 0x15373726, 0x17d35219, 0x155cbe3b,
+    0x17b1a67a, 0x1582109b, 0x178fc065, 0x15a72dea, 0x176da02d, 0x15cc15cb, 0x174b4626, 0x15f0c7e5,
+    0x1728b2a6, 0x161543db, 0x1705e601, 0x16398954, 0x16e2e08e, 0x165d97f8, 0x16bfa2a3, 0x16816f6b,
+    0x169c2c96, 0x16a50f58, 0x16787ec0, 0x16c87764, 0x16549978, 0x16eba73a, 0x16307d17, 0x170e9e81,
+    0x160c29f6, 0x17315ce5, 0x15e7a06e, 0x1753e20f, 0x15c2e0da, 0x17762daa, 0x159deb95, 0x17983f61,
+    0x1578c0fa, 0x17ba16e0, 0x15536163, 0x17dbb3d5, 0x152dcd2f, 0x17fd15eb, 0x150804b8, 0x181e3cd1,
+    0x14e2085d, 0x183f2835, 0x14bbd87c, 0x185fd7c5, 0x14957571, 0x18804b30, 0x146edf9d, 0x18a08228,
+    0x1448175f, 0x18c07c5c, 0x14211d15, 0x18e0397e, 0x13f9f121, 0x18ffb93e, 0x13d293e2, 0x191efb50,
+    0x13ab05bb, 0x193dff66, 0x1383470c, 0x195cc534, 0x135b5838, 0x197b4c6d, 0x133339a1, 0x199994c7,
+    0x130aebaa, 0x19b79df7, 0x12e26eb7, 0x19d567b2, 0x12b9c32c, 0x19f2f1b0, 0x1290e96c, 0x1a103ba7,
+    0x1267e1dd, 0x1a2d454e, 0x123eace4, 0x1a4a0e60, 0x12154ae7, 0x1a669693, 0x11ebbc4b, 0x1a82dda2,
+    0x11c20178, 0x1a9ee348, 0x11981ad4, 0x1abaa73e, 0x116e08c6, 0x1ad62941, 0x1143cbb7, 0x1af1690c,
+    0x1119640e, 0x1b0c665d, 0x10eed235, 0x1b2720f1, 0x10c41694, 0x1b419885, 0x10993195, 0x1b5bccd9,
+    0x106e23a1, 0x1b75bdac, 0x1042ed23, 0x1b8f6abe, 0x10178e86, 0x1ba8d3cf, 0x0fec0833, 0x1bc1f8a1,
+    0x0fc05a98, 0x1bdad8f6, 0x0f948620, 0x1bf37490, 0x0f688b36, 0x1c0bcb33, 0x0f3c6a47, 0x1c23dca3,
+    0x0f1023c1, 0x1c3ba8a4, 0x0ee3b810, 0x1c532efb, 0x0eb727a1, 0x1c6a6f6f, 0x0e8a72e4, 0x1c8169c5,
+    0x0e5d9a46, 0x1c981dc7, 0x0e309e36, 0x1cae8b3a, 0x0e037f23, 0x1cc4b1e9, 0x0dd63d7c, 0x1cda919c,
+    0x0da8d9b1, 0x1cf02a1e, 0x0d7b5432, 0x1d057b39, 0x0d4dad6f, 0x1d1a84b8, 0x0d1fe5d9, 0x1d2f4668,
+    0x0cf1fde1, 0x1d43c015, 0x0cc3f5f8, 0x1d57f18d, 0x0c95ce90, 0x1d6bda9f, 0x0c67881a, 0x1d7f7b18,
+    0x0c392309, 0x1d92d2c9, 0x0c0a9fcf, 0x1da5e181, 0x0bdbfedf, 0x1db8a713, 0x0bad40ab, 0x1dcb234e,
+    0x0b7e65a9, 0x1ddd5607, 0x0b4f6e4a, 0x1def3f10, 0x0b205b03, 0x1e00de3c, 0x0af12c48, 0x1e123361,
+    0x0ac1e28e, 0x1e233e53, 0x0a927e48, 0x1e33fee9, 0x0a62ffed, 0x1e4474f8, 0x0a3367f0, 0x1e54a05a,
+    0x0a03b6c9, 0x1e6480e5, 0x09d3eceb, 0x1e741672, 0x09a40ace, 0x1e8360db, 0x097410e8, 0x1e925ffb,
+    0x0943ffae, 0x1ea113ac, 0x0913d797, 0x1eaf7bc9, 0x08e3991b, 0x1ebd9831, 0x08b344af, 0x1ecb68be,
+    0x0882dacd, 0x1ed8ed51, 0x08525bea, 0x1ee625c6, 0x0821c87e, 0x1ef311fe, 0x07f12102, 0x1effb1d9,
+    0x07c065ee, 0x1f0c0538, 0x078f97b9, 0x1f180bfb, 0x075eb6dd, 0x1f23c606, 0x072dc3d1, 0x1f2f333b,
+    0x06fcbf0e, 0x1f3a537f, 0x06cba90f, 0x1f4526b5, 0x069a824a, 0x1f4facc4, 0x06694b3b, 0x1f59e591,
+    0x0638045a, 0x1f63d102, 0x0606ae20, 0x1f6d6f01, 0x05d54909, 0x1f76bf74, 0x05a3d58c, 0x1f7fc244,
+    0x05725426, 0x1f88775d, 0x0540c54f, 0x1f90dea7, 0x050f2981, 0x1f98f80f, 0x04dd8139, 0x1fa0c380,
+    0x04abccef, 0x1fa840e7, 0x047a0d1e, 0x1faf7031, 0x04484242, 0x1fb6514e, 0x04166cd5, 0x1fbce42c,
+    0x03e48d51, 0x1fc328ba, 0x03b2a433, 0x1fc91ee9, 0x0380b1f6, 0x1fcec6ab, 0x034eb713, 0x1fd41ff2,
+    0x031cb408, 0x1fd92ab0, 0x02eaa94f, 0x1fdde6d8, 0x02b89763, 0x1fe25461, 0x02867ec1, 0x1fe6733d,
+    0x02545fe4, 0x1fea4364, 0x02223b47, 0x1fedc4cb, 0x01f01166, 0x1ff0f76a, 0x01bde2bd, 0x1ff3db3a,
+    0x018bafc9, 0x1ff67033, 0x01597903, 0x1ff8b64e, 0x01273eea, 0x1ffaad86, 0x00f501f8, 0x1ffc55d7,
+    0x00c2c2a9, 0x1ffdaf3c, 0x0090817a, 0x1ffeb9b2, 0x005e3ee6, 0x1fff7536, 0x002bfb6a, 0x1fffe1c6,
+    /* 480 */
+    0x1fffff4c, 0x0006b3ba, 0x1fffc727, 0x003c516b, 0x1fff352c, 0x0071ee72, 0x1ffe495e, 0x00a78a39,
+    0x1ffd03bf, 0x00dd2429, 0x1ffb6452, 0x0112bbad, 0x1ff96b1d, 0x0148502e, 0x1ff71824, 0x017de115,
+    0x1ff46b6e, 0x01b36dcc, 0x1ff16504, 0x01e8f5bc, 0x1fee04ec, 0x021e7850, 0x1fea4b31, 0x0253f4f1,
+    0x1fe637de, 0x02896b09, 0x1fe1cafd, 0x02beda01, 0x1fdd049b, 0x02f44145, 0x1fd7e4c5, 0x0329a03d,
+    0x1fd26b8b, 0x035ef655, 0x1fcc98fa, 0x039442f6, 0x1fc66d24, 0x03c9858b, 0x1fbfe81a, 0x03febd7d,
+    0x1fb909ee, 0x0433ea39, 0x1fb1d2b4, 0x04690b28, 0x1faa427f, 0x049e1fb6, 0x1fa25965, 0x04d3274d,
+    0x1f9a177d, 0x05082159, 0x1f917cdc, 0x053d0d44, 0x1f88899c, 0x0571ea7a, 0x1f7f3dd6, 0x05a6b868,
+    0x1f7599a4, 0x05db7678, 0x1f6b9d20, 0x06102416, 0x1f614867, 0x0644c0af, 0x1f569b96, 0x06794baf,
+    0x1f4b96ca, 0x06adc482, 0x1f403a24, 0x06e22a95, 0x1f3485c2, 0x07167d56, 0x1f2879c5, 0x074abc30,
+    0x1f1c1650, 0x077ee692, 0x1f0f5b85, 0x07b2fbe9, 0x1f024987, 0x07e6fba3, 0x1ef4e07c, 0x081ae52d,
+    0x1ee7208a, 0x084eb7f6, 0x1ed909d6, 0x0882736d, 0x1eca9c88, 0x08b61701, 0x1ebbd8c9, 0x08e9a220,
+    0x1eacbec2, 0x091d1439, 0x1e9d4e9e, 0x09506cbd, 0x1e8d8888, 0x0983ab1b, 0x1e7d6cac, 0x09b6cec3,
+    0x1e6cfb38, 0x09e9d725, 0x1e5c3459, 0x0a1cc3b3, 0x1e4b183f, 0x0a4f93de, 0x1e39a71a, 0x0a824716,
+    0x1e27e11b, 0x0ab4dcce, 0x1e15c673, 0x0ae75477, 0x1e035756, 0x0b19ad84, 0x1df093f7, 0x0b4be768,
+    0x1ddd7c8b, 0x0b7e0195, 0x1dca1147, 0x0baffb7e, 0x1db65262, 0x0be1d499, 0x1da24014, 0x0c138c57,
+    0x1d8dda95, 0x0c45222f, 0x1d79221d, 0x0c769594, 0x1d6416e8, 0x0ca7e5fd, 0x1d4eb930, 0x0cd912dd,
+    0x1d390931, 0x0d0a1bad, 0x1d230729, 0x0d3affe1, 0x1d0cb354, 0x0d6bbef0, 0x1cf60df2, 0x0d9c5853,
+    0x1cdf1743, 0x0dcccb7f, 0x1cc7cf86, 0x0dfd17ee, 0x1cb036fd, 0x0e2d3d17, 0x1c984dea, 0x0e5d3a74,
+    0x1c801491, 0x0e8d0f7e, 0x1c678b35, 0x0ebcbbae, 0x1c4eb21b, 0x0eec3e7e, 0x1c358989, 0x0f1b976a,
+    0x1c1c11c6, 0x0f4ac5ed, 0x1c024b19, 0x0f79c981, 0x1be835cb, 0x0fa8a1a3, 0x1bcdd224, 0x0fd74dd0,
+    0x1bb32070, 0x1005cd83, 0x1b9820f8, 0x1034203c, 0x1b7cd408, 0x10624578, 0x1b6139ee, 0x10903cb4,
+    0x1b4552f6, 0x10be0571, 0x1b291f70, 0x10eb9f2e, 0x1b0c9fa9, 0x1119096a, 0x1aefd3f3, 0x114643a6,
+    0x1ad2bc9e, 0x11734d64, 0x1ab559fc, 0x11a02624, 0x1a97ac5f, 0x11cccd69, 0x1a79b41a, 0x11f942b6,
+    0x1a5b7182, 0x1225858d, 0x1a3ce4eb, 0x12519573, 0x1a1e0eac, 0x127d71eb, 0x19feef1b, 0x12a91a7b,
+    0x19df868f, 0x12d48ea9, 0x19bfd561, 0x12ffcdf9, 0x199fdbe9, 0x132ad7f2, 0x197f9a82, 0x1355ac1d,
+    0x195f1185, 0x13804a00, 0x193e414e, 0x13aab124, 0x191d2a39, 0x13d4e112, 0x18fbcca4, 0x13fed953,
+    0x18da28eb, 0x14289972, 0x18b83f6e, 0x145220fa, 0x1896108b, 0x147b6f75, 0x18739ca2, 0x14a48470,
+    0x1850e415, 0x14cd5f78, 0x182de744, 0x14f60019, 0x180aa692, 0x151e65e3, 0x17e72262, 0x15469062,
+    0x17c35b17, 0x156e7f28, 0x179f5116, 0x159631c2, 0x177b04c4, 0x15bda7c3, 0x17567687, 0x15e4e0bb,
+    0x1731a6c6, 0x160bdc3d, 0x170c95e8, 0x163299da, 0x16e74455, 0x16591926, 0x16c1b276, 0x167f59b5,
+    0x169be0b3, 0x16a55b1b, 0x1675cf79, 0x16cb1cef, 0x164f7f30, 0x16f09ec5, 0x1628f046, 0x1715e035,
+    0x16022326, 0x173ae0d5, 0x15db183c, 0x175fa03f, 0x15b3cff7, 0x17841e0b, 0x158c4ac6, 0x17a859d2,
+    0x15648916, 0x17cc532f, 0x153c8b57, 0x17f009bc, 0x151451fb, 0x18137d16, 0x14ebdd71, 0x1836acd9,
+    0x14c32e2b, 0x185998a2, 0x149a449c, 0x187c4010, 0x14712136, 0x189ea2c0, 0x1447c46c, 0x18c0c052,
+    0x141e2eb4, 0x18e29868, 0x13f46082, 0x19042aa0, 0x13ca5a4a, 0x1925769e, 0x13a01c83, 0x19467c04,
+    0x1375a7a4, 0x19673a75, 0x134afc24, 0x1987b195, 0x13201a7b, 0x19a7e109, 0x12f50320, 0x19c7c877,
+    0x12c9b68d, 0x19e76785, 0x129e353c, 0x1a06bdda, 0x12727fa6, 0x1a25cb1f, 0x12469647, 0x1a448efc,
+    0x121a7999, 0x1a63091b, 0x11ee2a19, 0x1a813926, 0x11c1a842, 0x1a9f1ec9, 0x1194f493, 0x1abcb9af,
+    0x11680f87, 0x1ada0986, 0x113af99e, 0x1af70dfb, 0x110db356, 0x1b13c6bd, 0x10e03d2e, 0x1b30337a,
+    0x10b297a5, 0x1b4c53e5, 0x1084c33c, 0x1b6827ac, 0x1056c074, 0x1b83ae83, 0x10288fcd, 0x1b9ee81c,
+    0x0ffa31c9, 0x1bb9d42a, 0x0fcba6eb, 0x1bd47262, 0x0f9cefb4, 0x1beec27a, 0x0f6e0ca9, 0x1c08c426,
+    0x0f3efe4d, 0x1c227720, 0x0f0fc524, 0x1c3bdb1d, 0x0ee061b3, 0x1c54efd7, 0x0eb0d47d, 0x1c6db508,
+    0x0e811e0a, 0x1c862a6a, 0x0e513edf, 0x1c9e4fb8, 0x0e213783, 0x1cb624ae, 0x0df1087b, 0x1ccda90b,
+    0x0dc0b250, 0x1ce4dc8a, 0x0d90358a, 0x1cfbbeed, 0x0d5f92af, 0x1d124ff1, 0x0d2eca4a, 0x1d288f59,
+    0x0cfddce2, 0x1d3e7ce4, 0x0ccccb02, 0x1d541857, 0x0c9b9532, 0x1d696174, 0x0c6a3bfd, 0x1d7e57ff,
+    0x0c38bfee, 0x1d92fbbe, 0x0c072190, 0x1da74c76, 0x0bd5616d, 0x1dbb49ef, 0x0ba38012, 0x1dcef3f1,
+    0x0b717e0a, 0x1de24a44, 0x0b3f5be3, 0x1df54cb2, 0x0b0d1a27, 0x1e07fb05, 0x0adab966, 0x1e1a550a,
+    0x0aa83a2c, 0x1e2c5a8c, 0x0a759d07, 0x1e3e0b5a, 0x0a42e284, 0x1e4f6741, 0x0a100b34, 0x1e606e10,
+    0x09dd17a3, 0x1e711f99, 0x09aa0861, 0x1e817bab, 0x0976ddff, 0x1e91821a, 0x0943990a, 0x1ea132b8,
+    0x09103a13, 0x1eb08d58, 0x08dcc1ab, 0x1ebf91d1, 0x08a93061, 0x1ece3ff7, 0x087586c7, 0x1edc97a3,
+    0x0841c56e, 0x1eea98aa, 0x080dece7, 0x1ef842e6, 0x07d9fdc3, 0x1f059631, 0x07a5f894, 0x1f129266,
+    0x0771dded, 0x1f1f375f, 0x073dae5f, 0x1f2b84f9, 0x07096a7d, 0x1f377b12, 0x06d512db, 0x1f431988,
+    0x06a0a809, 0x1f4e603b, 0x066c2a9d, 0x1f594f0b, 0x06379b29, 0x1f63e5d9, 0x0602fa41, 0x1f6e2487,
+    0x05ce4878, 0x1f780af9, 0x05998663, 0x1f819913, 0x0564b496, 0x1f8aceba, 0x052fd3a4, 0x1f93abd4,
+    0x04fae423, 0x1f9c3049, 0x04c5e6a7, 0x1fa45c00, 0x0490dbc4, 0x1fac2ee3, 0x045bc410, 0x1fb3a8db,
+    0x0426a020, 0x1fbac9d3, 0x03f17088, 0x1fc191b9, 0x03bc35df, 0x1fc80077, 0x0386f0b9, 0x1fce15fd,
+    0x0351a1ac, 0x1fd3d23a, 0x031c494e, 0x1fd9351d, 0x02e6e835, 0x1fde3e97, 0x02b17ef6, 0x1fe2ee9a,
+    0x027c0e28, 0x1fe74518, 0x02469660, 0x1feb4207, 0x02111834, 0x1feee55a, 0x01db943b, 0x1ff22f07,
+    0x01a60b0b, 0x1ff51f05, 0x01707d3a, 0x1ff7b54c, 0x013aeb5e, 0x1ff9f1d4, 0x0105560f, 0x1ffbd498,
+    0x00cfbde1, 0x1ffd5d92, 0x009a236d, 0x1ffe8cbd, 0x00648748, 0x1fff6217, 0x002eea09, 0x1fffdd9c,
+};
+
+/* FFT twiddles: twidTabLD[2j], [2j+1] = (cos, sin)(2 * pi * j / (n/2)), j = [0, n/2), format = Q31 */
+const uint32_t twidTabLD[512 + 480] PROGMEM = {
+    /* 512 */
+    0x7fffffff, 0x00000000, 0x7ff62182, 0x03242abf, 0x7fd8878e, 0x0647d97c, 0x7fa736b4, 0x096a9049,
+    0x7f62368f, 0x0c8bd35e, 0x7f0991c4, 0x0fab272b, 0x7e9d55fc, 0x12c8106f, 0x7e1d93ea, 0x15e21445,
+    0x7d8a5f40, 0x18f8b83c, 0x7ce3ceb2, 0x1c0b826a, 0x7c29fbee, 0x1f19f97b, 0x7b5d039e, 0x2223a4c5,
+    0x7a7d055b, 0x25280c5e, 0x798a23b1, 0x2826b928, 0x78848414, 0x2b1f34eb, 0x776c4edb, 0x2e110a62,
+    0x7641af3d, 0x30fbc54d, 0x7504d345, 0x33def287, 0x73b5ebd1, 0x36ba2014, 0x72552c85, 0x398cdd32,
+    0x70e2cbc6, 0x3c56ba70, 0x6f5f02b2, 0x3f1749b8, 0x6dca0d14, 0x41ce1e65, 0x6c242960, 0x447acd50,
+    0x6a6d98a4, 0x471cece7, 0x68a69e81, 0x49b41533, 0x66cf8120, 0x4c3fdff4, 0x64e88926, 0x4ebfe8a5,
+    0x62f201ac, 0x5133cc94, 0x60ec3830, 0x539b2af0, 0x5ed77c8a, 0x55f5a4d2, 0x5cb420e0, 0x5842dd54,
+    0x5a82799a, 0x5a82799a, 0x5842dd54, 0x5cb420e0, 0x55f5a4d2, 0x5ed77c8a, 0x539b2af0, 0x60ec3830,
+    0x5133cc94, 0x62f201ac, 0x4ebfe8a5, 0x64e88926, 0x4c3fdff4, 0x66cf8120, 0x49b41533, 0x68a69e81,
+    0x471cece7, 0x6a6d98a4, 0x447acd50, 0x6c242960, 0x41ce1e65, 0x6dca0d14, 0x3f1749b8, 0x6f5f02b2,
+    0x3c56ba70, 0x70e2cbc6, 0x398cdd32, 0x72552c85, 0x36ba2014, 0x73b5ebd1, 0x33def287, 0x7504d345,
+    0x30fbc54d, 0x7641af3d, 0x2e110a62, 0x776c4edb, 0x2b1f34eb, 0x78848414, 0x2826b928, 0x798a23b1,
+    0x25280c5e, 0x7a7d055b, 0x2223a4c5, 0x7b5d039e, 0x1f19f97b, 0x7c29fbee, 0x1c0b826a, 0x7ce3ceb2,
+    0x18f8b83c, 0x7d8a5f40, 0x15e21445, 0x7e1d93ea, 0x12c8106f, 0x7e9d55fc, 0x0fab272b, 0x7f0991c4,
+    0x0c8bd35e, 0x7f62368f, 0x096a9049, 0x7fa736b4, 0x0647d97c, 0x7fd8878e, 0x03242abf, 0x7ff62182,
+    0x00000000, 0x7fffffff, 0xfcdbd541, 0x7ff62182, 0xf9b82684, 0x7fd8878e, 0xf6956fb7, 0x7fa736b4,
+    0xf3742ca2, 0x7f62368f, 0xf054d8d5, 0x7f0991c4, 0xed37ef91, 0x7e9d55fc, 0xea1debbb, 0x7e1d93ea,
+    0xe70747c4, 0x7d8a5f40, 0xe3f47d96, 0x7ce3ceb2, 0xe0e60685, 0x7c29fbee, 0xdddc5b3b, 0x7b5d039e,
+    0xdad7f3a2, 0x7a7d055b, 0xd7d946d8, 0x798a23b1, 0xd4e0cb15, 0x78848414, 0xd1eef59e, 0x776c4edb,
+    0xcf043ab3, 0x7641af3d, 0xcc210d79, 0x7504d345, 0xc945dfec, 0x73b5ebd1, 0xc67322ce, 0x72552c85,
+    0xc3a94590, 0x70e2cbc6, 0xc0e8b648, 0x6f5f02b2, 0xbe31e19b, 0x6dca0d14, 0xbb8532b0, 0x6c242960,
+    0xb8e31319, 0x6a6d98a4, 0xb64beacd, 0x68a69e81, 0xb3c0200c, 0x66cf8120, 0xb140175b, 0x64e88926,
+    0xaecc336c, 0x62f201ac, 0xac64d510, 0x60ec3830, 0xaa0a5b2e, 0x5ed77c8a, 0xa7bd22ac, 0x5cb420e0,
+    0xa57d8666, 0x5a82799a, 0xa34bdf20, 0x5842dd54, 0xa1288376, 0x55f5a4d2, 0x9f13c7d0, 0x539b2af0,
+    0x9d0dfe54, 0x5133cc94, 0x9b1776da, 0x4ebfe8a5, 0x99307ee0, 0x4c3fdff4, 0x9759617f, 0x49b41533,
+    0x9592675c, 0x471cece7, 0x93dbd6a0, 0x447acd50, 0x9235f2ec, 0x41ce1e65, 0x90a0fd4e, 0x3f1749b8,
+    0x8f1d343a, 0x3c56ba70, 0x8daad37b, 0x398cdd32, 0x8c4a142f, 0x36ba2014, 0x8afb2cbb, 0x33def287,
+    0x89be50c3, 0x30fbc54d, 0x8893b125, 0x2e110a62, 0x877b7bec, 0x2b1f34eb, 0x8675dc4f, 0x2826b928,
+    0x8582faa5, 0x25280c5e, 0x84a2fc62, 0x2223a4c5, 0x83d60412, 0x1f19f97b, 0x831c314e, 0x1c0b826a,
+    0x8275a0c0, 0x18f8b83c, 0x81e26c16, 0x15e21445, 0x8162aa04, 0x12c8106f, 0x80f66e3c, 0x0fab272b,
+    0x809dc971, 0x0c8bd35e, 0x8058c94c, 0x096a9049, 0x80277872, 0x0647d97c, 0x8009de7e, 0x03242abf,
+    0x80000000, 0x00000000, 0x8009de7e, 0xfcdbd541, 0x80277872, 0xf9b82684, 0x8058c94c, 0xf6956fb7,
+    0x809dc971, 0xf3742ca2, 0x80f66e3c, 0xf054d8d5, 0x8162aa04, 0xed37ef91, 0x81e26c16, 0xea1debbb,
+    0x8275a0c0, 0xe70747c4, 0x831c314e, 0xe3f47d96, 0x83d60412, 0xe0e60685, 0x84a2fc62, 0xdddc5b3b,
+    0x8582faa5, 0xdad7f3a2, 0x8675dc4f, 0xd7d946d8, 0x877b7bec, 0xd4e0cb15, 0x8893b125, 0xd1eef59e,
+    0x89be50c3, 0xcf043ab3, 0x8afb2cbb, 0xcc210d79, 0x8c4a142f, 0xc945dfec, 0x8daad37b, 0xc67322ce,
+    0x8f1d343a, 0xc3a94590, 0x90a0fd4e, 0xc0e8b648, 0x9235f2ec, 0xbe31e19b, 0x93dbd6a0, 0xbb8532b0,
+    0x9592675c, 0xb8e31319, 0x9759617f, 0xb64beacd, 0x99307ee0, 0xb3c0200c, 0x9b1776da, 0xb140175b,
+    0x9d0dfe54, 0xaecc336c, 0x9f13c7d0, 0xac64d510, 0xa1288376, 0xaa0a5b2e, 0xa34bdf20, 0xa7bd22ac,
+    0xa57d8666, 0xa57d8666, 0xa7bd22ac, 0xa34bdf20, 0xaa0a5b2e, 0xa1288376, 0xac64d510, 0x9f13c7d0,
+    0xaecc336c, 0x9d0dfe54, 0xb140175b, 0x9b1776da, 0xb3c0200c, 0x99307ee0, 0xb64beacd, 0x9759617f,
+    0xb8e31319, 0x9592675c, 0xbb8532b0, 0x93dbd6a0, 0xbe31e19b, 0x9235f2ec, 0xc0e8b648, 0x90a0fd4e,
+    0xc3a94590, 0x8f1d343a, 0xc67322ce, 0x8daad37b, 0xc945dfec, 0x8c4a142f, 0xcc210d79, 0x8afb2cbb,
+    0xcf043ab3, 0x89be50c3, 0xd1eef59e, 0x8893b125, 0xd4e0cb15, 0x877b7bec, 0xd7d946d8, 0x8675dc4f,
+    0xdad7f3a2, 0x8582faa5, 0xdddc5b3b, 0x84a2fc62, 0xe0e60685, 0x83d60412, 0xe3f47d96, 0x831c314e,
+    0xe70747c4, 0x8275a0c0, 0xea1debbb, 0x81e26c16, 0xed37ef91, 0x8162aa04, 0xf054d8d5, 0x80f66e3c,
+    0xf3742ca2, 0x809dc971, 0xf6956fb7, 0x8058c94c, 0xf9b82684, 0x80277872, 0xfcdbd541, 0x8009de7e,
+    0x00000000, 0x80000000, 0x03242abf, 0x8009de7e, 0x0647d97c, 0x80277872, 0x096a9049, 0x8058c94c,
+    0x0c8bd35e, 0x809dc971, 0x0fab272b, 0x80f66e3c, 0x12c8106f, 0x8162aa04, 0x15e21445, 0x81e26c16,
+    0x18f8b83c, 0x8275a0c0, 0x1c0b826a, 0x831c314e, 0x1f19f97b, 0x83d60412, 0x2223a4c5, 0x84a2fc62,
+    0x25280c5e, 0x8582faa5, 0x2826b928, 0x8675dc4f, 0x2b1f34eb, 0x877b7bec, 0x2e110a62, 0x8893b125,
+    0x30fbc54d, 0x89be50c3, 0x33def287, 0x8afb2cbb, 0x36ba2014, 0x8c4a142f, 0x398cdd32, 0x8daad37b,
+    0x3c56ba70, 0x8f1d343a, 0x3f1749b8, 0x90a0fd4e, 0x41ce1e65, 0x9235f2ec, 0x447acd50, 0x93dbd6a0,
+    0x471cece7, 0x9592675c, 0x49b41533, 0x9759617f, 0x4c3fdff4, 0x99307ee0, 0x4ebfe8a5, 0x9b1776da,
+    0x5133cc94, 0x9d0dfe54, 0x539b2af0, 0x9f13c7d0, 0x55f5a4d2, 0xa1288376, 0x5842dd54, 0xa34bdf20,
+    0x5a82799a, 0xa57d8666, 0x5cb420e0, 0xa7bd22ac, 0x5ed77c8a, 0xaa0a5b2e, 0x60ec3830, 0xac64d510,
+    0x62f201ac, 0xaecc336c, 0x64e88926, 0xb140175b, 0x66cf8120, 0xb3c0200c, 0x68a69e81, 0xb64beacd,
+    0x6a6d98a4, 0xb8e31319, 0x6c242960, 0xbb8532b0, 0x6dca0d14, 0xbe31e19b, 0x6f5f02b2, 0xc0e8b648,
+    0x70e2cbc6, 0xc3a94590, 0x72552c85, 0xc67322ce, 0x73b5ebd1, 0xc945dfec, 0x7504d345, 0xcc210d79,
+    0x7641af3d, 0xcf043ab3, 0x776c4edb, 0xd1eef59e, 0x78848414, 0xd4e0cb15, 0x798a23b1, 0xd7d946d8,
+    0x7a7d055b, 0xdad7f3a2, 0x7b5d039e, 0xdddc5b3b, 0x7c29fbee, 0xe0e60685, 0x7ce3ceb2, 0xe3f47d96,
+    0x7d8a5f40, 0xe70747c4, 0x7e1d93ea, 0xea1debbb, 0x7e9d55fc, 0xed37ef91, 0x7f0991c4, 0xf054d8d5,
+    0x7f62368f, 0xf3742ca2, 0x7fa736b4, 0xf6956fb7, 0x7fd8878e, 0xf9b82684, 0x7ff62182, 0xfcdbd541,
+    /* 480 */
+    0x7fffffff, 0x00000000, 0x7ff4c56f, 0x0359c428, 0x7fd317b4, 0x06b2f1d2, 0x7f9afcb9, 0x0a0af299,
+    0x7f4c7e54, 0x0d61304e, 0x7ee7aa4c, 0x10b5150f, 0x7e6c9251, 0x14060b68, 0x7ddb4bfc, 0x17537e63,
+    0x7d33f0ca, 0x1a9cd9ac, 0x7c769e18, 0x1de189a6, 0x7ba3751d, 0x2120fb83, 0x7aba9ae6, 0x245a9d65,
+    0x79bc384d, 0x278dde6e, 0x78a879f4, 0x2aba2ee4, 0x777f903c, 0x2ddf0040, 0x7641af3d, 0x30fbc54d,
+    0x74ef0ebc, 0x340ff242, 0x7387ea23, 0x371afcd5, 0x720c8075, 0x3a1c5c57, 0x707d1443, 0x3d1389cb,
+    0x6ed9eba1, 0x40000000, 0x6d23501b, 0x42e13ba4, 0x6b598ea3, 0x45b6bb5e, 0x697cf78a, 0x487fffe4,
+    0x678dde6e, 0x4b3c8c12, 0x658c9a2d, 0x4debe4fe, 0x637984d4, 0x508d9211, 0x6154fb91, 0x53211d18,
+    0x5f1f5ea1, 0x55a6125c, 0x5cd91140, 0x581c00b3, 0x5a82799a, 0x5a82799a, 0x581c00b3, 0x5cd91140,
+    0x55a6125c, 0x5f1f5ea1, 0x53211d18, 0x6154fb91, 0x508d9211, 0x637984d4, 0x4debe4fe, 0x658c9a2d,
+    0x4b3c8c12, 0x678dde6e, 0x487fffe4, 0x697cf78a, 0x45b6bb5e, 0x6b598ea3, 0x42e13ba4, 0x6d23501b,
+    0x40000000, 0x6ed9eba1, 0x3d1389cb, 0x707d1443, 0x3a1c5c57, 0x720c8075, 0x371afcd5, 0x7387ea23,
+    0x340ff242, 0x74ef0ebc, 0x30fbc54d, 0x7641af3d, 0x2ddf0040, 0x777f903c, 0x2aba2ee4, 0x78a879f4,
+    0x278dde6e, 0x79bc384d, 0x245a9d65, 0x7aba9ae6, 0x2120fb83, 0x7ba3751d, 0x1de189a6, 0x7c769e18,
+    0x1a9cd9ac, 0x7d33f0ca, 0x17537e63, 0x7ddb4bfc, 0x14060b68, 0x7e6c9251, 0x10b5150f, 0x7ee7aa4c,
+    0x0d61304e, 0x7f4c7e54, 0x0a0af299, 0x7f9afcb9, 0x06b2f1d2, 0x7fd317b4, 0x0359c428, 0x7ff4c56f,
+    0x00000000, 0x7fffffff, 0xfca63bd8, 0x7ff4c56f, 0xf94d0e2e, 0x7fd317b4, 0xf5f50d67, 0x7f9afcb9,
+    0xf29ecfb2, 0x7f4c7e54, 0xef4aeaf1, 0x7ee7aa4c, 0xebf9f498, 0x7e6c9251, 0xe8ac819d, 0x7ddb4bfc,
+    0xe5632654, 0x7d33f0ca, 0xe21e765a, 0x7c769e18, 0xdedf047d, 0x7ba3751d, 0xdba5629b, 0x7aba9ae6,
+    0xd8722192, 0x79bc384d, 0xd545d11c, 0x78a879f4, 0xd220ffc0, 0x777f903c, 0xcf043ab3, 0x7641af3d,
+    0xcbf00dbe, 0x74ef0ebc, 0xc8e5032b, 0x7387ea23, 0xc5e3a3a9, 0x720c8075, 0xc2ec7635, 0x707d1443,
+    0xc0000000, 0x6ed9eba1, 0xbd1ec45c, 0x6d23501b, 0xba4944a2, 0x6b598ea3, 0xb780001c, 0x697cf78a,
+    0xb4c373ee, 0x678dde6e, 0xb2141b02, 0x658c9a2d, 0xaf726def, 0x637984d4, 0xacdee2e8, 0x6154fb91,
+    0xaa59eda4, 0x5f1f5ea1, 0xa7e3ff4d, 0x5cd91140, 0xa57d8666, 0x5a82799a, 0xa326eec0, 0x581c00b3,
+    0xa0e0a15f, 0x55a6125c, 0x9eab046f, 0x53211d18, 0x9c867b2c, 0x508d9211, 0x9a7365d3, 0x4debe4fe,
+    0x98722192, 0x4b3c8c12, 0x96830876, 0x487fffe4, 0x94a6715d, 0x45b6bb5e, 0x92dcafe5, 0x42e13ba4,
+    0x9126145f, 0x40000000, 0x8f82ebbd, 0x3d1389cb, 0x8df37f8b, 0x3a1c5c57, 0x8c7815dd, 0x371afcd5,
+    0x8b10f144, 0x340ff242, 0x89be50c3, 0x30fbc54d, 0x88806fc4, 0x2ddf0040, 0x8757860c, 0x2aba2ee4,
+    0x8643c7b3, 0x278dde6e, 0x8545651a, 0x245a9d65, 0x845c8ae3, 0x2120fb83, 0x838961e8, 0x1de189a6,
+    0x82cc0f36, 0x1a9cd9ac, 0x8224b404, 0x17537e63, 0x81936daf, 0x14060b68, 0x811855b4, 0x10b5150f,
+    0x80b381ac, 0x0d61304e, 0x80650347, 0x0a0af299, 0x802ce84c, 0x06b2f1d2, 0x800b3a91, 0x0359c428,
+    0x80000000, 0x00000000, 0x800b3a91, 0xfca63bd8, 0x802ce84c, 0xf94d0e2e, 0x80650347, 0xf5f50d67,
+    0x80b381ac, 0xf29ecfb2, 0x811855b4, 0xef4aeaf1, 0x81936daf, 0xebf9f498, 0x8224b404, 0xe8ac819d,
+    0x82cc0f36, 0xe5632654, 0x838961e8, 0xe21e765a, 0x845c8ae3, 0xdedf047d, 0x8545651a, 0xdba5629b,
+    0x8643c7b3, 0xd8722192, 0x8757860c, 0xd545d11c, 0x88806fc4, 0xd220ffc0, 0x89be50c3, 0xcf043ab3,
+    0x8b10f144, 0xcbf00dbe, 0x8c7815dd, 0xc8e5032b, 0x8df37f8b, 0xc5e3a3a9, 0x8f82ebbd, 0xc2ec7635,
+    0x9126145f, 0xc0000000, 0x92dcafe5, 0xbd1ec45c, 0x94a6715d, 0xba4944a2, 0x96830876, 0xb780001c,
+    0x98722192, 0xb4c373ee, 0x9a7365d3, 0xb2141b02, 0x9c867b2c, 0xaf726def, 0x9eab046f, 0xacdee2e8,
+    0xa0e0a15f, 0xaa59eda4, 0xa326eec0, 0xa7e3ff4d, 0xa57d8666, 0xa57d8666, 0xa7e3ff4d, 0xa326eec0,
+    0xaa59eda4, 0xa0e0a15f, 0xacdee2e8, 0x9eab046f, 0xaf726def, 0x9c867b2c, 0xb2141b02, 0x9a7365d3,
+    0xb4c373ee, 0x98722192, 0xb780001c, 0x96830876, 0xba4944a2, 0x94a6715d, 0xbd1ec45c, 0x92dcafe5,
+    0xc0000000, 0x9126145f, 0xc2ec7635, 0x8f82ebbd, 0xc5e3a3a9, 0x8df37f8b, 0xc8e5032b, 0x8c7815dd,
+    0xcbf00dbe, 0x8b10f144, 0xcf043ab3, 0x89be50c3, 0xd220ffc0, 0x88806fc4, 0xd545d11c, 0x8757860c,
+    0xd8722192, 0x8643c7b3, 0xdba5629b, 0x8545651a, 0xdedf047d, 0x845c8ae3, 0xe21e765a, 0x838961e8,
+    0xe5632654, 0x82cc0f36, 0xe8ac819d, 0x8224b404, 0xebf9f498, 0x81936daf, 0xef4aeaf1, 0x811855b4,
+    0xf29ecfb2, 0x80b381ac, 0xf5f50d67, 0x80650347, 0xf94d0e2e, 0x802ce84c, 0xfca63bd8, 0x800b3a91,
+    0x00000000, 0x80000000, 0x0359c428, 0x800b3a91, 0x06b2f1d2, 0x802ce84c, 0x0a0af299, 0x80650347,
+    0x0d61304e, 0x80b381ac, 0x10b5150f, 0x811855b4, 0x14060b68, 0x81936daf, 0x17537e63, 0x8224b404,
+    0x1a9cd9ac, 0x82cc0f36, 0x1de189a6, 0x838961e8, 0x2120fb83, 0x845c8ae3, 0x245a9d65, 0x8545651a,
+    0x278dde6e, 0x8643c7b3, 0x2aba2ee4, 0x8757860c, 0x2ddf0040, 0x88806fc4, 0x30fbc54d, 0x89be50c3,
+    0x340ff242, 0x8b10f144, 0x371afcd5, 0x8c7815dd, 0x3a1c5c57, 0x8df37f8b, 0x3d1389cb, 0x8f82ebbd,
+    0x40000000, 0x9126145f, 0x42e13ba4, 0x92dcafe5, 0x45b6bb5e, 0x94a6715d, 0x487fffe4, 0x96830876,
+    0x4b3c8c12, 0x98722192, 0x4debe4fe, 0x9a7365d3, 0x508d9211, 0x9c867b2c, 0x53211d18, 0x9eab046f,
+    0x55a6125c, 0xa0e0a15f, 0x581c00b3, 0xa326eec0, 0x5a82799a, 0xa57d8666, 0x5cd91140, 0xa7e3ff4d,
+    0x5f1f5ea1, 0xaa59eda4, 0x6154fb91, 0xacdee2e8, 0x637984d4, 0xaf726def, 0x658c9a2d, 0xb2141b02,
+    0x678dde6e, 0xb4c373ee, 0x697cf78a, 0xb780001c, 0x6b598ea3, 0xba4944a2, 0x6d23501b, 0xbd1ec45c,
+    0x6ed9eba1, 0xc0000000, 0x707d1443, 0xc2ec7635, 0x720c8075, 0xc5e3a3a9, 0x7387ea23, 0xc8e5032b,
+    0x74ef0ebc, 0xcbf00dbe, 0x7641af3d, 0xcf043ab3, 0x777f903c, 0xd220ffc0, 0x78a879f4, 0xd545d11c,
+    0x79bc384d, 0xd8722192, 0x7aba9ae6, 0xdba5629b, 0x7ba3751d, 0xdedf047d, 0x7c769e18, 0xe21e765a,
+    0x7d33f0ca, 0xe5632654, 0x7ddb4bfc, 0xe8ac819d, 0x7e6c9251, 0xebf9f498, 0x7ee7aa4c, 0xef4aeaf1,
+    0x7f4c7e54, 0xf29ecfb2, 0x7f9afcb9, 0xf5f50d67, 0x7fd317b4, 0xf94d0e2e, 0x7ff4c56f, 0xfca63bd8,
+};
+
+/* mixed-radix digit reversal, FFT input i is taken from pre-twiddle output digitRevTabLD[i] */
+const uint16_t digitRevTabLDOffset[2] PROGMEM = {0, 256};
+
+const uint8_t digitRevTabLD[256 + 240] PROGMEM = {
+    /* 512 */
+      0,  64, 128, 192,  16,  80, 144, 208,  32,  96, 160, 224,  48, 112, 176, 240,
+      4,  68, 132, 196,  20,  84, 148, 212,  36, 100, 164, 228,  52, 116, 180, 244,
+      8,  72, 136, 200,  24,  88, 152, 216,  40, 104, 168, 232,  56, 120, 184, 248,
+     12,  76, 140, 204,  28,  92, 156, 220,  44, 108, 172, 236,  60, 124, 188, 252,
+      1,  65, 129, 193,  17,  81, 145, 209,  33,  97, 161, 225,  49, 113, 177, 241,
+      5,  69, 133, 197,  21,  85, 149, 213,  37, 101, 165, 229,  53, 117, 181, 245,
+      9,  73, 137, 201,  25,  89, 153, 217,  41, 105, 169, 233,  57, 121, 185, 249,
+     13,  77, 141, 205,  29,  93, 157, 221,  45, 109, 173, 237,  61, 125, 189, 253,
+      2,  66, 130, 194,  18,  82, 146, 210,  34,  98, 162, 226,  50, 114, 178, 242,
+      6,  70, 134, 198,  22,  86, 150, 214,  38, 102, 166, 230,  54, 118, 182, 246,
+     10,  74, 138, 202,  26,  90, 154, 218,  42, 106, 170, 234,  58, 122, 186, 250,
+     14,  78, 142, 206,  30,  94, 158, 222,  46, 110, 174, 238,  62, 126, 190, 254,
+      3,  67, 131, 195,  19,  83, 147, 211,  35,  99, 163, 227,  51, 115, 179, 243,
+      7,  71, 135, 199,  23,  87, 151, 215,  39, 103, 167, 231,  55, 119, 183, 247,
+     11,  75, 139, 203,  27,  91, 155, 219,  43, 107, 171, 235,  59, 123, 187, 251,
+     15,  79, 143, 207,  31,  95, 159, 223,  47, 111, 175, 239,  63, 127, 191, 255,
+    /* 480 */
+      0,  48,  96, 144, 192,  16,  64, 112, 160, 208,  32,  80, 128, 176, 224,   4,
+     52, 100, 148, 196,  20,  68, 116, 164, 212,  36,  84, 132, 180, 228,   8,  56,
+    104, 152, 200,  24,  72, 120, 168, 216,  40,  88, 136, 184, 232,  12,  60, 108,
+    156, 204,  28,  76, 124, 172, 220,  44,  92, 140, 188, 236,   1,  49,  97, 145,
+    193,  17,  65, 113, 161, 209,  33,  81, 129, 177, 225,   5,  53, 101, 149, 197,
+     21,  69, 117, 165, 213,  37,  85, 133, 181, 229,   9,  57, 105, 153, 201,  25,
+     73, 121, 169, 217,  41,  89, 137, 185, 233,  13,  61, 109, 157, 205,  29,  77,
+    125, 173, 221,  45,  93, 141, 189, 237,   2,  50,  98, 146, 194,  18,  66, 114,
+    162, 210,  34,  82, 130, 178, 226,   6,  54, 102, 150, 198,  22,  70, 118, 166,
+    214,  38,  86, 134, 182, 230,  10,  58, 106, 154, 202,  26,  74, 122, 170, 218,
+     42,  90, 138, 186, 234,  14,  62, 110, 158, 206,  30,  78, 126, 174, 222,  46,
+     94, 142, 190, 238,   3,  51,  99, 147, 195,  19,  67, 115, 163, 211,  35,  83,
+    131, 179, 227,   7,  55, 103, 151, 199,  23,  71, 119, 167, 215,  39,  87, 135,
+    183, 231,  11,  59, 107, 155, 203,  27,  75, 123, 171, 219,  43,  91, 139, 187,
+    235,  15,  63, 111, 159, 207,  31,  79, 127, 175, 223,  47,  95, 143, 191, 239,
+};
+
+/* sine window for the LD frame lengths, pairs (w[i], w[n-1-i]) like sinWindow, format = Q31 */
+const uint16_t sinWindowLDOffset[2] PROGMEM = {0, 512};
+
+const int sinWindowLD[512 + 480] PROGMEM = {
+    /* 512 */
+    0x003243f5, 0x7ffff621, 0x0096cbc1, 0x7fffa72c, 0x00fb5330, 0x7fff0943, 0x015fda03, 0x7ffe1c65,
+    0x01c45ffe, 0x7ffce093, 0x0228e4e2, 0x7ffb55ce, 0x028d6870, 0x7ff97c18, 0x02f1ea6c, 0x7ff75370,
+    0x03566a96, 0x7ff4dbd9, 0x03bae8b2, 0x7ff21553, 0x041f6480, 0x7feeffe1, 0x0483ddc3, 0x7feb9b85,
+    0x04e8543e, 0x7fe7e841, 0x054cc7b1, 0x7fe3e616, 0x05b137df, 0x7fdf9508, 0x0615a48b, 0x7fdaf519,
+    0x067a0d76, 0x7fd6064c, 0x06de7262, 0x7fd0c8a3, 0x0742d311, 0x7fcb3c23, 0x07a72f45, 0x7fc560cf,
+    0x080b86c2, 0x7fbf36aa, 0x086fd947, 0x7fb8bdb8, 0x08d42699, 0x7fb1f5fc, 0x09386e78, 0x7faadf7c,
+    0x099cb0a7, 0x7fa37a3c, 0x0a00ece8, 0x7f9bc640, 0x0a6522fe, 0x7f93c38c, 0x0ac952aa, 0x7f8b7227,
+    0x0b2d7baf, 0x7f82d214, 0x0b919dcf, 0x7f79e35a, 0x0bf5b8cb, 0x7f70a5fe, 0x0c59cc68, 0x7f671a05,
+    0x0cbdd865, 0x7f5d3f75, 0x0d21dc87, 0x7f531655, 0x0d85d88f, 0x7f489eaa, 0x0de9cc40, 0x7f3dd87c,
+    0x0e4db75b, 0x7f32c3d1, 0x0eb199a4, 0x7f2760af, 0x0f1572dc, 0x7f1baf1e, 0x0f7942c7, 0x7f0faf25,
+    0x0fdd0926, 0x7f0360cb, 0x1040c5bb, 0x7ef6c418, 0x10a4784b, 0x7ee9d914, 0x11082096, 0x7edc9fc6,
+    0x116bbe60, 0x7ecf1837, 0x11cf516a, 0x7ec14270, 0x1232d979, 0x7eb31e78, 0x1296564d, 0x7ea4ac58,
+    0x12f9c7aa, 0x7e95ec1a, 0x135d2d53, 0x7e86ddc6, 0x13c0870a, 0x7e778166, 0x1423d492, 0x7e67d703,
+    0x148715ae, 0x7e57dea7, 0x14ea4a1f, 0x7e47985b, 0x154d71aa, 0x7e37042a, 0x15b08c12, 0x7e26221f,
+    0x16139918, 0x7e14f242, 0x1676987f, 0x7e0374a0, 0x16d98a0c, 0x7df1a942, 0x173c6d80, 0x7ddf9034,
+    0x179f429f, 0x7dcd2981, 0x1802092c, 0x7dba7534, 0x1864c0ea, 0x7da77359, 0x18c7699b, 0x7d9423fc,
+    0x192a0304, 0x7d808728, 0x198c8ce7, 0x7d6c9ce9, 0x19ef0707, 0x7d58654d, 0x1a517128, 0x7d43e05e,
+    0x1ab3cb0d, 0x7d2f0e2b, 0x1b161479, 0x7d19eebf, 0x1b784d30, 0x7d048228, 0x1bda74f6, 0x7ceec873,
+    0x1c3c8b8c, 0x7cd8c1ae, 0x1c9e90b8, 0x7cc26de5, 0x1d00843d, 0x7cabcd28, 0x1d6265dd, 0x7c94df83,
+    0x1dc4355e, 0x7c7da505, 0x1e25f282, 0x7c661dbc, 0x1e879d0d, 0x7c4e49b7, 0x1ee934c3, 0x7c362904,
+    0x1f4ab968, 0x7c1dbbb3, 0x1fac2abf, 0x7c0501d2, 0x200d888d, 0x7bebfb70, 0x206ed295, 0x7bd2a89e,
+    0x20d0089c, 0x7bb9096b, 0x21312a65, 0x7b9f1de6, 0x219237b5, 0x7b84e61f, 0x21f3304f, 0x7b6a6227,
+    0x225413f8, 0x7b4f920e, 0x22b4e274, 0x7b3475e5, 0x23159b88, 0x7b190dbc, 0x23763ef7, 0x7afd59a4,
+    0x23d6cc87, 0x7ae159ae, 0x243743fa, 0x7ac50dec, 0x2497a517, 0x7aa8766f, 0x24f7efa2, 0x7a8b9348,
+    0x2558235f, 0x7a6e648a, 0x25b84012, 0x7a50ea47, 0x26184581, 0x7a332490, 0x26783370, 0x7a151378,
+    0x26d809a5, 0x79f6b711, 0x2737c7e3, 0x79d80f6f, 0x27976df1, 0x79b91ca4, 0x27f6fb92, 0x7999dec4,
+    0x2856708d, 0x797a55e0, 0x28b5cca5, 0x795a820e, 0x29150fa1, 0x793a6361, 0x29743946, 0x7919f9ec,
+    0x29d34958, 0x78f945c3, 0x2a323f9e, 0x78d846fb, 0x2a911bdc, 0x78b6fda8, 0x2aefddd8, 0x789569df,
+    0x2b4e8558, 0x78738bb3, 0x2bad1221, 0x7851633b, 0x2c0b83fa, 0x782ef08b, 0x2c69daa6, 0x780c33b8,
+    0x2cc815ee, 0x77e92cd9, 0x2d263596, 0x77c5dc01, 0x2d843964, 0x77a24148, 0x2de2211e, 0x777e5cc3,
+    0x2e3fec8b, 0x775a2e89, 0x2e9d9b70, 0x7735b6af, 0x2efb2d95, 0x7710f54c, 0x2f58a2be, 0x76ebea77,
+    0x2fb5fab2, 0x76c69647, 0x30133539, 0x76a0f8d2, 0x30705217, 0x767b1231, 0x30cd5115, 0x7654e279,
+    0x312a31f8, 0x762e69c4, 0x3186f487, 0x7607a828, 0x31e39889, 0x75e09dbd, 0x32401dc6, 0x75b94a9c,
+    0x329c8402, 0x7591aedd, 0x32f8cb07, 0x7569ca99, 0x3354f29b, 0x75419de7, 0x33b0fa84, 0x751928e0,
+    0x340ce28b, 0x74f06b9e, 0x3468aa76, 0x74c7663a, 0x34c4520d, 0x749e18cd, 0x351fd918, 0x74748371,
+    0x357b3f5d, 0x744aa63f, 0x35d684a6, 0x74208150, 0x3631a8b8, 0x73f614c0, 0x368cab5c, 0x73cb60a8,
+    0x36e78c5b, 0x73a06522, 0x37424b7b, 0x73752249, 0x379ce885, 0x73499838, 0x37f76341, 0x731dc70a,
+    0x3851bb77, 0x72f1aed9, 0x38abf0ef, 0x72c54fc1, 0x39060373, 0x7298a9dd, 0x395ff2c9, 0x726bbd48,
+    0x39b9bebc, 0x723e8a20, 0x3a136712, 0x7211107e, 0x3a6ceb96, 0x71e35080, 0x3ac64c0f, 0x71b54a41,
+    0x3b1f8848, 0x7186fdde, 0x3b78a007, 0x71586b74, 0x3bd19318, 0x7129931f, 0x3c2a6142, 0x70fa74fc,
+    0x3c830a50, 0x70cb1128, 0x3cdb8e09, 0x709b67c0, 0x3d33ec39, 0x706b78e3, 0x3d8c24a8, 0x703b44ad,
+    0x3de4371f, 0x700acb3c, 0x3e3c2369, 0x6fda0cae, 0x3e93e950, 0x6fa90921, 0x3eeb889c, 0x6f77c0b3,
+    0x3f430119, 0x6f463383, 0x3f9a5290, 0x6f1461b0, 0x3ff17cca, 0x6ee24b57, 0x40487f94, 0x6eaff099,
+    0x409f5ab6, 0x6e7d5193, 0x40f60dfb, 0x6e4a6e66, 0x414c992f, 0x6e174730, 0x41a2fc1a, 0x6de3dc11,
+    0x41f93689, 0x6db02d29, 0x424f4845, 0x6d7c3a98, 0x42a5311b, 0x6d48047e, 0x42faf0d4, 0x6d138afb,
+    0x4350873c, 0x6cdece2f, 0x43a5f41e, 0x6ca9ce3b, 0x43fb3746, 0x6c748b3f, 0x4450507e, 0x6c3f055d,
+    0x44a53f93, 0x6c093cb6, 0x44fa0450, 0x6bd3316a, 0x454e9e80, 0x6b9ce39b, 0x45a30df0, 0x6b66536b,
+    0x45f7526b, 0x6b2f80fb, 0x464b6bbe, 0x6af86c6c, 0x469f59b4, 0x6ac115e2, 0x46f31c1a, 0x6a897d7d,
+    0x4746b2bc, 0x6a51a361, 0x479a1d67, 0x6a1987b0, 0x47ed5be6, 0x69e12a8c, 0x48406e08, 0x69a88c19,
+    0x48935397, 0x696fac78, 0x48e60c62, 0x69368bce, 0x49389836, 0x68fd2a3d, 0x498af6df, 0x68c387e9,
+    0x49dd282a, 0x6889a4f6, 0x4a2f2be6, 0x684f8186, 0x4a8101de, 0x68151dbe, 0x4ad2a9e2, 0x67da79c3,
+    0x4b2423be, 0x679f95b7, 0x4b756f40, 0x676471c0, 0x4bc68c36, 0x67290e02, 0x4c177a6e, 0x66ed6aa1,
+    0x4c6839b7, 0x66b187c3, 0x4cb8c9dd, 0x6675658c, 0x4d092ab0, 0x66390422, 0x4d595bfe, 0x65fc63a9,
+    0x4da95d96, 0x65bf8447, 0x4df92f46, 0x65826622, 0x4e48d0dd, 0x6545095f, 0x4e984229, 0x65076e25,
+    0x4ee782fb, 0x64c99498, 0x4f369320, 0x648b7ce0, 0x4f857269, 0x644d2722, 0x4fd420a4, 0x640e9386,
+    0x50229da1, 0x63cfc231, 0x5070e92f, 0x6390b34a, 0x50bf031f, 0x635166f9, 0x510ceb40, 0x6311dd64,
+    0x515aa162, 0x62d216b3, 0x51a82555, 0x6292130c, 0x51f576ea, 0x6251d298, 0x524295f0, 0x6211557e,
+    0x528f8238, 0x61d09be5, 0x52dc3b92, 0x618fa5f7, 0x5328c1d0, 0x614e73da, 0x537514c2, 0x610d05b7,
+    0x53c13439, 0x60cb5bb7, 0x540d2005, 0x60897601, 0x5458d7f9, 0x604754bf, 0x54a45be6, 0x6004f819,
+    0x54efab9c, 0x5fc26038, 0x553ac6ee, 0x5f7f8d46, 0x5585adad, 0x5f3c7f6b, 0x55d05faa, 0x5ef936d1,
+    0x561adcb9, 0x5eb5b3a2, 0x566524aa, 0x5e71f606, 0x56af3750, 0x5e2dfe29, 0x56f9147e, 0x5de9cc33,
+    0x5742bc06, 0x5da5604f, 0x578c2dba, 0x5d60baa7, 0x57d5696d, 0x5d1bdb65, 0x581e6ef1, 0x5cd6c2b5,
+    0x58673e1b, 0x5c9170bf, 0x58afd6bd, 0x5c4be5b0, 0x58f838a9, 0x5c0621b2, 0x594063b5, 0x5bc024f0,
+    0x598857b2, 0x5b79ef96, 0x59d01475, 0x5b3381ce, 0x5a1799d1, 0x5aecdbc5, 0x5a5ee79a, 0x5aa5fda5,
+    /* 480 */
+    0x00359dd2, 0x7ffff4c5, 0x00a0d951, 0x7fff9aef, 0x010c1460, 0x7ffee744, 0x01774eb2, 0x7ffdd9c4,
+    0x01e287fc, 0x7ffc726f, 0x024dbff4, 0x7ffab147, 0x02b8f64e, 0x7ff8964d, 0x03242abf, 0x7ff62182,
+    0x038f5cfb, 0x7ff352e8, 0x03fa8cb8, 0x7ff02a82, 0x0465b9aa, 0x7feca851, 0x04d0e386, 0x7fe8cc57,
+    0x053c0a01, 0x7fe49698, 0x05a72ccf, 0x7fe00716, 0x06124ba5, 0x7fdb1dd5, 0x067d6639, 0x7fd5dad8,
+    0x06e87c3f, 0x7fd03e23, 0x07538d6b, 0x7fca47b9, 0x07be9973, 0x7fc3f7a0, 0x0829a00c, 0x7fbd4dda,
+    0x0894a0ea, 0x7fb64a6e, 0x08ff9bc2, 0x7faeed5f, 0x096a9049, 0x7fa736b4, 0x09d57e35, 0x7f9f2671,
+    0x0a40653a, 0x7f96bc9c, 0x0aab450d, 0x7f8df93c, 0x0b161d63, 0x7f84dc55, 0x0b80edf1, 0x7f7b65ef,
+    0x0bebb66c, 0x7f719611, 0x0c56768a, 0x7f676cc0, 0x0cc12dff, 0x7f5cea05, 0x0d2bdc80, 0x7f520de6,
+    0x0d9681c2, 0x7f46d86c, 0x0e011d7c, 0x7f3b499d, 0x0e6baf61, 0x7f2f6183, 0x0ed63727, 0x7f232026,
+    0x0f40b483, 0x7f16858e, 0x0fab272b, 0x7f0991c4, 0x10158ed4, 0x7efc44d0, 0x107feb33, 0x7eee9ebe,
+    0x10ea3bfd, 0x7ee09f95, 0x115480e9, 0x7ed24761, 0x11beb9aa, 0x7ec3962a, 0x1228e5f8, 0x7eb48bfb,
+    0x12930586, 0x7ea528e0, 0x12fd180b, 0x7e956ce1, 0x13671d3d, 0x7e85580c, 0x13d114d0, 0x7e74ea6a,
+    0x143afe7b, 0x7e642408, 0x14a4d9f4, 0x7e5304f2, 0x150ea6ef, 0x7e418d32, 0x15786522, 0x7e2fbcd6,
+    0x15e21445, 0x7e1d93ea, 0x164bb40b, 0x7e0b127a, 0x16b5442b, 0x7df83895, 0x171ec45c, 0x7de50646,
+    0x17883452, 0x7dd17b9c, 0x17f193c5, 0x7dbd98a4, 0x185ae269, 0x7da95d6c, 0x18c41ff6, 0x7d94ca03,
+    0x192d4c21, 0x7d7fde76, 0x199666a0, 0x7d6a9ad5, 0x19ff6f2a, 0x7d54ff2e, 0x1a686575, 0x7d3f0b90,
+    0x1ad14938, 0x7d28c00c, 0x1b3a1a28, 0x7d121cb0, 0x1ba2d7fc, 0x7cfb218c, 0x1c0b826a, 0x7ce3ceb2,
+    0x1c74192a, 0x7ccc2430, 0x1cdc9bf2, 0x7cb42217, 0x1d450a78, 0x7c9bc87a, 0x1dad6473, 0x7c831767,
+    0x1e15a99a, 0x7c6a0ef2, 0x1e7dd9a4, 0x7c50af2b, 0x1ee5f447, 0x7c36f824, 0x1f4df93a, 0x7c1ce9ef,
+    0x1fb5e836, 0x7c02849f, 0x201dc0ef, 0x7be7c847, 0x2085831f, 0x7bccb4f8, 0x20ed2e7b, 0x7bb14ac5,
+    0x2154c2bb, 0x7b9589c3, 0x21bc3f97, 0x7b797205, 0x2223a4c5, 0x7b5d039e, 0x228af1fe, 0x7b403ea2,
+    0x22f226f8, 0x7b232325, 0x2359436c, 0x7b05b13d, 0x23c04710, 0x7ae7e8fc, 0x2427319d, 0x7ac9ca7a,
+    0x248e02cb, 0x7aab55ca, 0x24f4ba50, 0x7a8c8b01, 0x255b57e6, 0x7a6d6a37, 0x25c1db44, 0x7a4df380,
+    0x26284422, 0x7a2e26f2, 0x268e9238, 0x7a0e04a4, 0x26f4c53e, 0x79ed8cad, 0x275adcee, 0x79ccbf22,
+    0x27c0d8fe, 0x79ab9c1c, 0x2826b928, 0x798a23b1, 0x288c7d24, 0x796855f9, 0x28f224ab, 0x7946330c,
+    0x2957af74, 0x7923bb01, 0x29bd1d3a, 0x7900edf2, 0x2a226db5, 0x78ddcbf5, 0x2a87a09d, 0x78ba5524,
+    0x2aecb5ac, 0x78968998, 0x2b51ac9a, 0x7872696a, 0x2bb68522, 0x784df4b3, 0x2c1b3efb, 0x78292b8d,
+    0x2c7fd9e0, 0x78040e12, 0x2ce45589, 0x77de9c5b, 0x2d48b1b1, 0x77b8d683, 0x2dacee11, 0x7792bca5,
+    0x2e110a62, 0x776c4edb, 0x2e75065e, 0x77458d40, 0x2ed8e1c0, 0x771e77f0, 0x2f3c9c40, 0x76f70f05,
+    0x2fa03599, 0x76cf529c, 0x3003ad85, 0x76a742d1, 0x306703bf, 0x767edfbe, 0x30ca3800, 0x76562982,
+    0x312d4a03, 0x762d2038, 0x31903982, 0x7603c3fd, 0x31f30638, 0x75da14ef, 0x3255afe0, 0x75b01329,
+    0x32b83634, 0x7585becb, 0x331a98ef, 0x755b17f2, 0x337cd7cd, 0x75301ebb, 0x33def287, 0x7504d345,
+    0x3440e8da, 0x74d935ae, 0x34a2ba81, 0x74ad4615, 0x35046736, 0x74810499, 0x3565eeb6, 0x74547158,
+    0x35c750bc, 0x74278c72, 0x36288d03, 0x73fa5607, 0x3689a348, 0x73ccce36, 0x36ea9346, 0x739ef51f,
+    0x374b5cb9, 0x7370cae2, 0x37abff5d, 0x73424fa0, 0x380c7aee, 0x73138379, 0x386ccf2a, 0x72e4668f,
+    0x38ccfbcb, 0x72b4f902, 0x392d008f, 0x72853af3, 0x398cdd32, 0x72552c85, 0x39ec9172, 0x7224cdd8,
+    0x3a4c1d09, 0x71f41f0f, 0x3aab7fb7, 0x71c3204c, 0x3b0ab937, 0x7191d1b1, 0x3b69c947, 0x71603361,
+    0x3bc8afa5, 0x712e457f, 0x3c276c0d, 0x70fc082d, 0x3c85fe3d, 0x70c97b90, 0x3ce465f3, 0x70969fca,
+    0x3d42a2ec, 0x706374ff, 0x3da0b4e7, 0x702ffb54, 0x3dfe9ba1, 0x6ffc32eb, 0x3e5c56d8, 0x6fc81bea,
+    0x3eb9e64b, 0x6f93b676, 0x3f1749b8, 0x6f5f02b2, 0x3f7480dd, 0x6f2a00c4, 0x3fd18b7a, 0x6ef4b0d1,
+    0x402e694c, 0x6ebf12ff, 0x408b1a12, 0x6e892772, 0x40e79d8c, 0x6e52ee52, 0x4143f379, 0x6e1c67c4,
+    0x41a01b97, 0x6de593ee, 0x41fc15a6, 0x6dae72f7, 0x4257e166, 0x6d770506, 0x42b37e96, 0x6d3f4a40,
+    0x430eecf6, 0x6d0742cf, 0x436a2c45, 0x6cceeed8, 0x43c53c44, 0x6c964e83, 0x44201cb2, 0x6c5d61f9,
+    0x447acd50, 0x6c242960, 0x44d54ddf, 0x6beaa4e2, 0x452f9e1e, 0x6bb0d4a7, 0x4589bdcf, 0x6b76b8d6,
+    0x45e3acb1, 0x6b3c519a, 0x463d6a87, 0x6b019f1a, 0x4696f710, 0x6ac6a180, 0x46f0520f, 0x6a8b58f6,
+    0x47497b44, 0x6a4fc5a6, 0x47a27271, 0x6a13e7b8, 0x47fb3757, 0x69d7bf57, 0x4853c9b9, 0x699b4cad,
+    0x48ac2957, 0x695e8fe5, 0x490455f4, 0x69218929, 0x495c4f52, 0x68e438a4, 0x49b41533, 0x68a69e81,
+    0x4a0ba75b, 0x6868baec, 0x4a63058a, 0x682a8e0f, 0x4aba2f84, 0x67ec1817, 0x4b11250c, 0x67ad592f,
+    0x4b67e5e4, 0x676e5183, 0x4bbe71d1, 0x672f013f, 0x4c14c894, 0x66ef6891, 0x4c6ae9f2, 0x66af87a4,
+    0x4cc0d5ae, 0x666f5ea6, 0x4d168b8b, 0x662eedc3, 0x4d6c0b4e, 0x65ee3529, 0x4dc154bb, 0x65ad3505,
+    0x4e166795, 0x656bed84, 0x4e6b43a2, 0x652a5ed6, 0x4ebfe8a5, 0x64e88926, 0x4f145662, 0x64a66ca5,
+    0x4f688ca0, 0x6464097f, 0x4fbc8b22, 0x64215fe5, 0x501051ae, 0x63de7003, 0x5063e008, 0x639b3a0b,
+    0x50b735f8, 0x6357be2a, 0x510a5340, 0x6313fc90, 0x515d37a9, 0x62cff56c, 0x51afe2f6, 0x628ba8ef,
+    0x520254ef, 0x62471749, 0x52548d59, 0x620240a8, 0x52a68bfb, 0x61bd253f, 0x52f8509b, 0x6177c53c,
+    0x5349daff, 0x613220d2, 0x539b2af0, 0x60ec3830, 0x53ec4032, 0x60a60b88, 0x543d1a8e, 0x605f9b0b,
+    0x548db9cb, 0x6018e6eb, 0x54de1db1, 0x5fd1ef59, 0x552e4605, 0x5f8ab487, 0x557e3292, 0x5f4336a7,
+    0x55cde31e, 0x5efb75ea, 0x561d5771, 0x5eb37285, 0x566c8f55, 0x5e6b2ca8, 0x56bb8a90, 0x5e22a487,
+    0x570a48ec, 0x5dd9da55, 0x5758ca31, 0x5d90ce45, 0x57a70e29, 0x5d47808a, 0x57f5149d, 0x5cfdf157,
+    0x5842dd54, 0x5cb420e0, 0x5890681a, 0x5c6a0f59, 0x58ddb4b8, 0x5c1fbcf6, 0x592ac2f7, 0x5bd529eb,
+    0x597792a1, 0x5b8a566c, 0x59c42381, 0x5b3f42ae, 0x5a107561, 0x5af3eee6, 0x5a5c880a, 0x5aa85b48,
+};
+
+/* low overlap window (window_shape 1 in AAC-LD): w[i] = 0 for i < 3n/8, a sine slope of n/4 samples,
+ *   then 1.0 up to n + 3n/8; only the pairs of the slope are stored, format = Q31
+ */
+const uint16_t lowOverlapWindowLDOffset[2] PROGMEM = {0, 128};
+
+const int lowOverlapWindowLD[128 + 120] PROGMEM = {
+    /* 512 */
+    0x00c90f88, 0x7fff6216, 0x025b26d7, 0x7ffa72d1, 0x03ed26e6, 0x7ff09478, 0x057f0035, 0x7fe1c76b,
+    0x0710a345, 0x7fce0c3e, 0x08a2009a, 0x7fb563b3, 0x0a3308bd, 0x7f97cebd, 0x0bc3ac35, 0x7f754e80,
+    0x0d53db92, 0x7f4de451, 0x0ee38766, 0x7f2191b4, 0x1072a048, 0x7ef05860, 0x120116d5, 0x7eba3a39,
+    0x138edbb1, 0x7e7f3957, 0x151bdf86, 0x7e3f57ff, 0x16a81305, 0x7dfa98a8, 0x183366e9, 0x7db0fdf8,
+    0x19bdcbf3, 0x7d628ac6, 0x1b4732ef, 0x7d0f4218, 0x1ccf8cb3, 0x7cb72724, 0x1e56ca1e, 0x7c5a3d50,
+    0x1fdcdc1b, 0x7bf88830, 0x2161b3a0, 0x7b920b89, 0x22e541af, 0x7b26cb4f, 0x24677758, 0x7ab6cba4,
+    0x25e845b6, 0x7a4210d8, 0x27679df4, 0x79c89f6e, 0x28e5714b, 0x794a7c12, 0x2a61b101, 0x78c7aba2,
+    0x2bdc4e6f, 0x78403329, 0x2d553afc, 0x77b417df, 0x2ecc681e, 0x77235f2d, 0x3041c761, 0x768e0ea6,
+    0x31b54a5e, 0x75f42c0b, 0x3326e2c3, 0x7555bd4c, 0x34968250, 0x74b2c884, 0x36041ad9, 0x740b53fb,
+    0x376f9e46, 0x735f6626, 0x38d8fe93, 0x72af05a7, 0x3a402dd2, 0x71fa3949, 0x3ba51e29, 0x71410805,
+    0x3d07c1d6, 0x708378ff, 0x3e680b2c, 0x6fc19385, 0x3fc5ec98, 0x6efb5f12, 0x4121589b, 0x6e30e34a,
+    0x427a41d0, 0x6d6227fa, 0x43d09aed, 0x6c8f351c, 0x452456bd, 0x6bb812d1, 0x46756828, 0x6adcc964,
+    0x47c3c22f, 0x69fd614a, 0x490f57ee, 0x6919e320, 0x4a581c9e, 0x683257ab, 0x4b9e0390, 0x6746c7d8,
+    0x4ce10034, 0x66573cbb, 0x4e210617, 0x6563bf92, 0x4f5e08e3, 0x646c59bf, 0x5097fc5e, 0x637114cc,
+    0x51ced46e, 0x6271fa69, 0x53028518, 0x616f146c, 0x5433027d, 0x60686ccf, 0x556040e2, 0x5f5e0db3,
+    0x568a34a9, 0x5e50015d, 0x57b0d256, 0x5d3e5237, 0x58d40e8c, 0x5c290acc, 0x59f3de12, 0x5b1035cf,
+    /* 480 */
+    0x00d676eb, 0x7fff4c54, 0x02835b5a, 0x7ff9af04, 0x0430238f, 0x7fee74a2, 0x05dcbcbe, 0x7fdd9dad,
+    0x07891418, 0x7fc72ae2, 0x093516d4, 0x7fab1d3d, 0x0ae0b22c, 0x7f8975f9, 0x0c8bd35e, 0x7f62368f,
+    0x0e3667ad, 0x7f3560b9, 0x0fe05c64, 0x7f02f66f, 0x11899ed3, 0x7ecaf9e5, 0x13321c53, 0x7e8d6d91,
+    0x14d9c245, 0x7e4a5426, 0x16807e15, 0x7e01b096, 0x18263d36, 0x7db3860f, 0x19caed29, 0x7d5fd801,
+    0x1b6e7b7a, 0x7d06aa16, 0x1d10d5c2, 0x7ca80038, 0x1eb1e9a7, 0x7c43de8e, 0x2051a4dd, 0x7bda497d,
+    0x21eff528, 0x7b6b45a5, 0x238cc85d, 0x7af6d7e6, 0x25280c5e, 0x7a7d055b, 0x26c1af22, 0x79fdd35c,
+    0x28599eb0, 0x7979477d, 0x29efc925, 0x78ef678f, 0x2b841caf, 0x7860399e, 0x2d168792, 0x77cbc3f2,
+    0x2ea6f827, 0x77320d0d, 0x30355cdd, 0x76931bae, 0x31c1a43b, 0x75eef6ce, 0x334bbcde, 0x7545a5a0,
+    0x34d3957e, 0x74972f92, 0x36591cea, 0x73e39c49, 0x37dc420c, 0x732af3a7, 0x395cf3e9, 0x726d3dc6,
+    0x3adb21a1, 0x71aa82f7, 0x3c56ba70, 0x70e2cbc6, 0x3dcfadb0, 0x701620f5, 0x3f45ead8, 0x6f448b7e,
+    0x40b9617d, 0x6e6e1492, 0x422a0154, 0x6d92c59b, 0x4397ba32, 0x6cb2a837, 0x45027c0c, 0x6bcdc639,
+    0x466a36f9, 0x6ae429ae, 0x47cedb31, 0x69f5dcd3, 0x4930590f, 0x6902ea1d, 0x4a8ea111, 0x680b5c33,
+    0x4be9a3db, 0x670f3df3, 0x4d415234, 0x660e9a6a, 0x4e959d08, 0x65097cdb, 0x4fe6756a, 0x63fff0ba,
+    0x5133cc94, 0x62f201ac, 0x527d93e6, 0x61dfbb8a, 0x53c3bcea, 0x60c92a5a, 0x55063951, 0x5fae5a55,
+    0x5644faf4, 0x5e8f57e2, 0x577ff3da, 0x5d6c2f99, 0x58b71632, 0x5c44ee40, 0x59ea5454, 0x5b19a0c8,
+};
+
 const uint8_t uniqueIDTab[8] = {0x5f, 0x4b, 0x43, 0x5f, 0x5f, 0x4a, 0x52, 0x5f};
 
 const uint32_t twidTabOdd[8*6 + 32*6 + 128*6] PROGMEM = {
@@ -1344,9 +1971,54 @@ const uint16_t tnsMaxBandsLong[2*12] PROGMEM = {
 
 const uint8_t tnsMaxOrderLong[3] PROGMEM = {20, 12, 12};
 
+/* AAC-LD (ER AOT 23): scale factor bands for frame length 512 and 480 (tables 4.5.x, ISO/IEC 14496-3:2005/Amd.1)
+ * defined for 22.05 - 48 kHz only, sfBandTotalLD = 0 marks an unsupported sample rate
+ */
+const uint8_t sfBandTotalLD[2][12] PROGMEM = {
+    { 0, 0, 0, 36, 36, 37, 31, 31, 0, 0, 0, 0 },    /* 512 */
+    { 0, 0, 0, 35, 35, 37, 30, 30, 0, 0, 0, 0 },    /* 480 */
+};
+
+const uint16_t sfBandTabLDOffset[2][12] PROGMEM = {
+    { 0, 0, 0,   0,   0,  37,  75,  75, 0, 0, 0, 0 },
+    { 0, 0, 0, 107, 107, 143, 181, 181, 0, 0, 0, 0 },
+};
+
+const uint16_t sfBandTabLD[212] PROGMEM = {
+    /* 512, 44, 48 kHz [37] */
+      0,   4,   8,  12,  16,  20,  24,  28,  32,  36,  40,  44,  48,  52,  56,  60,  68,  76,  84,
+     92, 100, 112, 124, 136, 148, 164, 184, 208, 236, 268, 300, 332, 364, 396, 428, 460, 512,
+
+    /* 512, 32 kHz [38] */
+      0,   4,   8,  12,  16,  20,  24,  28,  32,  36,  40,  44,  48,  52,  56,  64,  72,  80,  88,
+     96, 108, 120, 132, 144, 160, 176, 192, 212, 236, 260, 288, 320, 352, 384, 416, 448, 480, 512,
+
+    /* 512, 22, 24 kHz [32] */
+      0,   4,   8,  12,  16,  20,  24,  28,  32,  36,  40,  44,  52,  60,  68,  80,
+     92, 104, 120, 140, 164, 192, 224, 256, 288, 320, 352, 384, 416, 448, 480, 512,
+
+    /* 480, 44, 48 kHz [36] */
+      0,   4,   8,  12,  16,  20,  24,  28,  32,  36,  40,  44,  48,  52,  56,  64,  72,  80,
+     88,  96, 108, 120, 132, 144, 156, 172, 188, 212, 240, 272, 304, 336, 368, 400, 432, 480,
+
+    /* 480, 32 kHz [38] */
+      0,   4,   8,  12,  16,  20,  24,  28,  32,  36,  40,  44,  48,  52,  56,  60,  64,  72,  80,
+     88,  96, 104, 112, 124, 136, 148, 164, 180, 200, 224, 256, 288, 320, 352, 384, 416, 448, 480,
+
+    /* 480, 22, 24 kHz [31] */
+      0,   4,   8,  12,  16,  20,  24,  28,  32,  36,  40,  44,  52,  60,  68,  80,
+     92, 104, 120, 140, 164, 192, 224, 256, 288, 320, 352, 384, 416, 448, 480
+};
+
+/* AAC-LD TNS max bands, max order is the LC one */
+const uint8_t tnsMaxBandsLD[2][12] PROGMEM = {
+    { 0, 0, 0, 31, 32, 37, 20, 20, 0, 0, 0, 0 },    /* 512 */
+    { 0, 0, 0, 31, 32, 37, 30, 30, 0, 0, 0, 0 },    /* 480 */
+};
+
 
 /* k0Tab[sampRateIdx][k] = k0 = startMin + offset(bs_start_freq) for given sample rate (4.6.18.3.2.1)
- * downsampled (single-rate) SBR not currently supported
+ * m_sbrDownsampled only moves the QMF synthesis to the core rate (32 bands), k0 comes from this table as well
  */
 const uint8_t k0Tab[NUM_SAMPLE_RATES_SBR][16] = {
     {  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 16, 18, 20, 23, 27, 31 }, /* 96 kHz */
@@ -1363,7 +2035,7 @@ const uint8_t k0Tab[NUM_SAMPLE_RATES_SBR][16] = {
 
 /* k2Tab[sampRateIdx][k] = stopVector(bs_stop_freq) for given sample rate, bs_stop_freq = [0, 13] (4.6.18.3.2.1)
  * generated with Matlab script calc_stopvec.m
- * downsampled (single-rate) SBR not currently supported
+ * m_sbrDownsampled only moves the QMF synthesis to the core rate (32 bands), k2 comes from this table as well
  */
 const uint8_t k2Tab[NUM_SAMPLE_RATES_SBR][14] = {
     { 13, 15, 17, 19, 21, 24, 27, 31, 35, 39, 44, 50, 57, 64 }, /* 96 kHz */
@@ -1457,7 +2129,7 @@ static const int newBWTab[4][4] PROGMEM = {
 };
 
 /* NINT(2.048E6 / Fs) (figure 4.47)
- * downsampled (single-rate) SBR not currently supported
+ * indexed by the SBR rate, m_sbrDownsampled keeps the same k0/k2 band limits and only synthesizes at the core rate
  */
 const uint8_t goalSBTab[NUM_SAMPLE_RATES_SBR] = {
     21, 23, 32, 43, 46, 64, 85, 93, 128
@@ -1546,6 +2218,71 @@ static const int cos4sin4tab64[64] PROGMEM = {
     0x5a2d0957, 0x29348937, 0x5a56deec, 0x2ff1d9c7, 0x5a72c63b, 0x2b8ef77d, 0x5a80baf6, 0x2dce88aa,
 };
 
+/* QMFSynthesisDown() pre-twiddle, format = Q31
+ *
+ * for (i = 0; i < 32; i++) {
+ *   angle = (i + 0.5) * M_PI / 128;
+ *   x = cos(angle);
+ *   x = sin(angle);
+ * }
+ */
+static const int cos1sin1tabQMFS32[64] PROGMEM = {
+    0x7ffd885a, 0x01921d20, 0x7fe9cbc0, 0x04b6195d, 0x7fc25596, 0x07d95b9e, 0x7f872bf3, 0x0afb6805,
+    0x7f3857f6, 0x0e1bc2e4, 0x7ed5e5c6, 0x1139f0cf, 0x7e5fe493, 0x145576b1, 0x7dd6668f, 0x176dd9de,
+    0x7d3980ec, 0x1a82a026, 0x7c894bde, 0x1d934fe5, 0x7bc5e290, 0x209f701c, 0x7aef6323, 0x23a6887f,
+    0x7a05eead, 0x26a82186, 0x7909a92d, 0x29a3c485, 0x77fab989, 0x2c98fbba, 0x76d94989, 0x2f875262,
+    0x75a585cf, 0x326e54c7, 0x745f9dd1, 0x354d9057, 0x7307c3d0, 0x382493b0, 0x719e2cd2, 0x3af2eeb7,
+    0x7023109a, 0x3db832a6, 0x6e96a99d, 0x4073f21d, 0x6cf934fc, 0x4325c135, 0x6b4af279, 0x45cd358f,
+    0x698c246c, 0x4869e665, 0x67bd0fbd, 0x4afb6c98, 0x65ddfbd3, 0x4d8162c4, 0x63ef3290, 0x4ffb654d,
+    0x61f1003f, 0x5269126e, 0x5fe3b38d, 0x54ca0a4b, 0x5dc79d7c, 0x571deefa, 0x5b9d1154, 0x59646498,
+};
+
+/* DCT4_32() pre-twiddle, format = Q31
+ *
+ * for (i = 0; i < 16; i++) {
+ *   angle = (i + 0.25) * M_PI / 32;
+ *   x = cos(angle);
+ *   x = sin(angle);
+ * }
+ */
+static const int cos4sin4tab32[32] PROGMEM = {
+    0x7ff62182, 0x03242abf, 0x7f0991c4, 0x0fab272b, 0x7ce3ceb2, 0x1c0b826a, 0x798a23b1, 0x2826b928,
+    0x7504d345, 0x33def287, 0x6f5f02b2, 0x3f1749b8, 0x68a69e81, 0x49b41533, 0x60ec3830, 0x539b2af0,
+    0x5842dd54, 0x5cb420e0, 0x4ebfe8a5, 0x64e88926, 0x447acd50, 0x6c242960, 0x398cdd32, 0x72552c85,
+    0x2e110a62, 0x776c4edb, 0x2223a4c5, 0x7b5d039e, 0x15e21445, 0x7e1d93ea, 0x096a9049, 0x7fa736b4,
+};
+
+/* DCT4_32() post-twiddle, format = Q31
+ *
+ * for (i = 0; i < 16; i++) {
+ *   angle = i * M_PI / 32;
+ *   x = cos(angle);
+ *   x = sin(angle);
+ * }
+ */
+static const int cos1sin1tab32[32] PROGMEM = {
+    0x7fffffff, 0x00000000, 0x7f62368f, 0x0c8bd35e, 0x7d8a5f40, 0x18f8b83c, 0x7a7d055b, 0x25280c5e,
+    0x7641af3d, 0x30fbc54d, 0x70e2cbc6, 0x3c56ba70, 0x6a6d98a4, 0x471cece7, 0x62f201ac, 0x5133cc94,
+    0x5a82799a, 0x5a82799a, 0x5133cc94, 0x62f201ac, 0x471cece7, 0x6a6d98a4, 0x3c56ba70, 0x70e2cbc6,
+    0x30fbc54d, 0x7641af3d, 0x25280c5e, 0x7a7d055b, 0x18f8b83c, 0x7d8a5f40, 0x0c8bd35e, 0x7f62368f,
+};
+
+/* FFT16C() twiddles W16^(n2 * k1) for n2, k1 = [1, 3], format = Q31
+ *
+ * for (n2 = 1; n2 < 4; n2++) {
+ *   for (k1 = 1; k1 < 4; k1++) {
+ *     angle = 2 * M_PI * n2 * k1 / 16;
+ *     x = cos(angle);
+ *     x = sin(angle);
+ *   }
+ * }
+ */
+const uint32_t twidTabFFT16[18] PROGMEM = {
+    0x7641af3d, 0x30fbc54d, 0x5a82799a, 0x5a82799a, 0x30fbc54d, 0x7641af3d, 0x5a82799a, 0x5a82799a,
+    0x00000000, 0x7fffffff, 0xa57d8666, 0x5a82799a, 0x30fbc54d, 0x7641af3d, 0xa57d8666, 0x5a82799a,
+    0x89be50c3, 0xcf043ab3,
+};
+
 /* invBandTab[i] = 1.0 / (i + 1), Q31 */
 static const int invBandTab[64] PROGMEM = {
     0x7fffffff, 0x40000000, 0x2aaaaaab, 0x20000000, 0x1999999a, 0x15555555, 0x12492492, 0x10000000,
@@ -1667,7 +2404,7 @@ static const int8_t negMask[3] = {~0x03, ~0x07, ~0x0f};
 
 bool AACDecoder_AllocateBuffers(void){
 
-    /* here, sizes are: AACDecInfo_t:96 PSInfoBase_t:27364 ProgConfigElement_t*16:1312 PSInfoSBR_t:50788 */
+    /* here, sizes are: AACDecInfo_t:96 PSInfoBase_t:27364 ProgConfigElement_t*16:1312 PSInfoSBR_t:50788 (58876 with AAC_ENABLE_PS) */
 #ifdef AAC_ENABLE_SBR
     if(!m_PSInfoSBR) {m_PSInfoSBR   = (PSInfoSBR_t*)__malloc_heap_psram(sizeof(PSInfoSBR_t));}
 
@@ -1713,6 +2450,9 @@ bool AACDecoder_AllocateBuffers(void){
     m_AACDecInfo->adtsBlocksLeft = 0;
     m_AACDecInfo->tnsUsed = 0;
     m_AACDecInfo->pnsUsed = 0;
+    m_PSInfoBase->frameLength = NSAMPS_LONG;
+    m_aacConcealChans = 0;
+    m_aacConcealFrames = 0;
 
     return true;
 }
@@ -1751,6 +2491,8 @@ int AACFlushCodec()
     /* reset internal codec state (flush overlap buffers, etc.) */
     memset(m_PSInfoBase->overlap, 0,  AAC_MAX_NCHANS * AAC_MAX_NSAMPS * sizeof(int));
     memset(m_PSInfoBase->prevWinShape, 0, AAC_MAX_NCHANS * sizeof(int));
+    m_aacConcealChans = 0;
+    m_aacConcealFrames = 0;
 
     return ERR_AAC_NONE;
 }
@@ -1813,6 +2555,89 @@ bool AACDecoder_IsInit(void) {
 
  **********************************************************************************************************************/
 
+/***********************************************************************************************************************
+ * Function:    AACScanSyncWord
+ *
+ * Description: locate the next byte-aligned 12-bit sync pattern, no further checks
+ *
+ * Inputs:      buffer to search for sync word
+ *              max number of bytes to search in buffer
+ *
+ * Outputs:     none
+ *
+ * Return:      offset to first sync pattern (bytes from start of buf)
+ *              -1 if not found after searching nBytes
+ *
+ * Notes:       one aligned 32-bit load per 4 bytes, words without a 0xff byte are skipped:
+ *                x = ~word has a zero byte where word has 0xff, (x - 0x01010101) & ~x & 0x80808080 is
+ *                non-zero only then
+ **********************************************************************************************************************/
+int AACScanSyncWord(uint8_t *buf, int nBytes)
+{
+    int i, j;
+    uint32_t x;
+
+    /* byte by byte up to a word boundary */
+    for (i = 0; i < nBytes - 1 && ((uintptr_t)(buf + i) & 0x03); i++) {
+        if (buf[i] == SYNCWORDH && (buf[i+1] & SYNCWORDL) == SYNCWORDL)
+            return i;
+    }
+    /* a word at a time, buf[i+4] is the second sync byte for a 0xff in the last byte of the word */
+    for (; i + 4 < nBytes; i += 4) {
+        memcpy(&x, buf + i, 4); // the compiler emits a plain aligned load, no strict aliasing violation
+        x = ~x;
+        if (((x - 0x01010101) & ~x & 0x80808080) == 0)
+            continue;
+        for (j = i; j < i + 4; j++) {
+            if (buf[j] == SYNCWORDH && (buf[j+1] & SYNCWORDL) == SYNCWORDL)
+                return j;
+        }
+    }
+    for (; i < nBytes - 1; i++) {
+        if (buf[i] == SYNCWORDH && (buf[i+1] & SYNCWORDL) == SYNCWORDL)
+            return i;
+    }
+
+    return -1;
+}
+/***********************************************************************************************************************
+ * Function:    AACCheckSyncFrames
+ *
+ * Description: check a sync word candidate, the ADTS header must be valid and the following ADTS_SYNC_FRAMES
+ *                headers must agree on ID, layer, profile, sample rate and channel configuration
+ *
+ * Inputs:      pointer to the candidate ADTS header
+ *              number of valid bytes in buf
+ *
+ * Outputs:     none
+ *
+ * Return:      1 if the candidate starts a frame, 0 if not
+ *
+ * Notes:       headers behind the end of buf can't be checked, the candidate is accepted on the ones in front
+ **********************************************************************************************************************/
+int AACCheckSyncFrames(uint8_t *buf, int nBytes)
+{
+    int n, frameBytes;
+
+    if (nBytes < 7)
+        return 0;
+    /* layer 0, sample rate index, frame length covers at least the header (with CRC if present) */
+    frameBytes = AACGetFrameBytes(buf);
+    if ((buf[1] & 0x06) != 0 || ((buf[2] >> 2) & 0x0f) >= NUM_SAMPLE_RATES || frameBytes < 7 + ((buf[1] & 0x01) ? 0 : 2))
+        return 0;
+
+    for (n = 0; n < ADTS_SYNC_FRAMES; n++) {
+        if (AACGetFrameBytes(buf) + 7 > nBytes)
+            break;
+        frameBytes = AACResyncNextFrame(buf, nBytes);
+        if (frameBytes < 0)
+            return 0;
+        buf += frameBytes;
+        nBytes -= frameBytes;
+    }
+
+    return 1;
+}
 /***********************************************************************************************************************
  * Function:    AACFindSyncWord
  *
@@ -1825,27 +2650,90 @@ bool AACDecoder_IsInit(void) {
  *
  * Return:      offset to first sync word (bytes from start of buf)
  *              -1 if sync not found after searching nBytes
+ *
+ * Notes:       a sync pattern is only accepted if the ADTS headers behind it agree (see AACCheckSyncFrames()),
+ *                so a 0xFFF in an ID3 picture or other garbage doesn't lock the decoder
  **********************************************************************************************************************/
 int AACFindSyncWord(uint8_t *buf, int nBytes)
 {
-    int i;
+    int i, offset;
 
-    /* find byte-aligned syncword (12 bits = 0xFFF) */
     for (i = 0; i < nBytes - 1; i++) {
-        if ( (buf[i+0] & SYNCWORDH) == SYNCWORDH && (buf[i+1] & SYNCWORDL) == SYNCWORDL )
+        offset = AACScanSyncWord(buf + i, nBytes - i);
+        if (offset < 0)
+            return -1;
+        i += offset;
+        if (AACCheckSyncFrames(buf + i, nBytes - i))
             return i;
     }
 
     return -1;
 }
+/***********************************************************************************************************************
+ * Function:    AACGetFrameBytes
+ *
+ * Description: frame length from an ADTS header, without touching the decoder state
+ *
+ * Inputs:      pointer to a 7-byte ADTS header
+ *
+ * Outputs:     none
+ *
+ * Return:      aac_frame_length (header included) in bytes
+ *              -1 if there is no sync word or the length is shorter than the header
+ **********************************************************************************************************************/
+int AACGetFrameBytes(uint8_t *buf)
+{
+    int frameBytes;
+
+    if ((buf[0] & SYNCWORDH) != SYNCWORDH || (buf[1] & SYNCWORDL) != SYNCWORDL)
+        return -1;
+    frameBytes = ((buf[3] & 0x03) << 11) | (buf[4] << 3) | (buf[5] >> 5);
+    if (frameBytes < 7)
+        return -1;
+
+    return frameBytes;
+}
+/***********************************************************************************************************************
+ * Function:    AACResyncNextFrame
+ *
+ * Description: check that the next ADTS header lies exactly one frame length behind the current one
+ *
+ * Inputs:      pointer to the ADTS header of the current (possibly damaged) frame
+ *              number of valid bytes in buf
+ *
+ * Outputs:     none
+ *
+ * Return:      length of the current frame in bytes, the next frame starts there
+ *              -1 if the next header does not follow or differs in the fixed header
+ *
+ * Notes:       the fixed header (ID, layer, CRC flag, profile, sample rate, channel configuration) must match
+ *              used to step over a frame that failed to decode without a byte-wise search
+ **********************************************************************************************************************/
+int AACResyncNextFrame(uint8_t *buf, int nBytes)
+{
+    int frameBytes;
+    uint8_t *next;
+
+    frameBytes = AACGetFrameBytes(buf);
+    if (frameBytes < 0 || frameBytes + 7 > nBytes)
+        return -1;
+    next = buf + frameBytes;
+    if (AACGetFrameBytes(next) < 0 || next[1] != buf[1] || (next[2] & 0xfd) != (buf[2] & 0xfd)
+            || (next[3] & 0xc0) != (buf[3] & 0xc0))
+        return -1;
+
+    return frameBytes;
+}
 //**************************************************************************************
-int AACGetSampRate(){return m_AACDecInfo->sampRate * (m_AACDecInfo->sbrEnabled ? 2 : 1);}
-int AACGetChannels(){return m_AACDecInfo->nChans;}
+int AACGetSampRate(){return m_AACDecInfo->sampRate * (m_AACDecInfo->sbrEnabled && !m_sbrDownsampled ? 2 : 1);}
+int AACGetChannels(){return (m_AACDecInfo->psUsed ? 2 : m_AACDecInfo->nChans);} // PS: mono is decoded as stereo
 int AACGetBitsPerSample(){return 16;}
 int AACGetID() {return m_AACDecInfo->id;} // 0-MPEG4, 1-MPEG2
-uint8_t AACGetProfile() {return (uint8_t)m_AACDecInfo->profile;} // 0-Main, 1-LC, 2-SSR, 3-reserved
+uint8_t AACGetProfile() {return (uint8_t)m_AACDecInfo->profile;} // 0-Main, 1-LC, 2-SSR, 3-reserved, 22-LD
 uint8_t AACGetFormat() {return (uint8_t)m_AACDecInfo->format;}   // 0-unknown 1-ADTS 2-ADIF, 3-RAW
-int AACGetOutputSamps(){return m_AACDecInfo->nChans * AAC_MAX_NSAMPS  * (m_AACDecInfo->sbrEnabled ? 2 : 1);}
+int AACGetOutputSamps(){return AACGetChannels() * m_PSInfoBase->frameLength * (m_AACDecInfo->sbrEnabled && !m_sbrDownsampled ? 2 : 1);}
+void AACDecoder_SetSBRDownsampled(bool ds){m_sbrDownsampled = ds;} // HE-AAC output at the core rate, set before decoding
+void AACDecoder_SetFrameLength(int n){if(m_PSInfoBase) m_PSInfoBase->frameLength = n;} // raw blocks only, checked in SetRawBlockParams
 int AACGetBitrate() {
     uint32_t br = AACGetBitsPerSample() * AACGetChannels() *  AACGetSampRate();
     return (br / m_AACDecInfo->compressionRatio);
@@ -1857,7 +2745,7 @@ int AACGetBitrate() {
  *
  * Inputs:      flag indicating source of parameters
  *              nChans, sampRate,
- *              and profile  0 = main, 1 = LC, 2 = SSR, 3 = reserved
+ *              and profile  0 = main, 1 = LC, 2 = SSR, 3 = reserved, 22 = ER AAC-LD
  *                optionally filled-in
  *
  * Outputs:     updated codec state
@@ -1869,6 +2757,8 @@ int AACGetBitrate() {
  *              if copyLast == 0, then the codec uses the values passed in
  *                aacFrameInfo to configure its internal state (useful when the
  *                source is MP4 format, for example)
+ *              AAC-LD needs the frame length (512 or 480) from the AudioSpecificConfig,
+ *                see AACDecoder_SetFrameLength()
  **************************************************************************************/
 int AACSetRawBlockParams(int copyLast, int nChans, int sampRateCore, int profile)
 {
@@ -1937,7 +2827,7 @@ int AACDecode(uint8_t *inbuf, int *bytesLeft, short *outbuf)
     if (m_AACDecInfo->format == AAC_FF_ADTS) {
         /* can have 1-4 raw data blocks per ADTS frame (header only present for first one) */
         if (m_AACDecInfo->adtsBlocksLeft == 0) {
-            offset = AACFindSyncWord(inptr, bitsAvail >> 3);
+            offset = AACScanSyncWord(inptr, bitsAvail >> 3); /* the frame is at hand, no look-ahead */
             if (offset < 0)
                 return ERR_AAC_INDATA_UNDERFLOW;
             inptr += offset;
@@ -2064,6 +2954,9 @@ int AACDecode(uint8_t *inbuf, int *bytesLeft, short *outbuf)
 
     m_AACDecInfo->compressionRatio = (float)(AACGetOutputSamps()) * 2 / (inptr - inbuf);
 
+    /* fade in after a concealed frame, remember where the muting ramp of the next lost frame starts */
+    ConcealUpdate(outbuf);
+
     /* update pointers */
     m_AACDecInfo->frameCount++;
     *bytesLeft -= (inptr - inbuf);
@@ -2071,6 +2964,92 @@ int AACDecode(uint8_t *inbuf, int *bytesLeft, short *outbuf)
 
     return ERR_AAC_NONE;
 }
+/***********************************************************************************************************************
+ * Function:    AACConcealFrame
+ *
+ * Description: produce one frame of pcm in place of a frame that could not be decoded
+ *
+ * Inputs:      pointer to outbuf, big enough to hold one frame of decoded PCM samples
+ *
+ * Outputs:     plain AAC (LC, LD): the overlap part of the last good frame, i.e. what a frame with an
+ *                all-zero spectrum would give, its falling window half is the muting ramp
+ *              SBR, PS: linear muting ramp from the last output sample of each channel down to 0
+ *              interleaved LRLRLR... if stereo, same layout and length as the last good frame
+ *
+ * Return:      number of output samples (all channels), 0 if no frame has been decoded yet
+ *
+ * Notes:       the overlap buffers are cleared afterwards, so the rising window of the next good frame
+ *                starts from silence, it is faded in as well (see ConcealUpdate())
+ *              with SBR the core output runs through the QMF delay, the tail of the overlap buffer
+ *                would not join the last output sample, hence the ramp
+ *              the remaining raw data blocks of an ADTS frame are dropped, the next call has to start
+ *                at a sync word
+ **********************************************************************************************************************/
+int AACConcealFrame(short *outbuf)
+{
+    int i, ch, nChans, nSamps, ramp;
+    int *over;
+
+    nChans = m_aacConcealChans;
+    nSamps = m_aacConcealSamps;
+    if (nChans < 1 || nChans > AAC_MAX_NCHANS)
+        return 0;
+
+    if (m_aacConcealCore) {
+        for (ch = 0; ch < nChans; ch++) {
+            over = m_PSInfoBase->overlap[ch];
+            for (i = 0; i < nSamps; i++)
+                outbuf[i * nChans + ch] = CLIPTOSHORT((over[i] + (1 << (FBITS_OUT_IMDCT-1))) >> FBITS_OUT_IMDCT);
+        }
+        memset(m_PSInfoBase->overlap, 0, AAC_MAX_NCHANS * AAC_MAX_NSAMPS * sizeof(int));
+    } else {
+        ramp = (nSamps < CONCEAL_RAMP ? nSamps : CONCEAL_RAMP);
+        for (i = 0; i < ramp; i++) {
+            for (ch = 0; ch < nChans; ch++)
+                *outbuf++ = (short)((m_aacConcealLast[ch] * (ramp - i)) / ramp);
+        }
+        memset(outbuf, 0, (nSamps - ramp) * nChans * sizeof(short));
+    }
+
+    for (ch = 0; ch < AAC_MAX_NCHANS; ch++)
+        m_aacConcealLast[ch] = 0;
+    m_AACDecInfo->adtsBlocksLeft = 0;
+    m_aacConcealFrames++;
+
+    return nSamps * nChans;
+}
+/***********************************************************************************************************************
+ * Function:    ConcealUpdate
+ *
+ * Description: fade in the first good frame after a concealed one, remember the layout and the last sample of
+ *                each channel for AACConcealFrame()
+ *
+ * Inputs:      pointer to outbuf with the decoded frame
+ *
+ * Outputs:     outbuf faded in over CONCEAL_RAMP samples if the previous frame was concealed
+ *
+ * Return:      none
+ **********************************************************************************************************************/
+void ConcealUpdate(short *outbuf)
+{
+    int i, ch, nChans, nSamps, ramp;
+
+    nChans = AACGetChannels();
+    nSamps = AACGetOutputSamps() / nChans;
+    if (m_aacConcealFrames) {
+        ramp = (nSamps < CONCEAL_RAMP ? nSamps : CONCEAL_RAMP);
+        for (i = 0; i < ramp; i++) {
+            for (ch = 0; ch < nChans; ch++)
+                outbuf[i * nChans + ch] = (short)((outbuf[i * nChans + ch] * i) / ramp);
+        }
+        m_aacConcealFrames = 0;
+    }
+    for (ch = 0; ch < nChans; ch++)
+        m_aacConcealLast[ch] = outbuf[(nSamps - 1) * nChans + ch];
+    m_aacConcealChans = nChans;
+    m_aacConcealSamps = nSamps;
+    m_aacConcealCore = (!m_AACDecInfo->sbrEnabled && !m_AACDecInfo->psUsed);
+}
 /***********************************************************************************************************************
  * Function:    DecodeLPCCoefs
  *
@@ -2213,12 +3192,17 @@ int TNSFilter(int ch)
         tnsMaxBand = tnsMaxBandTab[m_PSInfoBase->sampRateIdx];
     } else {
         nWindows = NWINDOWS_LONG;
-        winLen = NSAMPS_LONG;
-        nSFB = sfBandTotalLong[m_PSInfoBase->sampRateIdx];
-        maxOrder = tnsMaxOrderLong[m_AACDecInfo->profile];
-        sfbTab = sfBandTabLong + sfBandTabLongOffset[m_PSInfoBase->sampRateIdx];
-        tnsMaxBandTab = tnsMaxBandsLong + tnsMaxBandsLongOffset[m_AACDecInfo->profile];
-        tnsMaxBand = tnsMaxBandTab[m_PSInfoBase->sampRateIdx];
+        winLen = m_PSInfoBase->frameLength;
+        nSFB = GetSFBandTotalLong();
+        sfbTab = GetSFBandTabLong();
+        if (m_AACDecInfo->profile == AAC_PROFILE_LD) {
+            maxOrder = tnsMaxOrderLong[AAC_PROFILE_LC];
+            tnsMaxBand = tnsMaxBandsLD[m_PSInfoBase->frameLength == 480][m_PSInfoBase->sampRateIdx];
+        } else {
+            maxOrder = tnsMaxOrderLong[m_AACDecInfo->profile];
+            tnsMaxBandTab = tnsMaxBandsLong + tnsMaxBandsLongOffset[m_AACDecInfo->profile];
+            tnsMaxBand = tnsMaxBandTab[m_PSInfoBase->sampRateIdx];
+        }
     }
 
     if (tnsMaxBand > icsInfo->maxSFB)
@@ -2561,7 +3545,15 @@ int DecodeNextElement(uint8_t **buf, int *bitOffset, int *bitsAvail)
     GetBits(*bitOffset);
 
     m_AACDecInfo->prevBlockID = m_AACDecInfo->currBlockID;
-    m_AACDecInfo->currBlockID = GetBits(NUM_SYN_ID_BITS);
+    if (m_AACDecInfo->profile == AAC_PROFILE_LD) {
+        /* er_raw_data_block has no element IDs: one SCE (mono) or CPE (stereo), then end of frame */
+        if (m_AACDecInfo->prevBlockID == AAC_ID_INVALID)
+            m_AACDecInfo->currBlockID = (m_PSInfoBase->nChans == 1 ? AAC_ID_SCE : AAC_ID_CPE);
+        else
+            m_AACDecInfo->currBlockID = AAC_ID_END;
+    } else {
+        m_AACDecInfo->currBlockID = GetBits(NUM_SYN_ID_BITS);
+    }
 
     /* set defaults (could be overwritten by DecodeXXXElement(), depending on currBlockID) */
     m_PSInfoBase->commonWin = 0;
@@ -2893,6 +3885,266 @@ void DCT4(int tabidx, int *coef, int gb)
     }
 }
 
+/***********************************************************************************************************************
+ * Function:    CMulShift32
+ *
+ * Description: complex multiply by a conjugated Q31 twiddle, (re + i*im) * (c - i*s) / 2
+ *
+ * Inputs:      pointers to real and imaginary part
+ *              cos and sin of the twiddle, format = Q31
+ *
+ * Outputs:     product in place, gains 1 fraction bit (like MULSHIFT32)
+ *
+ * Return:      none
+ **********************************************************************************************************************/
+inline void CMulShift32(int *re, int *im, int c, int s)
+{
+    int xr = *re, xi = *im;
+
+    *re = MULSHIFT32(c, xr) + MULSHIFT32(s, xi);
+    *im = MULSHIFT32(c, xi) - MULSHIFT32(s, xr);
+}
+
+/***********************************************************************************************************************
+ * Function:    R4PassLD, R3PassLD, R5PassLD
+ *
+ * Description: one radix-4, radix-3 or radix-5 decimation-in-time pass of FFTLD
+ *
+ * Inputs:      buffer of nfft complex samples (re, im interleaved)
+ *              number of complex samples
+ *              span L of the butterflies merged by this pass (product of the radices done so far)
+ *              FFT twiddle table (W_nfft^j), and the step through it for W_(L*r)^1
+ *
+ * Outputs:     processed samples in same buffer
+ *
+ * Return:      none
+ *
+ * Notes:       scales by 1/2: loses at most 1 GB (radix-4), 1 GB (radix-5), 0 GB (radix-3)
+ *              twiddle W^0 is a shift, so the first pass (L = 1) needs no multiplies
+ **********************************************************************************************************************/
+void R4PassLD(int *x, int nfft, int L, const int *twid, int tstep)
+{
+    int b, k, s, c1, s1, c2, s2, c3, s3;
+    int ar, ai, br, bi, cr, ci, dr, di, t0r, t0i, t1r, t1i, t2r, t2i, t3r, t3i;
+    int *xp;
+
+    s = 2 * L;  /* distance between the butterfly inputs, in ints */
+    for (k = 0; k < L; k++) {
+        c1 = twid[2*k*tstep + 0];   s1 = twid[2*k*tstep + 1];
+        c2 = twid[4*k*tstep + 0];   s2 = twid[4*k*tstep + 1];
+        c3 = twid[6*k*tstep + 0];   s3 = twid[6*k*tstep + 1];
+        for (b = k; b < nfft; b += 4*L) {
+            xp = x + 2*b;
+            ar = xp[0]   >> 1;  ai = xp[1]     >> 1;
+            br = xp[s];         bi = xp[s+1];
+            cr = xp[2*s];       ci = xp[2*s+1];
+            dr = xp[3*s];       di = xp[3*s+1];
+            if (k) {
+                CMulShift32(&br, &bi, c1, s1);
+                CMulShift32(&cr, &ci, c2, s2);
+                CMulShift32(&dr, &di, c3, s3);
+            } else {
+                br >>= 1;   bi >>= 1;
+                cr >>= 1;   ci >>= 1;
+                dr >>= 1;   di >>= 1;
+            }
+
+            t0r = ar + cr;  t0i = ai + ci;
+            t1r = ar - cr;  t1i = ai - ci;
+            t2r = br + dr;  t2i = bi + di;
+            t3r = br - dr;  t3i = bi - di;
+
+            xp[0]     = t0r + t2r;  xp[1]     = t0i + t2i;
+            xp[s]     = t1r + t3i;  xp[s+1]   = t1i - t3r;
+            xp[2*s]   = t0r - t2r;  xp[2*s+1] = t0i - t2i;
+            xp[3*s]   = t1r - t3i;  xp[3*s+1] = t1i + t3r;
+        }
+    }
+}
+
+void R3PassLD(int *x, int nfft, int L, const int *twid, int tstep)
+{
+    const int SIN_PI_3 = 0x6ed9eba1;    /* sin(pi/3), format = Q31 */
+    int b, k, s, c1, s1, c2, s2;
+    int ar, ai, br, bi, cr, ci, tr, ti, mr, mi, dr, di;
+    int *xp;
+
+    s = 2 * L;
+    for (k = 0; k < L; k++) {
+        c1 = twid[2*k*tstep + 0];   s1 = twid[2*k*tstep + 1];
+        c2 = twid[4*k*tstep + 0];   s2 = twid[4*k*tstep + 1];
+        for (b = k; b < nfft; b += 3*L) {
+            xp = x + 2*b;
+            ar = xp[0]   >> 1;  ai = xp[1]     >> 1;
+            br = xp[s];         bi = xp[s+1];
+            cr = xp[2*s];       ci = xp[2*s+1];
+            if (k) {
+                CMulShift32(&br, &bi, c1, s1);
+                CMulShift32(&cr, &ci, c2, s2);
+            } else {
+                br >>= 1;   bi >>= 1;
+                cr >>= 1;   ci >>= 1;
+            }
+
+            tr = br + cr;   ti = bi + ci;
+            mr = ar - (tr >> 1);    mi = ai - (ti >> 1);
+            dr = MULSHIFT32(SIN_PI_3, br - cr) << 1;
+            di = MULSHIFT32(SIN_PI_3, bi - ci) << 1;
+
+            xp[0]   = ar + tr;  xp[1]     = ai + ti;
+            xp[s]   = mr + di;  xp[s+1]   = mi - dr;
+            xp[2*s] = mr - di;  xp[2*s+1] = mi + dr;
+        }
+    }
+}
+
+void R5PassLD(int *x, int nfft, int L, const int *twid, int tstep)
+{
+    const int COS_2PI_5 = 0x278dde6e;   /* cos(2*pi/5), format = Q31 */
+    const int COS_4PI_5 = -0x678dde6e;  /* cos(4*pi/5) */
+    const int SIN_2PI_5 = 0x79bc384d;   /* sin(2*pi/5) */
+    const int SIN_4PI_5 = 0x4b3c8c12;   /* sin(4*pi/5) */
+    int b, k, q, s, c[5], sn[5];
+    int vr[5], vi[5], t1r, t1i, t2r, t2i, t3r, t3i, t4r, t4i, m1r, m1i, m2r, m2i, n1r, n1i, n2r, n2i;
+    int *xp;
+
+    s = 2 * L;
+    for (k = 0; k < L; k++) {
+        for (q = 1; q < 5; q++) {
+            c[q]  = twid[2*q*k*tstep + 0];
+            sn[q] = twid[2*q*k*tstep + 1];
+        }
+        for (b = k; b < nfft; b += 5*L) {
+            xp = x + 2*b;
+            for (q = 0; q < 5; q++) {
+                vr[q] = xp[q*s];
+                vi[q] = xp[q*s+1];
+                if (k && q)
+                    CMulShift32(&vr[q], &vi[q], c[q], sn[q]);
+                else {
+                    vr[q] >>= 1;
+                    vi[q] >>= 1;
+                }
+            }
+
+            t1r = vr[1] + vr[4];    t1i = vi[1] + vi[4];
+            t2r = vr[2] + vr[3];    t2i = vi[2] + vi[3];
+            t3r = vr[1] - vr[4];    t3i = vi[1] - vi[4];
+            t4r = vr[2] - vr[3];    t4i = vi[2] - vi[3];
+
+            m1r = vr[0] + ((MULSHIFT32(COS_2PI_5, t1r) + MULSHIFT32(COS_4PI_5, t2r)) << 1);
+            m1i = vi[0] + ((MULSHIFT32(COS_2PI_5, t1i) + MULSHIFT32(COS_4PI_5, t2i)) << 1);
+            m2r = vr[0] + ((MULSHIFT32(COS_4PI_5, t1r) + MULSHIFT32(COS_2PI_5, t2r)) << 1);
+            m2i = vi[0] + ((MULSHIFT32(COS_4PI_5, t1i) + MULSHIFT32(COS_2PI_5, t2i)) << 1);
+            n1r = (MULSHIFT32(SIN_2PI_5, t3r) + MULSHIFT32(SIN_4PI_5, t4r)) << 1;
+            n1i = (MULSHIFT32(SIN_2PI_5, t3i) + MULSHIFT32(SIN_4PI_5, t4i)) << 1;
+            n2r = (MULSHIFT32(SIN_4PI_5, t3r) - MULSHIFT32(SIN_2PI_5, t4r)) << 1;
+            n2i = (MULSHIFT32(SIN_4PI_5, t3i) - MULSHIFT32(SIN_2PI_5, t4i)) << 1;
+
+            /* y1,4 = m1 -/+ i*n1, y2,3 = m2 -/+ i*n2 */
+            xp[0]   = vr[0] + t1r + t2r;    xp[1]     = vi[0] + t1i + t2i;
+            xp[s]   = m1r + n1i;            xp[s+1]   = m1i - n1r;
+            xp[2*s] = m2r + n2i;            xp[2*s+1] = m2i - n2r;
+            xp[3*s] = m2r - n2i;            xp[3*s+1] = m2i + n2r;
+            xp[4*s] = m1r - n1i;            xp[4*s+1] = m1i + n1r;
+        }
+    }
+}
+
+/***********************************************************************************************************************
+ * Function:    FFTLD
+ *
+ * Description: mixed-radix complex FFT for the AAC-LD transform (256 or 240 points)
+ *
+ * Inputs:      table index (0 = 512, 1 = 480 samples per frame)
+ *              buffer of nfft complex samples (re, im interleaved), in digit-reversed order
+ *
+ * Outputs:     forward FFT / 16 in natural order, in same buffer
+ *
+ * Return:      none
+ *
+ * Notes:       decimation in time, one pass per radix in fftRadixLD (4*4*4*4 or 5*3*4*4)
+ *              gain of at most 2 (radix-4), 1.5 (radix-3), 2.5 (radix-5) per pass, 16 or 15 in total
+ **********************************************************************************************************************/
+void FFTLD(int ldIdx, int *x)
+{
+    int pass, r, L, nfft;
+    const int *twid;
+
+    nfft = nmdctTabLD[ldIdx] >> 1;
+    twid = (const int *)twidTabLD + cos4sin4tabLDOffset[ldIdx];
+
+    L = 1;
+    for (pass = 0; pass < 4; pass++) {
+        r = fftRadixLD[ldIdx][pass];
+        if (r == 4)
+            R4PassLD(x, nfft, L, twid, nfft / (4*L));
+        else if (r == 3)
+            R3PassLD(x, nfft, L, twid, nfft / (3*L));
+        else
+            R5PassLD(x, nfft, L, twid, nfft / (5*L));
+        L *= r;
+    }
+}
+
+/***********************************************************************************************************************
+ * Function:    DCT4LD
+ *
+ * Description: type-IV DCT for AAC-LD (n = 512 or 480), same gain (-1/(2n)) and output format as DCT4
+ *
+ * Inputs:      table index (0 = 512, 1 = 480 samples per frame)
+ *              buffer of n samples
+ *              work buffer of n ints (n/2 complex)
+ *              number of guard bits in the input buffer
+ *
+ * Outputs:     processed samples in coef
+ *
+ * Return:      none
+ *
+ * Notes:       n/2-point complex FFT with pre- and post-twiddle, the pre-twiddle writes digit-reversed
+ *              input guard bits are handled as in DCT4 (>> es before, << es with clipping after)
+ *              the FFT runs at full scale (PreMul 64/n, 1/2 per pass), PostMul adds the final 1/8
+ *              peak values (FFT output) are < 3x the input peak, so GBITS_IN_DCT4 = 4 is enough
+ **********************************************************************************************************************/
+void DCT4LD(int ldIdx, int *coef, int *work, int gb)
+{
+    int i, k, m, n, nfft, es, c, s, xr, xi, z;
+    const int *csptr;
+    const uint8_t *perm;
+
+    n = nmdctTabLD[ldIdx];
+    nfft = n >> 1;
+    es = (gb < GBITS_IN_DCT4 ? GBITS_IN_DCT4 - gb : 0);
+
+    /* pre-twiddle into digit-reversed order, v[m] = (x[2m] + i*x[n-1-2m]) * (128/n) * exp(-i*pi*(m + 1/8)/n) / 2 */
+    csptr = cos4sin4tabLD + cos4sin4tabLDOffset[ldIdx];
+    perm = digitRevTabLD + digitRevTabLDOffset[ldIdx];
+    for (i = 0; i < nfft; i++) {
+        m = perm[i];
+        xr = coef[2*m] >> es;
+        xi = coef[n - 1 - 2*m] >> es;
+        CMulShift32(&xr, &xi, csptr[2*m], csptr[2*m + 1]);
+        work[2*i + 0] = xr;
+        work[2*i + 1] = xi;
+    }
+
+    FFTLD(ldIdx, work);
+
+    /* post-twiddle, w = V[k] * exp(-i*pi*(k + 1/8)/n) / 8, X[2k] = -Re(w), X[n-1-2k] = Im(w) */
+    csptr = cos1sin1tabLD + cos4sin4tabLDOffset[ldIdx];
+    for (k = 0; k < nfft; k++) {
+        c = *csptr++;
+        s = *csptr++;
+        xr = work[2*k + 0];
+        xi = work[2*k + 1];
+        CMulShift32(&xr, &xi, c, s);
+        z = -xr;
+        coef[2*k] = (es ? CLIP_2N_SHIFT30(z, es) : z);
+        z = xi;
+        coef[n - 1 - 2*k] = (es ? CLIP_2N_SHIFT30(z, es) : z);
+    }
+}
+
 /***********************************************************************************************************************
  * Function:    BitReverse
  *
@@ -3435,7 +4687,7 @@ void DecodeSpectrumLong(int ch)
     icsInfo = (ch == 1 && m_PSInfoBase->commonWin == 1) ? &(m_PSInfoBase->icsInfo[0]) : &(m_PSInfoBase->icsInfo[ch]);
 
     /* decode long block */
-    sfbTab = sfBandTabLong + sfBandTabLongOffset[m_PSInfoBase->sampRateIdx];
+    sfbTab = GetSFBandTabLong();
     sfbCodeBook = m_PSInfoBase->sfbCodeBook[ch];
     for (sfb = 0; sfb < icsInfo->maxSFB; sfb++) {
         cb = *sfbCodeBook++;
@@ -3456,7 +4708,7 @@ void DecodeSpectrumLong(int ch)
     }
 
     /* fill with zeros above maxSFB */
-    nVals = NSAMPS_LONG - sfbTab[sfb];
+    nVals = m_PSInfoBase->frameLength - sfbTab[sfb];
     UnpackZeros(nVals, coef);
 
     /* add pulse data, if present */
@@ -3470,7 +4722,7 @@ void DecodeSpectrumLong(int ch)
             else
                 coef[offset] -= m_pulseInfo[ch].amp[i];
         }
-        ASSERT(offset < NSAMPS_LONG);
+        ASSERT(offset < m_PSInfoBase->frameLength);
     }
 }
 
@@ -3537,36 +4789,110 @@ void DecodeSpectrumShort(int ch)
     ASSERT(coef == m_PSInfoBase->coef[ch] + NSAMPS_LONG);
 }
 
-#ifndef AAC_ENABLE_SBR
 /***********************************************************************************************************************
- * Function:    DecWindowOverlap
+ * Function:    DecWindowOverlapLD
  *
- * Description: apply synthesis window, do overlap-add, clip to 16-bit PCM,
- *                for winSequence LONG-LONG
+ * Description: apply synthesis window, do overlap-add, clip to 16-bit PCM, for AAC-LD (512 or 480 samples)
  *
- * Inputs:      input buffer (output of type-IV DCT)
+ * Inputs:      table index (0 = 512, 1 = 480 samples per frame)
+ *              input buffer (output of DCT4LD)
  *              overlap buffer (saved from last time)
  *              number of channels
- *              window type (sin or KBD) for input buffer
- *              window type (sin or KBD) for overlap buffer
+ *              window type (sine or low overlap) for input buffer
+ *              window type (sine or low overlap) for overlap buffer
  *
  * Outputs:     one channel, one frame of 16-bit PCM, interleaved by nChans
  *
  * Return:      none
  *
- * Notes:       this processes one channel at a time, but skips every other sample in
- *                the output buffer (pcm) for stereo interleaving
- *              this should fit in registers on ARM
- *
+ * Notes:       same structure as DecWindowOverlap, AAC-LD has only one window sequence (long)
+ *              window_shape 1 is the low overlap window: 0 for the first 3n/8 samples of the
+ *                rising half, then a sine slope of n/4 samples (lowOverlapWindowLD)
  **********************************************************************************************************************/
-void DecWindowOverlap(int *buf0, int *over0, short *pcm0, int nChans, int winTypeCurr, int winTypePrev)
+void DecWindowOverlapLD(int ldIdx, int *buf0, int *over0, short *pcm0, int nChans, int winTypeCurr, int winTypePrev)
 {
-    int in, w0, w1, f0, f1;
+    int i, n, nFlat, in, w0, w1, f0, f1;
     int *buf1, *over1;
     short *pcm1;
-    const int *wndCurr, *wndPrev;
+    const int *wndSin, *wndLow;
 
-    buf0 += (1024 >> 1);
+    n = nmdctTabLD[ldIdx];
+    nFlat = (3 * n) >> 3;
+    wndSin = sinWindowLD + sinWindowLDOffset[ldIdx];
+    wndLow = lowOverlapWindowLD + lowOverlapWindowLDOffset[ldIdx];
+
+    buf0 += (n >> 1);
+    buf1  = buf0  - 1;
+    pcm1  = pcm0 + (n - 1) * nChans;
+    over1 = over0 + n - 1;
+
+    for (i = 0; i < (n >> 1); i++) {
+        /* window pair (w[i], w[n-1-i]) of the rising half for the overlap part */
+        if (winTypePrev == 0) {
+            w0 = wndSin[2*i];               w1 = wndSin[2*i + 1];
+        } else if (i < nFlat) {
+            w0 = 0;                         w1 = 0x7fffffff;
+        } else {
+            w0 = wndLow[2*(i - nFlat)];     w1 = wndLow[2*(i - nFlat) + 1];
+        }
+        in = *buf0++;
+
+        f0 = MULSHIFT32(w0, in);
+        f1 = MULSHIFT32(w1, in);
+
+        in = *over0;
+        *pcm0 = CLIPTOSHORT( (in - f0 + (1 << (FBITS_OUT_IMDCT-1))) >> FBITS_OUT_IMDCT );
+        pcm0 += nChans;
+
+        in = *over1;
+        *pcm1 = CLIPTOSHORT( (in + f1 + (1 << (FBITS_OUT_IMDCT-1))) >> FBITS_OUT_IMDCT );
+        pcm1 -= nChans;
+
+        /* falling half of the current window, saved for the next frame */
+        if (winTypeCurr == 0) {
+            w0 = wndSin[2*i];               w1 = wndSin[2*i + 1];
+        } else if (i < nFlat) {
+            w0 = 0;                         w1 = 0x7fffffff;
+        } else {
+            w0 = wndLow[2*(i - nFlat)];     w1 = wndLow[2*(i - nFlat) + 1];
+        }
+        in = *buf1--;
+
+        *over1-- = MULSHIFT32(w0, in);
+        *over0++ = MULSHIFT32(w1, in);
+    }
+}
+
+#ifndef AAC_ENABLE_SBR
+/***********************************************************************************************************************
+ * Function:    DecWindowOverlap
+ *
+ * Description: apply synthesis window, do overlap-add, clip to 16-bit PCM,
+ *                for winSequence LONG-LONG
+ *
+ * Inputs:      input buffer (output of type-IV DCT)
+ *              overlap buffer (saved from last time)
+ *              number of channels
+ *              window type (sin or KBD) for input buffer
+ *              window type (sin or KBD) for overlap buffer
+ *
+ * Outputs:     one channel, one frame of 16-bit PCM, interleaved by nChans
+ *
+ * Return:      none
+ *
+ * Notes:       this processes one channel at a time, but skips every other sample in
+ *                the output buffer (pcm) for stereo interleaving
+ *              this should fit in registers on ARM
+ *
+ **********************************************************************************************************************/
+void DecWindowOverlap(int *buf0, int *over0, short *pcm0, int nChans, int winTypeCurr, int winTypePrev)
+{
+    int in, w0, w1, f0, f1;
+    int *buf1, *over1;
+    short *pcm1;
+    const int *wndCurr, *wndPrev;
+
+    buf0 += (1024 >> 1);
     buf1  = buf0  - 1;
     pcm1  = pcm0 + (1024 - 1) * nChans;
     over1 = over0 + 1024 - 1;
@@ -3999,12 +5325,29 @@ void DecWindowOverlapShort(int *buf0, int *over0, short *pcm0, int nChans, int w
  **********************************************************************************************************************/
 int IMDCT(int ch, int chOut, short *outbuf)
 {
-    int i;
+    int i, ldIdx;
     ICSInfo_t *icsInfo;
 
     icsInfo = (ch == 1 && m_PSInfoBase->commonWin == 1) ? &(m_PSInfoBase->icsInfo[0]) : &(m_PSInfoBase->icsInfo[ch]);
     outbuf += chOut;
 
+    if (m_AACDecInfo->profile == AAC_PROFILE_LD) {
+        /* AAC-LD: one 512 or 480 sample block, straight to 16-bit PCM (no SBR)
+         * only the first frameLength samples of the overlap buffer are used, the rest is the FFT work buffer
+         */
+        ldIdx = (m_PSInfoBase->frameLength == 480);
+        DCT4LD(ldIdx, m_PSInfoBase->coef[ch], m_PSInfoBase->overlap[chOut] + m_PSInfoBase->frameLength,
+                                                                                          m_PSInfoBase->gbCurrent[ch]);
+        DecWindowOverlapLD(ldIdx, m_PSInfoBase->coef[ch], m_PSInfoBase->overlap[chOut], outbuf, m_AACDecInfo->nChans,
+                                                                  icsInfo->winShape, m_PSInfoBase->prevWinShape[chOut]);
+
+        m_AACDecInfo->rawSampleBuf[ch] = 0;
+        m_AACDecInfo->rawSampleBytes = 0;
+        m_AACDecInfo->rawSampleFBits = 0;
+        m_PSInfoBase->prevWinShape[chOut] = icsInfo->winShape;
+        return 0;
+    }
+
     /* optimized type-IV DCT (operates inplace) */
     if (icsInfo->winSequence == 2) {
         /* 8 short blocks */
@@ -4105,7 +5448,7 @@ void DecodeICSInfo(ICSInfo_t *icsInfo, int sampRateIdx)
         /* long block */
         icsInfo->maxSFB =               GetBits(6);
         icsInfo->predictorDataPresent = GetBits(1);
-        if (icsInfo->predictorDataPresent) {
+        if (icsInfo->predictorDataPresent && m_AACDecInfo->profile != AAC_PROFILE_LD) {   /* LD: LTP, rejected later */
             icsInfo->predictorReset =   GetBits(1);
             if (icsInfo->predictorReset)
                 icsInfo->predictorResetGroupNum = GetBits(5);
@@ -4418,13 +5761,17 @@ void DecodeICS(int ch)
 
     ti = &m_PSInfoBase->tnsInfo[ch];
     ti->tnsDataPresent = GetBits(1);
-    if (ti->tnsDataPresent)
+    if (ti->tnsDataPresent && m_AACDecInfo->profile != AAC_PROFILE_LD)
         DecodeTNSInfo(icsInfo->winSequence, ti, ti->coef);
 
     gi = &m_PSInfoBase->gainControlInfo[ch];
     gi->gainControlDataPresent = GetBits(1);
     if (gi->gainControlDataPresent)
         DecodeGainControlInfo(icsInfo->winSequence, gi);
+
+    /* ER syntax: TNS data comes after the gain control flag */
+    if (ti->tnsDataPresent && m_AACDecInfo->profile == AAC_PROFILE_LD)
+        DecodeTNSInfo(icsInfo->winSequence, ti, ti->coef);
 }
 
 /***********************************************************************************************************************
@@ -4455,10 +5802,21 @@ int DecodeNoiselessData(uint8_t **buf, int *bitOffset, int *bitsAvail, int ch)
 
     DecodeICS(ch);
 
-    if (icsInfo->winSequence == 2)
+    /* AAC-LD: only long blocks, no long term prediction */
+    if (m_AACDecInfo->profile == AAC_PROFILE_LD) {
+        if (icsInfo->winSequence != 0)
+            return ERR_AAC_INVALID_FRAME;
+        if (icsInfo->predictorDataPresent)
+            return ERR_AAC_MPEG4_UNSUPPORTED;
+    }
+
+    if (icsInfo->winSequence == 2) {
         DecodeSpectrumShort(ch);
-    else
+    } else {
+        if (icsInfo->maxSFB > GetSFBandTotalLong())
+            return ERR_AAC_INVALID_FRAME;
         DecodeSpectrumLong(ch);
+    }
 
     bitsUsed = CalcBitsUsed(*buf, *bitOffset);
     *buf += ((bitsUsed + *bitOffset) >> 3);
@@ -4596,6 +5954,7 @@ int UnpackADTSHeader(uint8_t **buf, int *bitOffset, int *bitsAvail)
     m_AACDecInfo->id = m_fhADTS.id;
     m_AACDecInfo->profile = m_fhADTS.profile;
     m_AACDecInfo->sbrEnabled = 0;
+    m_PSInfoBase->frameLength = NSAMPS_LONG;
     m_AACDecInfo->adtsBlocksLeft = m_fhADTS.numRawDataBlocks;
 
     /* update bitstream reader */
@@ -4808,6 +6167,7 @@ int UnpackADIFHeader(uint8_t **buf, int *bitOffset, int *bitsAvail)
     m_AACDecInfo->sampRate = sampRateTab[m_PSInfoBase->sampRateIdx];
     m_AACDecInfo->profile = m_pce[0]->profile;
     m_AACDecInfo->sbrEnabled = 0;
+    m_PSInfoBase->frameLength = NSAMPS_LONG;
 
     /* update bitstream reader */
     bitsUsed = CalcBitsUsed(*buf, *bitOffset);
@@ -4860,9 +6220,19 @@ int SetRawBlockParams(int copyLast, int nChans, int sampRate, int profile)
     m_AACDecInfo->sampRate = sampRateTab[m_PSInfoBase->sampRateIdx];
 
     /* check validity of header */
-    if (m_PSInfoBase->sampRateIdx >= NUM_SAMPLE_RATES || m_PSInfoBase->sampRateIdx < 0 ||
-        m_AACDecInfo->profile != AAC_PROFILE_LC)
+    if (m_PSInfoBase->sampRateIdx >= NUM_SAMPLE_RATES || m_PSInfoBase->sampRateIdx < 0)
+        return ERR_AAC_RAWBLOCK_PARAMS;
+
+    /* LC: 1024 samples per frame, LD: 512 or 480, mono or stereo (channel configuration 1 or 2) */
+    if (m_AACDecInfo->profile == AAC_PROFILE_LC) {
+        if (m_PSInfoBase->frameLength != NSAMPS_LONG)
+            return ERR_AAC_RAWBLOCK_PARAMS;
+    } else if (m_AACDecInfo->profile == AAC_PROFILE_LD) {
+        if (m_PSInfoBase->nChans < 1 || m_PSInfoBase->nChans > 2 || !GetSFBandTabLong())
+            return ERR_AAC_RAWBLOCK_PARAMS;
+    } else {
         return ERR_AAC_RAWBLOCK_PARAMS;
+    }
 
     return ERR_AAC_NONE;
 }
@@ -4889,9 +6259,60 @@ int PrepareRawBlock()
     m_AACDecInfo->bitRate = 0;
     m_AACDecInfo->sbrEnabled = 0;
 
+    /* profile without decoder tables, or frame length without scalefactor band table (AAC-LD below 22 kHz) */
+    if (m_AACDecInfo->profile != AAC_PROFILE_LC && m_AACDecInfo->profile != AAC_PROFILE_LD)
+        return ERR_AAC_RAWBLOCK_PARAMS;
+    if (!GetSFBandTabLong())
+        return ERR_AAC_RAWBLOCK_PARAMS;
+
     return ERR_AAC_NONE;
 }
 
+/***********************************************************************************************************************
+* Function:    GetSFBandTabLong
+*
+* Description: scale factor band table for long blocks of the current frame length
+*
+* Inputs:      none
+*
+* Outputs:     none
+*
+* Return:      pointer to sfb offsets for sampRateIdx (1024: LC, 512/480: AAC-LD),
+*                0 if there is no table for this frame length and sample rate
+***********************************************************************************************************************/
+const uint16_t *GetSFBandTabLong()
+{
+    int idx = m_PSInfoBase->sampRateIdx;
+
+    if (m_PSInfoBase->frameLength == NSAMPS_LONG)
+        return sfBandTabLong + sfBandTabLongOffset[idx];
+    if (m_PSInfoBase->frameLength != 512 && m_PSInfoBase->frameLength != 480)
+        return 0;
+    if (!sfBandTotalLD[m_PSInfoBase->frameLength == 480][idx])
+        return 0;
+
+    return sfBandTabLD + sfBandTabLDOffset[m_PSInfoBase->frameLength == 480][idx];
+}
+
+/***********************************************************************************************************************
+* Function:    GetSFBandTotalLong
+*
+* Description: number of scale factor bands in a long block of the current frame length
+*
+* Inputs:      none
+*
+* Outputs:     none
+*
+* Return:      number of bands, only valid if GetSFBandTabLong() returns a table
+***********************************************************************************************************************/
+int GetSFBandTotalLong()
+{
+    if (m_PSInfoBase->frameLength == NSAMPS_LONG)
+        return sfBandTotalLong[m_PSInfoBase->sampRateIdx];
+
+    return sfBandTotalLD[m_PSInfoBase->frameLength == 480][m_PSInfoBase->sampRateIdx];
+}
+
 /***********************************************************************************************************************
  * Function:    DequantBlock
  *
@@ -5071,8 +6492,8 @@ int AACDequantize(int ch)
         sfbTab = sfBandTabShort + sfBandTabShortOffset[m_PSInfoBase->sampRateIdx];
         nSamps = NSAMPS_SHORT;
     } else {
-        sfbTab = sfBandTabLong + sfBandTabLongOffset[m_PSInfoBase->sampRateIdx];
-        nSamps = NSAMPS_LONG;
+        sfbTab = GetSFBandTabLong();
+        nSamps = m_PSInfoBase->frameLength;
     }
     coef = m_PSInfoBase->coef[ch];
     sfbCodeBook = m_PSInfoBase->sfbCodeBook[ch];
@@ -5367,8 +6788,8 @@ int PNS(int ch)
         sfbTab = sfBandTabShort + sfBandTabShortOffset[m_PSInfoBase->sampRateIdx];
         nSamps = NSAMPS_SHORT;
     } else {
-        sfbTab = sfBandTabLong + sfBandTabLongOffset[m_PSInfoBase->sampRateIdx];
-        nSamps = NSAMPS_LONG;
+        sfbTab = GetSFBandTabLong();
+        nSamps = m_PSInfoBase->frameLength;
     }
     coef = m_PSInfoBase->coef[ch];
     sfbCodeBook = m_PSInfoBase->sfbCodeBook[ch];
@@ -5611,8 +7032,8 @@ int StereoProcess()
         sfbTab = sfBandTabShort + sfBandTabShortOffset[m_PSInfoBase->sampRateIdx];
         nSamps = NSAMPS_SHORT;
     } else {
-        sfbTab = sfBandTabLong + sfBandTabLongOffset[m_PSInfoBase->sampRateIdx];
-        nSamps = NSAMPS_LONG;
+        sfbTab = GetSFBandTabLong();
+        nSamps = m_PSInfoBase->frameLength;
     }
     coefL = m_PSInfoBase->coef[0];
     coefR = m_PSInfoBase->coef[1];
@@ -6551,14 +7972,17 @@ int DecodeSBRBitstream(int chBase) {
  *              base output channel (range = [0, nChans-1])
  *              initialized state structs (SBRHdr, SBRGrid, SBRFreq, SBRChan)
  *
- * Outputs:     2048 samples of decoded 16-bit PCM, after SBR
+ * Outputs:     2048 samples of decoded 16-bit PCM, after SBR (1024 with downsampled SBR)
  *
  * Return:      0 if successful, error code (< 0) if error
  **********************************************************************************************************************/
 int DecodeSBRData(int chBase, short *outbuf) {
 
     int k, l, ch, chBlock, qmfaBands, qmfsBands;
-    int upsampleOnly, gbIdx, gbMask;
+    int upsampleOnly, gbIdx, gbMask, nSampsQMFS, outStride;
+#ifdef AAC_ENABLE_PS
+    int psActive;
+#endif
     int *inbuf;
     short *outptr;
 
@@ -6597,6 +8021,17 @@ int DecodeSBRData(int chBase, short *outbuf) {
         sbrFreq->kStart = 32;
         sbrFreq->numQMFBands = 0;
     }
+    /* output samples per time slot and channel, downsampled SBR stays at the core rate */
+    nSampsQMFS = (m_sbrDownsampled ? 32 : 64);
+#ifdef AAC_ENABLE_PS
+    /* PS is only defined for a single mono SCE */
+    psActive = (m_PSInfoSBR->ps.headerRead && chBlock == 1 && chBase == 0 && m_AACDecInfo->nChans == 1 && !upsampleOnly);
+#endif
+    /* once PS was used the output stays stereo, a mono frame without PS goes to both channels */
+    outStride = m_AACDecInfo->nChans;
+#ifdef AAC_ENABLE_PS
+    if(m_AACDecInfo->psUsed && !psActive && chBlock == 1 && chBase == 0 && m_AACDecInfo->nChans == 1) outStride = 2;
+#endif
 
     for(ch = 0; ch < chBlock; ch++) {
         sbrGrid = &(m_PSInfoSBR->sbrGrid[chBase + ch]);
@@ -6630,8 +8065,8 @@ int DecodeSBRData(int chBase, short *outbuf) {
             for(l = 0; l < 32; l++) {
                 /* step 4 - synthesis QMF */
                 QMFSynthesis(m_PSInfoSBR->XBuf[l + HF_ADJ][0], m_PSInfoSBR->delayQMFS[chBase + ch],
-                        &(m_PSInfoSBR->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, m_AACDecInfo->nChans);
-                outptr += 64 * m_AACDecInfo->nChans;
+                        &(m_PSInfoSBR->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, outStride);
+                outptr += nSampsQMFS * outStride;
             }
         }
         else {
@@ -6662,20 +8097,30 @@ int DecodeSBRData(int chBase, short *outbuf) {
             AdjustHighFreq(sbrHdr, sbrGrid, sbrFreq, sbrChan, ch);
 
             /* step 4 - synthesis QMF */
-            qmfsBands = sbrFreq->kStartPrev + sbrFreq->numQMFBandsPrev;
-            for(l = 0; l < sbrGrid->envTimeBorder[0]; l++) {
-                /* if new envelope starts mid-frame, use old settings until start of first envelope in this frame */
-                QMFSynthesis(m_PSInfoSBR->XBuf[l + HF_ADJ][0], m_PSInfoSBR->delayQMFS[chBase + ch],
-                        &(m_PSInfoSBR->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, m_AACDecInfo->nChans);
-                outptr += 64 * m_AACDecInfo->nChans;
+#ifdef AAC_ENABLE_PS
+            if(psActive) {
+                /* mono SCE with parametric stereo, synthesis for both output channels */
+                DecodePS(sbrGrid->envTimeBorder[0], sbrFreq->kStartPrev + sbrFreq->numQMFBandsPrev,
+                        sbrFreq->kStart + sbrFreq->numQMFBands, outbuf);
             }
+            else
+#endif
+            {
+                qmfsBands = sbrFreq->kStartPrev + sbrFreq->numQMFBandsPrev;
+                for(l = 0; l < sbrGrid->envTimeBorder[0]; l++) {
+                    /* if new envelope starts mid-frame, use old settings until start of first envelope in this frame */
+                    QMFSynthesis(m_PSInfoSBR->XBuf[l + HF_ADJ][0], m_PSInfoSBR->delayQMFS[chBase + ch],
+                            &(m_PSInfoSBR->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, outStride);
+                    outptr += nSampsQMFS * outStride;
+                }
 
-            qmfsBands = sbrFreq->kStart + sbrFreq->numQMFBands;
-            for(; l < 32; l++) {
-                /* use new settings for rest of frame (usually the entire frame, unless the first envelope starts mid-frame) */
-                QMFSynthesis(m_PSInfoSBR->XBuf[l + HF_ADJ][0], m_PSInfoSBR->delayQMFS[chBase + ch],
-                        &(m_PSInfoSBR->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, m_AACDecInfo->nChans);
-                outptr += 64 * m_AACDecInfo->nChans;
+                qmfsBands = sbrFreq->kStart + sbrFreq->numQMFBands;
+                for(; l < 32; l++) {
+                    /* use new settings for rest of frame (usually the entire frame, unless the first envelope starts mid-frame) */
+                    QMFSynthesis(m_PSInfoSBR->XBuf[l + HF_ADJ][0], m_PSInfoSBR->delayQMFS[chBase + ch],
+                            &(m_PSInfoSBR->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, outStride);
+                    outptr += nSampsQMFS * outStride;
+                }
             }
         }
 
@@ -6691,6 +8136,9 @@ int DecodeSBRData(int chBase, short *outbuf) {
 
         if(sbrHdr->count > 0) sbrChan->reset = 0;
     }
+    if(outStride != m_AACDecInfo->nChans) {
+        for(k = 0; k < 32 * nSampsQMFS; k++) outbuf[2 * k + 1] = outbuf[2 * k];
+    }
     sbrFreq->kStartPrev = sbrFreq->kStart;
     sbrFreq->numQMFBandsPrev = sbrFreq->numQMFBands;
 
@@ -9642,12 +11090,18 @@ void QMFSynthesisConv(int *cPtr, int *delay, int dIdx, short *outbuf, int nChans
  *
  * Notes:       assumes MIN_GBITS_IN_QMFS guard bits in input, either from
  *                QMFAnalysis (if upsampling only) or from MapHF (if SBR on)
+ *              with downsampled SBR QMFSynthesisDown is used instead, 32 output samples
  **********************************************************************************************************************/
 void QMFSynthesis(int *inbuf, int *delay, int *delayIdx, int qmfsBands, short *outbuf, int nChans) {
 
     int n, a0, a1, b0, b1, dOff0, dOff1, dIdx;
     int *tBufLo, *tBufHi;
 
+    if (m_sbrDownsampled) {
+        QMFSynthesisDown(inbuf, delay, delayIdx, qmfsBands, outbuf, nChans);
+        return;
+    }
+
     dIdx = *delayIdx;
     tBufLo = delay + dIdx*128 + 0;
     tBufHi = delay + dIdx*128 + 127;
@@ -9714,6 +11168,238 @@ void QMFSynthesis(int *inbuf, int *delay, int *delayIdx, int qmfsBands, short *o
 
     *delayIdx = (*delayIdx == NUM_QMF_DELAY_BUFS - 1 ? 0 : *delayIdx + 1);
 }
+/***********************************************************************************************************************
+ * Function:    FFT16C
+ *
+ * Description: in-place 16-point complex FFT, two radix-4 passes (n = 4*n1 + n2, k = k1 + 4*k2)
+ *
+ * Inputs:      buffer of 16 complex samples, stored as RE{x0}, IM{x0}, RE{x1}, IM{x1} ...
+ *
+ * Outputs:     processed samples in same buffer, natural order
+ *
+ * Return:      none
+ *
+ * Notes:       output is scaled by 1/16 (1/4 in pass 1, 1/2 in the twiddles, 1/2 in pass 2)
+ *              assumes 2 guard bits in, gbOut = gbIn - 1
+ **********************************************************************************************************************/
+void FFT16C(int *x) {
+
+    int n2, k1, ar, ai, br, bi, cr, ci, dr, di, tr, ti, c, s;
+    int buf[32];
+    int *bPtr;
+    const int *twPtr;
+
+    /* pass 1 - 4-point DFT over n1 for each n2, then multiply by W16^(n2*k1)
+     * y0 = a+b+c+d, y1 = (a-c) - j(b-d), y2 = (a+c) - (b+d), y3 = (a-c) + j(b-d)
+     */
+    for (n2 = 0; n2 < 4; n2++) {
+        ar = x[2*(n2 + 0)  + 0] >> 1;   ai = x[2*(n2 + 0)  + 1] >> 1;
+        br = x[2*(n2 + 4)  + 0] >> 1;   bi = x[2*(n2 + 4)  + 1] >> 1;
+        cr = x[2*(n2 + 8)  + 0] >> 1;   ci = x[2*(n2 + 8)  + 1] >> 1;
+        dr = x[2*(n2 + 12) + 0] >> 1;   di = x[2*(n2 + 12) + 1] >> 1;
+
+        bPtr = buf + 8*n2;
+        bPtr[0] = (ar + br + cr + dr) >> 1;
+        bPtr[1] = (ai + bi + ci + di) >> 1;
+        bPtr[2] = (ar - cr + bi - di) >> 1;
+        bPtr[3] = (ai - ci - br + dr) >> 1;
+        bPtr[4] = (ar + cr - br - dr) >> 1;
+        bPtr[5] = (ai + ci - bi - di) >> 1;
+        bPtr[6] = (ar - cr - bi + di) >> 1;
+        bPtr[7] = (ai - ci + br - dr) >> 1;
+
+        /* W16^0 = 1, scale like the twiddle multiplication */
+        bPtr[0] >>= 1;
+        bPtr[1] >>= 1;
+        if (n2 == 0) {
+            for (k1 = 2; k1 < 8; k1++)
+                bPtr[k1] >>= 1;
+            continue;
+        }
+
+        /* (tr + j*ti) * (c - j*s), gain 1/2 from MULSHIFT32 by Q31 */
+        twPtr = (const int *)twidTabFFT16 + 6*(n2 - 1);
+        for (k1 = 1; k1 < 4; k1++) {
+            c = *twPtr++;
+            s = *twPtr++;
+            tr = bPtr[2*k1 + 0];
+            ti = bPtr[2*k1 + 1];
+            bPtr[2*k1 + 0] = MULSHIFT32(c, tr) + MULSHIFT32(s, ti);
+            bPtr[2*k1 + 1] = MULSHIFT32(c, ti) - MULSHIFT32(s, tr);
+        }
+    }
+
+    /* pass 2 - 4-point DFT over n2 for each k1 */
+    for (k1 = 0; k1 < 4; k1++) {
+        ar = buf[8*0 + 2*k1 + 0];   ai = buf[8*0 + 2*k1 + 1];
+        br = buf[8*1 + 2*k1 + 0];   bi = buf[8*1 + 2*k1 + 1];
+        cr = buf[8*2 + 2*k1 + 0];   ci = buf[8*2 + 2*k1 + 1];
+        dr = buf[8*3 + 2*k1 + 0];   di = buf[8*3 + 2*k1 + 1];
+
+        x[2*(k1 + 0)  + 0] = (ar + br + cr + dr) >> 1;
+        x[2*(k1 + 0)  + 1] = (ai + bi + ci + di) >> 1;
+        x[2*(k1 + 4)  + 0] = (ar - cr + bi - di) >> 1;
+        x[2*(k1 + 4)  + 1] = (ai - ci - br + dr) >> 1;
+        x[2*(k1 + 8)  + 0] = (ar + cr - br - dr) >> 1;
+        x[2*(k1 + 8)  + 1] = (ai + ci - bi - di) >> 1;
+        x[2*(k1 + 12) + 0] = (ar - cr - bi + di) >> 1;
+        x[2*(k1 + 12) + 1] = (ai - ci + br - dr) >> 1;
+    }
+}
+/***********************************************************************************************************************
+ * Function:    DCT4_32
+ *
+ * Description: in-place 32-point type-IV DCT, pre-twiddle + 16-point complex FFT + post-twiddle
+ *
+ * Inputs:      buffer of 32 samples
+ *
+ * Outputs:     processed samples in same buffer
+ *
+ * Return:      none
+ *
+ * Notes:       output is scaled by 1/64 (1/2 pre-twiddle, 1/16 FFT, 1/2 post-twiddle), with the pre-twiddle in
+ *                QMFSynthesisDown the same FBITS_LOST_DCT4_64 as the 64-point version in QMFSynthesis
+ *              assumes 2 guard bits in
+ **********************************************************************************************************************/
+void DCT4_32(int *buf) {
+
+    int n, ar, ai, c, s;
+    int tBuf[32];
+    const int *csPtr;
+
+    /* z[n] = (x[2n] + j*x[31-2n]) * exp(-j*pi*(n + 0.25)/32) */
+    csPtr = cos4sin4tab32;
+    for (n = 0; n < 16; n++) {
+        c = *csPtr++;
+        s = *csPtr++;
+        ar = buf[2*n];
+        ai = buf[31 - 2*n];
+        tBuf[2*n + 0] = MULSHIFT32(c, ar) + MULSHIFT32(s, ai);
+        tBuf[2*n + 1] = MULSHIFT32(c, ai) - MULSHIFT32(s, ar);
+    }
+
+    FFT16C(tBuf);
+
+    /* y[k] = Z[k] * exp(-j*pi*k/32), X[2k] = RE{y[k]}, X[31-2k] = -IM{y[k]} */
+    csPtr = cos1sin1tab32;
+    for (n = 0; n < 16; n++) {
+        c = *csPtr++;
+        s = *csPtr++;
+        ar = tBuf[2*n + 0];
+        ai = tBuf[2*n + 1];
+        buf[2*n]      = MULSHIFT32(c, ar) + MULSHIFT32(s, ai);
+        buf[31 - 2*n] = MULSHIFT32(s, ar) - MULSHIFT32(c, ai);
+    }
+}
+/***********************************************************************************************************************
+ * Function:    QMFSynthesisDownConv
+ *
+ * Description: final convolution kernel for downsampled synthesis QMF
+ *
+ * Inputs:      pointer to coefficient table cTabS, every 2nd coefficient is used
+ *              delay buffer of size 32*10 = 320 complex samples (640 ints)
+ *              index for delay ring buffer (range = [0, 9])
+ *              number of channels
+ *
+ * Outputs:     32 consecutive 16-bit PCM samples, interleaved by factor of nChans
+ *
+ * Return:      none
+ *
+ * Notes:       same structure as QMFSynthesisConv with half the ring buffer stride
+ **********************************************************************************************************************/
+void QMFSynthesisDownConv(int *cPtr, int *delay, int dIdx, short *outbuf, int nChans) {
+
+    int k, dOff0, dOff1;
+    U64 sum64;
+
+    dOff0 = (dIdx)*64;
+    dOff1 = dOff0 - 1;
+    if (dOff1 < 0)
+        dOff1 += 640;
+
+    for (k = 0; k <= 31; k++) {
+        sum64.w64 = 0;
+        sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff0]);   dOff0 -= 128; if (dOff0 < 0) {dOff0 += 640;}
+        sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff1]);   dOff1 -= 128; if (dOff1 < 0) {dOff1 += 640;}
+        sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff0]);   dOff0 -= 128; if (dOff0 < 0) {dOff0 += 640;}
+        sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff1]);   dOff1 -= 128; if (dOff1 < 0) {dOff1 += 640;}
+        sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff0]);   dOff0 -= 128; if (dOff0 < 0) {dOff0 += 640;}
+        sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff1]);   dOff1 -= 128; if (dOff1 < 0) {dOff1 += 640;}
+        sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff0]);   dOff0 -= 128; if (dOff0 < 0) {dOff0 += 640;}
+        sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff1]);   dOff1 -= 128; if (dOff1 < 0) {dOff1 += 640;}
+        sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff0]);   dOff0 -= 128; if (dOff0 < 0) {dOff0 += 640;}
+        sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff1]);   dOff1 -= 128; if (dOff1 < 0) {dOff1 += 640;}
+
+        cPtr += 10;     /* prototype c[2*i] */
+        dOff0++;
+        dOff1--;
+        *outbuf = CLIPTOSHORT((sum64.r.hi32 + RND_VAL) >> FBITS_OUT_QMFS);
+        outbuf += nChans;
+    }
+}
+/***********************************************************************************************************************
+ * Function:    QMFSynthesisDown
+ *
+ * Description: 32-subband synthesis QMF for downsampled SBR, output at the core sample rate (4.6.18.4.2)
+ *
+ * Inputs:      32 consecutive complex subband QMF samples, format = Q(FBITS_IN_QMFS)
+ *              delay buffer of size 32*10 = 320 complex samples (640 ints)
+ *              index for delay ring buffer (range = [0, 9])
+ *              number of QMF subbands to process (range = [0, 64], only the lower 32 are used)
+ *              number of channels
+ *
+ * Outputs:     32 consecutive 16-bit PCM samples, interleaved by factor of nChans
+ *              updated delay buffer
+ *              updated delay index
+ *
+ * Return:      none
+ *
+ * Notes:       assumes MIN_GBITS_IN_QMFS guard bits in input
+ *              v[k] = RE{sum(X[n] * exp(j*pi*(n + 0.5)*(2k - 127.5)/64))}, k = [0, 63], the quarter sample offset
+ *                to the 64-subband bank is applied as pre-twiddle, the rest is a 32-point DCT-IV of the real part
+ *                and a DST-IV of the imaginary part (like QMFSynthesis)
+ **********************************************************************************************************************/
+void QMFSynthesisDown(int *inbuf, int *delay, int *delayIdx, int qmfsBands, short *outbuf, int nChans) {
+
+    int n, a, b, xr, xi, c, s, dIdx;
+    int *tBufLo, *tBufHi;
+    const int *csPtr;
+
+    dIdx = *delayIdx;
+    tBufLo = delay + dIdx*64 + 0;
+    tBufHi = delay + dIdx*64 + 32;
+
+    /* Y[n] = X[n] * exp(-j*pi*(n + 0.5)/128), real part in order, imaginary part reversed (DST-IV via DCT-IV) */
+    qmfsBands = MIN(qmfsBands, 32);
+    csPtr = cos1sin1tabQMFS32;
+    for (n = 0; n < qmfsBands; n++) {
+        c = *csPtr++;
+        s = *csPtr++;
+        xr = *inbuf++;
+        xi = *inbuf++;
+        tBufLo[n]      = MULSHIFT32(c, xr) + MULSHIFT32(s, xi);
+        tBufHi[31 - n] = MULSHIFT32(c, xi) - MULSHIFT32(s, xr);
+    }
+    for (     ; n < 32; n++) {
+        tBufLo[n]      = 0;
+        tBufHi[31 - n] = 0;
+    }
+
+    DCT4_32(tBufLo);
+    DCT4_32(tBufHi);
+
+    /* v[n] = s[n] - a[n], v[63-n] = s[n] + a[n], with s[n] = (-1)^n * b[n] */
+    for (n = 0; n < 32; n++) {
+        a = tBufLo[n];
+        b = (n & 0x01) ? -tBufHi[n] : tBufHi[n];
+        tBufLo[n] = b - a;
+        tBufHi[n] = b + a;
+    }
+
+    QMFSynthesisDownConv((int *)cTabS, delay, dIdx, outbuf, nChans);
+
+    *delayIdx = (*delayIdx == NUM_QMF_DELAY_BUFS - 1 ? 0 : *delayIdx + 1);
+}
 /***********************************************************************************************************************
  * Function:    UnpackSBRHeader
  *
@@ -10127,8 +11813,16 @@ void UnpackSBRSingleChannel(int chBase) {
         bitsLeft = 8 * m_PSInfoSBR->extendedDataSize;
 
         /* get ID, unpack extension info, do whatever is necessary with it... */
+#ifdef AAC_ENABLE_PS
+        while(bitsLeft > 7) {
+            bitsLeft -= 2;
+            if(GetBits(2) != EXTENSION_ID_PS) break;
+            bitsLeft -= UnpackPSData();
+        }
+        if(bitsLeft < 0) m_PSInfoSBR->ps.dataAvailable = 0; /* overread, corrupt PS data */
+#endif
         while(bitsLeft > 0) {
-            GetBits(8);
+            GetBits(MIN(bitsLeft, 8));
             bitsLeft -= 8;
         }
     }
@@ -10218,3 +11912,817 @@ void UnpackSBRChannelPair(int chBase) {
         }
     }
 }
+
+#ifdef AAC_ENABLE_PS
+//----------------------------------------------------------------------------------------------------------------------
+//                                 P A R A M E T R I C   S T E R E O   (HE-AACv2)
+//----------------------------------------------------------------------------------------------------------------------
+/* baseline PS decoder (14496-3, 8.6.4): 20 stereo bands, IID/ICC only (IPD/OPD extension is skipped),
+ *   34 band data is mapped down to 20 bands, hybrid filterbank splits QMF bands 0 - 2 into 10 subbands
+ */
+
+/* Huffman trees, [node][bit], entries <= 0 are leaves (-symbol) */
+static const int8_t psHuffIIDdf0[28][2] PROGMEM = {
+    {-14,  1}, { 24,  2}, { 23,  3}, { 22,  4}, { 21,  5}, {-19,  6}, { -9,  7}, {-20,  8}, { -8,  9}, { -7, 10},
+    {-21, 11}, { 20, 12}, { 25, 13}, { 19, 14}, { 15, 17}, { -4, 16}, { -3,  0}, { 18, 26}, { -1, -2}, { -5,-25},
+    {-22, -6}, {-10,-18}, {-17,-11}, {-16,-12}, {-15,-13}, {-23,-24}, {-26, 27}, {-27,-28}
+};
+
+static const int8_t psHuffIIDdt0[28][2] PROGMEM = {
+    {-14,  1}, {-13,  2}, {-15,  3}, {-12,  4}, {-16,  5}, {-11,  6}, {-17,  7}, {-10,  8}, {-18,  9}, { -9, 10},
+    {-19, 11}, { -8, 12}, {-20, 13}, {-21, 14}, { -7, 15}, { 24, 16}, { 17, 20}, { 18, 19}, {-23,  0}, { -1, -2},
+    { 21, 25}, { 22, 23}, { -3, -4}, { -5,-24}, {-22, -6}, { 26, 27}, {-25,-26}, {-27,-28}
+};
+
+static const int8_t psHuffIIDdf1[60][2] PROGMEM = {
+    {  1,-30}, { 52,  2}, {-31,  3}, { 51,  4}, { 50,  5}, { 49,  6}, { 48,  7}, { 44,  8}, { 18,  9}, { 10,-23},
+    {-39, 11}, { 12,-20}, { 28, 13}, {-43, 14}, { 15, 43}, { 57, 16}, { 17, 39}, {  0, -1}, {-38, 19}, { 20,-21},
+    { 34, 21}, {-42, 22}, {-44, 23}, { 24,-15}, { 41, 25}, { 27, 26}, { -2, -3}, { -4, -5}, { 29,-17}, {-45, 30},
+    { 31, 54}, { 33, 32}, { -6, -7}, { -8,-52}, { 35,-18}, { 36,-16}, { 37, 42}, { 38, 40}, { -9,-51}, {-10,-50},
+    {-11,-49}, {-12,-48}, {-13,-47}, {-14,-46}, {-37, 45}, { 46,-22}, {-40, 47}, {-19,-41}, {-24,-36}, {-25,-35},
+    {-26,-34}, {-27,-33}, { 53,-29}, {-28,-32}, { 56, 55}, {-53,-54}, {-55,-56}, { 59, 58}, {-57,-58}, {-59,-60}
+};
+
+static const int8_t psHuffIIDdt1[60][2] PROGMEM = {
+    {  1,-30}, {-31,  2}, {  3,-29}, {  4, 53}, { 51,  5}, {-33,  6}, { 49,  7}, {  8, 25}, { 38,  9}, {-37, 10},
+    { 11, 47}, { 16, 12}, { 13, 22}, { 57, 14}, { 15, 21}, {  0, -1}, {-43, 17}, { 44, 18}, { 20, 19}, { -2, -3},
+    { -4,-56}, { -5,-55}, { 23,-15}, { 24,-13}, { -6,-54}, { 26,-25}, { 48, 27}, { 28, 33}, { 29, 45}, { 30,-18},
+    {-45, 31}, {-47, 32}, { -7,-53}, { 34,-21}, { 35,-19}, { 36, 54}, { 37,-14}, { -8,-52}, { 39,-23}, {-39, 40},
+    {-41, 41}, { 42,-17}, { 43, 55}, { -9,-10}, {-11,-12}, {-42, 46}, {-16,-44}, {-20,-40}, {-22,-38}, {-35, 50},
+    {-24,-36}, { 52,-27}, {-26,-34}, {-28,-32}, {-46, 56}, {-48,-49}, {-50,-51}, { 59, 58}, {-57,-58}, {-59,-60}
+};
+
+static const int8_t psHuffICCdf[14][2] PROGMEM = {
+    { -7,  1}, { -8,  2}, { -6,  3}, { -9,  4}, { -5,  5}, {-10,  6}, { -4,  7}, {-11,  8}, {-12,  9}, { -3, 10},
+    {-13, 11}, { -2, 12}, {-14, 13}, { -1,  0}
+};
+
+static const int8_t psHuffICCdt[14][2] PROGMEM = {
+    { -7,  1}, { -8,  2}, { -6,  3}, { -9,  4}, { -5,  5}, {-10,  6}, { -4,  7}, {-11,  8}, { -3,  9}, {-12, 10},
+    { -2, 11}, {-13, 12}, { -1, 13}, {  0,-14}
+};
+
+static const uint8_t psNumEnvTab[2][4] = {{0, 1, 2, 4}, {1, 2, 3, 4}};
+static const uint8_t psNrParTab[6] = {10, 20, 34, 10, 20, 34};
+
+/* stereo band of hybrid subbands 0 - 11 (4 and 5 are merged into 3 and 2) and of QMF subbands 3 - 63 */
+static const uint8_t psHybridBk[12] = {0, 1, 2, 3, 0, 0, 1, 0, 5, 4, 6, 7};
+static const uint8_t psQmfBk[64] = {
+     0,  0,  0,  8,  9, 10, 11, 12, 13, 14, 14, 15, 15, 15, 16, 16, 16, 16, 17, 17, 17, 17, 17, 18, 18, 18, 18, 18,
+    18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19
+};
+
+/* mixing matrices h11, h12, h21, h22 (Q30) for procedure Ra (iccMode 0 - 2) and Rb (iccMode 3 - 5)
+ *   row = iid index + 7 (default quantization), iid index + 30 (fine quantization), column = icc index
+ */
+static const uint32_t psMixRa[46][8][4] PROGMEM = {
+    0x0514ea90, 0x5a5ded0a, 0x00000000, 0x00000000, 0x04c79307, 0x5a5cb2ef, 0x01b9deb1, 0xff11bd68, 0x0451c165, 0x5a5ac7e9, 0x02ad567f, 0xfe828cc1, 0x03294236, 0x5a55a979, 0x03fa91c2, 0xfd95b515,
+    0x0207adb9, 0x5a502f06, 0x04a89c04, 0xfce2bb95, 0x003af516, 0x5a46280c, 0x05139461, 0xfbe792c9, 0xfd46084a, 0x5a2f4820, 0x0449d3bc, 0xfa43af33, 0xfaf06d79, 0x59fee595, 0x0075cb27, 0xf7d14d1c,
+    0x0b4e2545, 0x59cd03f7, 0x00000000, 0x00000000, 0x0aaeff1d, 0x59c6916e, 0x03b28166, 0xfddf935f, 0x09bc13c5, 0x59bc7d7a, 0x05bf9b9f, 0xfc987d60, 0x0755f830, 0x59a199a7, 0x089a1d5e, 0xfa7bd0d7,
+    0x04f9c825, 0x5984d4e4, 0x0a26c2ce, 0xf8e3a73b, 0x012d2ccd, 0x5950333c, 0x0b3e6ea8, 0xf6a7ae96, 0xfabde16f, 0x58d841b0, 0x0a0209da, 0xf2ee4ff7, 0xf4f0897e, 0x57db1c01, 0x02571462, 0xed695766,
+    0x11b5c099, 0x58c29682, 0x00000000, 0x00000000, 0x10d1bdf6, 0x58b1dece, 0x058bae7d, 0xfc98888d, 0x0f74fe1b, 0x5897be84, 0x08a4f197, 0xfa8d4b49, 0x0bff20fc, 0x5852109c, 0x0d0720bb, 0xf72d77bf,
+    0x0890e81d, 0x580790f8, 0x0f8021c2, 0xf4a2a931, 0x02f9efeb, 0x577f675d, 0x117544c4, 0xf11544a4, 0xf936ade8, 0x5649bb44, 0x105bacf6, 0xeb329c85, 0xef4a5925, 0x53bf0b6a, 0x05de3343, 0xe2972a06,
+    0x1b4a293c, 0x564c2e5c, 0x00000000, 0x00000000, 0x1a1cdfb4, 0x5621982e, 0x07ed8267, 0xfaa4ec79, 0x184e9707, 0x55df1300, 0x0c67d171, 0xf76f1396, 0x13afd2fc, 0x552ddd5f, 0x12e609ec, 0xf226c27b,
+    0x0f0dbec5, 0x5470b97d, 0x16c3199a, 0xee314e85, 0x075e0527, 0x5317e680, 0x1a46c3fa, 0xe8b3e174, 0xf954dc40, 0x500bdf94, 0x1a765f52, 0xdfc0d833, 0xe8b0288d, 0x49b7f8e1, 0x0e2ffc18, 0xd322a7e2,
+    0x24e9f646, 0x52a3d467, 0x00000000, 0x00000000, 0x2397314a, 0x52516fc6, 0x09cb943b, 0xf8b6af6d, 0x218dbcf6, 0x51d0d8df, 0x0f634fed, 0xf45ba575, 0x1c4dd7ca, 0x507aee5e, 0x17b2433a, 0xed3af719,
+    0x16faac18, 0x4f0f08ac, 0x1ce3abc5, 0xe7ef9753, 0x0dfc9d5f, 0x4c7a60eb, 0x22295729, 0xe0b0008a, 0xfcda0040, 0x46b138a0, 0x24c786e5, 0xd532d2d5, 0xe5af7236, 0x3ae943fb, 0x19e34380, 0xc60b679b,
+    0x304c299c, 0x4c8be085, 0x00000000, 0x00000000, 0x2efadd3a, 0x4bf8754e, 0x0b3448b9, 0xf6a0dc58, 0x2cf1bb71, 0x4b12bde8, 0x11aea8b6, 0xf10dfd33, 0x27a738a8, 0x48b20f6b, 0x1b92b2c2, 0xe806e52c,
+    0x2236fc69, 0x462daa08, 0x22168ce0, 0xe16ed41f, 0x18d7b4c0, 0x41a4d9a0, 0x296b24c3, 0xd8a08b90, 0x061ee85d, 0x37a5ae9d, 0x2fe87946, 0xcb702f89, 0xe9424599, 0x240ad13a, 0x2a9bcb94, 0xbc784f42,
+    0x384ba5cd, 0x46df3081, 0x00000000, 0x00000000, 0x371780e5, 0x46144b55, 0x0b943ff7, 0xf56e3c1c, 0x353a3217, 0x44d8a0d4, 0x1254cd06, 0xef2d48af, 0x305a61b7, 0x4197282a, 0x1cd476e2, 0xe5276b2f,
+    0x2b4c4605, 0x3e29835d, 0x23fa901a, 0xddf5e818, 0x2277a18d, 0x380912e5, 0x2c82b279, 0xd49bb4e6, 0x1046666d, 0x2ac29c11, 0x35e441b6, 0xc77b2b58, 0xf1e902c0, 0x11bcee31, 0x3680f6e6, 0xbb62422d,
+    0x40000000, 0x40000000, 0x00000000, 0x00000000, 0x3efbe321, 0x3efbe321, 0x0b5bdf1d, 0xf4a420e3, 0x3d6804db, 0x3d6804db, 0x1208f9a4, 0xedf7065c, 0x394281f2, 0x394281f2, 0x1c96b76b, 0xe3694895,
+    0x34ec7cfd, 0x34ec7cfd, 0x23fcb454, 0xdc034bac, 0x2d413ccd, 0x2d413ccd, 0x2d413ccd, 0xd2bec333, 0x1d033669, 0x1d033669, 0x390bd586, 0xc6f42a7a, 0x00000000, 0x00000000, 0x40000000, 0xc0000000,
+    0x46df3081, 0x384ba5cd, 0x00000000, 0x00000000, 0x46144b55, 0x371780e5, 0x0a91c3e4, 0xf46bc009, 0x44d8a0d4, 0x353a3217, 0x10d2b751, 0xedab32fa, 0x4197282a, 0x305a61b7, 0x1ad894d1, 0xe32b891e,
+    0x3e29835d, 0x2b4c4605, 0x220a17e8, 0xdc056fe6, 0x380912e5, 0x2277a18d, 0x2b644b1a, 0xd37d4d87, 0x2ac29c11, 0x1046666d, 0x3884d4a8, 0xca1bbe4a, 0x11bcee31, 0xf1e902c0, 0x449dbdd3, 0xc97f091a,
+    0x4c8be085, 0x304c299c, 0x00000000, 0x00000000, 0x4bf8754e, 0x2efadd3a, 0x095f23a8, 0xf4cbb747, 0x4b12bde8, 0x2cf1bb71, 0x0ef202cd, 0xee51574a, 0x48b20f6b, 0x27a738a8, 0x17f91ad4, 0xe46d4d3e,
+    0x462daa08, 0x2236fc69, 0x1e912be1, 0xdde97320, 0x41a4d9a0, 0x18d7b4c0, 0x275f7470, 0xd694db3d, 0x37a5ae9d, 0x061ee85d, 0x348fd077, 0xd01786ba, 0x240ad13a, 0xe9424599, 0x4387b0be, 0xd564346c,
+    0x52a3d467, 0x24e9f646, 0x00000000, 0x00000000, 0x52516fc6, 0x2397314a, 0x07495093, 0xf6346bc5, 0x51d0d8df, 0x218dbcf6, 0x0ba45a8b, 0xf09cb013, 0x507aee5e, 0x1c4dd7ca, 0x12c508e7, 0xe84dbcc6,
+    0x4f0f08ac, 0x16faac18, 0x181068ad, 0xe31c543b, 0x4c7a60eb, 0x0dfc9d5f, 0x1f4fff76, 0xddd6a8d7, 0x46b138a0, 0xfcda0040, 0x2acd2d2b, 0xdb38791b, 0x3ae943fb, 0xe5af7236, 0x39f49865, 0xe61cbc80,
+    0x564c2e5c, 0x1b4a293c, 0x00000000, 0x00000000, 0x5621982e, 0x1a1cdfb4, 0x055b1387, 0xf8127d99, 0x55df1300, 0x184e9707, 0x0890ec6a, 0xf3982e8f, 0x552ddd5f, 0x13afd2fc, 0x0dd93d85, 0xed19f614,
+    0x5470b97d, 0x0f0dbec5, 0x11ceb17b, 0xe93ce666, 0x5317e680, 0x075e0527, 0x174c1e8c, 0xe5b93c06, 0x500bdf94, 0xf954dc40, 0x203f27cd, 0xe589a0ae, 0x49b7f8e1, 0xe8b0288d, 0x2cdd581e, 0xf1d003e8,
+    0x58c29682, 0x11b5c099, 0x00000000, 0x00000000, 0x58b1dece, 0x10d1bdf6, 0x03677773, 0xfa745183, 0x5897be84, 0x0f74fe1b, 0x0572b4b7, 0xf75b0e69, 0x5852109c, 0x0bff20fc, 0x08d28841, 0xf2f8df45,
+    0x580790f8, 0x0890e81d, 0x0b5d56cf, 0xf07fde3e, 0x577f675d, 0x02f9efeb, 0x0eeabb5c, 0xee8abb3c, 0x5649bb44, 0xf936ade8, 0x14cd637b, 0xefa4530a, 0x53bf0b6a, 0xef4a5925, 0x1d68d5fa, 0xfa21ccbd,
+    0x59cd03f7, 0x0b4e2545, 0x00000000, 0x00000000, 0x59c6916e, 0x0aaeff1d, 0x02206ca1, 0xfc4d7e9a, 0x59bc7d7a, 0x09bc13c5, 0x036782a0, 0xfa406461, 0x59a199a7, 0x0755f830, 0x05842f29, 0xf765e2a2,
+    0x5984d4e4, 0x04f9c825, 0x071c58c5, 0xf5d93d32, 0x5950333c, 0x012d2ccd, 0x0958516a, 0xf4c19158, 0x58d841b0, 0xfabde16f, 0x0d11b009, 0xf5fdf626, 0x57db1c01, 0xf4f0897e, 0x1296a89a, 0xfda8eb9e,
+    0x5a5ded0a, 0x0514ea90, 0x00000000, 0x00000000, 0x5a5cb2ef, 0x04c79307, 0x00ee4298, 0xfe46214f, 0x5a5ac7e9, 0x0451c165, 0x017d733f, 0xfd52a981, 0x5a55a979, 0x03294236, 0x026a4aeb, 0xfc056e3e,
+    0x5a502f06, 0x0207adb9, 0x031d446b, 0xfb5763fc, 0x5a46280c, 0x003af516, 0x04186d37, 0xfaec6b9f, 0x5a2f4820, 0xfd46084a, 0x05bc50cd, 0xfbb62c44, 0x59fee595, 0xfaf06d79, 0x082eb2e4, 0xff8a34d9,
+    0x00494567, 0x5a825bf2, 0x00000000, 0x00000000, 0x0044ab63, 0x5a825aff, 0x00198e94, 0xfff2e7e3, 0x003dab86, 0x5a825984, 0x002790e2, 0xffeb092e, 0x002c1dad, 0x5a825590, 0x003a806b, 0xffde0447,
+    0x001b10f4, 0x5a825156, 0x004416b7, 0xffd42d1f, 0x00002ea9, 0x5a824997, 0x00494559, 0xffc65cc4, 0xffd50cc8, 0x5a8237ed, 0x003b5ce3, 0xffaf4094, 0xffb6bad4, 0x5a821289, 0x00005d52, 0xff8cb99f,
+    0x00824b8b, 0x5a821bd1, 0x00000000, 0x00000000, 0x007a21da, 0x5a8218d0, 0x002d649e, 0xffe8afcf, 0x006db709, 0x5a82141f, 0x004647f6, 0xffdaacc6, 0x004e9191, 0x5a820798, 0x0067f0f6, 0xffc37ecd,
+    0x00304f38, 0x5a81fa2f, 0x00790220, 0xffb1f9a5, 0x000093bb, 0x5a81e1a4, 0x00824b38, 0xff996176, 0xffb3e937, 0x5a81a9a3, 0x0069c51a, 0xff703c3c, 0xff7db5c4, 0x5a81331d, 0x00012775, 0xff32c36f,
+    0x00e7b173, 0x5a81510b, 0x00000000, 0x00000000, 0x00d93dc4, 0x5a814782, 0x00508c3e, 0xffd67477, 0x00c34129, 0x5a81389a, 0x007cbab1, 0xffbd7c3e, 0x008c16e1, 0x5a8110d1, 0x00b88b67, 0xff942dbb,
+    0x005678a0, 0x5a80e63c, 0x00d6f3c5, 0xff74f517, 0x0001d426, 0x5a80984a, 0x00e7af9a, 0xff49213c, 0xff799c87, 0x5a7fe66f, 0x00bcbc86, 0xfeffcf36, 0xff1855f1, 0x5a7e6e0c, 0x0003a844, 0xfe924563,
+    0x019bf87d, 0x5a7ecff3, 0x00000000, 0x00000000, 0x018279a3, 0x5a7eb192, 0x008ead5d, 0xffb5d9f3, 0x015badb2, 0x5a7e8215, 0x00dcff20, 0xff894953, 0x00fa49c3, 0x5a7e0357, 0x01473964, 0xff3f9077,
+    0x009b8d55, 0x5a7d7bb1, 0x017d79aa, 0xff07d7d2, 0x0005cdca, 0x5a7c8360, 0x019bee05, 0xfeb99fee, 0xff13f79d, 0x5a7a4cca, 0x0151a6b7, 0xfe36c6eb, 0xfe643160, 0x5a759dc7, 0x000b9b49, 0xfd735071,
+    0x02dc5943, 0x5a76e601, 0x00000000, 0x00000000, 0x02afaa3f, 0x5a7684b8, 0x00fbe547, 0xff7b548a, 0x026ba4b1, 0x5a75eca4, 0x01865ac8, 0xff2b9812, 0x01c0bcb5, 0x5a7456c1, 0x0242c3fb, 0xfea7b18f,
+    0x011a3f8f, 0x5a72a459, 0x02a3c624, 0xfe440122, 0x0012771d, 0x5a6f892b, 0x02dc1da8, 0xfdb81388, 0xfe65d1bd, 0x5a6872de, 0x025eb382, 0xfcce0825, 0xfd24951e, 0x5a5973dd, 0x0024eb39, 0xfb70861d,
+    0x0514ea90, 0x5a5ded0a, 0x00000000, 0x00000000, 0x04c79307, 0x5a5cb2ef, 0x01b9deb1, 0xff11bd68, 0x0451c165, 0x5a5ac7e9, 0x02ad567f, 0xfe828cc1, 0x03294236, 0x5a55a979, 0x03fa91c2, 0xfd95b515,
+    0x0207adb9, 0x5a502f06, 0x04a89c04, 0xfce2bb95, 0x003af516, 0x5a46280c, 0x05139461, 0xfbe792c9, 0xfd46084a, 0x5a2f4820, 0x0449d3bc, 0xfa43af33, 0xfaf06d79, 0x59fee595, 0x0075cb27, 0xf7d14d1c,
+    0x072ab79b, 0x5a39b8a1, 0x00000000, 0x00000000, 0x06c05bcb, 0x5a373abe, 0x026799b8, 0xfeacbc3e, 0x061e3b09, 0x5a335599, 0x03bb913e, 0xfde0dbdf, 0x04859bff, 0x5a28f092, 0x058f6bd1, 0xfc8fb08d,
+    0x02f58bb6, 0x5a1dd0ec, 0x0687056a, 0xfb90f668, 0x00768b40, 0x5a097552, 0x0726e230, 0xfa2b9ebf, 0xfc51e707, 0x59db0742, 0x06265e9a, 0xf7d6a4ae, 0xf8e499f6, 0x5978df07, 0x00ec97ae, 0xf45d7a15,
+    0x0a178ef2, 0x59f1fd03, 0x00000000, 0x00000000, 0x098737e8, 0x59ece855, 0x03537648, 0xfe1c4ff1, 0x08aafd19, 0x59e4f732, 0x052b33ae, 0xfcf9b13b, 0x067ebd29, 0x59cfc612, 0x07b963f9, 0xfb19379a,
+    0x045c4268, 0x59b9196b, 0x0919f726, 0xf9ae6778, 0x00ee907d, 0x598f9c9a, 0x0a0c8535, 0xf7b1cadf, 0xfb28c1fe, 0x59310a02, 0x08daf2a8, 0xf4615d00, 0xf6147fdb, 0x58695294, 0x01db1720, 0xef75c0c6,
+    0x0e2b0093, 0x5964d649, 0x00000000, 0x00000000, 0x0d6b20c0, 0x595a7348, 0x048c0ffc, 0xfd4e9660, 0x0c45fccf, 0x594a374e, 0x0713ebe9, 0xfbb07e50, 0x095f5830, 0x591ee82d, 0x0a9ffae3, 0xf90452c3,
+    0x068235dd, 0x58f09569, 0x0c95a0d1, 0xf7003a51, 0x01df9f24, 0x589bde02, 0x0e0b2692, 0xf42dcac1, 0xf9e9f097, 0x57daf449, 0x0ccb4cf1, 0xef7c6216, 0xf253d839, 0x56447ccb, 0x03b6d1c5, 0xe890bc2c,
+    0x13c5ece4, 0x5852ca3c, 0x00000000, 0x00000000, 0x12cf1afd, 0x583d9b4f, 0x06195c66, 0xfc2d7bdc, 0x115554c5, 0x581c811f, 0x0983cfe6, 0xf9e22285, 0x0d9440e4, 0x57c43c84, 0x0e5f8109, 0xf6190265,
+    0x09d91d0d, 0x5765e40d, 0x11256d7a, 0xf33f84fc, 0x03bebcf6, 0x56b986e2, 0x136a4d81, 0xef45795f, 0xf8fb404c, 0x5531e05f, 0x127c5002, 0xe8b3583d, 0xeda53f8c, 0x51fc8d9c, 0x075ac4ef, 0xdf25fa86,
+    0x1b4a293c, 0x564c2e5c, 0x00000000, 0x00000000, 0x1a1cdfb4, 0x5621982e, 0x07ed8267, 0xfaa4ec79, 0x184e9707, 0x55df1300, 0x0c67d171, 0xf76f1396, 0x13afd2fc, 0x552ddd5f, 0x12e609ec, 0xf226c27b,
+    0x0f0dbec5, 0x5470b97d, 0x16c3199a, 0xee314e85, 0x075e0527, 0x5317e680, 0x1a46c3fa, 0xe8b3e174, 0xf954dc40, 0x500bdf94, 0x1a765f52, 0xdfc0d833, 0xe8b0288d, 0x49b7f8e1, 0x0e2ffc18, 0xd322a7e2,
+    0x217a28e9, 0x541744a4, 0x00000000, 0x00000000, 0x2030a28c, 0x53d4b8a8, 0x0931a14e, 0xf964a2b3, 0x1e35fcb2, 0x536cd3bd, 0x0e6c4ceb, 0xf57071f2, 0x191fa210, 0x52585cb3, 0x162012f8, 0xeef454c0,
+    0x13fbf68c, 0x5131c7d4, 0x1adba65c, 0xea1eb25b, 0x0b5c0e1e, 0x4f1a0d13, 0x1f7db0c7, 0xe3774bb5, 0xfb2b4289, 0x4a648f24, 0x2120746b, 0xd8cba9fc, 0xe63b61d1, 0x40b9f47b, 0x155f0a11, 0xca515edc,
+    0x288dd233, 0x50ea74d5, 0x00000000, 0x00000000, 0x273637a4, 0x508550b0, 0x0a58d960, 0xf8038281, 0x2524af9d, 0x4fe7885a, 0x104762a1, 0xf33f0d38, 0x1fcc3cc0, 0x4e446417, 0x192b810f, 0xeb7768f0,
+    0x1a5a35fa, 0x4c86f189, 0x1ed33022, 0xe5b6b035, 0x11187e81, 0x495ff0f0, 0x24c64581, 0xdde3bf03, 0xff2e78ce, 0x4256ddc3, 0x288bb4dd, 0xd1ab856f, 0xe5dc0861, 0x34283ae7, 0x1f013d83, 0xc2231fa3,
+    0x304c299c, 0x4c8be085, 0x00000000, 0x00000000, 0x2efadd3a, 0x4bf8754e, 0x0b3448b9, 0xf6a0dc58, 0x2cf1bb71, 0x4b12bde8, 0x11aea8b6, 0xf10dfd33, 0x27a738a8, 0x48b20f6b, 0x1b92b2c2, 0xe806e52c,
+    0x2236fc69, 0x462daa08, 0x22168ce0, 0xe16ed41f, 0x18d7b4c0, 0x41a4d9a0, 0x296b24c3, 0xd8a08b90, 0x061ee85d, 0x37a5ae9d, 0x2fe87946, 0xcb702f89, 0xe9424599, 0x240ad13a, 0x2a9bcb94, 0xbc784f42,
+    0x384ba5cd, 0x46df3081, 0x00000000, 0x00000000, 0x371780e5, 0x46144b55, 0x0b943ff7, 0xf56e3c1c, 0x353a3217, 0x44d8a0d4, 0x1254cd06, 0xef2d48af, 0x305a61b7, 0x4197282a, 0x1cd476e2, 0xe5276b2f,
+    0x2b4c4605, 0x3e29835d, 0x23fa901a, 0xddf5e818, 0x2277a18d, 0x380912e5, 0x2c82b279, 0xd49bb4e6, 0x1046666d, 0x2ac29c11, 0x35e441b6, 0xc77b2b58, 0xf1e902c0, 0x11bcee31, 0x3680f6e6, 0xbb62422d,
+    0x40000000, 0x40000000, 0x00000000, 0x00000000, 0x3efbe321, 0x3efbe321, 0x0b5bdf1d, 0xf4a420e3, 0x3d6804db, 0x3d6804db, 0x1208f9a4, 0xedf7065c, 0x394281f2, 0x394281f2, 0x1c96b76b, 0xe3694895,
+    0x34ec7cfd, 0x34ec7cfd, 0x23fcb454, 0xdc034bac, 0x2d413ccd, 0x2d413ccd, 0x2d413ccd, 0xd2bec333, 0x1d033669, 0x1d033669, 0x390bd586, 0xc6f42a7a, 0x00000000, 0x00000000, 0x40000000, 0xc0000000,
+    0x46df3081, 0x384ba5cd, 0x00000000, 0x00000000, 0x46144b55, 0x371780e5, 0x0a91c3e4, 0xf46bc009, 0x44d8a0d4, 0x353a3217, 0x10d2b751, 0xedab32fa, 0x4197282a, 0x305a61b7, 0x1ad894d1, 0xe32b891e,
+    0x3e29835d, 0x2b4c4605, 0x220a17e8, 0xdc056fe6, 0x380912e5, 0x2277a18d, 0x2b644b1a, 0xd37d4d87, 0x2ac29c11, 0x1046666d, 0x3884d4a8, 0xca1bbe4a, 0x11bcee31, 0xf1e902c0, 0x449dbdd3, 0xc97f091a,
+    0x4c8be085, 0x304c299c, 0x00000000, 0x00000000, 0x4bf8754e, 0x2efadd3a, 0x095f23a8, 0xf4cbb747, 0x4b12bde8, 0x2cf1bb71, 0x0ef202cd, 0xee51574a, 0x48b20f6b, 0x27a738a8, 0x17f91ad4, 0xe46d4d3e,
+    0x462daa08, 0x2236fc69, 0x1e912be1, 0xdde97320, 0x41a4d9a0, 0x18d7b4c0, 0x275f7470, 0xd694db3d, 0x37a5ae9d, 0x061ee85d, 0x348fd077, 0xd01786ba, 0x240ad13a, 0xe9424599, 0x4387b0be, 0xd564346c,
+    0x50ea74d5, 0x288dd233, 0x00000000, 0x00000000, 0x508550b0, 0x273637a4, 0x07fc7d7f, 0xf5a726a0, 0x4fe7885a, 0x2524af9d, 0x0cc0f2c8, 0xefb89d5f, 0x4e446417, 0x1fcc3cc0, 0x14889710, 0xe6d47ef1,
+    0x4c86f189, 0x1a5a35fa, 0x1a494fcb, 0xe12ccfde, 0x495ff0f0, 0x11187e81, 0x221c40fd, 0xdb39ba7f, 0x4256ddc3, 0xff2e78ce, 0x2e547a91, 0xd7744b23, 0x34283ae7, 0xe5dc0861, 0x3ddce05d, 0xe0fec27d,
+    0x541744a4, 0x217a28e9, 0x00000000, 0x00000000, 0x53d4b8a8, 0x2030a28c, 0x069b5d4d, 0xf6ce5eb2, 0x536cd3bd, 0x1e35fcb2, 0x0a8f8e0e, 0xf193b315, 0x52585cb3, 0x191fa210, 0x110bab40, 0xe9dfed08,
+    0x5131c7d4, 0x13fbf68c, 0x15e14da5, 0xe52459a4, 0x4f1a0d13, 0x0b5c0e1e, 0x1c88b44b, 0xe0824f39, 0x4a648f24, 0xfb2b4289, 0x27345604, 0xdedf8b95, 0x40b9f47b, 0xe63b61d1, 0x35aea124, 0xeaa0f5ef,
+    0x564c2e5c, 0x1b4a293c, 0x00000000, 0x00000000, 0x5621982e, 0x1a1cdfb4, 0x055b1387, 0xf8127d99, 0x55df1300, 0x184e9707, 0x0890ec6a, 0xf3982e8f, 0x552ddd5f, 0x13afd2fc, 0x0dd93d85, 0xed19f614,
+    0x5470b97d, 0x0f0dbec5, 0x11ceb17b, 0xe93ce666, 0x5317e680, 0x075e0527, 0x174c1e8c, 0xe5b93c06, 0x500bdf94, 0xf954dc40, 0x203f27cd, 0xe589a0ae, 0x49b7f8e1, 0xe8b0288d, 0x2cdd581e, 0xf1d003e8,
+    0x5852ca3c, 0x13c5ece4, 0x00000000, 0x00000000, 0x583d9b4f, 0x12cf1afd, 0x03d28424, 0xf9e6a39a, 0x581c811f, 0x115554c5, 0x061ddd7b, 0xf67c301a, 0x57c43c84, 0x0d9440e4, 0x09e6fd9b, 0xf1a07ef7,
+    0x5765e40d, 0x09d91d0d, 0x0cc07b04, 0xeeda9286, 0x56b986e2, 0x03bebcf6, 0x10ba86a1, 0xec95b27f, 0x5531e05f, 0xf8fb404c, 0x174ca7c3, 0xed83affe, 0x51fc8d9c, 0xeda53f8c, 0x20da057a, 0xf8a53b11,
+    0x5964d649, 0x0e2b0093, 0x00000000, 0x00000000, 0x595a7348, 0x0d6b20c0, 0x02b169a0, 0xfb73f004, 0x594a374e, 0x0c45fccf, 0x044f81b0, 0xf8ec1417, 0x591ee82d, 0x095f5830, 0x06fbad3d, 0xf560051d,
+    0x58f09569, 0x068235dd, 0x08ffc5af, 0xf36a5f2f, 0x589bde02, 0x01df9f24, 0x0bd2353f, 0xf1f4d96e, 0x57daf449, 0xf9e9f097, 0x10839dea, 0xf334b30f, 0x56447ccb, 0xf253d839, 0x176f43d4, 0xfc492e3b,
+    0x59f1fd03, 0x0a178ef2, 0x00000000, 0x00000000, 0x59ece855, 0x098737e8, 0x01e3b00f, 0xfcac89b8, 0x59e4f732, 0x08aafd19, 0x03064ec5, 0xfad4cc52, 0x59cfc612, 0x067ebd29, 0x04e6c866, 0xf8469c07,
+    0x59b9196b, 0x045c4268, 0x06519888, 0xf6e608da, 0x598f9c9a, 0x00ee907d, 0x084e3521, 0xf5f37acb, 0x59310a02, 0xfb28c1fe, 0x0b9ea300, 0xf7250d58, 0x58695294, 0xf6147fdb, 0x108a3f3a, 0xfe24e8e0,
+    0x5a39b8a1, 0x072ab79b, 0x00000000, 0x00000000, 0x5a373abe, 0x06c05bcb, 0x015343c2, 0xfd986648, 0x5a335599, 0x061e3b09, 0x021f2421, 0xfc446ec2, 0x5a28f092, 0x04859bff, 0x03704f73, 0xfa70942f,
+    0x5a1dd0ec, 0x02f58bb6, 0x046f0998, 0xf978fa96, 0x5a097552, 0x00768b40, 0x05d46141, 0xf8d91dd0, 0x59db0742, 0xfc51e707, 0x08295b52, 0xf9d9a166, 0x5978df07, 0xf8e499f6, 0x0ba285eb, 0xff136852,
+    0x5a5ded0a, 0x0514ea90, 0x00000000, 0x00000000, 0x5a5cb2ef, 0x04c79307, 0x00ee4298, 0xfe46214f, 0x5a5ac7e9, 0x0451c165, 0x017d733f, 0xfd52a981, 0x5a55a979, 0x03294236, 0x026a4aeb, 0xfc056e3e,
+    0x5a502f06, 0x0207adb9, 0x031d446b, 0xfb5763fc, 0x5a46280c, 0x003af516, 0x04186d37, 0xfaec6b9f, 0x5a2f4820, 0xfd46084a, 0x05bc50cd, 0xfbb62c44, 0x59fee595, 0xfaf06d79, 0x082eb2e4, 0xff8a34d9,
+    0x5a76e601, 0x02dc5943, 0x00000000, 0x00000000, 0x5a7684b8, 0x02afaa3f, 0x0084ab76, 0xff041ab9, 0x5a75eca4, 0x026ba4b1, 0x00d467ee, 0xfe79a538, 0x5a7456c1, 0x01c0bcb5, 0x01584e71, 0xfdbd3c05,
+    0x5a72a459, 0x011a3f8f, 0x01bbfede, 0xfd5c39dc, 0x5a6f892b, 0x0012771d, 0x0247ec78, 0xfd23e258, 0x5a6872de, 0xfe65d1bd, 0x0331f7db, 0xfda14c7e, 0x5a5973dd, 0xfd24951e, 0x048f79e3, 0xffdb14c7,
+    0x5a7ecff3, 0x019bf87d, 0x00000000, 0x00000000, 0x5a7eb192, 0x018279a3, 0x004a260d, 0xff7152a3, 0x5a7e8215, 0x015badb2, 0x0076b6ad, 0xff2300e0, 0x5a7e0357, 0x00fa49c3, 0x00c06f89, 0xfeb8c69c,
+    0x5a7d7bb1, 0x009b8d55, 0x00f8282e, 0xfe828656, 0x5a7c8360, 0x0005cdca, 0x01466012, 0xfe6411fb, 0x5a7a4cca, 0xff13f79d, 0x01c93915, 0xfeae5949, 0x5a759dc7, 0xfe643160, 0x028caf8f, 0xfff464b7,
+    0x5a81510b, 0x00e7b173, 0x00000000, 0x00000000, 0x5a814782, 0x00d93dc4, 0x00298b89, 0xffaf73c2, 0x5a81389a, 0x00c34129, 0x004283c2, 0xff83454f, 0x5a8110d1, 0x008c16e1, 0x006bd245, 0xff477499,
+    0x5a80e63c, 0x005678a0, 0x008b0ae9, 0xff290c3b, 0x5a80984a, 0x0001d426, 0x00b6dec4, 0xff185066, 0x5a7fe66f, 0xff799c87, 0x010030ca, 0xff43437a, 0x5a7e6e0c, 0xff1855f1, 0x016dba9d, 0xfffc57bc,
+    0x5a821bd1, 0x00824b8b, 0x00000000, 0x00000000, 0x5a8218d0, 0x007a21da, 0x00175031, 0xffd29b62, 0x5a82141f, 0x006db709, 0x0025533a, 0xffb9b80a, 0x5a820798, 0x004e9191, 0x003c8133, 0xff980f0a,
+    0x5a81fa2f, 0x00304f38, 0x004e065b, 0xff86fde0, 0x5a81e1a4, 0x000093bb, 0x00669e8a, 0xff7db4c8, 0x5a81a9a3, 0xffb3e937, 0x008fc3c4, 0xff963ae6, 0x5a81331d, 0xff7db5c4, 0x00cd3c91, 0xfffed88b,
+    0x5a825bf2, 0x00494567, 0x00000000, 0x00000000, 0x5a825aff, 0x0044ab63, 0x000d181d, 0xffe6716c, 0x5a825984, 0x003dab86, 0x0014f6d2, 0xffd86f1e, 0x5a825590, 0x002c1dad, 0x0021fbb9, 0xffc57f95,
+    0x5a825156, 0x001b10f4, 0x002bd2e1, 0xffbbe949, 0x5a824997, 0x00002ea9, 0x0039a33c, 0xffb6baa7, 0x5a8237ed, 0xffd50cc8, 0x0050bf6c, 0xffc4a31d, 0x5a821289, 0xffb6bad4, 0x00734661, 0xffffa2ae
+};
+
+static const uint32_t psMixRb[46][8][4] PROGMEM = {
+    0x0514ea90, 0x5a5ded0a, 0x00000000, 0x00000000, 0x04c36d5a, 0x5a5de9e1, 0xfe3acf8b, 0x0017e36c, 0x0447506e, 0x5a5de6ed, 0xfd421872, 0x00213b9d, 0x030f5395, 0x5a5de632, 0xfbf15af8, 0x00232b49,
+    0x01df9460, 0x5a5de98f, 0xfb46b550, 0x001911c0, 0x0041406b, 0x5a5decf7, 0xfaecb8a2, 0x0003aa2d, 0x0041406b, 0x5a5decf7, 0xfaecb8a2, 0x0003aa2d, 0x0041406b, 0x5a5decf7, 0xfaecb8a2, 0x0003aa2d,
+    0x0b4e2545, 0x59cd03f7, 0x00000000, 0x00000000, 0x0a9cf618, 0x59ccb6a5, 0xfc1ae77c, 0x0075d7f0, 0x098da49a, 0x59cc6d0b, 0xf9f4735c, 0x00a4a329, 0x06dcc927, 0x59cc57f5, 0xf7040c1b, 0x00afc398,
+    0x0436bde3, 0x59ccab8a, 0xf58268e7, 0x007e0569, 0x00930817, 0x59cd0210, 0xf4b59777, 0x00127c7d, 0x00930817, 0x59cd0210, 0xf4b59777, 0x00127c7d, 0x00930817, 0x59cd0210, 0xf4b59777, 0x00127c7d,
+    0x11b5c099, 0x58c29682, 0x00000000, 0x00000000, 0x10abd101, 0x58c0c546, 0xfa0614a6, 0x011f6061, 0x0f10c041, 0x58befc4c, 0xf6b0a511, 0x0194988b, 0x0ae9f1d7, 0x58be5839, 0xf20d74c6, 0x01b71cb8,
+    0x06bdb644, 0x58c05b44, 0xef9f86f4, 0x013e6fdb, 0x00ec0f76, 0x58c28a0b, 0xee5065b9, 0x002f0955, 0x00ec0f76, 0x58c28a0b, 0xee5065b9, 0x002f0955, 0x00ec0f76, 0x58c28a0b, 0xee5065b9, 0x002f0955,
+    0x1b4a293c, 0x564c2e5c, 0x00000000, 0x00000000, 0x19d92ca0, 0x5641fa37, 0xf73f9642, 0x029f5f07, 0x179390d7, 0x563738ae, 0xf241b4c0, 0x03c21b9a, 0x1173e923, 0x5631663b, 0xeb055184, 0x043f7b67,
+    0x0af5c615, 0x563d3668, 0xe702067b, 0x032d1cf1, 0x0183fe90, 0x564bd768, 0xe4c09f13, 0x007a81d2, 0x0183fe90, 0x564bd768, 0xe4c09f13, 0x007a81d2, 0x0183fe90, 0x564bd768, 0xe4c09f13, 0x007a81d2,
+    0x24e9f646, 0x52a3d467, 0x00000000, 0x00000000, 0x2342ec42, 0x52820fd8, 0xf5143599, 0x04aad5da, 0x209999e6, 0x525aec62, 0xeeaedc5f, 0x06dad7b3, 0x190516d8, 0x5239ecda, 0xe4dbdcd2, 0x08422f69,
+    0x103e5abe, 0x52618f23, 0xdeda2316, 0x06893555, 0x024dc4ca, 0x52a2320f, 0xdb2875a7, 0x0106f25f, 0x024dc4ca, 0x52a2320f, 0xdb2875a7, 0x0106f25f, 0x024dc4ca, 0x52a2320f, 0xdb2875a7, 0x0106f25f,
+    0x304c299c, 0x4c8be085, 0x00000000, 0x00000000, 0x2eb2f08c, 0x4c2c3428, 0xf3ad54db, 0x078e0646, 0x2c163a5a, 0x4badde8c, 0xec46e242, 0x0b7d5b86, 0x24362294, 0x4af951c1, 0xe00a7d5c, 0x0f6f9166,
+    0x19a3f9b1, 0x4b440968, 0xd7121545, 0x0df179c5, 0x03ffbf34, 0x4c814a25, 0xcfde4b12, 0x02841212, 0x03ffbf34, 0x4c814a25, 0xcfde4b12, 0x02841212, 0x03ffbf34, 0x4c814a25, 0xcfde4b12, 0x02841212,
+    0x384ba5cd, 0x46df3081, 0x00000000, 0x00000000, 0x36eeb15e, 0x4636cd7d, 0xf3afd122, 0x09a22107, 0x34ba7dda, 0x454378a0, 0xec479a5d, 0x0f03356f, 0x2e2aae1d, 0x4357c9e2, 0xdfc8ea98, 0x1615c2cd,
+    0x24da6b14, 0x42e13ee6, 0xd571a0c8, 0x17733034, 0x0783aeb0, 0x469f6e5f, 0xc8355125, 0x05efb3af, 0x0783aeb0, 0x469f6e5f, 0xc8355125, 0x05efb3af, 0x0783aeb0, 0x469f6e5f, 0xc8355125, 0x05efb3af,
+    0x40000000, 0x40000000, 0x00000000, 0x00000000, 0x3efbe321, 0x3efbe321, 0xf4a420e3, 0x0b5bdf1d, 0x3d6804db, 0x3d6804db, 0xedf7065c, 0x1208f9a4, 0x394281f2, 0x394281f2, 0xe3694895, 0x1c96b76b,
+    0x34ec7cfd, 0x34ec7cfd, 0xdc034bac, 0x23fcb454, 0x2e5f55f9, 0x2e5f55f9, 0xd3e41b76, 0x2c1be48a, 0x2e5f55f9, 0x2e5f55f9, 0xd3e41b76, 0x2c1be48a, 0x2e5f55f9, 0x2e5f55f9, 0xd3e41b76, 0x2c1be48a,
+    0x46df3081, 0x384ba5cd, 0x00000000, 0x00000000, 0x4636cd7d, 0x36eeb15e, 0xf65ddef9, 0x0c502ede, 0x454378a0, 0x34ba7dda, 0xf0fcca91, 0x13b865a3, 0x4357c9e2, 0x2e2aae1d, 0xe9ea3d33, 0x20371568,
+    0x42e13ee6, 0x24da6b14, 0xe88ccfcc, 0x2a8e5f38, 0x469f6e5f, 0x0783aeb0, 0xfa104c51, 0x37caaedb, 0x469f6e5f, 0x0783aeb0, 0xfa104c51, 0x37caaedb, 0x469f6e5f, 0x0783aeb0, 0xfa104c51, 0x37caaedb,
+    0x4c8be085, 0x304c299c, 0x00000000, 0x00000000, 0x4c2c3428, 0x2eb2f08c, 0xf871f9ba, 0x0c52ab25, 0x4badde8c, 0x2c163a5a, 0xf482a47a, 0x13b91dbe, 0x4af951c1, 0x24362294, 0xf0906e9a, 0x1ff582a4,
+    0x4b440968, 0x19a3f9b1, 0xf20e863b, 0x28edeabb, 0x4c814a25, 0x03ffbf34, 0xfd7bedee, 0x3021b4ee, 0x4c814a25, 0x03ffbf34, 0xfd7bedee, 0x3021b4ee, 0x4c814a25, 0x03ffbf34, 0xfd7bedee, 0x3021b4ee,
+    0x52a3d467, 0x24e9f646, 0x00000000, 0x00000000, 0x52820fd8, 0x2342ec42, 0xfb552a26, 0x0aebca67, 0x525aec62, 0x209999e6, 0xf925284d, 0x115123a1, 0x5239ecda, 0x190516d8, 0xf7bdd097, 0x1b24232e,
+    0x52618f23, 0x103e5abe, 0xf976caab, 0x2125dcea, 0x52a2320f, 0x024dc4ca, 0xfef90da1, 0x24d78a59, 0x52a2320f, 0x024dc4ca, 0xfef90da1, 0x24d78a59, 0x52a2320f, 0x024dc4ca, 0xfef90da1, 0x24d78a59,
+    0x564c2e5c, 0x1b4a293c, 0x00000000, 0x00000000, 0x5641fa37, 0x19d92ca0, 0xfd60a0f9, 0x08c069be, 0x563738ae, 0x179390d7, 0xfc3de466, 0x0dbe4b40, 0x5631663b, 0x1173e923, 0xfbc08499, 0x14faae7c,
+    0x563d3668, 0x0af5c615, 0xfcd2e30f, 0x18fdf985, 0x564bd768, 0x0183fe90, 0xff857e2e, 0x1b3f60ed, 0x564bd768, 0x0183fe90, 0xff857e2e, 0x1b3f60ed, 0x564bd768, 0x0183fe90, 0xff857e2e, 0x1b3f60ed,
+    0x58c29682, 0x11b5c099, 0x00000000, 0x00000000, 0x58c0c546, 0x10abd101, 0xfee09f9f, 0x05f9eb5a, 0x58befc4c, 0x0f10c041, 0xfe6b6775, 0x094f5aef, 0x58be5839, 0x0ae9f1d7, 0xfe48e348, 0x0df28b3a,
+    0x58c05b44, 0x06bdb644, 0xfec19025, 0x1060790c, 0x58c28a0b, 0x00ec0f76, 0xffd0f6ab, 0x11af9a47, 0x58c28a0b, 0x00ec0f76, 0xffd0f6ab, 0x11af9a47, 0x58c28a0b, 0x00ec0f76, 0xffd0f6ab, 0x11af9a47,
+    0x59cd03f7, 0x0b4e2545, 0x00000000, 0x00000000, 0x59ccb6a5, 0x0a9cf618, 0xff8a2810, 0x03e51884, 0x59cc6d0b, 0x098da49a, 0xff5b5cd7, 0x060b8ca4, 0x59cc57f5, 0x06dcc927, 0xff503c68, 0x08fbf3e5,
+    0x59ccab8a, 0x0436bde3, 0xff81fa97, 0x0a7d9719, 0x59cd0210, 0x00930817, 0xffed8383, 0x0b4a6889, 0x59cd0210, 0x00930817, 0xffed8383, 0x0b4a6889, 0x59cd0210, 0x00930817, 0xffed8383, 0x0b4a6889,
+    0x5a5ded0a, 0x0514ea90, 0x00000000, 0x00000000, 0x5a5de9e1, 0x04c36d5a, 0xffe81c94, 0x01c53075, 0x5a5de6ed, 0x0447506e, 0xffdec463, 0x02bde78e, 0x5a5de632, 0x030f5395, 0xffdcd4b7, 0x040ea508,
+    0x5a5de98f, 0x01df9460, 0xffe6ee40, 0x04b94ab0, 0x5a5decf7, 0x0041406b, 0xfffc55d3, 0x0513475e, 0x5a5decf7, 0x0041406b, 0xfffc55d3, 0x0513475e, 0x5a5decf7, 0x0041406b, 0xfffc55d3, 0x0513475e,
+    0x00494567, 0x5a825bf2, 0x00000000, 0x00000000, 0x0044a7b5, 0x5a825bf2, 0xffe6678c, 0x0000136a, 0x003da266, 0x5a825bf2, 0xffd860e8, 0x00001afb, 0x002c07c5, 0x5a825bf2, 0xffc56f17, 0x00001c7e,
+    0x001af008, 0x5a825bf2, 0xffbbdc3c, 0x00001448, 0x0003a9e1, 0x5a825bf2, 0xffb6d20f, 0x000002f6, 0x0003a9e1, 0x5a825bf2, 0xffb6d20f, 0x000002f6, 0x0003a9e1, 0x5a825bf2, 0xffb6d20f, 0x000002f6,
+    0x00824b8b, 0x5a821bd1, 0x00000000, 0x00000000, 0x007a1644, 0x5a821bd1, 0xffd27c41, 0x00003d65, 0x006d9a47, 0x5a821bd1, 0xffb98b38, 0x00005552, 0x004e4c6b, 0x5a821bd1, 0xff97dae9, 0x00005a18,
+    0x002fe72b, 0x5a821bd1, 0xff86d48a, 0x00004022, 0x000683d4, 0x5a821bd1, 0xff7dde2e, 0x0000095e, 0x000683d4, 0x5a821bd1, 0xff7dde2e, 0x0000095e, 0x000683d4, 0x5a821bd1, 0xff7dde2e, 0x0000095e,
+    0x00e7b173, 0x5a81510b, 0x00000000, 0x00000000, 0x00d91962, 0x5a81510a, 0xffaf11e4, 0x0000c222, 0x00c2e6bf, 0x5a815109, 0xff82b836, 0x00010dca, 0x008b3cea, 0x5a815109, 0xff46cfed, 0x00011ce7,
+    0x00552fe2, 0x5a81510a, 0xff288920, 0x0000cace, 0x000b95f8, 0x5a81510b, 0xff1898c1, 0x00001d9f, 0x000b95f8, 0x5a81510b, 0xff1898c1, 0x00001d9f, 0x000b95f8, 0x5a81510b, 0xff1898c1, 0x00001d9f,
+    0x019bf87d, 0x5a7ecff3, 0x00000000, 0x00000000, 0x01820809, 0x5a7ecfeb, 0xff702063, 0x000265bb, 0x015a92d2, 0x5a7ecfe3, 0xff21464a, 0x000354fb, 0x00f79c86, 0x5a7ecfe1, 0xfeb6bee5, 0x000384e6,
+    0x00977f92, 0x5a7ecfea, 0xfe80e593, 0x0002815a, 0x00149ae3, 0x5a7ecff3, 0xfe648b82, 0x00005daf, 0x00149ae3, 0x5a7ecff3, 0xfe648b82, 0x00005daf, 0x00149ae3, 0x5a7ecff3, 0xfe648b82, 0x00005daf,
+    0x02dc5943, 0x5a76e601, 0x00000000, 0x00000000, 0x02ae4b5a, 0x5a76e5b0, 0xff0064c1, 0x0007931e, 0x02683791, 0x5a76e564, 0xfe74423f, 0x000a87ac, 0x01b85d39, 0x5a76e552, 0xfdb6d6a8, 0x000b2075,
+    0x010d7942, 0x5a76e5a8, 0xfd5707fc, 0x0007ec75, 0x0024a76c, 0x5a76e5ff, 0xfd2491b5, 0x0001285c, 0x0024a76c, 0x5a76e5ff, 0xfd2491b5, 0x0001285c, 0x0024a76c, 0x5a76e5ff, 0xfd2491b5, 0x0001285c,
+    0x0514ea90, 0x5a5ded0a, 0x00000000, 0x00000000, 0x04c36d5a, 0x5a5de9e1, 0xfe3acf8b, 0x0017e36c, 0x0447506e, 0x5a5de6ed, 0xfd421872, 0x00213b9d, 0x030f5395, 0x5a5de632, 0xfbf15af8, 0x00232b49,
+    0x01df9460, 0x5a5de98f, 0xfb46b550, 0x001911c0, 0x0041406b, 0x5a5decf7, 0xfaecb8a2, 0x0003aa2d, 0x0041406b, 0x5a5decf7, 0xfaecb8a2, 0x0003aa2d, 0x0041406b, 0x5a5decf7, 0xfaecb8a2, 0x0003aa2d,
+    0x072ab79b, 0x5a39b8a1, 0x00000000, 0x00000000, 0x06b8719b, 0x5a39ac23, 0xfd829d46, 0x002f79de, 0x060a293e, 0x5a39a067, 0xfc2449f9, 0x00421e1d, 0x0452f721, 0x5a399d61, 0xfa48d8fc, 0x00461f52,
+    0x02a63627, 0x5a39aabe, 0xf9573cb6, 0x00320e7b, 0x005c511e, 0x5a39b855, 0xf8d79b57, 0x000752de, 0x005c511e, 0x5a39b855, 0xf8d79b57, 0x000752de, 0x005c511e, 0x5a39b855, 0xf8d79b57, 0x000752de,
+    0x0a178ef2, 0x59f1fd03, 0x00000000, 0x00000000, 0x09787539, 0x59f1cbe7, 0xfc83603b, 0x005dfcb8, 0x08852926, 0x59f19d5f, 0xfa975469, 0x00832a9d, 0x061d037e, 0x59f1907f, 0xf7f86579, 0x008bb762,
+    0x03c03f54, 0x59f1c565, 0xf6a18584, 0x0064062d, 0x0082d217, 0x59f1fbd1, 0xf5ebc17f, 0x000ea8d5, 0x0082d217, 0x59f1fbd1, 0xf5ebc17f, 0x000ea8d5, 0x0082d217, 0x59f1fbd1, 0xf5ebc17f, 0x000ea8d5,
+    0x0e2b0093, 0x5964d649, 0x00000000, 0x00000000, 0x0d509cdc, 0x5964179c, 0xfb28711a, 0x00b8a238, 0x0c00f0e7, 0x59635fda, 0xf8794c69, 0x0102bb28, 0x08a697e2, 0x5963260b, 0xf4c797d1, 0x0115fc9f,
+    0x0552e280, 0x5963f625, 0xf2decbd9, 0x00c82e53, 0x00ba02a6, 0x5964d170, 0xf1d9c54a, 0x001d711f, 0x00ba02a6, 0x5964d170, 0xf1d9c54a, 0x001d711f, 0x00ba02a6, 0x5964d170, 0xf1d9c54a, 0x001d711f,
+    0x13c5ece4, 0x5852ca3c, 0x00000000, 0x00000000, 0x12a25f01, 0x584ff7ac, 0xf962e1db, 0x0165412c, 0x10de03f0, 0x584d28b6, 0xf5ae7105, 0x01f89682, 0x0c43984e, 0x584c1026, 0xf07d5a8d, 0x022780e8,
+    0x07985b7e, 0x584f3783, 0xedbe65b3, 0x0191f546, 0x010a699a, 0x5852b628, 0xec41171a, 0x003b8f54, 0x010a699a, 0x5852b628, 0xec41171a, 0x003b8f54, 0x010a699a, 0x5852b628, 0xec41171a, 0x003b8f54,
+    0x1b4a293c, 0x564c2e5c, 0x00000000, 0x00000000, 0x19d92ca0, 0x5641fa37, 0xf73f9642, 0x029f5f07, 0x179390d7, 0x563738ae, 0xf241b4c0, 0x03c21b9a, 0x1173e923, 0x5631663b, 0xeb055184, 0x043f7b67,
+    0x0af5c615, 0x563d3668, 0xe702067b, 0x032d1cf1, 0x0183fe90, 0x564bd768, 0xe4c09f13, 0x007a81d2, 0x0183fe90, 0x564bd768, 0xe4c09f13, 0x007a81d2, 0x0183fe90, 0x564bd768, 0xe4c09f13, 0x007a81d2,
+    0x217a28e9, 0x541744a4, 0x00000000, 0x00000000, 0x1fdfec1c, 0x54004d96, 0xf5c43566, 0x03e21803, 0x1d501bd8, 0x53e6a196, 0xefd46f99, 0x05a64334, 0x162a51b8, 0x53d42e4b, 0xe6e96767, 0x06a2355d,
+    0x0e2e7edd, 0x53ef453d, 0xe1acceff, 0x051fabce, 0x01fce7dd, 0x5416516a, 0xde94f697, 0x00ca401c, 0x01fce7dd, 0x5416516a, 0xde94f697, 0x00ca401c, 0x01fce7dd, 0x5416516a, 0xde94f697, 0x00ca401c,
+    0x288dd233, 0x50ea74d5, 0x00000000, 0x00000000, 0x26e1ab5b, 0x50b9a4e2, 0xf4794ada, 0x058d3798, 0x242b5cb6, 0x507ebbb3, 0xeda8a368, 0x083dcc69, 0x1c46bd48, 0x5043e148, 0xe2ee08a6, 0x0a3db429,
+    0x12bb2575, 0x507b4cf8, 0xdc07eaea, 0x085f0f45, 0x02b45943, 0x50e78fdc, 0xd7894a5f, 0x015a45b1, 0x02b45943, 0x50e78fdc, 0xd7894a5f, 0x015a45b1, 0x02b45943, 0x50e78fdc, 0xd7894a5f, 0x015a45b1,
+    0x304c299c, 0x4c8be085, 0x00000000, 0x00000000, 0x2eb2f08c, 0x4c2c3428, 0xf3ad54db, 0x078e0646, 0x2c163a5a, 0x4badde8c, 0xec46e242, 0x0b7d5b86, 0x24362294, 0x4af951c1, 0xe00a7d5c, 0x0f6f9166,
+    0x19a3f9b1, 0x4b440968, 0xd7121545, 0x0df179c5, 0x03ffbf34, 0x4c814a25, 0xcfde4b12, 0x02841212, 0x03ffbf34, 0x4c814a25, 0xcfde4b12, 0x02841212, 0x03ffbf34, 0x4c814a25, 0xcfde4b12, 0x02841212,
+    0x384ba5cd, 0x46df3081, 0x00000000, 0x00000000, 0x36eeb15e, 0x4636cd7d, 0xf3afd122, 0x09a22107, 0x34ba7dda, 0x454378a0, 0xec479a5d, 0x0f03356f, 0x2e2aae1d, 0x4357c9e2, 0xdfc8ea98, 0x1615c2cd,
+    0x24da6b14, 0x42e13ee6, 0xd571a0c8, 0x17733034, 0x0783aeb0, 0x469f6e5f, 0xc8355125, 0x05efb3af, 0x0783aeb0, 0x469f6e5f, 0xc8355125, 0x05efb3af, 0x0783aeb0, 0x469f6e5f, 0xc8355125, 0x05efb3af,
+    0x40000000, 0x40000000, 0x00000000, 0x00000000, 0x3efbe321, 0x3efbe321, 0xf4a420e3, 0x0b5bdf1d, 0x3d6804db, 0x3d6804db, 0xedf7065c, 0x1208f9a4, 0x394281f2, 0x394281f2, 0xe3694895, 0x1c96b76b,
+    0x34ec7cfd, 0x34ec7cfd, 0xdc034bac, 0x23fcb454, 0x2e5f55f9, 0x2e5f55f9, 0xd3e41b76, 0x2c1be48a, 0x2e5f55f9, 0x2e5f55f9, 0xd3e41b76, 0x2c1be48a, 0x2e5f55f9, 0x2e5f55f9, 0xd3e41b76, 0x2c1be48a,
+    0x46df3081, 0x384ba5cd, 0x00000000, 0x00000000, 0x4636cd7d, 0x36eeb15e, 0xf65ddef9, 0x0c502ede, 0x454378a0, 0x34ba7dda, 0xf0fcca91, 0x13b865a3, 0x4357c9e2, 0x2e2aae1d, 0xe9ea3d33, 0x20371568,
+    0x42e13ee6, 0x24da6b14, 0xe88ccfcc, 0x2a8e5f38, 0x469f6e5f, 0x0783aeb0, 0xfa104c51, 0x37caaedb, 0x469f6e5f, 0x0783aeb0, 0xfa104c51, 0x37caaedb, 0x469f6e5f, 0x0783aeb0, 0xfa104c51, 0x37caaedb,
+    0x4c8be085, 0x304c299c, 0x00000000, 0x00000000, 0x4c2c3428, 0x2eb2f08c, 0xf871f9ba, 0x0c52ab25, 0x4badde8c, 0x2c163a5a, 0xf482a47a, 0x13b91dbe, 0x4af951c1, 0x24362294, 0xf0906e9a, 0x1ff582a4,
+    0x4b440968, 0x19a3f9b1, 0xf20e863b, 0x28edeabb, 0x4c814a25, 0x03ffbf34, 0xfd7bedee, 0x3021b4ee, 0x4c814a25, 0x03ffbf34, 0xfd7bedee, 0x3021b4ee, 0x4c814a25, 0x03ffbf34, 0xfd7bedee, 0x3021b4ee,
+    0x50ea74d5, 0x288dd233, 0x00000000, 0x00000000, 0x50b9a4e2, 0x26e1ab5b, 0xfa72c868, 0x0b86b526, 0x507ebbb3, 0x242b5cb6, 0xf7c23397, 0x12575c98, 0x5043e148, 0x1c46bd48, 0xf5c24bd7, 0x1d11f75a,
+    0x507b4cf8, 0x12bb2575, 0xf7a0f0bb, 0x23f81516, 0x50e78fdc, 0x02b45943, 0xfea5ba4f, 0x2876b5a1, 0x50e78fdc, 0x02b45943, 0xfea5ba4f, 0x2876b5a1, 0x50e78fdc, 0x02b45943, 0xfea5ba4f, 0x2876b5a1,
+    0x541744a4, 0x217a28e9, 0x00000000, 0x00000000, 0x54004d96, 0x1fdfec1c, 0xfc1de7fd, 0x0a3bca9a, 0x53e6a196, 0x1d501bd8, 0xfa59bccc, 0x102b9067, 0x53d42e4b, 0x162a51b8, 0xf95dcaa3, 0x19169899,
+    0x53ef453d, 0x0e2e7edd, 0xfae05432, 0x1e533101, 0x5416516a, 0x01fce7dd, 0xff35bfe4, 0x216b0969, 0x5416516a, 0x01fce7dd, 0xff35bfe4, 0x216b0969, 0x5416516a, 0x01fce7dd, 0xff35bfe4, 0x216b0969,
+    0x564c2e5c, 0x1b4a293c, 0x00000000, 0x00000000, 0x5641fa37, 0x19d92ca0, 0xfd60a0f9, 0x08c069be, 0x563738ae, 0x179390d7, 0xfc3de466, 0x0dbe4b40, 0x5631663b, 0x1173e923, 0xfbc08499, 0x14faae7c,
+    0x563d3668, 0x0af5c615, 0xfcd2e30f, 0x18fdf985, 0x564bd768, 0x0183fe90, 0xff857e2e, 0x1b3f60ed, 0x564bd768, 0x0183fe90, 0xff857e2e, 0x1b3f60ed, 0x564bd768, 0x0183fe90, 0xff857e2e, 0x1b3f60ed,
+    0x5852ca3c, 0x13c5ece4, 0x00000000, 0x00000000, 0x584ff7ac, 0x12a25f01, 0xfe9abed4, 0x069d1e25, 0x584d28b6, 0x10de03f0, 0xfe07697e, 0x0a518efb, 0x584c1026, 0x0c43984e, 0xfdd87f18, 0x0f82a573,
+    0x584f3783, 0x07985b7e, 0xfe6e0aba, 0x12419a4d, 0x5852b628, 0x010a699a, 0xffc470ac, 0x13bee8e6, 0x5852b628, 0x010a699a, 0xffc470ac, 0x13bee8e6, 0x5852b628, 0x010a699a, 0xffc470ac, 0x13bee8e6,
+    0x5964d649, 0x0e2b0093, 0x00000000, 0x00000000, 0x5964179c, 0x0d509cdc, 0xff475dc8, 0x04d78ee6, 0x59635fda, 0x0c00f0e7, 0xfefd44d8, 0x0786b397, 0x5963260b, 0x08a697e2, 0xfeea0361, 0x0b38682f,
+    0x5963f625, 0x0552e280, 0xff37d1ad, 0x0d213427, 0x5964d170, 0x00ba02a6, 0xffe28ee1, 0x0e263ab6, 0x5964d170, 0x00ba02a6, 0xffe28ee1, 0x0e263ab6, 0x5964d170, 0x00ba02a6, 0xffe28ee1, 0x0e263ab6,
+    0x59f1fd03, 0x0a178ef2, 0x00000000, 0x00000000, 0x59f1cbe7, 0x09787539, 0xffa20348, 0x037c9fc5, 0x59f19d5f, 0x08852926, 0xff7cd563, 0x0568ab97, 0x59f1907f, 0x061d037e, 0xff74489e, 0x08079a87,
+    0x59f1c565, 0x03c03f54, 0xff9bf9d3, 0x095e7a7c, 0x59f1fbd1, 0x0082d217, 0xfff1572b, 0x0a143e81, 0x59f1fbd1, 0x0082d217, 0xfff1572b, 0x0a143e81, 0x59f1fbd1, 0x0082d217, 0xfff1572b, 0x0a143e81,
+    0x5a39b8a1, 0x072ab79b, 0x00000000, 0x00000000, 0x5a39ac23, 0x06b8719b, 0xffd08622, 0x027d62ba, 0x5a39a067, 0x060a293e, 0xffbde1e3, 0x03dbb607, 0x5a399d61, 0x0452f721, 0xffb9e0ae, 0x05b72704,
+    0x5a39aabe, 0x02a63627, 0xffcdf185, 0x06a8c34a, 0x5a39b855, 0x005c511e, 0xfff8ad22, 0x072864a9, 0x5a39b855, 0x005c511e, 0xfff8ad22, 0x072864a9, 0x5a39b855, 0x005c511e, 0xfff8ad22, 0x072864a9,
+    0x5a5ded0a, 0x0514ea90, 0x00000000, 0x00000000, 0x5a5de9e1, 0x04c36d5a, 0xffe81c94, 0x01c53075, 0x5a5de6ed, 0x0447506e, 0xffdec463, 0x02bde78e, 0x5a5de632, 0x030f5395, 0xffdcd4b7, 0x040ea508,
+    0x5a5de98f, 0x01df9460, 0xffe6ee40, 0x04b94ab0, 0x5a5decf7, 0x0041406b, 0xfffc55d3, 0x0513475e, 0x5a5decf7, 0x0041406b, 0xfffc55d3, 0x0513475e, 0x5a5decf7, 0x0041406b, 0xfffc55d3, 0x0513475e,
+    0x5a76e601, 0x02dc5943, 0x00000000, 0x00000000, 0x5a76e5b0, 0x02ae4b5a, 0xfff86ce2, 0x00ff9b3f, 0x5a76e564, 0x02683791, 0xfff57854, 0x018bbdc1, 0x5a76e552, 0x01b85d39, 0xfff4df8b, 0x02492958,
+    0x5a76e5a8, 0x010d7942, 0xfff8138b, 0x02a8f804, 0x5a76e5ff, 0x0024a76c, 0xfffed7a4, 0x02db6e4b, 0x5a76e5ff, 0x0024a76c, 0xfffed7a4, 0x02db6e4b, 0x5a76e5ff, 0x0024a76c, 0xfffed7a4, 0x02db6e4b,
+    0x5a7ecff3, 0x019bf87d, 0x00000000, 0x00000000, 0x5a7ecfeb, 0x01820809, 0xfffd9a45, 0x008fdf9d, 0x5a7ecfe3, 0x015a92d2, 0xfffcab05, 0x00deb9b6, 0x5a7ecfe1, 0x00f79c86, 0xfffc7b1a, 0x0149411b,
+    0x5a7ecfea, 0x00977f92, 0xfffd7ea6, 0x017f1a6d, 0x5a7ecff3, 0x00149ae3, 0xffffa251, 0x019b747e, 0x5a7ecff3, 0x00149ae3, 0xffffa251, 0x019b747e, 0x5a7ecff3, 0x00149ae3, 0xffffa251, 0x019b747e,
+    0x5a81510b, 0x00e7b173, 0x00000000, 0x00000000, 0x5a81510a, 0x00d91962, 0xffff3dde, 0x0050ee1c, 0x5a815109, 0x00c2e6bf, 0xfffef236, 0x007d47ca, 0x5a815109, 0x008b3cea, 0xfffee319, 0x00b93013,
+    0x5a81510a, 0x00552fe2, 0xffff3532, 0x00d776e0, 0x5a81510b, 0x000b95f8, 0xffffe261, 0x00e7673f, 0x5a81510b, 0x000b95f8, 0xffffe261, 0x00e7673f, 0x5a81510b, 0x000b95f8, 0xffffe261, 0x00e7673f,
+    0x5a821bd1, 0x00824b8b, 0x00000000, 0x00000000, 0x5a821bd1, 0x007a1644, 0xffffc29b, 0x002d83bf, 0x5a821bd1, 0x006d9a47, 0xffffaaae, 0x004674c8, 0x5a821bd1, 0x004e4c6b, 0xffffa5e8, 0x00682517,
+    0x5a821bd1, 0x002fe72b, 0xffffbfde, 0x00792b76, 0x5a821bd1, 0x000683d4, 0xfffff6a2, 0x008221d2, 0x5a821bd1, 0x000683d4, 0xfffff6a2, 0x008221d2, 0x5a821bd1, 0x000683d4, 0xfffff6a2, 0x008221d2,
+    0x5a825bf2, 0x00494567, 0x00000000, 0x00000000, 0x5a825bf2, 0x0044a7b5, 0xffffec96, 0x00199874, 0x5a825bf2, 0x003da266, 0xffffe505, 0x00279f18, 0x5a825bf2, 0x002c07c5, 0xffffe382, 0x003a90e9,
+    0x5a825bf2, 0x001af008, 0xffffebb8, 0x004423c4, 0x5a825bf2, 0x0003a9e1, 0xfffffd0a, 0x00492df1, 0x5a825bf2, 0x0003a9e1, 0xfffffd0a, 0x00492df1, 0x5a825bf2, 0x0003a9e1, 0xfffffd0a, 0x00492df1
+};
+
+/* 8 band complex hybrid filters for QMF band 0 (outputs 0, 1, 2+5, 3+4, 6, 7), Q31 */
+static const uint32_t psHybrid8[6][13][2] PROGMEM = {
+    0xff532109, 0x00acdef7, 0xfee34b5f, 0x02af570f, 0x00000000, 0x05d1eac2, 0x038f276e, 0x0897b86d, 0x08f26d36, 0x08f26d36, 0x0df26407, 0x05c6e77e, 0x10000000, 0x00000000,
+    0x0df26407, 0xfa391882, 0x08f26d36, 0xf70d92ca, 0x038f276e, 0xf7684793, 0x00000000, 0xfa2e153e, 0xfee34b5f, 0xfd50a8f1, 0xff532109, 0xff532109,
+    0x00acdef7, 0x00acdef7, 0x02af570f, 0xfee34b5f, 0x00000000, 0xfa2e153e, 0xf7684793, 0xfc70d892, 0xf70d92ca, 0x08f26d36, 0x05c6e77e, 0x0df26407, 0x10000000, 0x00000000,
+    0x05c6e77e, 0xf20d9bf9, 0xf70d92ca, 0xf70d92ca, 0xf7684793, 0x038f276e, 0x00000000, 0x05d1eac2, 0x02af570f, 0x011cb4a1, 0x00acdef7, 0xff532109,
+    0x0159bdef, 0x00000000, 0xfaa151e2, 0x00000000, 0x00000000, 0x00000000, 0x112f70d9, 0x00000000, 0xee1b2593, 0x00000000, 0xf4723104, 0x00000000, 0x20000000, 0x00000000,
+    0xf4723104, 0x00000000, 0xee1b2593, 0x00000000, 0x112f70d9, 0x00000000, 0x00000000, 0x00000000, 0xfaa151e2, 0x00000000, 0x0159bdef, 0x00000000,
+    0xfea64211, 0x00000000, 0x02396942, 0x00000000, 0x00000000, 0x00000000, 0xf8e1b123, 0x00000000, 0x11e4da6d, 0x00000000, 0xe41b37f2, 0x00000000, 0x20000000, 0x00000000,
+    0xe41b37f2, 0x00000000, 0x11e4da6d, 0x00000000, 0xf8e1b123, 0x00000000, 0x00000000, 0x00000000, 0x02396942, 0x00000000, 0xfea64211, 0x00000000,
+    0x00acdef7, 0xff532109, 0x02af570f, 0x011cb4a1, 0x00000000, 0x05d1eac2, 0xf7684793, 0x038f276e, 0xf70d92ca, 0xf70d92ca, 0x05c6e77e, 0xf20d9bf9, 0x10000000, 0x00000000,
+    0x05c6e77e, 0x0df26407, 0xf70d92ca, 0x08f26d36, 0xf7684793, 0xfc70d892, 0x00000000, 0xfa2e153e, 0x02af570f, 0xfee34b5f, 0x00acdef7, 0x00acdef7,
+    0xff532109, 0xff532109, 0xfee34b5f, 0xfd50a8f1, 0x00000000, 0xfa2e153e, 0x038f276e, 0xf7684793, 0x08f26d36, 0xf70d92ca, 0x0df26407, 0xfa391882, 0x10000000, 0x00000000,
+    0x0df26407, 0x05c6e77e, 0x08f26d36, 0x08f26d36, 0x038f276e, 0x0897b86d, 0x00000000, 0x05d1eac2, 0xfee34b5f, 0x02af570f, 0xff532109, 0x00acdef7
+};
+
+/* taps 1, 3, 5 and 6 of the 2 band real hybrid filter for QMF bands 1 and 2, Q31 */
+static const uint32_t psHybrid2[4] PROGMEM = {0x026e6c90, 0xf6aa2f25, 0x2729e766, 0x40000000};
+
+/* all-pass decorrelator, bands 0 - 11 hybrid, 12 - 31 QMF 3 - 22
+ *   psPhiFract = exp(-i * pi * 0.39 * fCenter), psQFract = exp(-i * pi * q(m) * fCenter), q(m) = {0.43, 0.75, 0.347}
+ */
+static const uint32_t psPhiFract[32][2] PROGMEM = {
+    0x7e8073ae, 0xec79170c, 0x72b9baca, 0xc73ca07b, 0x5c44ee40, 0xa748e9ce, 0x3d39385b, 0x8f976992,
+    0x7fffffff, 0x00000000, 0x7fffffff, 0x00000000, 0x72b9baca, 0x38c35f85, 0x7e8073ae, 0x1386e8f4,
+    0xba914696, 0x9477d07e, 0x05067734, 0x80194350, 0x895cc359, 0xcff261f0, 0x834e4955, 0x1ce70e50,
+    0xcb537f5c, 0x74a8dcd1, 0x5beb9002, 0x5913aba7, 0x72f2914e, 0xc7b012c3, 0xf1f439e1, 0x80c5e32d,
+    0x838961e8, 0xe21e765a, 0xb9b99ecc, 0x6afbbc51, 0x4cda91e8, 0x665c1120, 0x7a576cee, 0xda5ce2fa,
+    0x0607958d, 0x80246067, 0x89be50c3, 0xcf043ab3, 0xa9dab9d8, 0x5eac3b52, 0x3be51fc9, 0x711f3b6f,
+    0x7eb91860, 0xedf6f2cc, 0x19f4ef21, 0x82a8d3b2, 0x92dcafe5, 0xbd1ec45c, 0x9c1adb3e, 0x5007f38d,
+    0x2976203f, 0x79195336, 0x7ffbf51e, 0x0202b287, 0x2d3ea9e7, 0x88435eb8, 0x9eab046f, 0xacdee2e8
+};
+
+static const uint32_t psQFract[32][3][2] PROGMEM = {
+    0x7e2defed, 0xea7d08ab, 0x7a7d055b, 0xdad7f3a2, 0x7ed03e2a, 0xee9c9f5e,
+    0x6fec9aaa, 0xc1e5413a, 0x5133cc94, 0x9d0dfe54, 0x7573deeb, 0xcd1e7305,
+    0x55063951, 0xa051a5ab, 0x0c8bd35e, 0x809dc971, 0x636c0442, 0xaf61c447,
+    0x3084ca33, 0x898d4e33, 0xc3a94590, 0x8f1d343a, 0x4a0d6730, 0x979882b3,
+    0x7fffffff, 0x00000000, 0x7fffffff, 0x00000000, 0x7fffffff, 0x00000000,
+    0x7fffffff, 0x00000000, 0x7fffffff, 0x00000000, 0x7fffffff, 0x00000000,
+    0x6fec9aaa, 0x3e1abec6, 0x5133cc94, 0x62f201ac, 0x7573deeb, 0x32e18cfb,
+    0x7e2defed, 0x1582f755, 0x7a7d055b, 0x25280c5e, 0x7ed03e2a, 0x116360a2,
+    0xa4c842d2, 0xa63437df, 0xb8e31319, 0x6a6d98a4, 0xd5af016e, 0x873279c5,
+    0xf0f488d9, 0x80e321ff, 0x8275a0c0, 0xe70747c4, 0x1a72e379, 0x82c32b3c,
+    0x80aaa6ae, 0xf2f423b2, 0x471cece7, 0x6a6d98a4, 0x9d2ead98, 0xaea47031,
+    0x9477d07e, 0x456eb96a, 0x7d8a5f40, 0xe70747c4, 0x8151df9d, 0xedaa8617,
+    0x0202b287, 0x7ffbf51e, 0xcf043ab3, 0x89be50c3, 0x9bfab4a1, 0x4fdfc183,
+    0x7d572c4e, 0x19f4ef21, 0xcf043ab3, 0x7641af3d, 0x1893b8fd, 0x7d9e4bf8,
+    0x34ac80a4, 0x8b57232f, 0x7641af3d, 0xcf043ab3, 0x7abf7944, 0x244a29ad,
+    0x99a3eee0, 0xb3256e18, 0x89be50c3, 0xcf043ab3, 0x58eeadda, 0xa3f0a587,
+    0x9eab046f, 0x53211d18, 0x30fbc54d, 0x7641af3d, 0xd77daec8, 0x869444d2,
+    0x3be51fc9, 0x711f3b6f, 0x30fbc54d, 0x89be50c3, 0x819b8536, 0xebc71fa7,
+    0x7b769e14, 0xde39686c, 0x89be50c3, 0x30fbc54d, 0xb3a121be, 0x66b87d65,
+    0xf9f86a73, 0x80246067, 0x7641af3d, 0x30fbc54d, 0x37c51905, 0x73362c90,
+    0x81e7f007, 0xe9fe3a2d, 0xcf043ab3, 0x89be50c3, 0x7ff16847, 0x03d1d1ef,
+    0xcf043ab3, 0x7641af3d, 0xcf043ab3, 0x7641af3d, 0x3e8b240e, 0x90520d04,
+    0x68b92144, 0x4999c5a8, 0x7641af3d, 0xcf043ab3, 0xb9e4a9bc, 0x94e809f9,
+    0x5eac3b52, 0xa9dab9d8, 0x89be50c3, 0xcf043ab3, 0x80a051ca, 0x0ca56fc9,
+    0xc094cf73, 0x90d0aebb, 0x30fbc54d, 0x7641af3d, 0xd051db6f, 0x76c9bbd1,
+    0x85a89312, 0x25a31d06, 0x30fbc54d, 0x89be50c3, 0x53483a15, 0x6133860f,
+    0x0a0af299, 0x7f9afcb9, 0x89be50c3, 0x30fbc54d, 0x7cb1b6ab, 0xe318f1b0,
+    0x7eb91860, 0x12090d34, 0x7641af3d, 0x30fbc54d, 0x2006ea38, 0x84124e81,
+    0x2d3ea9e7, 0x88435eb8, 0xcf043ab3, 0x89be50c3, 0xa0ec1d3a, 0xaa4d2e53,
+    0x950443af, 0xb9b99ecc, 0xcf043ab3, 0x7641af3d, 0x880d20e7, 0x2cae16a8,
+    0xa4146ffe, 0x5913aba7, 0x7641af3d, 0xcf043ab3, 0xf02826d1, 0x7f04068b,
+    0x42e13ba4, 0x6d23501b, 0x89be50c3, 0xcf043ab3, 0x694c48d5, 0x48c6a27d
+};
+
+static const int psFilterA[3] PROGMEM = {0x53625ae4, 0x4848aef5, 0x3ea94d15}; /* a(m), Q31 */
+static const uint8_t psLinkDelay[3] = {3, 4, 5};
+
+/***********************************************************************************************************************
+ * Function:    DecodePSHuffman
+ *
+ * Description: decode one PS Huffman codeword
+ *
+ * Inputs:      Huffman tree ([node][bit], leaves <= 0)
+ *
+ * Outputs:     none
+ *
+ * Return:      symbol index
+ **********************************************************************************************************************/
+int DecodePSHuffman(const int8_t (*huffTab)[2]) {
+
+    int n = 0;
+
+    while((n = huffTab[n][GetBits(1)]) > 0)
+        ;
+    return -n;
+}
+/***********************************************************************************************************************
+ * Function:    DecodePSIndex
+ *
+ * Description: undo delta coding of IID or ICC indices (in frequency or time direction)
+ *
+ * Inputs:      delta coded indices
+ *              indices of the previous envelope
+ *              time direction flag
+ *              number of transmitted parameters, stride (2 for 10 band modes, 1 otherwise)
+ *              valid index range
+ *
+ * Outputs:     decoded indices, expanded to 20 bands if stride == 2
+ *
+ * Return:      none
+ **********************************************************************************************************************/
+void DecodePSIndex(int8_t *index, int8_t *indexPrev, int dt, int nrPar, int stride, int minIdx, int maxIdx) {
+
+    int i, v;
+
+    for(i = 0; i < nrPar; i++) {
+        if(dt)
+            v = indexPrev[i * stride] + index[i];
+        else
+            v = (i == 0 ? 0 : index[i - 1]) + index[i];
+        index[i] = MAX(minIdx, MIN(v, maxIdx));
+    }
+    if(stride == 2) {
+        for(i = 2 * nrPar - 1; i > 0; i--)
+            index[i] = index[i >> 1];
+    }
+}
+/***********************************************************************************************************************
+ * Function:    MapPSIndex34To20
+ *
+ * Description: map IID or ICC indices of the 34 band configuration to 20 stereo bands
+ *
+ * Inputs:      34 indices
+ *
+ * Outputs:     20 indices (in place)
+ *
+ * Return:      none
+ **********************************************************************************************************************/
+void MapPSIndex34To20(int8_t *index) {
+
+    index[0]  = (2 * index[0] + index[1]) / 3;
+    index[1]  = (index[1] + 2 * index[2]) / 3;
+    index[2]  = (2 * index[3] + index[4]) / 3;
+    index[3]  = (index[4] + 2 * index[5]) / 3;
+    index[4]  = (index[6] + index[7]) / 2;
+    index[5]  = (index[8] + index[9]) / 2;
+    index[6]  = index[10];
+    index[7]  = index[11];
+    index[8]  = (index[12] + index[13]) / 2;
+    index[9]  = (index[14] + index[15]) / 2;
+    index[10] = index[16];
+    index[11] = index[17];
+    index[12] = index[18];
+    index[13] = index[19];
+    index[14] = (index[20] + index[21]) / 2;
+    index[15] = (index[22] + index[23]) / 2;
+    index[16] = (index[24] + index[25]) / 2;
+    index[17] = (index[26] + index[27]) / 2;
+    index[18] = (index[28] + index[29] + index[30] + index[31]) / 4;
+    index[19] = (index[32] + index[33]) / 2;
+}
+/***********************************************************************************************************************
+ * Function:    UnpackPSData
+ *
+ * Description: unpack ps_data() from the SBR extension (table 8.1), decode the IID and ICC indices of all envelopes
+ *
+ * Inputs:      BitStreamInfo struct pointing to start of ps_data()
+ *
+ * Outputs:     updated SBRParamStereo struct
+ *
+ * Return:      number of bits read
+ *
+ * Notes:       if no PS header has been received yet the data can't be parsed, the caller skips the rest of the
+ *                extension
+ **********************************************************************************************************************/
+int UnpackPSData() {
+
+    int e, n, cnt, frameClass, numEnv, nrIIDPar, nrICCPar, fine, thr;
+    uint8_t iidDt[4], iccDt[4];
+    int8_t iidIndex[34], iccIndex[34];
+    int8_t iidDelta[4][34] = {}, iccDelta[4][34] = {};
+    SBRParamStereo *ps = &(m_PSInfoSBR->ps);
+    uint8_t *startBuf = m_aac_BitStreamInfo.bytePtr;
+    int startBits = m_aac_BitStreamInfo.cachedBits;
+
+    if(GetBits(1)) {
+        /* PS header */
+        ps->enableIID = GetBits(1);
+        if(ps->enableIID) ps->iidMode = GetBits(3);
+        ps->enableICC = GetBits(1);
+        if(ps->enableICC) ps->iccMode = GetBits(3);
+        ps->enableExt = GetBits(1);
+        ps->headerRead = !(ps->enableIID && ps->iidMode > 5) && !(ps->enableICC && ps->iccMode > 5);
+    }
+    if(!ps->headerRead) return CalcBitsUsed(startBuf, 0) + startBits;
+
+    frameClass = GetBits(1);
+    numEnv = psNumEnvTab[frameClass][GetBits(2)];
+    if(frameClass) {
+        for(e = 0; e < numEnv; e++)
+            ps->borderPos[e + 1] = GetBits(5) + 1;
+    }
+
+    fine = (ps->iidMode > 2);
+    nrIIDPar = psNrParTab[ps->iidMode];
+    nrICCPar = psNrParTab[ps->iccMode];
+    if(ps->enableIID) {
+        for(e = 0; e < numEnv; e++) {
+            iidDt[e] = GetBits(1);
+            for(n = 0; n < nrIIDPar; n++) {
+                if(fine)
+                    iidDelta[e][n] = DecodePSHuffman(iidDt[e] ? psHuffIIDdt1 : psHuffIIDdf1) - 30;
+                else
+                    iidDelta[e][n] = DecodePSHuffman(iidDt[e] ? psHuffIIDdt0 : psHuffIIDdf0) - 14;
+            }
+        }
+    }
+    if(ps->enableICC) {
+        for(e = 0; e < numEnv; e++) {
+            iccDt[e] = GetBits(1);
+            for(n = 0; n < nrICCPar; n++)
+                iccDelta[e][n] = DecodePSHuffman(iccDt[e] ? psHuffICCdt : psHuffICCdf) - 7;
+        }
+    }
+    if(ps->enableExt) {
+        /* IPD/OPD extension, not used by the baseline decoder */
+        cnt = GetBits(4);
+        if(cnt == 15) cnt += GetBits(8);
+        while(cnt--) GetBits(8);
+    }
+
+    /* no new parameters, the last envelope of the previous frame is kept */
+    ps->dataAvailable = (numEnv > 0);
+    if(!ps->dataAvailable) return CalcBitsUsed(startBuf, 0) + startBits;
+
+    for(e = 0; e < numEnv; e++) {
+        if(ps->enableIID) {
+            memcpy(iidIndex, iidDelta[e], 34);
+            DecodePSIndex(iidIndex, ps->iidIndexPrev, iidDt[e], nrIIDPar, (nrIIDPar == 10 ? 2 : 1), (fine ? -15 : -7),
+                    (fine ? 15 : 7));
+        }
+        else {
+            memset(iidIndex, 0, 34);
+        }
+        if(ps->enableICC) {
+            memcpy(iccIndex, iccDelta[e], 34);
+            DecodePSIndex(iccIndex, ps->iccIndexPrev, iccDt[e], nrICCPar, (nrICCPar == 10 ? 2 : 1), 0, 7);
+        }
+        else {
+            memset(iccIndex, 0, 34);
+        }
+        memcpy(ps->iidIndexPrev, iidIndex, 34);
+        memcpy(ps->iccIndexPrev, iccIndex, 34);
+        if(ps->enableIID && nrIIDPar == 34) MapPSIndex34To20(iidIndex);
+        if(ps->enableICC && nrICCPar == 34) MapPSIndex34To20(iccIndex);
+        memcpy(ps->iidPar[e], iidIndex, 20);
+        memcpy(ps->iccPar[e], iccIndex, 20);
+    }
+
+    /* envelope borders (time slots) */
+    ps->borderPos[0] = 0;
+    if(frameClass == 0) {
+        for(e = 1; e < numEnv; e++)
+            ps->borderPos[e] = (e * 32) / numEnv;
+    }
+    else {
+        if(ps->borderPos[numEnv] < 32) {
+            /* last envelope doesn't reach the end of the frame, append one with the same parameters */
+            memcpy(ps->iidPar[numEnv], ps->iidPar[numEnv - 1], 20);
+            memcpy(ps->iccPar[numEnv], ps->iccPar[numEnv - 1], 20);
+            numEnv++;
+        }
+        for(e = 1; e < numEnv; e++) {
+            thr = 32 - (numEnv - e);
+            if(ps->borderPos[e] > thr)
+                ps->borderPos[e] = thr;
+            else if(ps->borderPos[e] < ps->borderPos[e - 1] + 1)
+                ps->borderPos[e] = ps->borderPos[e - 1] + 1;
+        }
+    }
+    ps->borderPos[numEnv] = 32;
+    ps->numEnv = numEnv;
+
+    return CalcBitsUsed(startBuf, 0) + startBits;
+}
+/***********************************************************************************************************************
+ * Function:    PSHybridAnalysis
+ *
+ * Description: split QMF bands 0 - 2 of one time slot into 12 hybrid subbands (8 + 2 + 2), subbands 4 and 5 are
+ *                merged into 3 and 2 (20 band configuration)
+ *
+ * Inputs:      time slot
+ *              XBuf, QMF analysis output (6 slots ahead of the synthesis, this compensates the filter delay)
+ *
+ * Outputs:     12 complex hybrid samples (4 and 5 are zero)
+ *
+ * Return:      none
+ **********************************************************************************************************************/
+void PSHybridAnalysis(int l, int (*hyb)[2]) {
+
+    int j, k, f, re, im, ore, oim;
+    int x[13][2];
+    const int *c;
+    static const uint8_t outIdx[6] = {0, 1, 2, 3, 6, 7};
+    SBRParamStereo *ps = &(m_PSInfoSBR->ps);
+
+    for(k = 0; k < 3; k++) {
+        for(j = 0; j < 13; j++) {
+            if(l + j < 12) {
+                x[j][0] = ps->hybridBuf[k][l + j][0];
+                x[j][1] = ps->hybridBuf[k][l + j][1];
+            }
+            else {
+                x[j][0] = m_PSInfoSBR->XBuf[HF_GEN + l + j - 12][k][0];
+                x[j][1] = m_PSInfoSBR->XBuf[HF_GEN + l + j - 12][k][1];
+            }
+        }
+        if(k == 0) {
+            for(f = 0; f < 6; f++) {
+                c = (const int *)psHybrid8[f][0];
+                re = im = 0;
+                for(j = 0; j < 13; j++, c += 2) {
+                    re += MULSHIFT32(x[j][0], c[0]) - MULSHIFT32(x[j][1], c[1]);
+                    im += MULSHIFT32(x[j][0], c[1]) + MULSHIFT32(x[j][1], c[0]);
+                }
+                hyb[outIdx[f]][0] = re << 1;
+                hyb[outIdx[f]][1] = im << 1;
+            }
+            hyb[4][0] = hyb[4][1] = hyb[5][0] = hyb[5][1] = 0;
+        }
+        else {
+            /* symmetric real filter, even taps except the center one are zero */
+            re  = MULSHIFT32(x[6][0], psHybrid2[3]);
+            im  = MULSHIFT32(x[6][1], psHybrid2[3]);
+            ore = MULSHIFT32(x[1][0] + x[11][0], psHybrid2[0]) + MULSHIFT32(x[3][0] + x[9][0], psHybrid2[1]) +
+                  MULSHIFT32(x[5][0] + x[7][0], psHybrid2[2]);
+            oim = MULSHIFT32(x[1][1] + x[11][1], psHybrid2[0]) + MULSHIFT32(x[3][1] + x[9][1], psHybrid2[1]) +
+                  MULSHIFT32(x[5][1] + x[7][1], psHybrid2[2]);
+            hyb[6 + 2 * k][0] = (re + ore) << 1;
+            hyb[6 + 2 * k][1] = (im + oim) << 1;
+            hyb[7 + 2 * k][0] = (re - ore) << 1;
+            hyb[7 + 2 * k][1] = (im - oim) << 1;
+        }
+    }
+}
+/***********************************************************************************************************************
+ * Function:    PSAllpass
+ *
+ * Description: decorrelate one subband sample with the fractional delay and the three all-pass links
+ *
+ * Inputs:      complex sample
+ *              all-pass band (0 - 11 hybrid subbands, 12 - 31 QMF bands 3 - 22)
+ *              decay slope of this band, Q31
+ *
+ * Outputs:     decorrelated sample at half scale (in place)
+ *
+ * Return:      none
+ **********************************************************************************************************************/
+void PSAllpass(int *x, int ap, int decaySlope) {
+
+    int m, g, re, im, r0re, r0im, *d;
+    const int *c;
+    SBRParamStereo *ps = &(m_PSInfoSBR->ps);
+
+    /* z^-2 * phiFract */
+    d = ps->apDelay[ps->apDelayIdx][ap];
+    c = (const int *)psPhiFract[ap];
+    r0re = (MULSHIFT32(d[0], c[0]) - MULSHIFT32(d[1], c[1])) << 1;
+    r0im = (MULSHIFT32(d[0], c[1]) + MULSHIFT32(d[1], c[0])) << 1;
+    d[0] = x[0] >> 1;
+    d[1] = x[1] >> 1;
+
+    for(m = 0; m < 3; m++) {
+        g = MULSHIFT32(psFilterA[m], decaySlope) << 1;
+        d = ps->apLinkDelay[m][ps->apLinkIdx[m]][ap];
+        c = (const int *)psQFract[ap][m];
+        re = ((MULSHIFT32(d[0], c[0]) - MULSHIFT32(d[1], c[1])) << 1) - (MULSHIFT32(g, r0re) << 1);
+        im = ((MULSHIFT32(d[0], c[1]) + MULSHIFT32(d[1], c[0])) << 1) - (MULSHIFT32(g, r0im) << 1);
+        d[0] = r0re + (MULSHIFT32(g, re) << 1);
+        d[1] = r0im + (MULSHIFT32(g, im) << 1);
+        r0re = re;
+        r0im = im;
+    }
+    x[0] = r0re;
+    x[1] = r0im;
+}
+/***********************************************************************************************************************
+ * Function:    PSUpdateMixing
+ *
+ * Description: start a new envelope, calculate the mixing matrices of all stereo bands and the per slot increments
+ *                for the linear interpolation from the previous envelope
+ *
+ * Inputs:      envelope
+ *
+ * Outputs:     current mixing matrices and increments, Q30
+ *
+ * Return:      none
+ **********************************************************************************************************************/
+void PSUpdateMixing(int env, int (*hCur)[4], int (*hDelta)[4]) {
+
+    int bk, i, row, len;
+    const int *h;
+    SBRParamStereo *ps = &(m_PSInfoSBR->ps);
+
+    len = ps->borderPos[env + 1] - ps->borderPos[env];
+    for(bk = 0; bk < 20; bk++) {
+        row = ps->iidPar[env][bk] + (ps->iidMode > 2 ? 30 : 7);
+        h = (const int *)(ps->iccMode > 2 ? psMixRb : psMixRa)[row][ps->iccPar[env][bk]];
+        for(i = 0; i < 4; i++) {
+            hCur[bk][i] = ps->hPrev[bk][i];
+            hDelta[bk][i] = (h[i] - ps->hPrev[bk][i]) / len;
+            ps->hPrev[bk][i] = h[i];
+        }
+    }
+}
+/***********************************************************************************************************************
+ * Function:    DecodePS
+ *
+ * Description: apply parametric stereo to one frame of the mono SBR signal and run the synthesis QMF for both
+ *                output channels
+ *
+ * Inputs:      first time slot with new SBR settings
+ *              number of synthesis QMF bands before and from that slot
+ *              XBuf after HF adjustment
+ *
+ * Outputs:     2048 stereo samples of decoded 16-bit PCM, interleaved
+ *
+ * Return:      none
+ *
+ * Notes:       transient detection uses float, the signal path is fixed point with MIN_GBITS_IN_QMFS guard bits
+ *                kept in the output; the decorrelated signal is carried at half scale
+ **********************************************************************************************************************/
+void DecodePS(int env0, int qmfsBandsPrev, int qmfsBands, short *outbuf) {
+
+    int l, i, k, sb, bk, env, nBands, ch, s[2], d[2], *x, *h;
+    int g[20], hCur[20][4], hDelta[20][4];  /* g = ducking gain, Q30 */
+    int hybIn[12][2], hybOut[2][12][2];
+    int64_t sum;
+    float p[20], denom;
+    SBRParamStereo *ps = &(m_PSInfoSBR->ps);
+
+    if(!m_AACDecInfo->psUsed) {
+        /* first PS frame, start from a pass-through mix */
+        for(bk = 0; bk < 20; bk++) {
+            ps->hPrev[bk][0] = ps->hPrev[bk][1] = 0x40000000;
+            ps->hPrev[bk][2] = ps->hPrev[bk][3] = 0;
+        }
+        m_AACDecInfo->psUsed = 1;
+    }
+    if(!ps->dataAvailable) {
+        /* keep the parameters of the last envelope for the whole frame */
+        memcpy(ps->iidPar[0], ps->iidPar[ps->numEnv ? ps->numEnv - 1 : 0], 20);
+        memcpy(ps->iccPar[0], ps->iccPar[ps->numEnv ? ps->numEnv - 1 : 0], 20);
+        ps->numEnv = 1;
+        ps->borderPos[0] = 0;
+        ps->borderPos[1] = 32;
+    }
+    ps->dataAvailable = 0;
+
+    env = 0;
+    PSUpdateMixing(env, hCur, hDelta);
+
+    for(l = 0; l < 32; l++) {
+        nBands = (l < env0 ? qmfsBandsPrev : qmfsBands);
+        if(l == ps->borderPos[env + 1]) PSUpdateMixing(++env, hCur, hDelta);
+        for(bk = 0; bk < 20; bk++) {
+            for(i = 0; i < 4; i++)
+                hCur[bk][i] += hDelta[bk][i];
+        }
+
+        PSHybridAnalysis(l, hybIn);
+
+        /* transient detection, ducking gain per stereo band */
+        for(bk = 0; bk < 20; bk++)
+            p[bk] = 0;
+        for(sb = 0; sb < 12; sb++)
+            p[psHybridBk[sb]] += (float)hybIn[sb][0] * hybIn[sb][0] + (float)hybIn[sb][1] * hybIn[sb][1];
+        for(sb = 3; sb < nBands; sb++) {
+            x = m_PSInfoSBR->XBuf[l + HF_ADJ][sb];
+            p[psQmfBk[sb]] += (float)x[0] * x[0] + (float)x[1] * x[1];
+        }
+        for(bk = 0; bk < 20; bk++) {
+            ps->peakDecayNrg[bk] = MAX(ps->peakDecayNrg[bk] * 0.76592833836465f, p[bk]);
+            ps->powerSmooth[bk] += 0.25f * (p[bk] - ps->powerSmooth[bk]);
+            ps->peakDiffSmooth[bk] += 0.25f * (ps->peakDecayNrg[bk] - p[bk] - ps->peakDiffSmooth[bk]);
+            denom = 1.5f * ps->peakDiffSmooth[bk];
+            g[bk] = (denom > ps->powerSmooth[bk] ? (int)(ps->powerSmooth[bk] / denom * 1073741824.0f) : 0x40000000);
+        }
+
+        /* hybrid subbands */
+        for(sb = 0; sb < 12; sb++) {
+            if(sb == 4 || sb == 5) {
+                hybOut[0][sb][0] = hybOut[0][sb][1] = hybOut[1][sb][0] = hybOut[1][sb][1] = 0;
+                continue;
+            }
+            bk = psHybridBk[sb];
+            s[0] = d[0] = hybIn[sb][0];
+            s[1] = d[1] = hybIn[sb][1];
+            PSAllpass(d, sb, 0x7fffffff);
+            h = hCur[bk];
+            for(i = 0; i < 2; i++) {
+                d[i] = MULSHIFT32(g[bk], d[i]) << 2;
+                hybOut[0][sb][i] = CLIP_2N(MULSHIFT32(h[0], s[i]) + (MULSHIFT32(h[2], d[i]) << 1), 27) << 2;
+                hybOut[1][sb][i] = CLIP_2N(MULSHIFT32(h[1], s[i]) + (MULSHIFT32(h[3], d[i]) << 1), 27) << 2;
+            }
+        }
+
+        /* QMF bands, all 64 are run through the delay lines, bands above nBands are silent */
+        for(sb = 3; sb < 64; sb++) {
+            bk = psQmfBk[sb];
+            if(sb < nBands) {
+                s[0] = m_PSInfoSBR->XBuf[l + HF_ADJ][sb][0];
+                s[1] = m_PSInfoSBR->XBuf[l + HF_ADJ][sb][1];
+            }
+            else {
+                s[0] = s[1] = 0;
+            }
+            if(sb <= 22) {
+                d[0] = s[0];
+                d[1] = s[1];
+                PSAllpass(d, sb + 9, (sb <= 3 ? 0x7fffffff : 0x7fffffff - (sb - 3) * 0x06666666));
+            }
+            else {
+                x = (sb < 35 ? ps->qmfDelay[ps->qmfDelayIdx][sb - 23] : ps->qmfDelay1[sb - 35]);
+                d[0] = x[0];
+                d[1] = x[1];
+                x[0] = s[0] >> 1;
+                x[1] = s[1] >> 1;
+            }
+            h = hCur[bk];
+            for(i = 0; i < 2; i++) {
+                d[i] = MULSHIFT32(g[bk], d[i]) << 2;
+                m_PSInfoSBR->psBuf[0][sb][i] = CLIP_2N(MULSHIFT32(h[0], s[i]) + (MULSHIFT32(h[2], d[i]) << 1), 27) << 2;
+                m_PSInfoSBR->psBuf[1][sb][i] = CLIP_2N(MULSHIFT32(h[1], s[i]) + (MULSHIFT32(h[3], d[i]) << 1), 27) << 2;
+            }
+        }
+        ps->apDelayIdx ^= 1;
+        for(i = 0; i < 3; i++)
+            ps->apLinkIdx[i] = (ps->apLinkIdx[i] + 1 == psLinkDelay[i] ? 0 : ps->apLinkIdx[i] + 1);
+        ps->qmfDelayIdx = (ps->qmfDelayIdx == 13 ? 0 : ps->qmfDelayIdx + 1);
+
+        /* hybrid synthesis (sum of the subbands) and synthesis QMF for both channels */
+        for(ch = 0; ch < 2; ch++) {
+            for(i = 0; i < 2; i++) {
+                sum = 0;
+                for(k = 0; k < 8; k++)
+                    sum += hybOut[ch][k][i];
+                m_PSInfoSBR->psBuf[ch][0][i] = (int)MAX((int64_t)-(1 << 29), MIN(sum, (int64_t)(1 << 29) - 1));
+                m_PSInfoSBR->psBuf[ch][1][i] = CLIP_2N(hybOut[ch][8][i] + hybOut[ch][9][i], 29);
+                m_PSInfoSBR->psBuf[ch][2][i] = CLIP_2N(hybOut[ch][10][i] + hybOut[ch][11][i], 29);
+            }
+            QMFSynthesis(m_PSInfoSBR->psBuf[ch][0], m_PSInfoSBR->delayQMFS[ch], &(m_PSInfoSBR->delayIdxQMFS[ch]), nBands,
+                    outbuf + ch, 2);
+        }
+        outbuf += (m_sbrDownsampled ? 32 : 64) * 2;
+    }
+
+    /* keep the last 12 input samples of the hybrid filters */
+    for(k = 0; k < 3; k++) {
+        for(i = 0; i < 12; i++) {
+            ps->hybridBuf[k][i][0] = m_PSInfoSBR->XBuf[HF_GEN + 20 + i][k][0];
+            ps->hybridBuf[k][i][1] = m_PSInfoSBR->XBuf[HF_GEN + 20 + i][k][1];
+        }
+    }
+}
+#endif /* AAC_ENABLE_PS */
@@ -9,6 +9,13 @@
 
 #if (defined CONFIG_IDF_TARGET_ESP32S3 && defined BOARD_HAS_PSRAM)
     #define AAC_ENABLE_SBR  // needs additional 60KB DRAM,
+    #define AAC_ENABLE_PS   // parametric stereo (HE-AACv2), needs SBR and additional 8KB DRAM
+#elif defined AAC_ENABLE_SBR_NO_PSRAM
+    #define AAC_ENABLE_SBR  // set in the build flags, SBR without PSRAM takes 60KB of the heap, use with downsampled SBR
+#endif
+
+#if (defined AAC_ENABLE_PS && !defined AAC_ENABLE_SBR)
+    #undef AAC_ENABLE_PS
 #endif
 
 #define ASSERT(x) /* do nothing */
@@ -114,6 +121,7 @@ typedef struct _AACDecInfo_t {
     int   profile;    /* 0: Main profile, 1: LowComplexity (LC), 2: ScalableSamplingRate (SSR), 3: reserved */
     int   format;
     int   sbrEnabled;
+    int   psUsed;     /* parametric stereo: mono SCE is output as stereo */
     int   tnsUsed;
     int   pnsUsed;
     int   frameCount;
@@ -342,6 +350,7 @@ typedef struct _PSInfoBase_t {
     int      nChans;
     int      useImpChanMap;
     int      sampRateIdx;
+    int      frameLength;           /* 1024 (LC), 512 or 480 (AAC-LD) */
     /* state information which can be overwritten by subsequent elements within frame */
     ICSInfo_t  icsInfo[2]; // [MAX_NCHANS_ELEM]
     int      commonWin;
@@ -367,6 +376,37 @@ typedef struct _PSInfoBase_t {
     int      prevWinShape[2]; // [AAC_MAX_NCHANS]
 } PSInfoBase_t;
 
+typedef struct _SBRParamStereo {
+    /* bitstream, header values are kept until the next PS header */
+    uint8_t  headerRead;
+    uint8_t  dataAvailable;
+    uint8_t  enableIID;
+    uint8_t  enableICC;
+    uint8_t  enableExt;
+    uint8_t  iidMode;
+    uint8_t  iccMode;
+    uint8_t  numEnv;
+    uint8_t  borderPos[5 + 1];     // [MAX_PS_ENVELOPES + 1]
+    int8_t   iidPar[5][20];        // [MAX_PS_ENVELOPES][NUM_PS_BANDS] /* dequant index, 20 band resolution */
+    int8_t   iccPar[5][20];        // [MAX_PS_ENVELOPES][NUM_PS_BANDS]
+    int8_t   iidIndexPrev[34];     /* last envelope, in the resolution it was transmitted */
+    int8_t   iccIndexPrev[34];
+
+    /* state info that must be saved between frames */
+    uint8_t  apDelayIdx;
+    uint8_t  apLinkIdx[3];         // [NUM_AP_LINKS]
+    uint8_t  qmfDelayIdx;
+    int      hybridBuf[3][12][2];  // [NUM_HYBRID_QMF][HYBRID_FILTER_LEN - 1][2]
+    int      apDelay[2][32][2];    // [2][NUM_AP_BANDS][2]
+    int      apLinkDelay[3][5][32][2]; // [NUM_AP_LINKS][5][NUM_AP_BANDS][2]
+    int      qmfDelay[14][12][2];  /* QMF bands 23 - 34 are delayed by 14 slots */
+    int      qmfDelay1[29][2];     /* QMF bands 35 - 63 by one slot */
+    float    peakDecayNrg[20];     // [NUM_PS_BANDS]
+    float    powerSmooth[20];
+    float    peakDiffSmooth[20];
+    int      hPrev[20][4];         // [NUM_PS_BANDS][4]  /* mixing matrix at the end of the last envelope, Q30 */
+} SBRParamStereo;
+
 typedef struct _PSInfoSBR {
     /* save for entire file */
     int      frameCount;
@@ -429,6 +469,10 @@ typedef struct _PSInfoSBR {
     int      delayQMFS[2][10 * 128]; // [AAC_MAX_NCHANS][DELAY_SAMPS_QMFS]
     int      XBufDelay[2][8][64][2]; // [AAC_MAX_NCHANS][HF_GEN][64][2]
     int      XBuf[32+8][64][2];
+#ifdef AAC_ENABLE_PS
+    SBRParamStereo ps;
+    int      psBuf[2][64][2];        /* one time slot of the left and right output */
+#endif
 } PSInfoSBR_t;
 
 bool AACDecoder_AllocateBuffers(void);
@@ -436,6 +480,11 @@ int AACFlushCodec();
 void AACDecoder_FreeBuffers(void);
 bool AACDecoder_IsInit(void);
 int AACFindSyncWord(uint8_t *buf, int nBytes);
+int AACScanSyncWord(uint8_t *buf, int nBytes);
+int AACCheckSyncFrames(uint8_t *buf, int nBytes);
+int AACGetFrameBytes(uint8_t *buf);
+int AACResyncNextFrame(uint8_t *buf, int nBytes);
+int AACConcealFrame(short *outbuf);
 int AACSetRawBlockParams(int copyLast, int nChans, int sampRateCore, int profile);
 int AACDecode(uint8_t *inbuf, int *bytesLeft, short *outbuf);
 int AACGetSampRate();
@@ -446,6 +495,8 @@ uint8_t AACGetFormat(); // 0-unknown 1-ADTS 2-ADIF, 3-RAW
 int AACGetBitsPerSample();
 int AACGetBitrate();
 int AACGetOutputSamps();
+void AACDecoder_SetSBRDownsampled(bool ds); // HE-AAC: 32-subband synthesis, output at the core sample rate
+void AACDecoder_SetFrameLength(int n); // raw blocks: 1024 (LC), 512 or 480 (AAC-LD), set before AACSetRawBlockParams
 int AACGetBitrate();
 void DecodeLPCCoefs(int order, int res, int8_t *filtCoef, int *a, int *b);
 int FilterRegion(int size, int dir, int order, int *audioCoef, int *a, int *hist);
@@ -467,6 +518,8 @@ void R4FirstPass(int *x, int bg);
 void R8FirstPass(int *x, int bg);
 void R4Core(int *x, int bg, int gp, int *wtab);
 void R4FFT(int tabidx, int *x);
+void FFTLD(int ldIdx, int *x);
+void DCT4LD(int ldIdx, int *coef, int *work, int gb);
 void UnpackZeros(int nVals, int *coef);
 void UnpackQuads(int cb, int nVals, int *coef);
 void UnpackPairsNoEsc(int cb, int nVals, int *coef);
@@ -477,7 +530,9 @@ void DecWindowOverlap(int *buf0, int *over0, short *pcm0, int nChans, int winTyp
 void DecWindowOverlapLongStart(int *buf0, int *over0, short *pcm0, int nChans, int winTypeCurr, int winTypePrev);
 void DecWindowOverlapLongStop(int *buf0, int *over0, short *pcm0, int nChans, int winTypeCurr, int winTypePrev);
 void DecWindowOverlapShort(int *buf0, int *over0, short *pcm0, int nChans, int winTypeCurr, int winTypePrev);
+void DecWindowOverlapLD(int ldIdx, int *buf0, int *over0, short *pcm0, int nChans, int winTypeCurr, int winTypePrev);
 int IMDCT(int ch, int chOut, short *outbuf);
+void ConcealUpdate(short *outbuf);
 void DecodeICSInfo(ICSInfo_t *icsInfo, int sampRateIdx);
 void DecodeSectionData(int winSequence, int numWinGrp, int maxSFB, uint8_t *sfbCodeBook);
 int DecodeOneScaleFactor();
@@ -495,6 +550,8 @@ int GetSampleRateIdxADIF(int nPCE);
 int UnpackADIFHeader(uint8_t **buf, int *bitOffset, int *bitsAvail);
 int SetRawBlockParams(int copyLast, int nChans, int sampRate, int profile);
 int PrepareRawBlock();
+const uint16_t *GetSFBandTabLong();
+int GetSFBandTotalLong();
 int DequantBlock(int *inbuf, int nSamps, int scale);
 int AACDequantize(int ch);
 int DeinterleaveShortBlocks(int ch);
@@ -575,6 +632,10 @@ void QMFAnalysisConv(int *cTab, int *delay, int dIdx, int *uBuf);
 int QMFAnalysis(int *inbuf, int *delay, int *XBuf, int fBitsIn, int *delayIdx, int qmfaBands);
 void QMFSynthesisConv(int *cPtr, int *delay, int dIdx, short *outbuf, int nChans);
 void QMFSynthesis(int *inbuf, int *delay, int *delayIdx, int qmfsBands, short *outbuf, int nChans);
+void FFT16C(int *x);
+void DCT4_32(int *buf);
+void QMFSynthesisDownConv(int *cPtr, int *delay, int dIdx, short *outbuf, int nChans);
+void QMFSynthesisDown(int *inbuf, int *delay, int *delayIdx, int qmfsBands, short *outbuf, int nChans);
 int UnpackSBRHeader(SBRHeader *sbrHdr);
 void UnpackSBRGrid(SBRHeader *sbrHdr, SBRGrid *sbrGrid);
 void UnpackDeltaTimeFreq(int numEnv, uint8_t *deltaFlagEnv, int numNoiseFloors, uint8_t *deltaFlagNoise);
@@ -584,3 +645,12 @@ void CopyCouplingGrid(SBRGrid *sbrGridLeft, SBRGrid *sbrGridRight);
 void CopyCouplingInverseFilterMode(int numNoiseFloorBands, uint8_t *modeLeft, uint8_t *modeRight);
 void UnpackSBRSingleChannel(int chBase);
 void UnpackSBRChannelPair(int chBase);
+// PS
+int DecodePSHuffman(const int8_t (*huffTab)[2]);
+void DecodePSIndex(int8_t *index, int8_t *indexPrev, int dt, int nrPar, int stride, int minIdx, int maxIdx);
+void MapPSIndex34To20(int8_t *index);
+int UnpackPSData();
+void PSHybridAnalysis(int l, int (*hyb)[2]);
+void PSAllpass(int *x, int ap, int decaySlope);
+void PSUpdateMixing(int env, int (*hCur)[4], int (*hDelta)[4]);
+void DecodePS(int env0, int qmfsBandsPrev, int qmfsBands, short *outbuf);
@@ -11,32 +11,28 @@
  *
  */
 #include "flac_decoder.h"
-#include "vector"
-using namespace std;
 
 
 FLACFrameHeader_t   *FLACFrameHeader;
 FLACMetadataBlock_t *FLACMetadataBlock;
 FLACsubFramesBuff_t *FLACsubFramesBuff;
 
-vector<int32_t> coefs;
-const uint16_t  outBuffSize = 2048;
 uint16_t        m_blockSize = 0;
 uint16_t        m_blockSizeLeft = 0;
 uint16_t        m_validSamples = 0;
 uint8_t         m_status = 0;
 uint8_t        *m_inptr;
-uint16_t       *s_flacSegmentTable = NULL;
-float           m_compressionRatio = 0;
 uint32_t        m_bitrate = 0;
-uint16_t        m_rIndex = 0;
+uint32_t        m_rIndex = 0;
 uint64_t        m_bitBuffer = 0;
 uint8_t         m_bitBufferLen = 0;
-bool            s_f_flacParseOgg = false;
-uint8_t         m_flacPageSegments = 0;
-uint8_t         m_page0_len = 0;
 char           *m_streamTitle = NULL;
 boolean         s_f_newSt = false;
+bool            s_f_flacCrcCheck = true;
+uint16_t        m_crc16 = 0;
+uint32_t        m_crcErrors = 0;
+uint32_t        m_maxBlockSize = 0;
+uint32_t        m_maxFrameSize = DEFAULT_MAX_FRAMESIZE;
 
 //----------------------------------------------------------------------------------------------------------------------
 //          FLAC INI SECTION
@@ -50,74 +46,155 @@ bool FLACDecoder_AllocateBuffers(void){
 
     if(!FLACFrameHeader)    {FLACFrameHeader    = (FLACFrameHeader_t*)    __malloc_heap_psram(sizeof(FLACFrameHeader_t));}
     if(!FLACMetadataBlock)  {FLACMetadataBlock  = (FLACMetadataBlock_t*)  __malloc_heap_psram(sizeof(FLACMetadataBlock_t));}
-    if(!FLACsubFramesBuff)  {FLACsubFramesBuff  = (FLACsubFramesBuff_t*)  __malloc_heap_psram(sizeof(FLACsubFramesBuff_t));}
+    if(!FLACsubFramesBuff)  {FLACsubFramesBuff  = (FLACsubFramesBuff_t*)  __malloc_heap_psram(sizeof(FLACsubFramesBuff_t));
+                             if(FLACsubFramesBuff) memset(FLACsubFramesBuff, 0, sizeof(FLACsubFramesBuff_t));}
     if(!m_streamTitle)      {m_streamTitle      = (char*)                 __malloc_heap_psram(256);}
-    if(!s_flacSegmentTable) {s_flacSegmentTable = (uint16_t*)             __malloc_heap_psram(256 * sizeof(uint16_t));}
 
-    if(!FLACFrameHeader || !FLACMetadataBlock || !FLACsubFramesBuff || !m_streamTitle || !s_flacSegmentTable){
+    if(!FLACFrameHeader || !FLACMetadataBlock || !FLACsubFramesBuff || !m_streamTitle){
         log_e("not enough memory to allocate flacdecoder buffers");
         return false;
     }
+    if(!FLACDecoder_SetMaxBlockSize(DEFAULT_MAX_BLOCKSIZE, DEFAULT_MAX_FRAMESIZE)) return false; // until STREAMINFO is read
     FLACDecoder_ClearBuffer();
     return true;
 }
 //----------------------------------------------------------------------------------------------------------------------
+bool FLACDecoder_SetMaxBlockSize(uint32_t maxBlockSize, uint32_t maxFrameSize){
+    // sizes the sample buffers from STREAMINFO, a 4096 block stream needs 32KB instead of the 64KB default (2 x 8192 x 4)
+    if(maxBlockSize > MAX_BLOCKSIZE) return false;
+    if(maxBlockSize == 0) maxBlockSize = DEFAULT_MAX_BLOCKSIZE;
+    m_maxFrameSize = maxFrameSize;
+    if(maxBlockSize == m_maxBlockSize) return true;
+    if(FLACsubFramesBuff->samplesBuffer[0]) free(FLACsubFramesBuff->samplesBuffer[0]);
+    int32_t* p = (int32_t*)__malloc_heap_psram(MAX_CHANNELS * maxBlockSize * sizeof(int32_t));
+    for(int ch = 0; ch < MAX_CHANNELS; ch++) FLACsubFramesBuff->samplesBuffer[ch] = p ? p + ch * maxBlockSize : NULL;
+    m_maxBlockSize = p ? maxBlockSize : 0;
+    if(!p){
+        log_e("not enough memory to allocate flacdecoder sample buffers");
+        return false;
+    }
+    return true;
+}
+//----------------------------------------------------------------------------------------------------------------------
 void FLACDecoder_ClearBuffer(){
     memset(FLACFrameHeader,   0, sizeof(FLACFrameHeader_t));
     memset(FLACMetadataBlock, 0, sizeof(FLACMetadataBlock_t));
-    memset(FLACsubFramesBuff, 0, sizeof(FLACsubFramesBuff_t));
+    memset(FLACsubFramesBuff->lpcCoefs, 0, sizeof(FLACsubFramesBuff->lpcCoefs)); // keep the sample buffers
     m_status = DECODE_FRAME;
+    m_crcErrors = 0;
     return;
 }
 //----------------------------------------------------------------------------------------------------------------------
 void FLACDecoder_FreeBuffers(){
     if(FLACFrameHeader)    {free(FLACFrameHeader);    FLACFrameHeader    = NULL;}
     if(FLACMetadataBlock)  {free(FLACMetadataBlock);  FLACMetadataBlock  = NULL;}
-    if(FLACsubFramesBuff)  {free(FLACsubFramesBuff);  FLACsubFramesBuff  = NULL;}
+    if(FLACsubFramesBuff)  {free(FLACsubFramesBuff->samplesBuffer[0]);
+                            free(FLACsubFramesBuff);  FLACsubFramesBuff  = NULL; m_maxBlockSize = 0;}
     if(m_streamTitle)      {free(m_streamTitle);      m_streamTitle      = NULL;}
-    if(s_flacSegmentTable) {free(s_flacSegmentTable); s_flacSegmentTable = NULL;}
 }
 //----------------------------------------------------------------------------------------------------------------------
 //            B I T R E A D E R
 //----------------------------------------------------------------------------------------------------------------------
-const uint32_t mask[] = {0x00000000, 0x00000001, 0x00000003, 0x00000007, 0x0000000f, 0x0000001f, 0x0000003f,
-                         0x0000007f, 0x000000ff, 0x000001ff, 0x000003ff, 0x000007ff, 0x00000fff, 0x00001fff,
-                         0x00003fff, 0x00007fff, 0x0000ffff, 0x0001ffff, 0x0003ffff, 0x0007ffff, 0x000fffff,
-                         0x001fffff, 0x003fffff, 0x007fffff, 0x00ffffff, 0x01ffffff, 0x03ffffff, 0x07ffffff,
-                         0x0fffffff, 0x1fffffff, 0x3fffffff, 0x7fffffff, 0xffffffff};
-
-uint32_t readUint(uint8_t nBits, int *bytesLeft){
-    while (m_bitBufferLen < nBits){
-        uint8_t temp = *(m_inptr + m_rIndex);
+// m_bitBuffer is left aligned, the next bit to read is bit 63 and the bits behind the m_bitBufferLen valid bits are 0.
+// The buffer is refilled with whole bytes, up to eight at once, and only when a read needs more bits than it holds.
+// *bytesLeft counts the bytes taken from the input, syncBytesLeft() gives back the bytes that were fetched ahead at a
+// byte aligned position. Behind the end of the input zero bytes are shifted in, *bytesLeft < 0 marks a truncated frame.
+
+static inline void bitReaderRefill(uint64_t &buf, uint8_t &len, int *bytesLeft){ // len must be <= 56
+    if(*bytesLeft >= 8){
+        uint8_t n = (64 - len) >> 3; // whole bytes that fit into the buffer
+        uint64_t w;
+        memcpy(&w, m_inptr + m_rIndex, 8);
+        w = __builtin_bswap64(w) & (~0ULL << (64 - n * 8));
+        buf |= w >> len;
+        len += n * 8;
+        m_rIndex += n;
+        *bytesLeft -= n;
+        return;
+    }
+    do{ // end of the input, byte by byte
+        if(*bytesLeft > 0) buf |= (uint64_t)*(m_inptr + m_rIndex) << (56 - len);
+        else if(*bytesLeft == 0) log_i("error in bitreader, the frame is truncated"); // zero padding from here
         m_rIndex++;
         (*bytesLeft)--;
-        if(*bytesLeft < 0) { log_i("error in bitreader"); }
-        m_bitBuffer = (m_bitBuffer << 8) | temp;
-        m_bitBufferLen += 8;
-    }
+        len += 8;
+    } while(len <= 56 && *bytesLeft > 0);
+}
+
+uint32_t readUint(uint8_t nBits, int *bytesLeft){
+    if(nBits == 0) return 0;
+    while(m_bitBufferLen < nBits) bitReaderRefill(m_bitBuffer, m_bitBufferLen, bytesLeft);
+    uint32_t result = m_bitBuffer >> (64 - nBits);
+    m_bitBuffer <<= nBits;
     m_bitBufferLen -= nBits;
-    uint32_t result = m_bitBuffer >> m_bitBufferLen;
-    if (nBits < 32)
-        result &= mask[nBits];
     return result;
 }
 
 int32_t readSignedInt(int nBits, int* bytesLeft){
+    if(nBits == 0) return 0;
     int32_t temp = readUint(nBits, bytesLeft) << (32 - nBits);
     temp = temp >> (32 - nBits); // The C++ compiler uses the sign bit to fill vacated bit positions
     return temp;
 }
 
 int64_t readRiceSignedInt(uint8_t param, int* bytesLeft){
-    long val = 0;
-    while (readUint(1, bytesLeft) == 0)
-        val++;
-    val = (val << param) | readUint(param, bytesLeft);
-    return (val >> 1) ^ -(val & 1);
+    uint32_t val = 0;
+    while(m_bitBuffer == 0){ // the unary run goes beyond the buffered bits
+        val += m_bitBufferLen;
+        m_bitBufferLen = 0;
+        if(*bytesLeft < 0) {m_bitBuffer = 1ULL << 63; m_bitBufferLen = 64;} // zero padding, end the run
+        else bitReaderRefill(m_bitBuffer, m_bitBufferLen, bytesLeft);
+    }
+    uint8_t zeros = __builtin_clzll(m_bitBuffer);
+    m_bitBuffer <<= zeros;
+    m_bitBuffer <<= 1; // stop bit, zeros + 1 can be 64
+    m_bitBufferLen -= zeros + 1;
+    val = ((val + zeros) << param) | readUint(param, bytesLeft);
+    return (int32_t)((val >> 1) ^ -(val & 1));
+}
+
+void decodeRicePartition(uint8_t param, int32_t* out, int count, int* bytesLeft){
+    // same as readRiceSignedInt() for a whole partition, the bitbuffer is held in registers
+    uint64_t buf = m_bitBuffer;
+    uint8_t  len = m_bitBufferLen;
+    for(int i = 0; i < count; i++){
+        uint32_t q = 0;
+        while(buf == 0){ // no stop bit in the buffered bits
+            q += len;
+            len = 0;
+            if(*bytesLeft < 0) {buf = 1ULL << 63; len = 64;} // zero padding, end the run
+            else bitReaderRefill(buf, len, bytesLeft);
+        }
+        uint8_t zeros = __builtin_clzll(buf);
+        q += zeros;
+        buf <<= zeros;
+        buf <<= 1;
+        len -= zeros + 1;
+        while(len < param) bitReaderRefill(buf, len, bytesLeft);
+        uint32_t val = q << param;
+        if(param){
+            val |= buf >> (64 - param);
+            buf <<= param;
+            len -= param;
+        }
+        out[i] = (val >> 1) ^ -(val & 1);
+    }
+    m_bitBuffer = buf;
+    m_bitBufferLen = len;
 }
 
 void alignToByte() {
-    m_bitBufferLen -= m_bitBufferLen % 8;
+    uint8_t n = m_bitBufferLen % 8;
+    m_bitBuffer <<= n;
+    m_bitBufferLen -= n;
+}
+
+void syncBytesLeft(int *bytesLeft){ // must be byte aligned
+    uint8_t n = m_bitBufferLen >> 3;
+    m_rIndex -= n;
+    *bytesLeft += n;
+    m_bitBuffer = 0;
+    m_bitBufferLen = 0;
 }
 //----------------------------------------------------------------------------------------------------------------------
 //              F L A C - D E C O D E R
@@ -138,14 +215,10 @@ void FLACDecoderReset(){ // set var to default
 //----------------------------------------------------------------------------------------------------------------------
 int FLACFindSyncWord(unsigned char *buf, int nBytes) {
     int i;
-    i = FLAC_specialIndexOf(buf, "OggS", nBytes);
-    if(i == 0){
-        // flag has ogg wrapper
-        return 0;
-    }
      /* find byte-aligned sync code - need 14 matching bits */
     for (i = 0; i < nBytes - 1; i++) {
         if ((buf[i + 0] & 0xFF) == 0xFF  && (buf[i + 1] & 0xFC) == 0xF8) { // <14> Sync code '11111111111110xx'
+            if(nBytes - i >= 16 && !FLACCheckFrameHeader(buf + i, nBytes - i)) continue; // false sync in audio data
             FLACDecoderReset();
             return i;
         }
@@ -153,6 +226,213 @@ int FLACFindSyncWord(unsigned char *buf, int nBytes) {
     return -1;
 }
 //----------------------------------------------------------------------------------------------------------------------
+// slice-by-4 tables, [0] is the CRC of one byte, [k] the CRC of one byte followed by k zero bytes
+const uint8_t crc8Table[4][256] = {
+    {
+        0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D,
+        0x70, 0x77, 0x7E, 0x79, 0x6C, 0x6B, 0x62, 0x65, 0x48, 0x4F, 0x46, 0x41, 0x54, 0x53, 0x5A, 0x5D,
+        0xE0, 0xE7, 0xEE, 0xE9, 0xFC, 0xFB, 0xF2, 0xF5, 0xD8, 0xDF, 0xD6, 0xD1, 0xC4, 0xC3, 0xCA, 0xCD,
+        0x90, 0x97, 0x9E, 0x99, 0x8C, 0x8B, 0x82, 0x85, 0xA8, 0xAF, 0xA6, 0xA1, 0xB4, 0xB3, 0xBA, 0xBD,
+        0xC7, 0xC0, 0xC9, 0xCE, 0xDB, 0xDC, 0xD5, 0xD2, 0xFF, 0xF8, 0xF1, 0xF6, 0xE3, 0xE4, 0xED, 0xEA,
+        0xB7, 0xB0, 0xB9, 0xBE, 0xAB, 0xAC, 0xA5, 0xA2, 0x8F, 0x88, 0x81, 0x86, 0x93, 0x94, 0x9D, 0x9A,
+        0x27, 0x20, 0x29, 0x2E, 0x3B, 0x3C, 0x35, 0x32, 0x1F, 0x18, 0x11, 0x16, 0x03, 0x04, 0x0D, 0x0A,
+        0x57, 0x50, 0x59, 0x5E, 0x4B, 0x4C, 0x45, 0x42, 0x6F, 0x68, 0x61, 0x66, 0x73, 0x74, 0x7D, 0x7A,
+        0x89, 0x8E, 0x87, 0x80, 0x95, 0x92, 0x9B, 0x9C, 0xB1, 0xB6, 0xBF, 0xB8, 0xAD, 0xAA, 0xA3, 0xA4,
+        0xF9, 0xFE, 0xF7, 0xF0, 0xE5, 0xE2, 0xEB, 0xEC, 0xC1, 0xC6, 0xCF, 0xC8, 0xDD, 0xDA, 0xD3, 0xD4,
+        0x69, 0x6E, 0x67, 0x60, 0x75, 0x72, 0x7B, 0x7C, 0x51, 0x56, 0x5F, 0x58, 0x4D, 0x4A, 0x43, 0x44,
+        0x19, 0x1E, 0x17, 0x10, 0x05, 0x02, 0x0B, 0x0C, 0x21, 0x26, 0x2F, 0x28, 0x3D, 0x3A, 0x33, 0x34,
+        0x4E, 0x49, 0x40, 0x47, 0x52, 0x55, 0x5C, 0x5B, 0x76, 0x71, 0x78, 0x7F, 0x6A, 0x6D, 0x64, 0x63,
+        0x3E, 0x39, 0x30, 0x37, 0x22, 0x25, 0x2C, 0x2B, 0x06, 0x01, 0x08, 0x0F, 0x1A, 0x1D, 0x14, 0x13,
+        0xAE, 0xA9, 0xA0, 0xA7, 0xB2, 0xB5, 0xBC, 0xBB, 0x96, 0x91, 0x98, 0x9F, 0x8A, 0x8D, 0x84, 0x83,
+        0xDE, 0xD9, 0xD0, 0xD7, 0xC2, 0xC5, 0xCC, 0xCB, 0xE6, 0xE1, 0xE8, 0xEF, 0xFA, 0xFD, 0xF4, 0xF3
+    },
+    {
+        0x00, 0x15, 0x2A, 0x3F, 0x54, 0x41, 0x7E, 0x6B, 0xA8, 0xBD, 0x82, 0x97, 0xFC, 0xE9, 0xD6, 0xC3,
+        0x57, 0x42, 0x7D, 0x68, 0x03, 0x16, 0x29, 0x3C, 0xFF, 0xEA, 0xD5, 0xC0, 0xAB, 0xBE, 0x81, 0x94,
+        0xAE, 0xBB, 0x84, 0x91, 0xFA, 0xEF, 0xD0, 0xC5, 0x06, 0x13, 0x2C, 0x39, 0x52, 0x47, 0x78, 0x6D,
+        0xF9, 0xEC, 0xD3, 0xC6, 0xAD, 0xB8, 0x87, 0x92, 0x51, 0x44, 0x7B, 0x6E, 0x05, 0x10, 0x2F, 0x3A,
+        0x5B, 0x4E, 0x71, 0x64, 0x0F, 0x1A, 0x25, 0x30, 0xF3, 0xE6, 0xD9, 0xCC, 0xA7, 0xB2, 0x8D, 0x98,
+        0x0C, 0x19, 0x26, 0x33, 0x58, 0x4D, 0x72, 0x67, 0xA4, 0xB1, 0x8E, 0x9B, 0xF0, 0xE5, 0xDA, 0xCF,
+        0xF5, 0xE0, 0xDF, 0xCA, 0xA1, 0xB4, 0x8B, 0x9E, 0x5D, 0x48, 0x77, 0x62, 0x09, 0x1C, 0x23, 0x36,
+        0xA2, 0xB7, 0x88, 0x9D, 0xF6, 0xE3, 0xDC, 0xC9, 0x0A, 0x1F, 0x20, 0x35, 0x5E, 0x4B, 0x74, 0x61,
+        0xB6, 0xA3, 0x9C, 0x89, 0xE2, 0xF7, 0xC8, 0xDD, 0x1E, 0x0B, 0x34, 0x21, 0x4A, 0x5F, 0x60, 0x75,
+        0xE1, 0xF4, 0xCB, 0xDE, 0xB5, 0xA0, 0x9F, 0x8A, 0x49, 0x5C, 0x63, 0x76, 0x1D, 0x08, 0x37, 0x22,
+        0x18, 0x0D, 0x32, 0x27, 0x4C, 0x59, 0x66, 0x73, 0xB0, 0xA5, 0x9A, 0x8F, 0xE4, 0xF1, 0xCE, 0xDB,
+        0x4F, 0x5A, 0x65, 0x70, 0x1B, 0x0E, 0x31, 0x24, 0xE7, 0xF2, 0xCD, 0xD8, 0xB3, 0xA6, 0x99, 0x8C,
+        0xED, 0xF8, 0xC7, 0xD2, 0xB9, 0xAC, 0x93, 0x86, 0x45, 0x50, 0x6F, 0x7A, 0x11, 0x04, 0x3B, 0x2E,
+        0xBA, 0xAF, 0x90, 0x85, 0xEE, 0xFB, 0xC4, 0xD1, 0x12, 0x07, 0x38, 0x2D, 0x46, 0x53, 0x6C, 0x79,
+        0x43, 0x56, 0x69, 0x7C, 0x17, 0x02, 0x3D, 0x28, 0xEB, 0xFE, 0xC1, 0xD4, 0xBF, 0xAA, 0x95, 0x80,
+        0x14, 0x01, 0x3E, 0x2B, 0x40, 0x55, 0x6A, 0x7F, 0xBC, 0xA9, 0x96, 0x83, 0xE8, 0xFD, 0xC2, 0xD7
+    },
+    {
+        0x00, 0x6B, 0xD6, 0xBD, 0xAB, 0xC0, 0x7D, 0x16, 0x51, 0x3A, 0x87, 0xEC, 0xFA, 0x91, 0x2C, 0x47,
+        0xA2, 0xC9, 0x74, 0x1F, 0x09, 0x62, 0xDF, 0xB4, 0xF3, 0x98, 0x25, 0x4E, 0x58, 0x33, 0x8E, 0xE5,
+        0x43, 0x28, 0x95, 0xFE, 0xE8, 0x83, 0x3E, 0x55, 0x12, 0x79, 0xC4, 0xAF, 0xB9, 0xD2, 0x6F, 0x04,
+        0xE1, 0x8A, 0x37, 0x5C, 0x4A, 0x21, 0x9C, 0xF7, 0xB0, 0xDB, 0x66, 0x0D, 0x1B, 0x70, 0xCD, 0xA6,
+        0x86, 0xED, 0x50, 0x3B, 0x2D, 0x46, 0xFB, 0x90, 0xD7, 0xBC, 0x01, 0x6A, 0x7C, 0x17, 0xAA, 0xC1,
+        0x24, 0x4F, 0xF2, 0x99, 0x8F, 0xE4, 0x59, 0x32, 0x75, 0x1E, 0xA3, 0xC8, 0xDE, 0xB5, 0x08, 0x63,
+        0xC5, 0xAE, 0x13, 0x78, 0x6E, 0x05, 0xB8, 0xD3, 0x94, 0xFF, 0x42, 0x29, 0x3F, 0x54, 0xE9, 0x82,
+        0x67, 0x0C, 0xB1, 0xDA, 0xCC, 0xA7, 0x1A, 0x71, 0x36, 0x5D, 0xE0, 0x8B, 0x9D, 0xF6, 0x4B, 0x20,
+        0x0B, 0x60, 0xDD, 0xB6, 0xA0, 0xCB, 0x76, 0x1D, 0x5A, 0x31, 0x8C, 0xE7, 0xF1, 0x9A, 0x27, 0x4C,
+        0xA9, 0xC2, 0x7F, 0x14, 0x02, 0x69, 0xD4, 0xBF, 0xF8, 0x93, 0x2E, 0x45, 0x53, 0x38, 0x85, 0xEE,
+        0x48, 0x23, 0x9E, 0xF5, 0xE3, 0x88, 0x35, 0x5E, 0x19, 0x72, 0xCF, 0xA4, 0xB2, 0xD9, 0x64, 0x0F,
+        0xEA, 0x81, 0x3C, 0x57, 0x41, 0x2A, 0x97, 0xFC, 0xBB, 0xD0, 0x6D, 0x06, 0x10, 0x7B, 0xC6, 0xAD,
+        0x8D, 0xE6, 0x5B, 0x30, 0x26, 0x4D, 0xF0, 0x9B, 0xDC, 0xB7, 0x0A, 0x61, 0x77, 0x1C, 0xA1, 0xCA,
+        0x2F, 0x44, 0xF9, 0x92, 0x84, 0xEF, 0x52, 0x39, 0x7E, 0x15, 0xA8, 0xC3, 0xD5, 0xBE, 0x03, 0x68,
+        0xCE, 0xA5, 0x18, 0x73, 0x65, 0x0E, 0xB3, 0xD8, 0x9F, 0xF4, 0x49, 0x22, 0x34, 0x5F, 0xE2, 0x89,
+        0x6C, 0x07, 0xBA, 0xD1, 0xC7, 0xAC, 0x11, 0x7A, 0x3D, 0x56, 0xEB, 0x80, 0x96, 0xFD, 0x40, 0x2B
+    },
+    {
+        0x00, 0x16, 0x2C, 0x3A, 0x58, 0x4E, 0x74, 0x62, 0xB0, 0xA6, 0x9C, 0x8A, 0xE8, 0xFE, 0xC4, 0xD2,
+        0x67, 0x71, 0x4B, 0x5D, 0x3F, 0x29, 0x13, 0x05, 0xD7, 0xC1, 0xFB, 0xED, 0x8F, 0x99, 0xA3, 0xB5,
+        0xCE, 0xD8, 0xE2, 0xF4, 0x96, 0x80, 0xBA, 0xAC, 0x7E, 0x68, 0x52, 0x44, 0x26, 0x30, 0x0A, 0x1C,
+        0xA9, 0xBF, 0x85, 0x93, 0xF1, 0xE7, 0xDD, 0xCB, 0x19, 0x0F, 0x35, 0x23, 0x41, 0x57, 0x6D, 0x7B,
+        0x9B, 0x8D, 0xB7, 0xA1, 0xC3, 0xD5, 0xEF, 0xF9, 0x2B, 0x3D, 0x07, 0x11, 0x73, 0x65, 0x5F, 0x49,
+        0xFC, 0xEA, 0xD0, 0xC6, 0xA4, 0xB2, 0x88, 0x9E, 0x4C, 0x5A, 0x60, 0x76, 0x14, 0x02, 0x38, 0x2E,
+        0x55, 0x43, 0x79, 0x6F, 0x0D, 0x1B, 0x21, 0x37, 0xE5, 0xF3, 0xC9, 0xDF, 0xBD, 0xAB, 0x91, 0x87,
+        0x32, 0x24, 0x1E, 0x08, 0x6A, 0x7C, 0x46, 0x50, 0x82, 0x94, 0xAE, 0xB8, 0xDA, 0xCC, 0xF6, 0xE0,
+        0x31, 0x27, 0x1D, 0x0B, 0x69, 0x7F, 0x45, 0x53, 0x81, 0x97, 0xAD, 0xBB, 0xD9, 0xCF, 0xF5, 0xE3,
+        0x56, 0x40, 0x7A, 0x6C, 0x0E, 0x18, 0x22, 0x34, 0xE6, 0xF0, 0xCA, 0xDC, 0xBE, 0xA8, 0x92, 0x84,
+        0xFF, 0xE9, 0xD3, 0xC5, 0xA7, 0xB1, 0x8B, 0x9D, 0x4F, 0x59, 0x63, 0x75, 0x17, 0x01, 0x3B, 0x2D,
+        0x98, 0x8E, 0xB4, 0xA2, 0xC0, 0xD6, 0xEC, 0xFA, 0x28, 0x3E, 0x04, 0x12, 0x70, 0x66, 0x5C, 0x4A,
+        0xAA, 0xBC, 0x86, 0x90, 0xF2, 0xE4, 0xDE, 0xC8, 0x1A, 0x0C, 0x36, 0x20, 0x42, 0x54, 0x6E, 0x78,
+        0xCD, 0xDB, 0xE1, 0xF7, 0x95, 0x83, 0xB9, 0xAF, 0x7D, 0x6B, 0x51, 0x47, 0x25, 0x33, 0x09, 0x1F,
+        0x64, 0x72, 0x48, 0x5E, 0x3C, 0x2A, 0x10, 0x06, 0xD4, 0xC2, 0xF8, 0xEE, 0x8C, 0x9A, 0xA0, 0xB6,
+        0x03, 0x15, 0x2F, 0x39, 0x5B, 0x4D, 0x77, 0x61, 0xB3, 0xA5, 0x9F, 0x89, 0xEB, 0xFD, 0xC7, 0xD1
+    }
+};
+const uint16_t crc16Table[4][256] = {
+    {
+        0x0000, 0x8005, 0x800F, 0x000A, 0x801B, 0x001E, 0x0014, 0x8011, 0x8033, 0x0036, 0x003C, 0x8039, 0x0028, 0x802D, 0x8027, 0x0022,
+        0x8063, 0x0066, 0x006C, 0x8069, 0x0078, 0x807D, 0x8077, 0x0072, 0x0050, 0x8055, 0x805F, 0x005A, 0x804B, 0x004E, 0x0044, 0x8041,
+        0x80C3, 0x00C6, 0x00CC, 0x80C9, 0x00D8, 0x80DD, 0x80D7, 0x00D2, 0x00F0, 0x80F5, 0x80FF, 0x00FA, 0x80EB, 0x00EE, 0x00E4, 0x80E1,
+        0x00A0, 0x80A5, 0x80AF, 0x00AA, 0x80BB, 0x00BE, 0x00B4, 0x80B1, 0x8093, 0x0096, 0x009C, 0x8099, 0x0088, 0x808D, 0x8087, 0x0082,
+        0x8183, 0x0186, 0x018C, 0x8189, 0x0198, 0x819D, 0x8197, 0x0192, 0x01B0, 0x81B5, 0x81BF, 0x01BA, 0x81AB, 0x01AE, 0x01A4, 0x81A1,
+        0x01E0, 0x81E5, 0x81EF, 0x01EA, 0x81FB, 0x01FE, 0x01F4, 0x81F1, 0x81D3, 0x01D6, 0x01DC, 0x81D9, 0x01C8, 0x81CD, 0x81C7, 0x01C2,
+        0x0140, 0x8145, 0x814F, 0x014A, 0x815B, 0x015E, 0x0154, 0x8151, 0x8173, 0x0176, 0x017C, 0x8179, 0x0168, 0x816D, 0x8167, 0x0162,
+        0x8123, 0x0126, 0x012C, 0x8129, 0x0138, 0x813D, 0x8137, 0x0132, 0x0110, 0x8115, 0x811F, 0x011A, 0x810B, 0x010E, 0x0104, 0x8101,
+        0x8303, 0x0306, 0x030C, 0x8309, 0x0318, 0x831D, 0x8317, 0x0312, 0x0330, 0x8335, 0x833F, 0x033A, 0x832B, 0x032E, 0x0324, 0x8321,
+        0x0360, 0x8365, 0x836F, 0x036A, 0x837B, 0x037E, 0x0374, 0x8371, 0x8353, 0x0356, 0x035C, 0x8359, 0x0348, 0x834D, 0x8347, 0x0342,
+        0x03C0, 0x83C5, 0x83CF, 0x03CA, 0x83DB, 0x03DE, 0x03D4, 0x83D1, 0x83F3, 0x03F6, 0x03FC, 0x83F9, 0x03E8, 0x83ED, 0x83E7, 0x03E2,
+        0x83A3, 0x03A6, 0x03AC, 0x83A9, 0x03B8, 0x83BD, 0x83B7, 0x03B2, 0x0390, 0x8395, 0x839F, 0x039A, 0x838B, 0x038E, 0x0384, 0x8381,
+        0x0280, 0x8285, 0x828F, 0x028A, 0x829B, 0x029E, 0x0294, 0x8291, 0x82B3, 0x02B6, 0x02BC, 0x82B9, 0x02A8, 0x82AD, 0x82A7, 0x02A2,
+        0x82E3, 0x02E6, 0x02EC, 0x82E9, 0x02F8, 0x82FD, 0x82F7, 0x02F2, 0x02D0, 0x82D5, 0x82DF, 0x02DA, 0x82CB, 0x02CE, 0x02C4, 0x82C1,
+        0x8243, 0x0246, 0x024C, 0x8249, 0x0258, 0x825D, 0x8257, 0x0252, 0x0270, 0x8275, 0x827F, 0x027A, 0x826B, 0x026E, 0x0264, 0x8261,
+        0x0220, 0x8225, 0x822F, 0x022A, 0x823B, 0x023E, 0x0234, 0x8231, 0x8213, 0x0216, 0x021C, 0x8219, 0x0208, 0x820D, 0x8207, 0x0202
+    },
+    {
+        0x0000, 0x8603, 0x8C03, 0x0A00, 0x9803, 0x1E00, 0x1400, 0x9203, 0xB003, 0x3600, 0x3C00, 0xBA03, 0x2800, 0xAE03, 0xA403, 0x2200,
+        0xE003, 0x6600, 0x6C00, 0xEA03, 0x7800, 0xFE03, 0xF403, 0x7200, 0x5000, 0xD603, 0xDC03, 0x5A00, 0xC803, 0x4E00, 0x4400, 0xC203,
+        0x4003, 0xC600, 0xCC00, 0x4A03, 0xD800, 0x5E03, 0x5403, 0xD200, 0xF000, 0x7603, 0x7C03, 0xFA00, 0x6803, 0xEE00, 0xE400, 0x6203,
+        0xA000, 0x2603, 0x2C03, 0xAA00, 0x3803, 0xBE00, 0xB400, 0x3203, 0x1003, 0x9600, 0x9C00, 0x1A03, 0x8800, 0x0E03, 0x0403, 0x8200,
+        0x8006, 0x0605, 0x0C05, 0x8A06, 0x1805, 0x9E06, 0x9406, 0x1205, 0x3005, 0xB606, 0xBC06, 0x3A05, 0xA806, 0x2E05, 0x2405, 0xA206,
+        0x6005, 0xE606, 0xEC06, 0x6A05, 0xF806, 0x7E05, 0x7405, 0xF206, 0xD006, 0x5605, 0x5C05, 0xDA06, 0x4805, 0xCE06, 0xC406, 0x4205,
+        0xC005, 0x4606, 0x4C06, 0xCA05, 0x5806, 0xDE05, 0xD405, 0x5206, 0x7006, 0xF605, 0xFC05, 0x7A06, 0xE805, 0x6E06, 0x6406, 0xE205,
+        0x2006, 0xA605, 0xAC05, 0x2A06, 0xB805, 0x3E06, 0x3406, 0xB205, 0x9005, 0x1606, 0x1C06, 0x9A05, 0x0806, 0x8E05, 0x8405, 0x0206,
+        0x8009, 0x060A, 0x0C0A, 0x8A09, 0x180A, 0x9E09, 0x9409, 0x120A, 0x300A, 0xB609, 0xBC09, 0x3A0A, 0xA809, 0x2E0A, 0x240A, 0xA209,
+        0x600A, 0xE609, 0xEC09, 0x6A0A, 0xF809, 0x7E0A, 0x740A, 0xF209, 0xD009, 0x560A, 0x5C0A, 0xDA09, 0x480A, 0xCE09, 0xC409, 0x420A,
+        0xC00A, 0x4609, 0x4C09, 0xCA0A, 0x5809, 0xDE0A, 0xD40A, 0x5209, 0x7009, 0xF60A, 0xFC0A, 0x7A09, 0xE80A, 0x6E09, 0x6409, 0xE20A,
+        0x2009, 0xA60A, 0xAC0A, 0x2A09, 0xB80A, 0x3E09, 0x3409, 0xB20A, 0x900A, 0x1609, 0x1C09, 0x9A0A, 0x0809, 0x8E0A, 0x840A, 0x0209,
+        0x000F, 0x860C, 0x8C0C, 0x0A0F, 0x980C, 0x1E0F, 0x140F, 0x920C, 0xB00C, 0x360F, 0x3C0F, 0xBA0C, 0x280F, 0xAE0C, 0xA40C, 0x220F,
+        0xE00C, 0x660F, 0x6C0F, 0xEA0C, 0x780F, 0xFE0C, 0xF40C, 0x720F, 0x500F, 0xD60C, 0xDC0C, 0x5A0F, 0xC80C, 0x4E0F, 0x440F, 0xC20C,
+        0x400C, 0xC60F, 0xCC0F, 0x4A0C, 0xD80F, 0x5E0C, 0x540C, 0xD20F, 0xF00F, 0x760C, 0x7C0C, 0xFA0F, 0x680C, 0xEE0F, 0xE40F, 0x620C,
+        0xA00F, 0x260C, 0x2C0C, 0xAA0F, 0x380C, 0xBE0F, 0xB40F, 0x320C, 0x100C, 0x960F, 0x9C0F, 0x1A0C, 0x880F, 0x0E0C, 0x040C, 0x820F
+    },
+    {
+        0x0000, 0x8017, 0x802B, 0x003C, 0x8053, 0x0044, 0x0078, 0x806F, 0x80A3, 0x00B4, 0x0088, 0x809F, 0x00F0, 0x80E7, 0x80DB, 0x00CC,
+        0x8143, 0x0154, 0x0168, 0x817F, 0x0110, 0x8107, 0x813B, 0x012C, 0x01E0, 0x81F7, 0x81CB, 0x01DC, 0x81B3, 0x01A4, 0x0198, 0x818F,
+        0x8283, 0x0294, 0x02A8, 0x82BF, 0x02D0, 0x82C7, 0x82FB, 0x02EC, 0x0220, 0x8237, 0x820B, 0x021C, 0x8273, 0x0264, 0x0258, 0x824F,
+        0x03C0, 0x83D7, 0x83EB, 0x03FC, 0x8393, 0x0384, 0x03B8, 0x83AF, 0x8363, 0x0374, 0x0348, 0x835F, 0x0330, 0x8327, 0x831B, 0x030C,
+        0x8503, 0x0514, 0x0528, 0x853F, 0x0550, 0x8547, 0x857B, 0x056C, 0x05A0, 0x85B7, 0x858B, 0x059C, 0x85F3, 0x05E4, 0x05D8, 0x85CF,
+        0x0440, 0x8457, 0x846B, 0x047C, 0x8413, 0x0404, 0x0438, 0x842F, 0x84E3, 0x04F4, 0x04C8, 0x84DF, 0x04B0, 0x84A7, 0x849B, 0x048C,
+        0x0780, 0x8797, 0x87AB, 0x07BC, 0x87D3, 0x07C4, 0x07F8, 0x87EF, 0x8723, 0x0734, 0x0708, 0x871F, 0x0770, 0x8767, 0x875B, 0x074C,
+        0x86C3, 0x06D4, 0x06E8, 0x86FF, 0x0690, 0x8687, 0x86BB, 0x06AC, 0x0660, 0x8677, 0x864B, 0x065C, 0x8633, 0x0624, 0x0618, 0x860F,
+        0x8A03, 0x0A14, 0x0A28, 0x8A3F, 0x0A50, 0x8A47, 0x8A7B, 0x0A6C, 0x0AA0, 0x8AB7, 0x8A8B, 0x0A9C, 0x8AF3, 0x0AE4, 0x0AD8, 0x8ACF,
+        0x0B40, 0x8B57, 0x8B6B, 0x0B7C, 0x8B13, 0x0B04, 0x0B38, 0x8B2F, 0x8BE3, 0x0BF4, 0x0BC8, 0x8BDF, 0x0BB0, 0x8BA7, 0x8B9B, 0x0B8C,
+        0x0880, 0x8897, 0x88AB, 0x08BC, 0x88D3, 0x08C4, 0x08F8, 0x88EF, 0x8823, 0x0834, 0x0808, 0x881F, 0x0870, 0x8867, 0x885B, 0x084C,
+        0x89C3, 0x09D4, 0x09E8, 0x89FF, 0x0990, 0x8987, 0x89BB, 0x09AC, 0x0960, 0x8977, 0x894B, 0x095C, 0x8933, 0x0924, 0x0918, 0x890F,
+        0x0F00, 0x8F17, 0x8F2B, 0x0F3C, 0x8F53, 0x0F44, 0x0F78, 0x8F6F, 0x8FA3, 0x0FB4, 0x0F88, 0x8F9F, 0x0FF0, 0x8FE7, 0x8FDB, 0x0FCC,
+        0x8E43, 0x0E54, 0x0E68, 0x8E7F, 0x0E10, 0x8E07, 0x8E3B, 0x0E2C, 0x0EE0, 0x8EF7, 0x8ECB, 0x0EDC, 0x8EB3, 0x0EA4, 0x0E98, 0x8E8F,
+        0x8D83, 0x0D94, 0x0DA8, 0x8DBF, 0x0DD0, 0x8DC7, 0x8DFB, 0x0DEC, 0x0D20, 0x8D37, 0x8D0B, 0x0D1C, 0x8D73, 0x0D64, 0x0D58, 0x8D4F,
+        0x0CC0, 0x8CD7, 0x8CEB, 0x0CFC, 0x8C93, 0x0C84, 0x0CB8, 0x8CAF, 0x8C63, 0x0C74, 0x0C48, 0x8C5F, 0x0C30, 0x8C27, 0x8C1B, 0x0C0C
+    },
+    {
+        0x0000, 0x9403, 0xA803, 0x3C00, 0xD003, 0x4400, 0x7800, 0xEC03, 0x2003, 0xB400, 0x8800, 0x1C03, 0xF000, 0x6403, 0x5803, 0xCC00,
+        0x4006, 0xD405, 0xE805, 0x7C06, 0x9005, 0x0406, 0x3806, 0xAC05, 0x6005, 0xF406, 0xC806, 0x5C05, 0xB006, 0x2405, 0x1805, 0x8C06,
+        0x800C, 0x140F, 0x280F, 0xBC0C, 0x500F, 0xC40C, 0xF80C, 0x6C0F, 0xA00F, 0x340C, 0x080C, 0x9C0F, 0x700C, 0xE40F, 0xD80F, 0x4C0C,
+        0xC00A, 0x5409, 0x6809, 0xFC0A, 0x1009, 0x840A, 0xB80A, 0x2C09, 0xE009, 0x740A, 0x480A, 0xDC09, 0x300A, 0xA409, 0x9809, 0x0C0A,
+        0x801D, 0x141E, 0x281E, 0xBC1D, 0x501E, 0xC41D, 0xF81D, 0x6C1E, 0xA01E, 0x341D, 0x081D, 0x9C1E, 0x701D, 0xE41E, 0xD81E, 0x4C1D,
+        0xC01B, 0x5418, 0x6818, 0xFC1B, 0x1018, 0x841B, 0xB81B, 0x2C18, 0xE018, 0x741B, 0x481B, 0xDC18, 0x301B, 0xA418, 0x9818, 0x0C1B,
+        0x0011, 0x9412, 0xA812, 0x3C11, 0xD012, 0x4411, 0x7811, 0xEC12, 0x2012, 0xB411, 0x8811, 0x1C12, 0xF011, 0x6412, 0x5812, 0xCC11,
+        0x4017, 0xD414, 0xE814, 0x7C17, 0x9014, 0x0417, 0x3817, 0xAC14, 0x6014, 0xF417, 0xC817, 0x5C14, 0xB017, 0x2414, 0x1814, 0x8C17,
+        0x803F, 0x143C, 0x283C, 0xBC3F, 0x503C, 0xC43F, 0xF83F, 0x6C3C, 0xA03C, 0x343F, 0x083F, 0x9C3C, 0x703F, 0xE43C, 0xD83C, 0x4C3F,
+        0xC039, 0x543A, 0x683A, 0xFC39, 0x103A, 0x8439, 0xB839, 0x2C3A, 0xE03A, 0x7439, 0x4839, 0xDC3A, 0x3039, 0xA43A, 0x983A, 0x0C39,
+        0x0033, 0x9430, 0xA830, 0x3C33, 0xD030, 0x4433, 0x7833, 0xEC30, 0x2030, 0xB433, 0x8833, 0x1C30, 0xF033, 0x6430, 0x5830, 0xCC33,
+        0x4035, 0xD436, 0xE836, 0x7C35, 0x9036, 0x0435, 0x3835, 0xAC36, 0x6036, 0xF435, 0xC835, 0x5C36, 0xB035, 0x2436, 0x1836, 0x8C35,
+        0x0022, 0x9421, 0xA821, 0x3C22, 0xD021, 0x4422, 0x7822, 0xEC21, 0x2021, 0xB422, 0x8822, 0x1C21, 0xF022, 0x6421, 0x5821, 0xCC22,
+        0x4024, 0xD427, 0xE827, 0x7C24, 0x9027, 0x0424, 0x3824, 0xAC27, 0x6027, 0xF424, 0xC824, 0x5C27, 0xB024, 0x2427, 0x1827, 0x8C24,
+        0x802E, 0x142D, 0x282D, 0xBC2E, 0x502D, 0xC42E, 0xF82E, 0x6C2D, 0xA02D, 0x342E, 0x082E, 0x9C2D, 0x702E, 0xE42D, 0xD82D, 0x4C2E,
+        0xC028, 0x542B, 0x682B, 0xFC28, 0x102B, 0x8428, 0xB828, 0x2C2B, 0xE02B, 0x7428, 0x4828, 0xDC2B, 0x3028, 0xA42B, 0x982B, 0x0C28
+    }
+};
+
+uint8_t FLACcrc8(const uint8_t *buf, int len){ // polynomial x^8 + x^2 + x^1 + x^0, initialized with 0
+    uint8_t crc = 0;
+    while(len >= 4){
+        crc = crc8Table[3][buf[0] ^ crc] ^ crc8Table[2][buf[1]] ^ crc8Table[1][buf[2]] ^ crc8Table[0][buf[3]];
+        buf += 4;
+        len -= 4;
+    }
+    while(len--) crc = crc8Table[0][crc ^ *buf++];
+    return crc;
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint16_t FLACcrc16(uint16_t crc, const uint8_t *buf, int len){ // polynomial x^16 + x^15 + x^2 + x^0, start with 0
+    while(len >= 4){
+        crc = crc16Table[3][(crc >> 8) ^ buf[0]] ^ crc16Table[2][(crc & 0xFF) ^ buf[1]] ^
+              crc16Table[1][buf[2]] ^ crc16Table[0][buf[3]];
+        buf += 4;
+        len -= 4;
+    }
+    while(len--) crc = (crc << 8) ^ crc16Table[0][(crc >> 8) ^ *buf++];
+    return crc;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int FLACCheckFrameHeader(uint8_t *buf, int nBytes){
+    // A sync code can also appear inside the audio data. Checks the reserved values and the CRC-8 of the
+    // frame header, returns the length of the header or 0 if it is not valid
+    if(nBytes < 6) return 0;
+    if(buf[0] != 0xFF || (buf[1] & 0xFE) != 0xF8) return 0; // sync code, reserved bit must be 0
+    uint8_t bsCode = buf[2] >> 4;
+    uint8_t srCode = buf[2] & 0x0F;
+    uint8_t chAsgn = buf[3] >> 4;
+    uint8_t ssCode = (buf[3] >> 1) & 0x07;
+    if(bsCode == 0 || srCode == 15 || chAsgn > 10 || ssCode == 3 || ssCode == 7 || (buf[3] & 0x01)) return 0;
+
+    int     len = 4;
+    uint8_t b = buf[len++]; // frame or sample number, UTF-8 coded, 1...7 bytes
+    int     n;
+    if     ((b & 0x80) == 0x00) n = 0;
+    else if((b & 0xE0) == 0xC0) n = 1;
+    else if((b & 0xF0) == 0xE0) n = 2;
+    else if((b & 0xF8) == 0xF0) n = 3;
+    else if((b & 0xFC) == 0xF8) n = 4;
+    else if((b & 0xFE) == 0xFC) n = 5;
+    else if( b == 0xFE)         n = 6;
+    else return 0;
+    if(len + n >= nBytes) return 0;
+    for(int i = 0; i < n; i++){
+        if((buf[len++] & 0xC0) != 0x80) return 0;
+    }
+    if(bsCode == 6) len += 1;
+    if(bsCode == 7) len += 2;
+    if(srCode == 12) len += 1;
+    if(srCode == 13 || srCode == 14) len += 2;
+    if(len >= nBytes) return 0;
+    if(FLACcrc8(buf, len) != buf[len]) return 0;
+    return len + 1;
+}
+//----------------------------------------------------------------------------------------------------------------------
 boolean FLACFindMagicWord(unsigned char* buf, int nBytes){
     int idx = FLAC_specialIndexOf(buf, "fLaC", nBytes);
     if(idx >0){ // Metadatablock follows
@@ -179,168 +459,93 @@ char* FLACgetStreamTitle(){
     return NULL;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int FLACparseOGG(uint8_t *inbuf, int *bytesLeft){  // reference https://www.xiph.org/ogg/doc/rfc3533.txt
-
-    s_f_flacParseOgg = false;
-    int idx = FLAC_specialIndexOf(inbuf, "OggS", 6);
-    if(idx != 0) return ERR_FLAC_DECODER_ASYNC;
-
-    uint8_t  version            = *(inbuf +  4); (void) version;
-    uint8_t  headerType         = *(inbuf +  5); (void) headerType;
-    uint64_t granulePosition    = (uint64_t)*(inbuf + 13) << 56;  // granule_position: an 8 Byte field containing -
-             granulePosition   += (uint64_t)*(inbuf + 12) << 48;  // position information. For an audio stream, it MAY
-             granulePosition   += (uint64_t)*(inbuf + 11) << 40;  // contain the total number of PCM samples encoded
-             granulePosition   += (uint64_t)*(inbuf + 10) << 32;  // after including all frames finished on this page.
-             granulePosition   += *(inbuf +  9) << 24;  // This is a hint for the decoder and gives it some timing
-             granulePosition   += *(inbuf +  8) << 16;  // and position information. A special value of -1 (in two's
-             granulePosition   += *(inbuf +  7) << 8;   // complement) indicates that no packets finish on this page.
-             granulePosition   += *(inbuf +  6); (void) granulePosition;
-    uint32_t bitstreamSerialNr  = *(inbuf + 17) << 24;  // bitstream_serial_number: a 4 Byte field containing the
-             bitstreamSerialNr += *(inbuf + 16) << 16;  // unique serial number by which the logical bitstream
-             bitstreamSerialNr += *(inbuf + 15) << 8;   // is identified.
-             bitstreamSerialNr += *(inbuf + 14); (void) bitstreamSerialNr;
-    uint32_t pageSequenceNr     = *(inbuf + 21) << 24;  // page_sequence_number: a 4 Byte field containing the sequence
-             pageSequenceNr    += *(inbuf + 20) << 16;  // number of the page so the decoder can identify page loss
-             pageSequenceNr    += *(inbuf + 19) << 8;   // This sequence number is increasing on each logical bitstream
-             pageSequenceNr    += *(inbuf + 18); (void) pageSequenceNr;
-    uint32_t CRCchecksum        = *(inbuf + 25) << 24;
-             CRCchecksum       += *(inbuf + 24) << 16;
-             CRCchecksum       += *(inbuf + 23) << 8;
-             CRCchecksum       += *(inbuf + 22); (void) CRCchecksum;
-    uint8_t  pageSegments       = *(inbuf + 26);        // giving the number of segment entries
-
-    // read the segment table (contains pageSegments bytes),  1...251: Length of the frame in bytes,
-    // 255: A second byte is needed.  The total length is first_byte + second byte
-
-    int16_t segmentTableWrPtr = 0;
-
-    for(int i = 0; i < pageSegments; i++){
-        int n = *(inbuf + 27 + i);
-        while(*(inbuf + 27 + i) == 255){
-            i++;
-            n+= *(inbuf + 27 + i);
-        }
-        s_flacSegmentTable[segmentTableWrPtr] = n;
-        segmentTableWrPtr++;
-    //    s_flacSegmentLength += n;
-    }
-    m_page0_len = s_flacSegmentTable[0];
-
-    // for(int i = 0; i<pageSegments; i++){
-    //     log_i("%i %i", i, s_flacSegmentTable[i]);
-    // }
-
-
-    bool     continuedPage = headerType & 0x01; // set: page contains data of a packet continued from the previous page
-    bool     firstPage     = headerType & 0x02; // set: this is the first page of a logical bitstream (bos)
-    bool     lastPage      = headerType & 0x04; // set: this is the last page of a logical bitstream (eos)
-    static   uint8_t secondPage = 0; (void)continuedPage; (void)lastPage;
-
-    if(firstPage) secondPage = 3;
-    if(secondPage) secondPage--;
-
-    uint16_t headerSize = 0;
+int8_t FLACDecode(uint8_t *inbuf, int *bytesLeft, short *outbuf){ //  MAIN LOOP
+    int ret = FLACDecodeNative(inbuf, bytesLeft, outbuf);
+    return ret;
+}
+//----------------------------------------------------------------------------------------------------------------------
+static void flacParseVorbisComment(const uint8_t *buf, uint32_t len){ // METADATA_BLOCK_VORBIS_COMMENT, little endian
+    if(len < 8) return;
+    uint32_t vendorLength = buf[0] + (buf[1] << 8) + (buf[2] << 16) + ((uint32_t)buf[3] << 24);
+    if(vendorLength > len - 8) return;
+    uint32_t pos = 4 + vendorLength;
+    uint32_t nrOfComments = buf[pos] + (buf[pos + 1] << 8) + (buf[pos + 2] << 16) + ((uint32_t)buf[pos + 3] << 24);
+    pos += 4;
     uint8_t aLen = 0, tLen = 0;
-    uint8_t *aPos = NULL, *tPos = NULL;
-    if(firstPage || secondPage == 1){
-        // log_i("s_flacSegmentTable[0] %i", s_flacSegmentTable[0]);
-        headerSize = pageSegments + s_flacSegmentTable[0] +27;
-        idx = FLAC_specialIndexOf(inbuf + 28, "ARTIST", s_flacSegmentTable[0]);
-        if(idx > 0){
-            aPos = inbuf + 28 + idx + 7;
-            aLen = *(inbuf + 28 +idx -4) -  7;
-        }
-        idx = FLAC_specialIndexOf(inbuf + 28, "TITLE", s_flacSegmentTable[0]);
-        if(idx > 0){
-            tPos = inbuf + 28 + idx + 6;
-            tLen = *(inbuf + 28 + idx -4) - 6;
-        }
-        int pos = 0;
-        if(aLen) {memcpy(m_streamTitle, aPos, aLen); m_streamTitle[aLen] = '\0'; pos = aLen;}
-        if(aLen && tLen) {strcat(m_streamTitle, " - "); pos += 3;}
-        if(tLen) {memcpy(m_streamTitle + pos, tPos, tLen); m_streamTitle[pos + tLen] = '\0';}
-        if(tLen || aLen) s_f_newSt = true;
-    }
-    else{
-        headerSize = pageSegments + 27;
-    }
-    *bytesLeft -= headerSize;
-    return ERR_FLAC_NONE; // no error
+    const uint8_t *aPos = NULL, *tPos = NULL;
+    for(uint32_t i = 0; i < nrOfComments && pos + 4 <= len; i++){
+        uint32_t l = buf[pos] + (buf[pos + 1] << 8) + (buf[pos + 2] << 16) + ((uint32_t)buf[pos + 3] << 24);
+        pos += 4;
+        if(l > len - pos) break; // truncated
+        if(!aPos && l > 7 && !strncasecmp((const char*)buf + pos, "ARTIST=", 7)) {aPos = buf + pos + 7; aLen = min(l - 7, (uint32_t)120);}
+        if(!tPos && l > 6 && !strncasecmp((const char*)buf + pos, "TITLE=", 6))  {tPos = buf + pos + 6; tLen = min(l - 6, (uint32_t)120);}
+        pos += l;
+    }
+    int p = 0;
+    if(aLen) {memcpy(m_streamTitle, aPos, aLen); m_streamTitle[aLen] = '\0'; p = aLen;}
+    if(aLen && tLen) {strcat(m_streamTitle, " - "); p += 3;}
+    if(tLen) {memcpy(m_streamTitle + p, tPos, tLen); m_streamTitle[p + tLen] = '\0';}
+    if(tLen || aLen) s_f_newSt = true;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t FLACDecode(uint8_t *inbuf, int *bytesLeft, short *outbuf){ //  MAIN LOOP
-
-    if(s_f_flacParseOgg == true){
-        int ret = FLACparseOGG(inbuf, bytesLeft);
-        if(ret == ERR_FLAC_NONE) return FLAC_PARSE_OGG_DONE; // ok
-        else return ret;  // error
-    }
-
-    if ((inbuf[0] == 'O') && (inbuf[1] == 'g') && (inbuf[2] == 'g') && (inbuf[3] == 'S')){
-        s_f_flacParseOgg = true;
+int8_t FLACDecodeOggPacket(uint8_t *packet, int *bytesLeft, short *outbuf){
+    // packet is one Ogg packet (see ogg_demuxer): the mapping header, a metadata block or exactly one frame
+    // reference https://xiph.org/flac/ogg_mapping.html
+    int len = *bytesLeft;
+    *bytesLeft = 0; // the packet is used up in any case
+
+    if(len >= 51 && packet[0] == 0x7F && !memcmp(packet + 1, "FLAC", 4)){ // mapping header, 'fLaC', STREAMINFO
+        const uint8_t *si = packet + 17;
+        FLACMetadataBlock->minblocksize  = (si[0] << 8) + si[1];
+        FLACMetadataBlock->maxblocksize  = (si[2] << 8) + si[3];
+        FLACMetadataBlock->minframesize  = (si[4] << 16) + (si[5] << 8) + si[6];
+        FLACMetadataBlock->maxframesize  = (si[7] << 16) + (si[8] << 8) + si[9];
+        FLACMetadataBlock->sampleRate    = (si[10] << 12) + (si[11] << 4) + (si[12] >> 4);
+        FLACMetadataBlock->numChannels   = ((si[12] >> 1) & 0x07) + 1;
+        FLACMetadataBlock->bitsPerSample = (((si[12] & 0x01) << 4) | (si[13] >> 4)) + 1;
+        FLACMetadataBlock->totalSamples  = ((uint64_t)(si[13] & 0x0F) << 32) + ((uint32_t)si[14] << 24) + (si[15] << 16) + (si[16] << 8) + si[17];
+        if(FLACMetadataBlock->bitsPerSample > 16) return ERR_FLAC_BITS_PER_SAMPLE_TOO_BIG;
+        return FLAC_PARSE_OGG_STREAMINFO; // the caller sizes the decoder and its output buffer
+    }
+    if(len < 2) return FLAC_PARSE_OGG_DONE;
+    if(packet[0] != 0xFF){ // metadata block, the frames begin with the sync code
+        if((packet[0] & 0x7F) == 4 && len >= 4) flacParseVorbisComment(packet + 4, len - 4);
         return FLAC_PARSE_OGG_DONE;
     }
-    int ret = FLACDecodeNative(inbuf, bytesLeft, outbuf);
-    return ret;
+    m_status = DECODE_FRAME; // one packet, one frame
+    return FLACDecodeNative(packet, &len, outbuf, true);
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t FLACDecodeNative(uint8_t *inbuf, int *bytesLeft, short *outbuf){
+int8_t FLACDecodeNative(uint8_t *inbuf, int *bytesLeft, short *outbuf, bool wholeFrame){
+    // outbuf must take a whole block: blocksize * numChannels samples
+    // wholeFrame: inbuf holds exactly one frame (Ogg packet), don't wait for m_maxFrameSize bytes
 
-    int bl = *bytesLeft;
-    static int sbl = 0;
-
-    if(m_status != OUT_SAMPLES){
-        m_rIndex = 0;
-        m_inptr = inbuf;
-    }
+    m_rIndex = 0; // the bitbuffer is empty between the calls
+    m_inptr = inbuf;
 
     while(m_status == DECODE_FRAME){// Read a ton of header fields, and ignore most of them
         int ret = flacDecodeFrame (inbuf, bytesLeft);
         if(ret != 0) return ret;
-        if(*bytesLeft < MAX_BLOCKSIZE) return FLAC_DECODE_FRAMES_LOOP; // need more data
+        if(!wholeFrame && (uint32_t)*bytesLeft + m_rIndex < m_maxFrameSize) return FLAC_DECODE_FRAMES_LOOP; // need a whole frame
     }
 
-    if(m_status == DECODE_SUBFRAMES){
-
-        // Decode each channel's subframe, then skip footer
-        int ret = decodeSubframes(bytesLeft);
-        sbl = bl - *bytesLeft;
-        if(ret != 0) return ret;
-        m_status = OUT_SAMPLES;
-    }
-
-    if(m_status == OUT_SAMPLES){  // Write the decoded samples
-        // blocksize can be much greater than outbuff, so we can't stuff all in once
-        // therefore we need often more than one loop (split outputblock into pieces)
-        uint16_t blockSize;
-        static uint16_t offset = 0;
-        if(m_blockSize < outBuffSize + offset) blockSize = m_blockSize - offset;
-        else blockSize = outBuffSize;
-
-        for (int i = 0; i < blockSize; i++) {
-            for (int j = 0; j < FLACMetadataBlock->numChannels; j++) {
-                int val = FLACsubFramesBuff->samplesBuffer[j][i + offset];
-                if (FLACMetadataBlock->bitsPerSample == 8) val += 128;
-                outbuf[2*i+j] = val;
-            }
-        }
-
-        m_validSamples = blockSize * FLACMetadataBlock->numChannels;
-        offset += blockSize;
-        m_compressionRatio = (float)sbl / (m_validSamples * FLACMetadataBlock->numChannels);
-        m_bitrate = FLACMetadataBlock->sampleRate * FLACMetadataBlock->bitsPerSample * FLACMetadataBlock->numChannels;
-        m_bitrate /= m_compressionRatio;
-
-        if(offset != m_blockSize) return GIVE_NEXT_LOOP;
-        offset = 0;
-        if(offset > m_blockSize) { log_e("offset has a wrong value"); }
+    // Decode each channel's subframe, then the footer
+    int      bl = *bytesLeft;
+    uint32_t start = m_rIndex; // behind the frame header if it was read in this call
+    int ret = decodeSubframes(bytesLeft);
+    if(ret != 0) return ret;
+    alignToByte();
+    readUint(16, bytesLeft); // frame footer, CRC-16
+    syncBytesLeft(bytesLeft);
+    if(*bytesLeft < 0) {*bytesLeft = 0; return ERR_FLAC_DECODER_ASYNC;} // truncated frame, zero padding was read
+    if(s_f_flacCrcCheck && FLACcrc16(m_crc16, m_inptr + start, m_rIndex - start) != 0){ // CRC over the frame is 0
+        m_crcErrors++;
+        return ERR_FLAC_CRC_MISMATCH; // don't output the frame, resync
     }
 
-    alignToByte();
-    readUint(16, bytesLeft);
+    outputSamples(outbuf); // Write the decoded samples
+    m_bitrate = (uint64_t)(bl - *bytesLeft) * 8 * FLACMetadataBlock->sampleRate / m_blockSize;
 
-//    m_compressionRatio = (float)m_bytesDecoded / (float)m_blockSize * FLACMetadataBlock->numChannels * (16/8);
-//    log_i("m_compressionRatio % f", m_compressionRatio);
     m_status = DECODE_FRAME;
     return ERR_FLAC_NONE;
 }
@@ -391,32 +596,40 @@ int8_t flacDecodeFrame(uint8_t *inbuf, int *bytesLeft){
     }
     count--;
     for (int i = 0; i < count; i++) readUint(8, bytesLeft);
-    m_blockSize = 0;
+    uint32_t blockSize = 0; // up to 65536, doesn't fit in m_blockSize before the check
     if (FLACFrameHeader->blockSizeCode == 1)
-        m_blockSize = 192;
+        blockSize = 192;
     else if (2 <= FLACFrameHeader->blockSizeCode && FLACFrameHeader->blockSizeCode <= 5)
-        m_blockSize = 576 << (FLACFrameHeader->blockSizeCode - 2);
+        blockSize = 576 << (FLACFrameHeader->blockSizeCode - 2);
     else if (FLACFrameHeader->blockSizeCode == 6)
-        m_blockSize = readUint(8, bytesLeft) + 1;
+        blockSize = readUint(8, bytesLeft) + 1;
     else if (FLACFrameHeader->blockSizeCode == 7)
-        m_blockSize = readUint(16, bytesLeft) + 1;
+        blockSize = readUint(16, bytesLeft) + 1;
     else if (8 <= FLACFrameHeader->blockSizeCode && FLACFrameHeader->blockSizeCode <= 15)
-        m_blockSize = 256 << (FLACFrameHeader->blockSizeCode - 8);
+        blockSize = 256 << (FLACFrameHeader->blockSizeCode - 8);
     else{
         return ERR_FLAC_RESERVED_BLOCKSIZE_UNSUPPORTED;
     }
-    uint16_t maxBS = 8192;
-    if(psramFound()) maxBS = 8192 * 4;
-    if(m_blockSize > maxBS){
-        log_e("Error: blockSize too big ,%i bytes", m_blockSize);
+    if(blockSize > m_maxBlockSize){ // larger than STREAMINFO announced
+        log_e("Error: blockSize too big ,%lu samples", (unsigned long)blockSize);
         return ERR_FLAC_BLOCKSIZE_TOO_BIG;
     }
+    m_blockSize = blockSize;
     if(FLACFrameHeader->sampleRateCode == 12)
         readUint(8, bytesLeft);
     else if (FLACFrameHeader->sampleRateCode == 13 || FLACFrameHeader->sampleRateCode == 14){
         readUint(16, bytesLeft);
     }
-    readUint(8, bytesLeft);
+    readUint(8, bytesLeft); // CRC-8
+    syncBytesLeft(bytesLeft);
+    if(*bytesLeft < 0) {*bytesLeft = 0; return ERR_FLAC_DECODER_ASYNC;} // truncated header
+    if(s_f_flacCrcCheck){
+        if(FLACcrc8(inbuf, m_rIndex) != 0){ // the CRC over header + CRC-8 is 0
+            m_crcErrors++;
+            return ERR_FLAC_CRC_MISMATCH;
+        }
+        m_crc16 = FLACcrc16(0, inbuf, m_rIndex); // the CRC-16 of the frame includes the header
+    }
     m_status = DECODE_SUBFRAMES;
     m_blockSizeLeft = m_blockSize;
     return ERR_FLAC_NONE;
@@ -432,6 +645,14 @@ uint64_t FLACGetTotoalSamplesInStream(){
     return FLACMetadataBlock->totalSamples;
 }
 //----------------------------------------------------------------------------------------------------------------------
+uint16_t FLACGetMaxBlockSize(){
+    return FLACMetadataBlock->maxblocksize;
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t FLACGetMaxFrameSize(){
+    return FLACMetadataBlock->maxframesize;
+}
+//----------------------------------------------------------------------------------------------------------------------
 uint8_t FLACGetBitsPerSample(){
     return FLACMetadataBlock->bitsPerSample;
 }
@@ -448,6 +669,14 @@ uint32_t FLACGetBitRate(){
     return m_bitrate;
 }
 //----------------------------------------------------------------------------------------------------------------------
+void FLACDecoder_SetCRCCheck(bool check){ // verify CRC-8 and CRC-16 of every frame
+    s_f_flacCrcCheck = check;
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t FLACGetCRCErrors(){ // frames dropped because of a CRC mismatch since the decoder was set up
+    return m_crcErrors;
+}
+//----------------------------------------------------------------------------------------------------------------------
 uint32_t FLACGetAudioFileDuration() {
     if(FLACGetSampRate()){
         uint32_t afd = FLACGetTotoalSamplesInStream()/ FLACGetSampRate(); // AudioFileDuration
@@ -464,28 +693,6 @@ int8_t decodeSubframes(int* bytesLeft){
     else if (8 <= FLACFrameHeader->chanAsgn && FLACFrameHeader->chanAsgn <= 10) {
         decodeSubframe(FLACMetadataBlock->bitsPerSample + (FLACFrameHeader->chanAsgn == 9 ? 1 : 0), 0, bytesLeft);
         decodeSubframe(FLACMetadataBlock->bitsPerSample + (FLACFrameHeader->chanAsgn == 9 ? 0 : 1), 1, bytesLeft);
-        if(FLACFrameHeader->chanAsgn == 8) {
-            for (int i = 0; i < m_blockSize; i++)
-                FLACsubFramesBuff->samplesBuffer[1][i] = (
-                        FLACsubFramesBuff->samplesBuffer[0][i] -
-                        FLACsubFramesBuff->samplesBuffer[1][i]);
-        }
-        else if (FLACFrameHeader->chanAsgn == 9) {
-            for (int i = 0; i < m_blockSize; i++)
-                FLACsubFramesBuff->samplesBuffer[0][i] += FLACsubFramesBuff->samplesBuffer[1][i];
-        }
-        else if (FLACFrameHeader->chanAsgn == 10) {
-            for (int i = 0; i < m_blockSize; i++) {
-                long side =  FLACsubFramesBuff->samplesBuffer[1][i];
-                long right = FLACsubFramesBuff->samplesBuffer[0][i] - (side >> 1);
-                FLACsubFramesBuff->samplesBuffer[1][i] = right;
-                FLACsubFramesBuff->samplesBuffer[0][i] = right + side;
-            }
-        }
-        else {
-            log_e("unknown channel assignment, %i", FLACFrameHeader->chanAsgn);
-            return ERR_FLAC_UNKNOWN_CHANNEL_ASSIGNMENT;
-        }
     }
     else{
         log_e("Reserved channel assignment, %i", FLACFrameHeader->chanAsgn);
@@ -494,13 +701,55 @@ int8_t decodeSubframes(int* bytesLeft){
     return ERR_FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
+void outputSamples(short *outbuf){
+    // stereo decorrelation and interleaving in one pass
+    const int32_t* s0 = FLACsubFramesBuff->samplesBuffer[0];
+    const int32_t* s1 = FLACsubFramesBuff->samplesBuffer[1];
+    int16_t offset = (FLACMetadataBlock->bitsPerSample == 8) ? 128 : 0;
+    int     n = m_blockSize; // local, a store to outbuf could alias the uint16_t global
+
+    if(FLACMetadataBlock->numChannels == 1){
+        for(int i = 0; i < n; i++) outbuf[i] = s0[i] + offset;
+        m_validSamples = n;
+        return;
+    }
+    switch(FLACFrameHeader->chanAsgn){
+        case 8: // left/side
+            for(int i = 0; i < n; i++){
+                outbuf[2 * i]     = s0[i] + offset;
+                outbuf[2 * i + 1] = s0[i] - s1[i] + offset;
+            }
+            break;
+        case 9: // side/right
+            for(int i = 0; i < n; i++){
+                outbuf[2 * i]     = s0[i] + s1[i] + offset;
+                outbuf[2 * i + 1] = s1[i] + offset;
+            }
+            break;
+        case 10: // mid/side
+            for(int i = 0; i < n; i++){
+                int32_t side  = s1[i];
+                int32_t right = s0[i] - (side >> 1);
+                outbuf[2 * i]     = right + side + offset;
+                outbuf[2 * i + 1] = right + offset;
+            }
+            break;
+        default: // left, right
+            for(int i = 0; i < n; i++){
+                outbuf[2 * i]     = s0[i] + offset;
+                outbuf[2 * i + 1] = s1[i] + offset;
+            }
+    }
+    m_validSamples = n * 2;
+}
+//----------------------------------------------------------------------------------------------------------------------
 int8_t decodeSubframe(uint8_t sampleDepth, uint8_t ch, int* bytesLeft) {
     int8_t ret = 0;
     readUint(1, bytesLeft);
     uint8_t type = readUint(6, bytesLeft);
     int shift = readUint(1, bytesLeft);
     if (shift == 1) {
-        while (readUint(1, bytesLeft) == 0)
+        while (readUint(1, bytesLeft) == 0 && *bytesLeft >= 0)
             shift++;
     }
     sampleDepth -= shift;
@@ -534,20 +783,17 @@ int8_t decodeSubframe(uint8_t sampleDepth, uint8_t ch, int* bytesLeft) {
     return ERR_FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
+const int32_t fixedCoefs[5][4] = {{0, 0, 0, 0}, {1, 0, 0, 0}, {2, -1, 0, 0}, {3, -3, 1, 0}, {4, -6, 4, -1}};
+
 int8_t decodeFixedPredictionSubframe(uint8_t predOrder, uint8_t sampleDepth, uint8_t ch, int* bytesLeft) {
     uint8_t ret = 0;
     for(uint8_t i = 0; i < predOrder; i++)
         FLACsubFramesBuff->samplesBuffer[ch][i] = readSignedInt(sampleDepth, bytesLeft);
     ret = decodeResiduals(predOrder, ch, bytesLeft);
     if(ret) return ret;
-    coefs.clear();
-    if(predOrder == 0) coefs.resize(0);
-    if(predOrder == 1) coefs.push_back(1);  // FIXED_PREDICTION_COEFFICIENTS
-    if(predOrder == 2){coefs.push_back(2); coefs.push_back(-1);}
-    if(predOrder == 3){coefs.push_back(3); coefs.push_back(-3); coefs.push_back(1);}
-    if(predOrder == 4){coefs.push_back(4); coefs.push_back(-6); coefs.push_back(4); coefs.push_back(-1);}
     if(predOrder > 4) return ERR_FLAC_PREORDER_TOO_BIG; // Error: preorder > 4"
-    restoreLinearPrediction(ch, 0);
+    memcpy(FLACsubFramesBuff->lpcCoefs, fixedCoefs[predOrder], sizeof(fixedCoefs[0]));
+    restoreLinearPrediction(ch, predOrder, 0, false);
     return ERR_FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
@@ -557,12 +803,13 @@ int8_t decodeLinearPredictiveCodingSubframe(int lpcOrder, int sampleDepth, uint8
         FLACsubFramesBuff->samplesBuffer[ch][i] = readSignedInt(sampleDepth, bytesLeft);
     int precision = readUint(4, bytesLeft) + 1;
     int shift = readSignedInt(5, bytesLeft);
-    coefs.resize(0);
     for (uint8_t i = 0; i < lpcOrder; i++)
-        coefs.push_back(readSignedInt(precision, bytesLeft));
+        FLACsubFramesBuff->lpcCoefs[i] = readSignedInt(precision, bytesLeft);
     ret = decodeResiduals(lpcOrder, ch, bytesLeft);
     if(ret) return ret;
-    restoreLinearPrediction(ch, shift);
+    // |sum| < 2^(sampleDepth - 1) * 2^(precision - 1) * lpcOrder, a 32 bit accumulator is only sufficient if that fits
+    bool wide = sampleDepth + precision + (31 - __builtin_clz(lpcOrder)) > 32;
+    restoreLinearPrediction(ch, lpcOrder, shift, wide);
     return ERR_FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
@@ -586,9 +833,7 @@ int8_t decodeResiduals(uint8_t warmup, uint8_t ch, int* bytesLeft) {
 
         int param = readUint(paramBits, bytesLeft);
         if (param < escapeParam) {
-            for (int j = start; j < end; j++){
-                FLACsubFramesBuff->samplesBuffer[ch][j] = readRiceSignedInt(param, bytesLeft);
-            }
+            decodeRicePartition(param, FLACsubFramesBuff->samplesBuffer[ch] + start, end - start, bytesLeft);
         } else {
             int numBits = readUint(5, bytesLeft);
             for (int j = start; j < end; j++){
@@ -599,14 +844,112 @@ int8_t decodeResiduals(uint8_t warmup, uint8_t ch, int* bytesLeft) {
     return ERR_FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-void restoreLinearPrediction(uint8_t ch, uint8_t shift) {
+void restoreLinearPrediction(uint8_t ch, uint8_t order, uint8_t shift, bool wide) {
 
-    for (int i = coefs.size(); i < m_blockSize; i++) {
-        int32_t sum = 0;
-        for (int j = 0; j < coefs.size(); j++){
-            sum += FLACsubFramesBuff->samplesBuffer[ch][i - 1 - j] * coefs[j];
+    int32_t*       s = FLACsubFramesBuff->samplesBuffer[ch];
+    const int32_t* coefs = FLACsubFramesBuff->lpcCoefs;
+
+    if(wide){ // 64 bit accumulator
+        for(int i = order; i < m_blockSize; i++){
+            int64_t sum = 0;
+            for(int j = 0; j < order; j++) sum += (int64_t)coefs[j] * s[i - 1 - j];
+            s[i] += sum >> shift;
+        }
+        return;
+    }
+    if(order > 12){
+        for(int i = order; i < m_blockSize; i++){
+            int32_t sum = 0;
+            for(int j = 0; j < order; j++) sum += coefs[j] * s[i - 1 - j];
+            s[i] += sum >> shift;
         }
-        FLACsubFramesBuff->samplesBuffer[ch][i] += (sum >> shift);
+        return;
+    }
+    int32_t c[12]; // local copy, can be held in registers
+    for(int j = 0; j < order; j++) c[j] = coefs[j];
+
+    switch(order){ // unrolled for the common orders
+        case 12:
+            for(int i = 12; i < m_blockSize; i++){
+                int32_t sum = c[11] * s[i - 12] + c[10] * s[i - 11] + c[9] * s[i - 10] + c[8] * s[i - 9]
+                            + c[7] * s[i - 8] + c[6] * s[i - 7] + c[5] * s[i - 6] + c[4] * s[i - 5] + c[3] * s[i - 4]
+                            + c[2] * s[i - 3] + c[1] * s[i - 2] + c[0] * s[i - 1];
+                s[i] += sum >> shift;
+            }
+            break;
+        case 11:
+            for(int i = 11; i < m_blockSize; i++){
+                int32_t sum = c[10] * s[i - 11] + c[9] * s[i - 10] + c[8] * s[i - 9] + c[7] * s[i - 8]
+                            + c[6] * s[i - 7] + c[5] * s[i - 6] + c[4] * s[i - 5] + c[3] * s[i - 4] + c[2] * s[i - 3]
+                            + c[1] * s[i - 2] + c[0] * s[i - 1];
+                s[i] += sum >> shift;
+            }
+            break;
+        case 10:
+            for(int i = 10; i < m_blockSize; i++){
+                int32_t sum = c[9] * s[i - 10] + c[8] * s[i - 9] + c[7] * s[i - 8] + c[6] * s[i - 7] + c[5] * s[i - 6]
+                            + c[4] * s[i - 5] + c[3] * s[i - 4] + c[2] * s[i - 3] + c[1] * s[i - 2] + c[0] * s[i - 1];
+                s[i] += sum >> shift;
+            }
+            break;
+        case 9:
+            for(int i = 9; i < m_blockSize; i++){
+                int32_t sum = c[8] * s[i - 9] + c[7] * s[i - 8] + c[6] * s[i - 7] + c[5] * s[i - 6] + c[4] * s[i - 5]
+                            + c[3] * s[i - 4] + c[2] * s[i - 3] + c[1] * s[i - 2] + c[0] * s[i - 1];
+                s[i] += sum >> shift;
+            }
+            break;
+        case 8:
+            for(int i = 8; i < m_blockSize; i++){
+                int32_t sum = c[7] * s[i - 8] + c[6] * s[i - 7] + c[5] * s[i - 6] + c[4] * s[i - 5] + c[3] * s[i - 4]
+                            + c[2] * s[i - 3] + c[1] * s[i - 2] + c[0] * s[i - 1];
+                s[i] += sum >> shift;
+            }
+            break;
+        case 7:
+            for(int i = 7; i < m_blockSize; i++){
+                int32_t sum = c[6] * s[i - 7] + c[5] * s[i - 6] + c[4] * s[i - 5] + c[3] * s[i - 4] + c[2] * s[i - 3]
+                            + c[1] * s[i - 2] + c[0] * s[i - 1];
+                s[i] += sum >> shift;
+            }
+            break;
+        case 6:
+            for(int i = 6; i < m_blockSize; i++){
+                int32_t sum = c[5] * s[i - 6] + c[4] * s[i - 5] + c[3] * s[i - 4] + c[2] * s[i - 3] + c[1] * s[i - 2]
+                            + c[0] * s[i - 1];
+                s[i] += sum >> shift;
+            }
+            break;
+        case 5:
+            for(int i = 5; i < m_blockSize; i++){
+                int32_t sum = c[4] * s[i - 5] + c[3] * s[i - 4] + c[2] * s[i - 3] + c[1] * s[i - 2] + c[0] * s[i - 1];
+                s[i] += sum >> shift;
+            }
+            break;
+        case 4:
+            for(int i = 4; i < m_blockSize; i++){
+                int32_t sum = c[3] * s[i - 4] + c[2] * s[i - 3] + c[1] * s[i - 2] + c[0] * s[i - 1];
+                s[i] += sum >> shift;
+            }
+            break;
+        case 3:
+            for(int i = 3; i < m_blockSize; i++){
+                int32_t sum = c[2] * s[i - 3] + c[1] * s[i - 2] + c[0] * s[i - 1];
+                s[i] += sum >> shift;
+            }
+            break;
+        case 2:
+            for(int i = 2; i < m_blockSize; i++){
+                int32_t sum = c[1] * s[i - 2] + c[0] * s[i - 1];
+                s[i] += sum >> shift;
+            }
+            break;
+        case 1:
+            for(int i = 1; i < m_blockSize; i++){
+                int32_t sum = c[0] * s[i - 1];
+                s[i] += sum >> shift;
+            }
+            break;
     }
 }
 //----------------------------------------------------------------------------------------------------------------------
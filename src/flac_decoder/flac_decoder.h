@@ -7,7 +7,7 @@
  *      Author: wolle
  *
  *  Restrictions:
- *  blocksize must not exceed 8192
+ *  blocksize must not exceed 16384, the sample buffers are sized from STREAMINFO
  *  bits per sample must be 8 or 16
  *  num Channels must be 1 or 2
  *
@@ -19,17 +19,21 @@
 #include "Arduino.h"
 
 #define MAX_CHANNELS 2
-#define MAX_BLOCKSIZE 8192
+#define MAX_BLOCKSIZE 16384        // FLAC subset limit for streams up to 48kHz is 4608
+#define DEFAULT_MAX_BLOCKSIZE 8192 // used until STREAMINFO tells otherwise
+#define DEFAULT_MAX_FRAMESIZE 16384
+#define MAX_LPC_ORDER 32
 
 typedef struct FLACsubFramesBuff_t{
-    int32_t samplesBuffer[MAX_CHANNELS][MAX_BLOCKSIZE];
+    int32_t* samplesBuffer[MAX_CHANNELS]; // MAX_CHANNELS * m_maxBlockSize, see FLACDecoder_SetMaxBlockSize
+    int32_t lpcCoefs[MAX_LPC_ORDER]; // predictor coefficients of the current subframe
 }FLACsubframesBuffer_t;
 
 enum : uint8_t {FLACDECODER_INIT, FLACDECODER_READ_IN, FLACDECODER_WRITE_OUT};
-enum : uint8_t {DECODE_FRAME, DECODE_SUBFRAMES, OUT_SAMPLES};
+enum : uint8_t {DECODE_FRAME, DECODE_SUBFRAMES};
 enum : int8_t  {FLAC_PARSE_OGG_DONE = 100,
+                FLAC_PARSE_OGG_STREAMINFO = 101,
                 FLAC_DECODE_FRAMES_LOOP = 100,
-                GIVE_NEXT_LOOP = +1,
                 ERR_FLAC_NONE = 0,
                 ERR_FLAC_BLOCKSIZE_TOO_BIG = -1,
                 ERR_FLAC_RESERVED_BLOCKSIZE_UNSUPPORTED = -2,
@@ -42,7 +46,8 @@ enum : int8_t  {FLAC_PARSE_OGG_DONE = 100,
                 ERR_FLAC_WRONG_RICE_PARTITION_NR = -9,
                 ERR_FLAC_BITS_PER_SAMPLE_TOO_BIG = -10,
                 ERR_FLAG_BITS_PER_SAMPLE_UNKNOWN = -11,
-                ERR_FLAC_DECODER_ASYNC = -12};
+                ERR_FLAC_DECODER_ASYNC = -12,
+                ERR_FLAC_CRC_MISMATCH = -13};
 
 typedef struct FLACMetadataBlock_t{
                               // METADATA_BLOCK_STREAMINFO
@@ -146,16 +151,20 @@ typedef struct FLACFrameHeader_t {
 }FLACFrameHeader_t;
 
 int      FLACFindSyncWord(unsigned char *buf, int nBytes);
+int      FLACCheckFrameHeader(uint8_t *buf, int nBytes);
+uint8_t  FLACcrc8(const uint8_t *buf, int len);
+uint16_t FLACcrc16(uint16_t crc, const uint8_t *buf, int len);
 boolean  FLACFindMagicWord(unsigned char* buf, int nBytes);
 char*    FLACgetStreamTitle();
-int      FLACparseOGG(uint8_t *inbuf, int *bytesLeft);
 bool     FLACDecoder_AllocateBuffers(void);
 void     FLACDecoder_ClearBuffer();
 void     FLACDecoder_FreeBuffers();
+bool     FLACDecoder_SetMaxBlockSize(uint32_t maxBlockSize, uint32_t maxFrameSize);
 void     FLACSetRawBlockParams(uint8_t Chans, uint32_t SampRate, uint8_t BPS, uint32_t tsis, uint32_t AuDaLength);
 void     FLACDecoderReset();
 int8_t   FLACDecode(uint8_t *inbuf, int *bytesLeft, short *outbuf);
-int8_t   FLACDecodeNative(uint8_t *inbuf, int *bytesLeft, short *outbuf);
+int8_t   FLACDecodeNative(uint8_t *inbuf, int *bytesLeft, short *outbuf, bool wholeFrame = false);
+int8_t   FLACDecodeOggPacket(uint8_t *packet, int *bytesLeft, short *outbuf);
 int8_t   flacDecodeFrame(uint8_t *inbuf, int *bytesLeft);
 uint16_t FLACGetOutputSamps();
 uint64_t FLACGetTotoalSamplesInStream();
@@ -163,16 +172,23 @@ uint8_t  FLACGetBitsPerSample();
 uint8_t  FLACGetChannels();
 uint32_t FLACGetSampRate();
 uint32_t FLACGetBitRate();
+uint16_t FLACGetMaxBlockSize();
+uint32_t FLACGetMaxFrameSize();
+void     FLACDecoder_SetCRCCheck(bool check);
+uint32_t FLACGetCRCErrors();
 uint32_t FLACGetAudioFileDuration();
 uint32_t readUint(uint8_t nBits, int *bytesLeft);
 int32_t  readSignedInt(int nBits, int* bytesLeft);
 int64_t  readRiceSignedInt(uint8_t param, int* bytesLeft);
+void     decodeRicePartition(uint8_t param, int32_t* out, int count, int* bytesLeft);
 void     alignToByte();
+void     syncBytesLeft(int *bytesLeft);
 int8_t   decodeSubframes(int* bytesLeft);
+void     outputSamples(short *outbuf);
 int8_t   decodeSubframe(uint8_t sampleDepth, uint8_t ch, int* bytesLeft);
 int8_t   decodeFixedPredictionSubframe(uint8_t predOrder, uint8_t sampleDepth, uint8_t ch, int* bytesLeft);
 int8_t   decodeLinearPredictiveCodingSubframe(int lpcOrder, int sampleDepth, uint8_t ch, int* bytesLeft);
 int8_t   decodeResiduals(uint8_t warmup, uint8_t ch, int* bytesLeft);
-void     restoreLinearPrediction(uint8_t ch, uint8_t shift);
+void     restoreLinearPrediction(uint8_t ch, uint8_t order, uint8_t shift, bool wide);
 int      FLAC_specialIndexOf(uint8_t* base, const char* str, int baselen, bool exact = false);
 
@@ -35,6 +35,8 @@ const uint8_t  m_IMDCT_SCALE            =2;   // additional scaling (by sqrt(2))
 const uint8_t  m_NGRANS_MPEG1           =2;
 const uint8_t  m_NGRANS_MPEG2           =1;
 const uint32_t m_SQRTHALF               =0x5a82799a;  // sqrt(0.5) in Q31 format
+const uint16_t m_CONCEAL_RAMP           =256; // samples per channel of the muting and fade-in ramps around a lost frame
+const uint8_t  m_SYNC_FRAMES            =3;   // frame headers behind a sync word that must agree before MP3FindSyncWord() locks
 
 
 MP3FrameInfo_t *m_MP3FrameInfo;
@@ -52,6 +54,21 @@ ScaleFactorInfoSub_t m_ScaleFactorInfoSub[m_MAX_NGRAN][m_MAX_NCHAN];
 ScaleFactorJS_t *m_ScaleFactorJS;
 SubbandInfo_t *m_SubbandInfo;
 MP3DecInfo_t *m_MP3DecInfo;
+bool m_downmix = false;  /* stereo frames are mixed to mono before the synthesis, see MP3Decoder_SetDownmix() */
+int  m_rateShift = 0;    /* 0: full output rate, 1: half rate (lower 16 subbands), 2: quarter rate (lower 8 subbands) */
+short m_mp3ConcealLast[m_MAX_NCHAN]; /* last pcm sample of each channel, start of the muting ramp, see MP3ConcealFrame() */
+int  m_mp3ConcealFrames = 0;      /* frames concealed since the last good frame, the next good frame is faded in */
+#ifdef MP3_HUFFMAN_LUT
+uint16_t *m_huffLUT = NULL;                    /* first level lookup tables for the loop tables, see MP3Decoder_BuildHuffmanLUT() */
+uint16_t m_huffLUTOffset[m_HUFF_PAIRTABS];
+/* number of bits of the first level lookup table for each pair table, 0: no lookup table (noBits, oneShot, invalid)
+ * the Helix loop tables need up to 3 lookups per codeword, with 8...10 bits about 97% of the codewords are decoded with
+ * a single lookup (weighted by probability), tables 16...23 and 24...31 share the same codes
+ */
+const uint8_t huffLUTBits[m_HUFF_PAIRTABS] PROGMEM = {
+     0,  0,  0,  0,  0,  0,  0,  8,  8,  8,  9,  9,  8, 10,  0, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10};
+#endif
 
 const unsigned short huffTable[4242] PROGMEM = {
     /* huffTable01[9] */
@@ -1166,6 +1183,94 @@ int UnpackScaleFactors( unsigned char *buf, int *bitOffset, int bitsAvail, int g
  * M P 3 D E C
  **********************************************************************************************************************/
 
+/***********************************************************************************************************************
+ * Function:    MP3ScanSyncWord
+ *
+ * Description: locate the next byte-aligned 11-bit sync pattern, no further checks
+ *
+ * Inputs:      buffer to search for sync word
+ *              max number of bytes to search in buffer
+ *
+ * Outputs:     none
+ *
+ * Return:      offset to first sync pattern (bytes from start of buf)
+ *              -1 if not found after searching nBytes
+ *
+ * Notes:       one aligned 32-bit load per 4 bytes, words without a 0xff byte are skipped:
+ *                x = ~word has a zero byte where word has 0xff, (x - 0x01010101) & ~x & 0x80808080 is
+ *                non-zero only then
+ **********************************************************************************************************************/
+int MP3ScanSyncWord(unsigned char *buf, int nBytes) {
+    int i, j;
+    uint32_t x;
+
+    /* byte by byte up to a word boundary */
+    for (i = 0; i < nBytes - 1 && ((uintptr_t)(buf + i) & 0x03); i++) {
+        if (buf[i] == m_SYNCWORDH && (buf[i + 1] & m_SYNCWORDL) == m_SYNCWORDL)
+            return i;
+    }
+    /* a word at a time, buf[i + 4] is the second sync byte for a 0xff in the last byte of the word */
+    for (; i + 4 < nBytes; i += 4) {
+        memcpy(&x, buf + i, 4); // the compiler emits a plain aligned load, no strict aliasing violation
+        x = ~x;
+        if (((x - 0x01010101) & ~x & 0x80808080) == 0)
+            continue;
+        for (j = i; j < i + 4; j++) {
+            if (buf[j] == m_SYNCWORDH && (buf[j + 1] & m_SYNCWORDL) == m_SYNCWORDL)
+                return j;
+        }
+    }
+    for (; i < nBytes - 1; i++) {
+        if (buf[i] == m_SYNCWORDH && (buf[i + 1] & m_SYNCWORDL) == m_SYNCWORDL)
+            return i;
+    }
+
+    return -1;
+}
+/***********************************************************************************************************************
+ * Function:    MP3CheckSyncFrames
+ *
+ * Description: check a sync word candidate, the header must be valid and the following m_SYNC_FRAMES headers
+ *                must agree on version, layer, sample rate and mono/stereo
+ *
+ * Inputs:      pointer to the candidate frame header
+ *              number of valid bytes in buf
+ *
+ * Outputs:     none
+ *
+ * Return:      1 if the candidate starts a frame, 0 if not
+ *
+ * Notes:       headers behind the end of buf can't be checked, the candidate is accepted on the ones in front
+ *              free format (bitrate index 0) has no frame length to follow, the next header with the same
+ *                version, layer, bitrate index and sample rate is searched for instead (MP3FindFreeSync())
+ **********************************************************************************************************************/
+int MP3CheckSyncFrames(unsigned char *buf, int nBytes) {
+    int n, layer, frameBytes;
+
+    if (nBytes < 4)
+        return 0;
+    layer = 4 - ((buf[1] >> 1) & 0x03);
+    if (((buf[1] >> 3) & 0x03) == 1 || layer < 2 || layer > 3 || ((buf[2] >> 4) & 0x0f) == 15
+            || ((buf[2] >> 2) & 0x03) == 3 || (buf[3] & 0x03) == 2)
+        return 0;
+    if (((buf[2] >> 4) & 0x0f) == 0) {
+        /* free format: a matching header must follow within the largest frame (640 kbit/s at 32 kHz: 2880 bytes) */
+        return (MP3FindFreeSync(buf + 4, buf, (nBytes - 4 < 2881 ? nBytes - 4 : 2881)) >= 0);
+    }
+
+    for (n = 0; n < m_SYNC_FRAMES; n++) {
+        frameBytes = MP3GetFrameBytes(buf);
+        if (frameBytes + 4 > nBytes)
+            break;
+        frameBytes = MP3ResyncNextFrame(buf, nBytes);
+        if (frameBytes < 0)
+            return 0;
+        buf += frameBytes;
+        nBytes -= frameBytes;
+    }
+
+    return 1;
+}
 /***********************************************************************************************************************
  * Function:    MP3FindSyncWord
  *
@@ -1178,14 +1283,19 @@ int UnpackScaleFactors( unsigned char *buf, int *bitOffset, int bitsAvail, int g
  *
  * Return:      offset to first sync word (bytes from start of buf)
  *              -1 if sync not found after searching nBytes
+ *
+ * Notes:       a sync pattern is only accepted if the frame headers behind it agree (see MP3CheckSyncFrames()),
+ *                so a 0xFFF in an ID3 picture or other garbage doesn't lock the decoder
  **********************************************************************************************************************/
 int MP3FindSyncWord(unsigned char *buf, int nBytes) {
-    int i;
+    int i, offset;
 
-    /* find byte-aligned syncword - need 12 (MPEG 1,2) or 11 (MPEG 2.5) matching bits */
     for (i = 0; i < nBytes - 1; i++) {
-        if ((buf[i + 0] & m_SYNCWORDH) == m_SYNCWORDH
-                && (buf[i + 1] & m_SYNCWORDL) == m_SYNCWORDL)
+        offset = MP3ScanSyncWord(buf + i, nBytes - i);
+        if (offset < 0)
+            return -1;
+        i += offset;
+        if (MP3CheckSyncFrames(buf + i, nBytes - i))
             return i;
     }
 
@@ -1220,12 +1330,12 @@ int MP3FindFreeSync(unsigned char *buf, unsigned char firstFH[4], int nBytes){
     unsigned char *bufPtr = buf;
 
     /* loop until we either:
-     *  - run out of nBytes (FindMP3SyncWord() returns -1)
+     *  - run out of nBytes (MP3ScanSyncWord() returns -1)
      *  - find the next valid frame header (sync word, version, layer, CRC flag, bitrate, and sample rate
      *      in next header must match current header)
      */
     while (1) {
-        offset = MP3FindSyncWord(bufPtr, nBytes);
+        offset = MP3ScanSyncWord(bufPtr, nBytes);
         bufPtr += offset;
         if (offset < 0) {
             return -1;
@@ -1243,6 +1353,68 @@ int MP3FindFreeSync(unsigned char *buf, unsigned char firstFH[4], int nBytes){
 
     return -1;
 }
+/***********************************************************************************************************************
+ * Function:    MP3GetFrameBytes
+ *
+ * Description: frame length from a layer II or III frame header, without touching the decoder state
+ *
+ * Inputs:      pointer to a 4-byte frame header
+ *
+ * Outputs:     none
+ *
+ * Return:      total frame length in bytes, including header and pad byte
+ *              -1 if the header is invalid, layer I or free format (length unknown)
+ **********************************************************************************************************************/
+int MP3GetFrameBytes(unsigned char *buf) {
+    int verIdx, ver, layer, brIdx, srIdx, pad;
+
+    if ((buf[0] & m_SYNCWORDH) != m_SYNCWORDH || (buf[1] & m_SYNCWORDL) != m_SYNCWORDL)
+        return -1;
+    verIdx = (buf[1] >> 3) & 0x03;
+    ver = (verIdx == 0 ? MPEG25 : ((verIdx & 0x01) ? MPEG1 : MPEG2));
+    layer = 4 - ((buf[1] >> 1) & 0x03);
+    brIdx = (buf[2] >> 4) & 0x0f;
+    srIdx = (buf[2] >> 2) & 0x03;
+    pad = (buf[2] >> 1) & 0x01;
+    if (verIdx == 1 || srIdx == 3 || brIdx == 0 || brIdx == 15 || layer < 2 || layer > 3)
+        return -1;
+
+    if (layer == 3)
+        return (int) slotTab[ver][srIdx][brIdx] + pad;
+    /* layer II: 1152 samples per frame in all versions */
+    return 144 * ((int) bitrateTab[ver][1][brIdx] * 1000) / samplerateTab[ver][srIdx] + pad;
+}
+/***********************************************************************************************************************
+ * Function:    MP3ResyncNextFrame
+ *
+ * Description: check that the next frame header lies exactly one frame length behind the current one
+ *
+ * Inputs:      pointer to the frame header of the current (possibly damaged) frame
+ *              number of valid bytes in buf
+ *
+ * Outputs:     none
+ *
+ * Return:      length of the current frame in bytes, the next frame starts there
+ *              -1 if the frame length is unknown or the next header does not follow
+ *
+ * Notes:       the next header must agree on version, layer, CRC flag, sample rate and mono/stereo,
+ *                bitrate and padding may change (VBR)
+ *              used to step over a frame that failed to decode without a byte-wise search
+ **********************************************************************************************************************/
+int MP3ResyncNextFrame(unsigned char *buf, int nBytes) {
+    int frameBytes;
+    unsigned char *next;
+
+    frameBytes = MP3GetFrameBytes(buf);
+    if (frameBytes < 4 || frameBytes + 4 > nBytes)
+        return -1;
+    next = buf + frameBytes;
+    if (MP3GetFrameBytes(next) < 0 || next[1] != buf[1] || (next[2] & 0x0c) != (buf[2] & 0x0c)
+            || ((next[3] & 0xc0) == 0xc0) != ((buf[3] & 0xc0) == 0xc0))
+        return -1;
+
+    return frameBytes;
+}
 /***********************************************************************************************************************
  * Function:    MP3GetLastFrameInfo
  *
@@ -1258,7 +1430,7 @@ int MP3FindFreeSync(unsigned char *buf, unsigned char firstFH[4], int nBytes){
  * Notes:       call this right after calling MP3Decode
  **********************************************************************************************************************/
 void MP3GetLastFrameInfo() {
-    if (m_MP3DecInfo->layer != 3){
+    if (m_MP3DecInfo->layer != 2 && m_MP3DecInfo->layer != 3){
         m_MP3FrameInfo->bitrate=0;
         m_MP3FrameInfo->nChans=0;
         m_MP3FrameInfo->samprate=0;
@@ -1268,12 +1440,13 @@ void MP3GetLastFrameInfo() {
         m_MP3FrameInfo->version=0;
     }
     else{
+        int nChansOut = (m_downmix ? 1 : m_MP3DecInfo->nChans);
         m_MP3FrameInfo->bitrate=m_MP3DecInfo->bitrate;
-        m_MP3FrameInfo->nChans=m_MP3DecInfo->nChans;
-        m_MP3FrameInfo->samprate=m_MP3DecInfo->samprate;
+        m_MP3FrameInfo->nChans=nChansOut;
+        m_MP3FrameInfo->samprate=m_MP3DecInfo->samprate >> m_rateShift;
         m_MP3FrameInfo->bitsPerSample=16;
-        m_MP3FrameInfo->outputSamps=m_MP3DecInfo->nChans
-                * (int) samplesPerFrameTab[m_MPEGVersion][m_MP3DecInfo->layer-1];
+        m_MP3FrameInfo->outputSamps=nChansOut
+                * ((int) samplesPerFrameTab[m_MPEGVersion][m_MP3DecInfo->layer-1] >> m_rateShift);
         m_MP3FrameInfo->layer=m_MP3DecInfo->layer;
         m_MP3FrameInfo->version=m_MPEGVersion;
     }
@@ -1283,6 +1456,10 @@ int MP3GetChannels(){return m_MP3FrameInfo->nChans;}
 int MP3GetBitsPerSample(){return m_MP3FrameInfo->bitsPerSample;}
 int MP3GetBitrate(){return m_MP3FrameInfo->bitrate;}
 int MP3GetOutputSamps(){return m_MP3FrameInfo->outputSamps;}
+void MP3Decoder_SetDownmix(bool mono){m_downmix = mono;} /* true: stereo frames are decoded as mono, one synthesis */
+void MP3Decoder_SetRateDivider(uint8_t divider){          /* 1: full rate, 2: half rate, 4: quarter rate */
+    m_rateShift = (divider >= 4 ? 2 : divider >= 2 ? 1 : 0);
+}
 /***********************************************************************************************************************
  * Function:    MP3GetNextFrameInfo
  *
@@ -1297,7 +1474,7 @@ int MP3GetOutputSamps(){return m_MP3FrameInfo->outputSamps;}
  **********************************************************************************************************************/
 int MP3GetNextFrameInfo(unsigned char *buf) {
 
-    if (UnpackFrameHeader( buf) == -1 || m_MP3DecInfo->layer != 3)
+    if (UnpackFrameHeader( buf) == -1 || m_MP3DecInfo->layer < 2)
         return ERR_MP3_INVALID_FRAMEHEADER;
 
     MP3GetLastFrameInfo();
@@ -1321,6 +1498,72 @@ void MP3ClearBadFrame( short *outbuf) {
     for (i = 0; i < m_MP3DecInfo->nGrans * m_MP3DecInfo->nGranSamps * m_MP3DecInfo->nChans; i++)
         outbuf[i] = 0;
 }
+/***********************************************************************************************************************
+ * Function:    MP3ConcealFrame
+ *
+ * Description: produce one frame of pcm in place of a frame that could not be decoded
+ *
+ * Inputs:      pointer to outbuf, big enough to hold one frame of decoded PCM samples
+ *
+ * Outputs:     muting ramp from the last sample of the previous frame down to 0, then silence
+ *              interleaved LRLRLR... if stereo, same layout as the last good frame
+ *
+ * Return:      number of output samples (all channels), 0 if no frame has been decoded yet
+ *
+ * Notes:       uses the frame info of the last good frame, not the header of the damaged one
+ *              the synthesis state is kept, the next good frame is faded in (see MP3ConcealUpdate())
+ **********************************************************************************************************************/
+int MP3ConcealFrame(short *outbuf) {
+    int i, ch, nChans, nSamps, ramp;
+
+    nChans = m_MP3FrameInfo->nChans;
+    if (nChans < 1 || nChans > m_MAX_NCHAN)
+        return 0;
+    nSamps = m_MP3FrameInfo->outputSamps / nChans;
+    ramp = (nSamps < m_CONCEAL_RAMP ? nSamps : m_CONCEAL_RAMP);
+
+    for (i = 0; i < ramp; i++) {
+        for (ch = 0; ch < nChans; ch++)
+            *outbuf++ = (short)((m_mp3ConcealLast[ch] * (ramp - i)) / ramp);
+    }
+    memset(outbuf, 0, (nSamps - ramp) * nChans * sizeof(short));
+
+    for (ch = 0; ch < m_MAX_NCHAN; ch++)
+        m_mp3ConcealLast[ch] = 0;
+    m_mp3ConcealFrames++;
+
+    return nSamps * nChans;
+}
+/***********************************************************************************************************************
+ * Function:    MP3ConcealUpdate
+ *
+ * Description: fade in the first good frame after a concealed one, remember the last sample of each channel
+ *
+ * Inputs:      pointer to outbuf with the decoded frame, frame info of this frame (MP3GetLastFrameInfo())
+ *
+ * Outputs:     outbuf faded in over m_CONCEAL_RAMP samples if the previous frame was concealed
+ *
+ * Return:      none
+ *
+ * Notes:       the IMDCT overlap and the polyphase state still hold the audio from before the loss,
+ *                the ramp hides the step between them and the new frame
+ **********************************************************************************************************************/
+void MP3ConcealUpdate(short *outbuf) {
+    int i, ch, nChans, nSamps, ramp;
+
+    nChans = m_MP3FrameInfo->nChans;
+    nSamps = m_MP3FrameInfo->outputSamps / nChans;
+    if (m_mp3ConcealFrames) {
+        ramp = (nSamps < m_CONCEAL_RAMP ? nSamps : m_CONCEAL_RAMP);
+        for (i = 0; i < ramp; i++) {
+            for (ch = 0; ch < nChans; ch++)
+                outbuf[i * nChans + ch] = (short)((outbuf[i * nChans + ch] * i) / ramp);
+        }
+        m_mp3ConcealFrames = 0;
+    }
+    for (ch = 0; ch < nChans; ch++)
+        m_mp3ConcealLast[ch] = outbuf[(nSamps - 1) * nChans + ch];
+}
 /***********************************************************************************************************************
  * Function:    MP3Decode
  *
@@ -1339,16 +1582,21 @@ void MP3ClearBadFrame( short *outbuf) {
  *
  * Notes:       switching useSize on and off between frames in the same stream
  *                is not supported (bit reservoir is not maintained if useSize on)
+ *              layer II frames are decoded by MP2Decode(), layer I is not supported
  **********************************************************************************************************************/
 int MP3Decode( unsigned char *inbuf, int *bytesLeft, short *outbuf, int useSize){
     int offset, bitOffset, mainBits, gr, ch, fhBytes, siBytes, freeFrameBytes;
-    int prevBitOffset, sfBlockBits, huffBlockBits;
+    int prevBitOffset, sfBlockBits, huffBlockBits, nChansOut;
     unsigned char *mainPtr;
 
     /* unpack frame header */
     fhBytes = UnpackFrameHeader(inbuf);
     if (fhBytes < 0)
         return ERR_MP3_INVALID_FRAMEHEADER; /* don't clear outbuf since we don't know size (failed to parse header) */
+    if (m_MP3DecInfo->layer == 2)
+        return MP2Decode(inbuf, bytesLeft, outbuf, fhBytes);
+    if (m_MP3DecInfo->layer != 3)
+        return ERR_MP3_INVALID_FRAMEHEADER; /* layer I is not supported */
     inbuf += fhBytes;
     /* unpack side info */
     siBytes = UnpackSideInfo( inbuf);
@@ -1461,21 +1709,192 @@ int MP3Decode( unsigned char *inbuf, int *bytesLeft, short *outbuf, int useSize)
         }
 
         /* alias reduction, inverse MDCT, overlap-add, frequency inversion */
-        for (ch = 0; ch < m_MP3DecInfo->nChans; ch++) {
-            if (IMDCT( gr, ch) < 0) {
+        if (m_downmix && m_MP3DecInfo->nChans == 2) {
+            if (IMDCTDownmix(gr) < 0) {
                 MP3ClearBadFrame(outbuf);
                 return ERR_MP3_INVALID_IMDCT;
             }
+            nChansOut = 1;
+        } else {
+            for (ch = 0; ch < m_MP3DecInfo->nChans; ch++) {
+                if (IMDCT( gr, ch) < 0) {
+                    MP3ClearBadFrame(outbuf);
+                    return ERR_MP3_INVALID_IMDCT;
+                }
+            }
+            nChansOut = m_MP3DecInfo->nChans;
         }
         /* subband transform - if stereo, interleaves pcm LRLRLR */
         if (Subband(
-                outbuf + gr * m_MP3DecInfo->nGranSamps * m_MP3DecInfo->nChans)
+                outbuf + gr * (m_MP3DecInfo->nGranSamps >> m_rateShift) * nChansOut, nChansOut)
                 < 0) {
             MP3ClearBadFrame(outbuf);
             return ERR_MP3_INVALID_SUBBAND;
         }
     }
     MP3GetLastFrameInfo();
+    MP3ConcealUpdate(outbuf);
+    return ERR_MP3_NONE;
+}
+
+/***********************************************************************************************************************
+ * L A Y E R   I I
+ **********************************************************************************************************************/
+
+/***********************************************************************************************************************
+ * Function:    MP2Decode
+ *
+ * Description: decode one frame of MPEG-1/2 Layer II data
+ *
+ * Inputs:      pointer to the frame header (unpacked by UnpackFrameHeader), number of header bytes (4 or 6 with CRC)
+ *              number of valid bytes remaining in inbuf
+ *              pointer to outbuf, big enough to hold one frame of decoded PCM samples
+ *
+ * Outputs:     PCM data in outbuf, interleaved LRLRLR... if stereo, 1152 samples per channel
+ *              updated bytesLeft
+ *
+ * Return:      error code, defined in mp3_decoder.h (0 means no error, < 0 means error)
+ *
+ * Notes:       the requantized subband samples are written into IMDCTInfo.outBuf in the format of the layer III
+ *                IMDCT output (Q23, 1.0 = full scale), the 36 samples per subband are synthesized in two halves
+ *                of 18 blocks with Subband(), so downmix and reduced output rate work as in layer III
+ *              the CRC is not checked, ancillary data is skipped
+ **********************************************************************************************************************/
+int MP2Decode(unsigned char *inbuf, int *bytesLeft, short *outbuf, int fhBytes){
+    BitStreamInfo_t bitStreamInfo, *bsi = &bitStreamInfo;
+    uint8_t qClass[m_MAX_NCHAN][m_NBANDS];  /* quantizer class + 1, 0 = no bits allocated */
+    uint8_t scfsi[m_MAX_NCHAN][m_NBANDS];
+    uint8_t scf[m_MAX_NCHAN][m_NBANDS][3];  /* scalefactor index for each third of the frame (4 x 3 samples) */
+    int frameBytes, tabIdx, sbLimit, bound, nChans, nChansOut, nBandsOut;
+    int sb, ch, gr, half, part, q, k, levels, code, x, y;
+    int smp[3], mOut[m_MAX_NCHAN];
+
+    nChans = m_MP3DecInfo->nChans;
+
+    /* frame length, 1152 samples per frame in MPEG-1 and MPEG-2 */
+    if (m_MP3DecInfo->bitrate == 0 || m_MP3DecInfo->freeBitrateFlag) {
+        if (!m_MP3DecInfo->freeBitrateFlag) {
+            m_MP3DecInfo->freeBitrateFlag = 1;
+            m_MP3DecInfo->freeBitrateSlots = MP3FindFreeSync(inbuf + fhBytes, inbuf, *bytesLeft - fhBytes);
+            if (m_MP3DecInfo->freeBitrateSlots < 0) {
+                MP3ClearBadFrame(outbuf);
+                m_MP3DecInfo->freeBitrateFlag = 0;
+                return ERR_MP3_FREE_BITRATE_SYNC;
+            }
+            m_MP3DecInfo->bitrate = ((m_MP3DecInfo->freeBitrateSlots + fhBytes) * m_MP3DecInfo->samprate * 8) / 1152;
+        }
+        frameBytes = fhBytes + m_MP3DecInfo->freeBitrateSlots + CheckPadBit();
+    } else {
+        frameBytes = 144 * m_MP3DecInfo->bitrate / m_MP3DecInfo->samprate + CheckPadBit();
+    }
+    if (frameBytes > *bytesLeft) {
+        MP3ClearBadFrame(outbuf);
+        return ERR_MP3_INDATA_UNDERFLOW;
+    }
+
+    /* allocation table, MPEG-1 depends on sample rate and bitrate per channel (free format like high bitrates) */
+    if (m_MPEGVersion != MPEG1)
+        tabIdx = 4;
+    else if (m_FrameHeader->brIdx && m_MP3DecInfo->bitrate / nChans <= 48000)
+        tabIdx = (m_MP3DecInfo->samprate == 32000 ? 3 : 2);
+    else if (m_FrameHeader->brIdx && m_MP3DecInfo->bitrate / nChans <= 80000)
+        tabIdx = 0;
+    else
+        tabIdx = (m_MP3DecInfo->samprate == 48000 ? 0 : 1);
+    sbLimit = mp2SbLimit[tabIdx];
+    /* joint stereo: above bound the samples are coded once for both channels (intensity stereo) */
+    bound = (m_sMode == Joint ? (m_FrameHeader->modeExt + 1) * 4 : sbLimit);
+    if (bound > sbLimit) bound = sbLimit;
+
+    SetBitstreamPointer(bsi, frameBytes - fhBytes, inbuf + fhBytes);
+
+    /* bit allocation */
+    for (sb = 0; sb < sbLimit; sb++) {
+        const uint8_t *alloc = mp2AllocTab[mp2SbAllocTab[tabIdx][sb]];
+        for (ch = 0; ch < (sb < bound ? nChans : 1); ch++) {
+            code = GetBits(bsi, alloc[0]);
+            qClass[ch][sb] = (code ? mp2ClassTab[alloc[1]][code - 1] + 1 : 0);
+        }
+        if (sb >= bound) qClass[1][sb] = qClass[0][sb];
+    }
+    /* scalefactor selection information and scalefactors */
+    for (sb = 0; sb < sbLimit; sb++) {
+        for (ch = 0; ch < nChans; ch++) {
+            if (qClass[ch][sb]) scfsi[ch][sb] = GetBits(bsi, 2);
+        }
+    }
+    for (sb = 0; sb < sbLimit; sb++) {
+        for (ch = 0; ch < nChans; ch++) {
+            if (!qClass[ch][sb]) continue;
+            uint8_t *s = scf[ch][sb];
+            switch (scfsi[ch][sb]) {
+                case 0:  s[0] = GetBits(bsi, 6); s[1] = GetBits(bsi, 6); s[2] = GetBits(bsi, 6); break;
+                case 1:  s[0] = s[1] = GetBits(bsi, 6); s[2] = GetBits(bsi, 6); break;
+                case 2:  s[0] = s[1] = s[2] = GetBits(bsi, 6); break;
+                default: s[0] = GetBits(bsi, 6); s[1] = s[2] = GetBits(bsi, 6); break;
+            }
+        }
+    }
+
+    /* samples, 12 granules of 3 samples per subband, synthesized after 6 granules (18 blocks) */
+    nChansOut = (m_downmix && nChans == 2 ? 1 : nChans);
+    nBandsOut = m_NBANDS >> m_rateShift; /* reduced output rate: the upper subbands stay 0 */
+    for (half = 0; half < 2; half++) {
+        memset(m_IMDCTInfo->outBuf, 0, nChans * sizeof(m_IMDCTInfo->outBuf[0]));
+        mOut[0] = mOut[1] = 0;
+        for (gr = 0; gr < 6; gr++) {
+            part = (half * 6 + gr) >> 2;
+            for (sb = 0; sb < sbLimit; sb++) {
+                for (ch = 0; ch < nChans; ch++) {
+                    if (!qClass[ch][sb]) continue;
+                    q = qClass[ch][sb] - 1;
+                    levels = mp2Levels[q];
+                    if (sb < bound || ch == 0) {
+                        if (q < 4 && q != 2) {
+                            /* grouped codeword (3, 5 or 9 levels) */
+                            code = GetBits(bsi, mp2CodeBits[q]);
+                            smp[0] = code % levels; code /= levels;
+                            smp[1] = code % levels;
+                            smp[2] = code / levels;
+                        } else {
+                            smp[0] = GetBits(bsi, mp2CodeBits[q]);
+                            smp[1] = GetBits(bsi, mp2CodeBits[q]);
+                            smp[2] = GetBits(bsi, mp2CodeBits[q]);
+                        }
+                    }
+                    if (sb >= nBandsOut) continue;
+                    int *out = &m_IMDCTInfo->outBuf[ch][gr * 3][sb];
+                    for (k = 0; k < 3; k++) {
+                        code = (smp[k] < levels ? smp[k] : levels - 1); /* all ones codes are not allowed */
+                        x = (2 * code - (levels - 1)) * mp2Requant[q];    /* Q31 */
+                        y = MULSHIFT32(x, mp2ScaleFact[scf[ch][sb][part]]);
+                        out[k * m_NBANDS] = y;
+                        mOut[ch] |= FASTABS(y);
+                    }
+                }
+            }
+        }
+        if (nChansOut < nChans) {
+            /* downmix before the synthesis, one polyphase filter */
+            int *l = m_IMDCTInfo->outBuf[0][0], *r = m_IMDCTInfo->outBuf[1][0];
+            mOut[0] = 0;
+            for (k = 0; k < m_BLOCK_SIZE * m_NBANDS; k++) {
+                l[k] = (l[k] + r[k]) >> 1;
+                mOut[0] |= FASTABS(l[k]);
+            }
+        }
+        for (ch = 0; ch < nChansOut; ch++) {
+            m_IMDCTInfo->zeroOut[ch] = (mOut[ch] == 0);
+            m_IMDCTInfo->gb[ch] = (mOut[ch] ? CLZ(mOut[ch]) - 1 : 31);
+        }
+        if (Subband(outbuf + half * ((m_BLOCK_SIZE * m_NBANDS) >> m_rateShift) * nChansOut, nChansOut) < 0) {
+            MP3ClearBadFrame(outbuf);
+            return ERR_MP3_INVALID_SUBBAND;
+        }
+    }
+    *bytesLeft -= frameBytes;
+    MP3GetLastFrameInfo();
+    MP3ConcealUpdate(outbuf);
     return ERR_MP3_NONE;
 }
 
@@ -1507,6 +1926,8 @@ void MP3Decoder_ClearBuffer(void) {
     memset(&m_SideInfoSub,        0, sizeof(SideInfoSub_t)*(m_MAX_NGRAN *m_MAX_NCHAN));        //Clear SideInfoSub
     memset(&m_SFBandTable,        0, sizeof(SFBandTable_t));                                   //Clear SFBandTable
     memset( m_MP3FrameInfo,       0, sizeof(MP3FrameInfo_t));                                  //Clear MP3FrameInfo
+    memset(&m_mp3ConcealLast,     0, sizeof(short)*m_MAX_NCHAN);                               //Clear concealment
+    m_mp3ConcealFrames = 0;
 
     return;
 
@@ -1555,6 +1976,9 @@ bool MP3Decoder_AllocateBuffers(void) {
         log_e("not enough memory to allocate mp3decoder buffers");
         return false;
     }
+#ifdef MP3_HUFFMAN_LUT
+    if(!MP3Decoder_BuildHuffmanLUT()) log_w("not enough memory for the huffman lookup tables, use the helix tables");
+#endif
     MP3Decoder_ClearBuffer();
     return true;
 }
@@ -1584,6 +2008,9 @@ void MP3Decoder_FreeBuffers()
     if(m_IMDCTInfo)         {free(m_IMDCTInfo);       m_IMDCTInfo=0;}
     if(m_SubbandInfo)       {free(m_SubbandInfo);     m_SubbandInfo=0;}
     if(m_MP3FrameInfo)      {free(m_MP3FrameInfo);    m_MP3FrameInfo=0;}
+#ifdef MP3_HUFFMAN_LUT
+    if(m_huffLUT)           {free(m_huffLUT);         m_huffLUT=NULL;}
+#endif
 
 //    log_i("MP3Decoder: %lu bytes memory was freed", ESP.getFreeHeap() - i);
 }
@@ -1641,6 +2068,19 @@ int DecodeHuffmanPairs(int *xy, int nVals, int tabIdx, int bitsLeft, unsigned ch
     if(!(tabIdx >= 0)){log_i("(tabIdx >= 0)"); return -1;}
     if(!(tabType != invalidTab)){log_i("(tabType != invalidTab)"); return -1;}
 
+#ifdef MP3_HUFFMAN_LUT
+    if(m_huffLUT && huffLUTBits[tabIdx]) { /* lookup tables first, the Helix walk below decodes the pairs at the end of the data */
+        int nLeft = nVals;
+        int bitsUsed = DecodeHuffmanPairsLUT(xy, &nLeft, tabIdx, bitsLeft, buf, bitOffset);
+        if (!nLeft)
+            return bitsUsed;
+        xy += nVals - nLeft;
+        nVals = nLeft;
+        bitsLeft -= bitsUsed;
+        buf += (bitOffset + bitsUsed) >> 3;
+        bitOffset = (bitOffset + bitsUsed) & 0x07;
+    }
+#endif
 
     /* initially fill cache with any partial byte */
     cache = 0;
@@ -1831,6 +2271,175 @@ int DecodeHuffmanPairs(int *xy, int nVals, int tabIdx, int bitsLeft, unsigned ch
     return -1;
 }
 
+#ifdef MP3_HUFFMAN_LUT
+/***********************************************************************************************************************
+ * Function:    MP3Decoder_BuildHuffmanLUT
+ *
+ * Description: build the first level lookup tables from the Helix loop tables
+ *
+ * Inputs:      none
+ *
+ * Outputs:     m_huffLUT, m_huffLUTOffset
+ *
+ * Return:      false if there is not enough memory
+ *
+ * Notes:       entry = Helix codeword with the total codeword length in bits 12...15,
+ *              0 if the codeword is longer than the lookup table (walk the Helix tables)
+ **********************************************************************************************************************/
+bool MP3Decoder_BuildHuffmanLUT(){
+    if(m_huffLUT) return true;
+    uint32_t size = 0;
+    for(int t = 0; t < m_HUFF_PAIRTABS; t++){
+        if(!huffLUTBits[t]) continue;
+        int j;
+        for(j = 0; j < t; j++) if(huffLUTBits[j] && huffTabOffset[j] == huffTabOffset[t]) break;
+        if(j < t) {m_huffLUTOffset[t] = m_huffLUTOffset[j]; continue;} // same codes, other linBits
+        m_huffLUTOffset[t] = size;
+        size += 1 << huffLUTBits[t];
+    }
+    m_huffLUT = (uint16_t*)__malloc_heap_psram(size * sizeof(uint16_t));
+    if(!m_huffLUT) return false;
+
+    for(int t = 0; t < m_HUFF_PAIRTABS; t++){
+        int n = huffLUTBits[t];
+        if(!n) continue;
+        const unsigned short *tBase = huffTable + huffTabOffset[t];
+        uint16_t *lut = m_huffLUT + m_huffLUTOffset[t];
+        for(uint32_t v = 0; v < (1u << n); v++){
+            uint32_t bits = v << (32 - n); /* left-justified like the bitstream cache */
+            const unsigned short *tCurr = tBase;
+            int used = 0;
+            uint16_t e = 0;
+            while(1){
+                int maxBits = pgm_read_word(&tCurr[0]) & 0x000f;
+                if(used + maxBits > n) break; /* codeword is longer than the lookup table */
+                uint16_t cw = pgm_read_word(&tCurr[((bits << used) >> (32 - maxBits)) + 1]);
+                int len = (cw >> 12) & 0x000f;
+                if(!len){
+                    used += maxBits;
+                    tCurr += cw;
+                    continue;
+                }
+                e = (cw & 0x0fff) | ((used + len) << 12);
+                break;
+            }
+            lut[v] = e;
+        }
+    }
+    return true;
+}
+
+/***********************************************************************************************************************
+ * Function:    DecodeHuffmanPairsLUT
+ *
+ * Description: decode 2-way vector Huffman codes of the loop tables with the first level lookup tables
+ *
+ * Inputs:      same as DecodeHuffmanPairs, nVals points to the number of codewords to decode
+ *
+ * Outputs:     pairs of decoded coefficients in xy
+ *              number of codewords that are left for DecodeHuffmanPairs in nVals
+ *
+ * Return:      number of bits used
+ *
+ * Notes:       the bitstream cache is a 64 bit register, it is refilled once per pair (the longest pair is
+ *                19 bits codeword + 2 * 13 linBits + 2 sign bits = 47 bits)
+ *              stops in front of the first pair that could run past the end of the data, DecodeHuffmanPairs
+ *                decodes the rest with the Helix tables, so short input is handled exactly like in Helix
+ *              the output is identical to DecodeHuffmanPairs with the Helix tables
+ **********************************************************************************************************************/
+int DecodeHuffmanPairsLUT(int *xy, int *nVals, int tabIdx, int bitsLeft, unsigned char *buf, int bitOffset){
+    int x, y, len, maxBits, startBits, cachedBits, linBits, lutShift;
+    uint64_t cache;
+    uint16_t cw;
+    const unsigned short *tBase, *tCurr;
+    const uint16_t *lut;
+
+    if (bitsLeft < 47)
+        return 0;
+    startBits = bitsLeft;
+
+    tBase = huffTable + huffTabOffset[tabIdx];
+    linBits = huffTabLookup[tabIdx].linBits;
+    lut = m_huffLUT + m_huffLUTOffset[tabIdx];
+    lutShift = 64 - huffLUTBits[tabIdx];
+
+    /* initially fill cache with any partial byte */
+    cache = 0;
+    cachedBits = (8 - bitOffset) & 0x07;
+    if (cachedBits)
+        cache = (uint64_t) (*buf++) << (64 - cachedBits);
+    bitsLeft -= cachedBits;
+
+    while (*nVals > 0 && cachedBits + bitsLeft >= 47) {
+        /* refill cache, a whole pair is in the data */
+        if (cachedBits < 47) {
+            while (cachedBits <= 56 && bitsLeft >= 8) {
+                cache |= (uint64_t) (*buf++) << (56 - cachedBits);
+                cachedBits += 8;
+                bitsLeft -= 8;
+            }
+            if (cachedBits < 47) { /* last partial byte */
+                cache |= (uint64_t) (*buf++) << (56 - cachedBits);
+                cachedBits += bitsLeft;
+                bitsLeft = 0;
+                cache &= ~0ULL << (64 - cachedBits);
+            }
+        }
+
+        cw = lut[cache >> lutShift];
+        if (cw) {
+            len = cw >> 12;
+        } else {
+            /* long codeword, walk the Helix tables */
+            uint64_t c = cache;
+            tCurr = tBase;
+            len = 0;
+            while (1) {
+                maxBits = pgm_read_word(&tCurr[0]) & 0x000f;
+                cw = pgm_read_word(&tCurr[(c >> (64 - maxBits)) + 1]);
+                if (cw >> 12) {
+                    len += cw >> 12;
+                    break;
+                }
+                len += maxBits;
+                c <<= maxBits;
+                tCurr += cw;
+            }
+        }
+        cache <<= len;
+        cachedBits -= len;
+
+        x = (cw >> 4) & 0x000f;
+        y = (cw >> 8) & 0x000f;
+        if (x == 15 && linBits) {
+            x += (int) (cache >> (64 - linBits));
+            cache <<= linBits;
+            cachedBits -= linBits;
+        }
+        if (x) {
+            x |= (uint32_t) (cache >> 32) & 0x80000000;
+            cache <<= 1;
+            cachedBits--;
+        }
+        if (y == 15 && linBits) {
+            y += (int) (cache >> (64 - linBits));
+            cache <<= linBits;
+            cachedBits -= linBits;
+        }
+        if (y) {
+            y |= (uint32_t) (cache >> 32) & 0x80000000;
+            cache <<= 1;
+            cachedBits--;
+        }
+
+        *xy++ = x;
+        *xy++ = y;
+        *nVals -= 2;
+    }
+    return startBits - (bitsLeft + cachedBits);
+}
+#endif /* MP3_HUFFMAN_LUT */
+
 /***********************************************************************************************************************
  * Function:    DecodeHuffmanQuads
  *
@@ -3342,6 +3951,7 @@ int HybridTransform(int *xCurr, int *xPrev, int y[m_BLOCK_SIZE][m_NBANDS], SideI
     }
 
     bc->gbOut = CLZ(mOut) - 1;
+    bc->zeroOut = (mOut == 0); /* mOut is the OR of abs(y) of all outputs */
 
     return nBlocksOut;
 }
@@ -3375,15 +3985,21 @@ int IMDCT( int gr, int ch) {
      *   nBfly = number of butterflies to do (nLongBlocks - 1, unless no long blocks)
      */
     blockCutoff = m_SFBandTable.l[(m_MPEGVersion == MPEG1 ? 8 : 6)] / 18; /* same as 3* num short sfb's in spec */
+    int nBlocksMax = m_NBANDS >> m_rateShift; /* reduced output rate: the upper subbands stay 0 */
+    if (m_rateShift && m_HuffmanInfo->nonZeroBound[ch] > nBlocksMax * 18) {
+        memset(m_HuffmanInfo->huffDecBuf[ch] + nBlocksMax * 18, 0,
+                (m_HuffmanInfo->nonZeroBound[ch] - nBlocksMax * 18) * sizeof(int));
+        m_HuffmanInfo->nonZeroBound[ch] = nBlocksMax * 18;
+    }
     if (m_SideInfoSub[gr][ch].blockType != 2) {
         /* all long transforms */
         int x=(m_HuffmanInfo->nonZeroBound[ch] + 7) / 18 + 1;
-        bc.nBlocksLong=(x<32 ? x : 32);
+        bc.nBlocksLong=(x<nBlocksMax ? x : nBlocksMax);
         //bc.nBlocksLong = min((hi->nonZeroBound[ch] + 7) / 18 + 1, 32);
         nBfly = bc.nBlocksLong - 1;
     } else if (m_SideInfoSub[gr][ch].blockType == 2 && m_SideInfoSub[gr][ch].mixedBlock) {
         /* mixed block - long transforms until cutoff, then short transforms */
-        bc.nBlocksLong = blockCutoff;
+        bc.nBlocksLong = (blockCutoff < nBlocksMax ? blockCutoff : nBlocksMax);
         nBfly = bc.nBlocksLong - 1;
     } else {
         /* all short transforms */
@@ -3412,6 +4028,7 @@ int IMDCT( int gr, int ch) {
     m_IMDCTInfo->prevType[ch] = m_SideInfoSub[gr][ch].blockType;
     m_IMDCTInfo->prevWinSwitch[ch] = bc.currWinSwitch; /* 0 means not a mixed block (either all short or all long) */
     m_IMDCTInfo->gb[ch] = bc.gbOut;
+    m_IMDCTInfo->zeroOut[ch] = bc.zeroOut;
 
     assert(m_IMDCTInfo->numPrevIMDCT[ch] <= m_NBANDS);
 
@@ -3419,6 +4036,72 @@ int IMDCT( int gr, int ch) {
     return 0;
 }
 
+/***********************************************************************************************************************
+ * Function:    IMDCTDownmix
+ *
+ * Description: IMDCT for a stereo granule with mono output, (L + R) / 2 in outBuf[0]
+ *
+ * Inputs:      MP3DecInfo structure, after MP3Dequantize() (joint stereo is already decoded)
+ *              index of current granule
+ *
+ * Outputs:     PCM samples in outBuf[0], for input to the subband transform with one channel
+ *              overlap state of both channels
+ *
+ * Return:      0 on success,  -1 if null input pointers
+ *
+ * Notes:       if both channels use the same windows (current and previous granule) the spectra and the overlap
+ *                buffers are mixed and only one IMDCT is done, both channels continue with the mixed overlap
+ *              otherwise both channels are transformed and the time signals are mixed
+ **********************************************************************************************************************/
+int IMDCTDownmix(int gr) {
+    int i, n, *x0, *x1;
+    SideInfoSub_t *sis0 = &m_SideInfoSub[gr][0];
+    SideInfoSub_t *sis1 = &m_SideInfoSub[gr][1];
+
+    if (sis0->blockType == sis1->blockType && sis0->mixedBlock == sis1->mixedBlock &&
+            m_IMDCTInfo->prevType[0] == m_IMDCTInfo->prevType[1] &&
+            m_IMDCTInfo->prevWinSwitch[0] == m_IMDCTInfo->prevWinSwitch[1]) {
+        /* mix in the frequency domain, the coefficients behind nonZeroBound are 0 */
+        x0 = m_HuffmanInfo->huffDecBuf[0];
+        x1 = m_HuffmanInfo->huffDecBuf[1];
+        n = (m_HuffmanInfo->nonZeroBound[0] > m_HuffmanInfo->nonZeroBound[1] ?
+                m_HuffmanInfo->nonZeroBound[0] : m_HuffmanInfo->nonZeroBound[1]);
+        for (i = 0; i < n; i++)
+            x0[i] = (x0[i] >> 1) + (x1[i] >> 1);
+        m_HuffmanInfo->nonZeroBound[0] = n;
+        if (m_HuffmanInfo->gb[1] < m_HuffmanInfo->gb[0]) m_HuffmanInfo->gb[0] = m_HuffmanInfo->gb[1];
+
+        /* overlap from the last granule, the samples behind numPrevIMDCT blocks are 0 */
+        x0 = m_IMDCTInfo->overBuf[0];
+        x1 = m_IMDCTInfo->overBuf[1];
+        n = (m_IMDCTInfo->numPrevIMDCT[0] > m_IMDCTInfo->numPrevIMDCT[1] ?
+                m_IMDCTInfo->numPrevIMDCT[0] : m_IMDCTInfo->numPrevIMDCT[1]);
+        for (i = 0; i < n * 9; i++)
+            x0[i] = (x0[i] >> 1) + (x1[i] >> 1);
+        m_IMDCTInfo->numPrevIMDCT[0] = n;
+
+        if (IMDCT(gr, 0) < 0)
+            return -1;
+
+        memcpy(m_IMDCTInfo->overBuf[1], m_IMDCTInfo->overBuf[0], sizeof(m_IMDCTInfo->overBuf[0]));
+        m_IMDCTInfo->numPrevIMDCT[1] = m_IMDCTInfo->numPrevIMDCT[0];
+        m_IMDCTInfo->prevType[1] = m_IMDCTInfo->prevType[0];
+        m_IMDCTInfo->prevWinSwitch[1] = m_IMDCTInfo->prevWinSwitch[0];
+        return 0;
+    }
+
+    /* different windows (e.g. long and short blocks), mix in the time domain */
+    if (IMDCT(gr, 0) < 0 || IMDCT(gr, 1) < 0)
+        return -1;
+    x0 = &m_IMDCTInfo->outBuf[0][0][0];
+    x1 = &m_IMDCTInfo->outBuf[1][0][0];
+    for (i = 0; i < m_BLOCK_SIZE * m_NBANDS; i++)
+        x0[i] = (x0[i] >> 1) + (x1[i] >> 1);
+    if (m_IMDCTInfo->gb[1] < m_IMDCTInfo->gb[0]) m_IMDCTInfo->gb[0] = m_IMDCTInfo->gb[1];
+    m_IMDCTInfo->zeroOut[0] = m_IMDCTInfo->zeroOut[0] && m_IMDCTInfo->zeroOut[1];
+    return 0;
+}
+
 /***********************************************************************************************************************
  * S U B B A N D
  **********************************************************************************************************************/
@@ -3430,37 +4113,54 @@ int IMDCT( int gr, int ch) {
  *
  * Inputs:      filled MP3DecInfo structure, after calling IMDCT for all channels
  *              vbuf[ch] and vindex[ch] must be preserved between calls
+ *              number of output channels (1 after IMDCTDownmix)
+ *              with a reduced output rate the lower 16 or 8 subbands are synthesized, 16 or 8 point DCT
+ *                (FDCT32Reduced) and only every 2nd or 4th PCM sample of the polyphase filter (PolyphaseReduced)
  *
  * Outputs:     decoded PCM data, interleaved LRLRLR... if stereo
  *
  * Return:      0 on success,  -1 if null input pointers
+ *
+ * Notes:       the DCT of a silent granule (IMDCT output all zero) is not calculated, only the zeros are written
+ *                into vbuf. After 16 zero blocks (8 odd, 8 even) the whole vbuf of a channel is zero, then the
+ *                polyphase filter is skipped too, the PCM output is exactly 0
  **********************************************************************************************************************/
-int Subband( short *pcmBuf) {
-    int b;
-    if (m_MP3DecInfo->nChans == 2) {
-        /* stereo */
-        for (b = 0; b < m_BLOCK_SIZE; b++) {
-            FDCT32(m_IMDCTInfo->outBuf[0][b], m_SubbandInfo->vbuf + 0 * 32, m_SubbandInfo->vindex,
-                    (b & 0x01), m_IMDCTInfo->gb[0]);
-            FDCT32(m_IMDCTInfo->outBuf[1][b], m_SubbandInfo->vbuf + 1 * 32, m_SubbandInfo->vindex,
-                    (b & 0x01), m_IMDCTInfo->gb[1]);
+int Subband( short *pcmBuf, int nChans) {
+    int b, ch;
+    for (b = 0; b < m_BLOCK_SIZE; b++) {
+        bool silent = true;
+        for (ch = 0; ch < nChans; ch++) {
+            if (m_IMDCTInfo->zeroOut[ch]) {
+                FDCT32Zero(m_SubbandInfo->vbuf + ch * 32, m_SubbandInfo->vindex, (b & 0x01));
+                if (m_SubbandInfo->zeroBlocks[ch] < 16) m_SubbandInfo->zeroBlocks[ch]++;
+            } else if (m_rateShift) {
+                FDCT32Reduced(m_IMDCTInfo->outBuf[ch][b], m_SubbandInfo->vbuf + ch * 32, m_SubbandInfo->vindex,
+                        (b & 0x01), m_IMDCTInfo->gb[ch], m_rateShift);
+                m_SubbandInfo->zeroBlocks[ch] = 0;
+            } else {
+                FDCT32(m_IMDCTInfo->outBuf[ch][b], m_SubbandInfo->vbuf + ch * 32, m_SubbandInfo->vindex,
+                        (b & 0x01), m_IMDCTInfo->gb[ch]);
+                m_SubbandInfo->zeroBlocks[ch] = 0;
+            }
+            if (m_SubbandInfo->zeroBlocks[ch] < 16) silent = false;
+        }
+        if (silent) {
+            memset(pcmBuf, 0, nChans * (m_NBANDS >> m_rateShift) * sizeof(short));
+        } else if (m_rateShift) {
+            PolyphaseReduced(pcmBuf,
+                    m_SubbandInfo->vbuf + m_SubbandInfo->vindex + m_VBUF_LENGTH * (b & 0x01),
+                    polyCoef, nChans, m_rateShift);
+        } else if (nChans == 2) {
             PolyphaseStereo(pcmBuf,
                     m_SubbandInfo->vbuf + m_SubbandInfo->vindex + m_VBUF_LENGTH * (b & 0x01),
                     polyCoef);
-            m_SubbandInfo->vindex = (m_SubbandInfo->vindex - (b & 0x01)) & 7;
-            pcmBuf += (2 * m_NBANDS);
-        }
-    } else {
-        /* mono */
-        for (b = 0; b < m_BLOCK_SIZE; b++) {
-            FDCT32(m_IMDCTInfo->outBuf[0][b], m_SubbandInfo->vbuf + 0 * 32, m_SubbandInfo->vindex,
-                    (b & 0x01), m_IMDCTInfo->gb[0]);
+        } else {
             PolyphaseMono(pcmBuf,
                     m_SubbandInfo->vbuf + m_SubbandInfo->vindex + m_VBUF_LENGTH * (b & 0x01),
                     polyCoef);
-            m_SubbandInfo->vindex = (m_SubbandInfo->vindex - (b & 0x01)) & 7;
-            pcmBuf += m_NBANDS;
         }
+        m_SubbandInfo->vindex = (m_SubbandInfo->vindex - (b & 0x01)) & 7;
+        pcmBuf += nChans * (m_NBANDS >> m_rateShift);
     }
 
     return 0;
@@ -3503,6 +4203,29 @@ int Subband( short *pcmBuf) {
 	buf[16+i] = b2 + b3;    buf[31-i] = MULSHIFT32(*cptr++, b3 - b2) << (s2); \
 }
 
+/* second pass, one group of 8 in buf[0..7], takes the next 6 coefficients of cptr */
+#define D32SP() { \
+	a0 = buf[0]; 	    a7 = buf[7];		a3 = buf[3];	    a4 = buf[4]; \
+	b0 = a0 + a7;	    b7 = MULSHIFT32(*cptr++, a0 - a7) << 1; \
+	b3 = a3 + a4;	    b4 = MULSHIFT32(*cptr++, a3 - a4) << 3; \
+	a0 = b0 + b3;	    a3 = MULSHIFT32(*cptr,   b0 - b3) << 1; \
+	a4 = b4 + b7;		a7 = MULSHIFT32(*cptr++, b7 - b4) << 1; \
+	a1 = buf[1];	    a6 = buf[6];	    a2 = buf[2];	    a5 = buf[5]; \
+	b1 = a1 + a6;	    b6 = MULSHIFT32(*cptr++, a1 - a6) << 1; \
+	b2 = a2 + a5;	    b5 = MULSHIFT32(*cptr++, a2 - a5) << 1; \
+	a1 = b1 + b2;		a2 = MULSHIFT32(*cptr,   b1 - b2) << 2; \
+	a5 = b5 + b6;	    a6 = MULSHIFT32(*cptr++, b6 - b5) << 2; \
+	b0 = a0 + a1;	    b1 = MULSHIFT32(m_COS4_0, a0 - a1) << 1; \
+	b2 = a2 + a3;	    b3 = MULSHIFT32(m_COS4_0, a3 - a2) << 1; \
+	buf[0] = b0;	    buf[1] = b1; \
+	buf[2] = b2 + b3;	buf[3] = b3; \
+	b4 = a4 + a5;	    b5 = MULSHIFT32(m_COS4_0, a4 - a5) << 1; \
+	b6 = a6 + a7;	    b7 = MULSHIFT32(m_COS4_0, a7 - a6) << 1; \
+	b6 += b7; \
+	buf[4] = b4 + b6;	buf[5] = b5 + b7; \
+	buf[6] = b5 + b6;	buf[7] = b7; \
+}
+
 static const uint8_t FDCT32s1s2[16] = {5,3,3,2,2,1,1,1, 1,1,1,1,1,2,2,4};
 
 void FDCT32(int *buf, int *dest, int offset, int oddBlock, int gb) {
@@ -3530,29 +4253,7 @@ void FDCT32(int *buf, int *dest, int offset, int oddBlock, int gb) {
 
 	/* second pass */
 	for (i = 4; i > 0; i--) {
-		a0 = buf[0]; 	    a7 = buf[7];		a3 = buf[3];	    a4 = buf[4];
-		b0 = a0 + a7;	    b7 = MULSHIFT32(*cptr++, a0 - a7) << 1;
-		b3 = a3 + a4;	    b4 = MULSHIFT32(*cptr++, a3 - a4) << 3;
-		a0 = b0 + b3;	    a3 = MULSHIFT32(*cptr,   b0 - b3) << 1;
-		a4 = b4 + b7;		a7 = MULSHIFT32(*cptr++, b7 - b4) << 1;
-
-		a1 = buf[1];	    a6 = buf[6];	    a2 = buf[2];	    a5 = buf[5];
-		b1 = a1 + a6;	    b6 = MULSHIFT32(*cptr++, a1 - a6) << 1;
-		b2 = a2 + a5;	    b5 = MULSHIFT32(*cptr++, a2 - a5) << 1;
-		a1 = b1 + b2;		a2 = MULSHIFT32(*cptr,   b1 - b2) << 2;
-		a5 = b5 + b6;	    a6 = MULSHIFT32(*cptr++, b6 - b5) << 2;
-
-		b0 = a0 + a1;	    b1 = MULSHIFT32(m_COS4_0, a0 - a1) << 1;
-		b2 = a2 + a3;	    b3 = MULSHIFT32(m_COS4_0, a3 - a2) << 1;
-		buf[0] = b0;	    buf[1] = b1;
-		buf[2] = b2 + b3;	buf[3] = b3;
-
-		b4 = a4 + a5;	    b5 = MULSHIFT32(m_COS4_0, a4 - a5) << 1;
-		b6 = a6 + a7;	    b7 = MULSHIFT32(m_COS4_0, a7 - a6) << 1;
-		b6 += b7;
-		buf[4] = b4 + b6;	buf[5] = b5 + b7;
-		buf[6] = b5 + b6;	buf[7] = b7;
-
+		D32SP();
 		buf += 8;
 	}
 	buf -= 32;	/* reset */
@@ -3637,6 +4338,146 @@ void FDCT32(int *buf, int *dest, int offset, int oddBlock, int gb) {
 	}
 }
 
+/***********************************************************************************************************************
+ * Function:    FDCT32Reduced
+ *
+ * Description: 16-point (half rate) or 8-point (quarter rate) DCT for the reduced output rate
+ *
+ * Inputs:      input buffer, only the lower 32 >> rateShift samples are used, the upper subbands count as 0
+ *              buffer offset and oddblock flag for polyphase filter input buffer
+ *              number of guard bits in input
+ *              1: half rate, 2: quarter rate
+ *
+ * Outputs:     the vbuf rows of every 2nd or 4th PCM sample, the rows PolyphaseReduced reads
+ *
+ * Return:      none
+ *
+ * Notes:       FDCT32 pruned to the zero inputs and to the outputs of the kept rows, same arithmetic, bit exact
+ *              half rate: first pass without the difference branch, 2 of 4 second pass groups, 32 muls (FDCT32 80)
+ *              quarter rate: no first pass (buf[i] + 0), 1 second pass group, 12 muls
+ *              the rows of the other PCM samples are not written, they are never read at a reduced rate
+ **********************************************************************************************************************/
+void FDCT32Reduced(int *buf, int *dest, int offset, int oddBlock, int gb, int rateShift) {
+    int i, s, es, nGroups = (rateShift == 1 ? 2 : 1);
+    const int *cptr = (const int*)m_dcttab;
+    int a0, a1, a2, a3, a4, a5, a6, a7;
+    int b0, b1, b2, b3, b4, b5, b6, b7;
+    int *d;
+
+    es = 0;
+    if (gb < 6) {
+        es = 6 - gb;
+        for (i = 0; i < (m_NBANDS >> rateShift); i++)
+            buf[i] >>= es;
+    }
+
+    /* first pass - buf[16..31] are 0, the sum branch is left (b0 = buf[i], b1 = buf[15-i])
+     * quarter rate: buf[8..31] are 0, buf[0..7] pass unchanged */
+    if (rateShift == 1) {
+        for (i = 0; i < 8; i++) {
+            b0 = buf[i];            b1 = buf[15-i];
+            buf[i] = b0 + b1;       buf[15-i] = MULSHIFT32(cptr[2], b0 - b1) << FDCT32s1s2[8 + i];
+            cptr += 3;
+        }
+    }
+
+    /* second pass - buf[0..7] and buf[8..15] (half rate) or buf[0..7] (quarter rate) */
+    cptr = (const int*)m_dcttab + 24;
+    for (i = nGroups; i > 0; i--) {
+        D32SP();
+        buf += 8;
+    }
+    buf -= 8 * nGroups;	/* reset */
+
+    /* sample 0 - always delayed one block */
+    d = dest + 64*16 + ((offset - oddBlock) & 7) + (oddBlock ? 0 : m_VBUF_LENGTH);
+    s = buf[ 0];				d[0] = d[8] = s;
+
+    /* samples 16 to 31 */
+    d = dest + offset + (oddBlock ? m_VBUF_LENGTH  : 0);
+    if (rateShift == 1) {
+        s = buf[ 1];			d[0] = d[8] = s;	d += 128;
+        s = buf[ 9] + buf[13];	d[0] = d[8] = s;	d += 128;
+        s = buf[ 5];			d[0] = d[8] = s;	d += 128;
+        s = buf[13] + buf[11];	d[0] = d[8] = s;	d += 128;
+        s = buf[ 3];			d[0] = d[8] = s;	d += 128;
+        s = buf[11] + buf[15];	d[0] = d[8] = s;	d += 128;
+        s = buf[ 7];			d[0] = d[8] = s;	d += 128;
+        s = buf[15];			d[0] = d[8] = s;
+    } else {
+        s = buf[ 1];			d[0] = d[8] = s;	d += 256;
+        s = buf[ 5];			d[0] = d[8] = s;	d += 256;
+        s = buf[ 3];			d[0] = d[8] = s;	d += 256;
+        s = buf[ 7];			d[0] = d[8] = s;
+    }
+
+    /* samples 16 to 1 (sample 16 used again) */
+    d = dest + 16 + ((offset - oddBlock) & 7) + (oddBlock ? 0 : m_VBUF_LENGTH);
+    if (rateShift == 1) {
+        s = buf[ 1];			d[0] = d[8] = s;	d += 128;
+        s = buf[14] + buf[ 9];	d[0] = d[8] = s;	d += 128;
+        s = buf[ 6];			d[0] = d[8] = s;	d += 128;
+        s = buf[10] + buf[14];	d[0] = d[8] = s;	d += 128;
+        s = buf[ 2];			d[0] = d[8] = s;	d += 128;
+        s = buf[12] + buf[10];	d[0] = d[8] = s;	d += 128;
+        s = buf[ 4];			d[0] = d[8] = s;	d += 128;
+        s = buf[ 8] + buf[12];	d[0] = d[8] = s;
+    } else {
+        s = buf[ 1];			d[0] = d[8] = s;	d += 256;
+        s = buf[ 6];			d[0] = d[8] = s;	d += 256;
+        s = buf[ 2];			d[0] = d[8] = s;	d += 256;
+        s = buf[ 4];			d[0] = d[8] = s;
+    }
+
+    if (es) {
+        d = dest + 64*16 + ((offset - oddBlock) & 7) + (oddBlock ? 0 : m_VBUF_LENGTH);
+        s = d[0];	CLIP_2N(s, (31 - es));	d[0] = d[8] = (s << es);
+
+        d = dest + offset + (oddBlock ? m_VBUF_LENGTH  : 0);
+        for (i = 0; i < 16; i += (1 << rateShift)) {
+            s = d[0];	CLIP_2N(s, (31 - es));	d[0] = d[8] = (s << es);	d += (64 << rateShift);
+        }
+
+        d = dest + 16 + ((offset - oddBlock) & 7) + (oddBlock ? 0 : m_VBUF_LENGTH);
+        for (i = 0; i < 16; i += (1 << rateShift)) {
+            s = d[0];	CLIP_2N(s, (31 - es));	d[0] = d[8] = (s << es);	d += (64 << rateShift);
+        }
+    }
+}
+
+/***********************************************************************************************************************
+ * Function:    FDCT32Zero
+ *
+ * Description: same as FDCT32 with an all zero input buffer, writes the zeros to the same vbuf positions
+ *
+ * Inputs:      vbuf of the channel, buffer offset and oddblock flag for polyphase filter input buffer
+ *
+ * Outputs:     zeros in the polyphase filter input buffer
+ *
+ * Return:      none
+ **********************************************************************************************************************/
+void FDCT32Zero(int *dest, int offset, int oddBlock) {
+    int i, *d;
+
+    /* sample 0 */
+    d = dest + 64*16 + ((offset - oddBlock) & 7) + (oddBlock ? 0 : m_VBUF_LENGTH);
+    d[0] = d[8] = 0;
+
+    /* samples 16 to 31 */
+    d = dest + offset + (oddBlock ? m_VBUF_LENGTH : 0);
+    for (i = 0; i < 16; i++) {
+        d[0] = d[8] = 0;
+        d += 64;
+    }
+
+    /* samples 16 to 1 */
+    d = dest + 16 + ((offset - oddBlock) & 7) + (oddBlock ? 0 : m_VBUF_LENGTH);
+    for (i = 0; i < 16; i++) {
+        d[0] = d[8] = 0;
+        d += 64;
+    }
+}
+
 /***********************************************************************************************************************
  * P O L Y P H A S E
  **********************************************************************************************************************/
@@ -3802,3 +4643,67 @@ void PolyphaseStereo(short *pcm, int *vbuf, const uint32_t *coefBase){
         pcm += 2;
     }
 }
+/***********************************************************************************************************************
+ * Function:    PolyphaseReduced
+ *
+ * Description: filter one subband and produce 32 >> rateShift output PCM samples for each channel
+ *
+ * Inputs:      pointer to PCM output buffer
+ *              pointer to start of vbuf (preserved from last call)
+ *              start of filter coefficient table (in proper, shuffled order)
+ *              number of channels (1 or 2)
+ *              1: every 2nd sample (half rate), 2: every 4th sample (quarter rate)
+ *
+ * Outputs:     16 or 8 samples of each channel, interleaved LRLRLR... if stereo
+ *
+ * Return:      none
+ *
+ * Notes:       the upper subbands are 0 (see IMDCT), with every 2nd or 4th tap of the 512 tap window this is the
+ *                synthesis filterbank of 16 or 8 subbands, 16 MACs per output sample as at the full rate
+ *              same sums as PolyphaseStereo, output sample k uses coefBase + 16 * k and vbuf + 64 * k, these rows
+ *                are written by FDCT32Reduced
+ **********************************************************************************************************************/
+void PolyphaseReduced(short *pcm, int *vbuf, const uint32_t *coefBase, int nChans, int rateShift){
+    int k, ch, step = 1 << rateShift;
+    const uint32_t *coef;
+    int *vb1;
+    int vLo, vHi, c1, c2;
+    uint64_t sum1, sum2, rndVal;
+
+    rndVal = (uint64_t)( 1 << ((m_DQ_FRACBITS_OUT - 2 - 2 - 15) - 1 + (32 - m_CSHIFT)) );
+
+    for (ch = 0; ch < nChans; ch++) {
+        /* output sample 0 */
+        coef = coefBase;
+        vb1 = vbuf + 32 * ch;
+        sum1 = rndVal;
+        for(int j=0; j<8; j++){
+            c1=*coef; coef++; c2=*coef; coef++; vLo=*(vb1+(j)); vHi = *(vb1+(23-(j)));
+            sum1=MADD64(sum1, vLo,  c1); sum1=MADD64(sum1, vHi, -c2);
+        }
+        pcm[ch] = ClipToShort((int)SAR64(sum1, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
+
+        /* output sample 16 */
+        coef = coefBase + 256;
+        vb1 = vbuf + 64*16 + 32 * ch;
+        sum1 = rndVal;
+        for(int j=0; j<8; j++){
+            c1=*coef; coef++; vLo = *(vb1+(j)); sum1 = MADD64(sum1, vLo,  c1);
+        }
+        pcm[(16 >> rateShift) * nChans + ch] = ClipToShort((int)SAR64(sum1, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
+
+        /* sum1 = samples step, 2 * step ... < 16   sum2 = samples 32 - step, 32 - 2 * step ... > 16 */
+        for (k = step; k < 16; k += step) {
+            coef = coefBase + 16 * k;
+            vb1 = vbuf + 64 * k + 32 * ch;
+            sum1 = sum2 = rndVal;
+            for(int j=0; j<8; j++){
+                c1=*coef; coef++; c2=*coef; coef++; vLo=*(vb1+(j)); vHi = *(vb1+(23-(j)));
+                sum1=MADD64(sum1, vLo,  c1); sum2=MADD64(sum2, vLo,  c2);
+                sum1=MADD64(sum1, vHi, -c2); sum2=MADD64(sum2, vHi,  c1);
+            }
+            pcm[(k >> rateShift) * nChans + ch]        = ClipToShort((int)SAR64(sum1, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
+            pcm[((32 - k) >> rateShift) * nChans + ch] = ClipToShort((int)SAR64(sum2, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
+        }
+    }
+}
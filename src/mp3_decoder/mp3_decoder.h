@@ -4,6 +4,8 @@
 #include "Arduino.h"
 #include "assert.h"
 
+#define MP3_HUFFMAN_LUT  // multi-bit lookup tables for the big values codes, comment out to use the Helix tables only
+
 static const uint8_t  m_HUFF_PAIRTABS          =32;
 static const uint8_t  m_BLOCK_SIZE             =18;
 static const uint8_t  m_NBANDS                 =32;
@@ -144,6 +146,7 @@ typedef struct IMDCTInfo {
     int prevType[m_MAX_NCHAN];
     int prevWinSwitch[m_MAX_NCHAN];
     int gb[m_MAX_NCHAN];
+    int zeroOut[m_MAX_NCHAN];                     /* 1 if outBuf of this channel is all zero (silent granule) */
 } IMDCTInfo_t;
 
 typedef struct BlockCount {
@@ -155,6 +158,7 @@ typedef struct BlockCount {
     int currWinSwitch;
     int gbIn;
     int gbOut;
+    int zeroOut;
 } BlockCount_t;
 
 typedef struct ScaleFactorInfoSub {    /* max bits in scalefactors = 5, so use char's to save space */
@@ -175,6 +179,7 @@ typedef struct ScaleFactorJS { /* used in MPEG 2, 2.5 intensity (joint) stereo o
 typedef struct SubbandInfo {
     int vbuf[m_MAX_NCHAN * m_VBUF_LENGTH];      /* vbuf for fast DCT-based synthesis PQMF - double size for speed (no modulo indexing) */
     int vindex;                             /* internal index for tracking position in vbuf */
+    int zeroBlocks[m_MAX_NCHAN];            /* number of consecutive all zero blocks in vbuf */
 } SubbandInfo_t;
 
 typedef struct MP3DecInfo {
@@ -374,6 +379,59 @@ const int/*short*/sideBytesTab[3][2] PROGMEM = { { 17, 32 }, /* MPEG-1:   mono,
 { 9, 17 }, /* MPEG-2.5: mono, stereo */
 };
 
+/* layer II quantizer classes (ISO/IEC 11172-3 table B.4)
+ * [class] = number of levels and bits per codeword, 3, 5 and 9 levels are grouped (3 samples in one codeword)
+ */
+const uint16_t mp2Levels[17] PROGMEM = { 3, 5, 7, 9, 15, 31, 63, 127, 255, 511, 1023, 2047, 4095, 8191, 16383, 32767,
+    65535 };
+const uint8_t mp2CodeBits[17] PROGMEM = { 5, 7, 3, 10, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+
+/* format = Q31, 1/levels, requantized sample = (2 * code - (levels - 1)) / levels */
+const int mp2Requant[17] PROGMEM = {
+    0x2aaaaaab, 0x1999999a, 0x12492492, 0x0e38e38e, 0x08888889, 0x04210842, 0x02082082, 0x01020408,
+    0x00808081, 0x00402010, 0x00200802, 0x00100200, 0x00080080, 0x00040020, 0x00020008, 0x00010002,
+    0x00008001,
+};
+
+/* indexing = [row][allocation - 1], quantizer class of an allocation value */
+const uint8_t mp2ClassTab[6][15] PROGMEM = {
+    { 0, 1, 16 },
+    { 0, 1,  2,  3,  4,  5, 16 },
+    { 0, 1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14 },
+    { 0, 1,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 16 },
+    { 0, 2,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, 16 },
+};
+
+/* indexing = [allocation type] = { bits of the allocation field, row in mp2ClassTab } */
+const uint8_t mp2AllocTab[8][2] PROGMEM = {
+    { 2, 0 }, { 2, 3 }, { 3, 3 }, { 3, 1 }, { 4, 2 }, { 4, 3 }, { 4, 4 }, { 4, 5 },
+};
+
+/* indexing = [table][subband], allocation type of each subband
+ *   table 0...3 = MPEG-1 (ISO/IEC 11172-3 table B.2a...B.2d), table 4 = MPEG-2 LSF (ISO/IEC 13818-3 table B.1)
+ */
+const uint8_t mp2SbLimit[5] PROGMEM = { 27, 30, 8, 12, 30 };
+const uint8_t mp2SbAllocTab[5][30] PROGMEM = {
+    { 7, 7, 7, 6, 6, 6, 6, 6, 6, 6, 6, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 0, 0, 0, 0 },
+    { 7, 7, 7, 6, 6, 6, 6, 6, 6, 6, 6, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 0, 0, 0, 0, 0, 0, 0 },
+    { 5, 5, 2, 2, 2, 2, 2, 2 },
+    { 5, 5, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 },
+    { 4, 4, 4, 4, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
+};
+
+/* format = Q24, scalefactor 2^(1 - i/3), i = 63 is not allowed (decoded as 0) */
+const int mp2ScaleFact[64] PROGMEM = {
+    0x02000000, 0x01965fea, 0x01428a30, 0x01000000, 0x00cb2ff5, 0x00a14518, 0x00800000, 0x006597fb,
+    0x0050a28c, 0x00400000, 0x0032cbfd, 0x00285146, 0x00200000, 0x001965ff, 0x001428a3, 0x00100000,
+    0x000cb2ff, 0x000a1451, 0x00080000, 0x00065980, 0x00050a29, 0x00040000, 0x00032cc0, 0x00028514,
+    0x00020000, 0x00019660, 0x0001428a, 0x00010000, 0x0000cb30, 0x0000a145, 0x00008000, 0x00006598,
+    0x000050a3, 0x00004000, 0x000032cc, 0x00002851, 0x00002000, 0x00001966, 0x00001429, 0x00001000,
+    0x00000cb3, 0x00000a14, 0x00000800, 0x00000659, 0x0000050a, 0x00000400, 0x0000032d, 0x00000285,
+    0x00000200, 0x00000196, 0x00000143, 0x00000100, 0x000000cb, 0x000000a1, 0x00000080, 0x00000066,
+    0x00000051, 0x00000040, 0x00000033, 0x00000028, 0x00000020, 0x00000019, 0x00000014, 0x00000000,
+};
+
 /* indexing = [version][sampleRate][long (.l) or short (.s) block]
  *   sfBandTable[v][s].l[cb] = index of first bin in critical band cb (long blocks)
  *   sfBandTable[v][s].s[cb] = index of first bin in critical band cb (short blocks)
@@ -461,16 +519,22 @@ int  MP3Decode( unsigned char *inbuf, int *bytesLeft, short *outbuf, int useSize
 void MP3GetLastFrameInfo();
 int  MP3GetNextFrameInfo(unsigned char *buf);
 int  MP3FindSyncWord(unsigned char *buf, int nBytes);
+int  MP3GetFrameBytes(unsigned char *buf);
+int  MP3ResyncNextFrame(unsigned char *buf, int nBytes);
+int  MP3ConcealFrame(short *outbuf);
 int  MP3GetSampRate();
 int  MP3GetChannels();
 int  MP3GetBitsPerSample();
 int  MP3GetBitrate();
 int  MP3GetOutputSamps();
+void MP3Decoder_SetDownmix(bool mono);
+void MP3Decoder_SetRateDivider(uint8_t divider);
 
 //internally used
 void MP3Decoder_ClearBuffer(void);
 void PolyphaseMono(short *pcm, int *vbuf, const uint32_t *coefBase);
 void PolyphaseStereo(short *pcm, int *vbuf, const uint32_t *coefBase);
+void PolyphaseReduced(short *pcm, int *vbuf, const uint32_t *coefBase, int nChans, int rateShift);
 void SetBitstreamPointer(BitStreamInfo_t *bsi, int nBytes, unsigned char *buf);
 unsigned int GetBits(BitStreamInfo_t *bsi, int nBits);
 int CalcBitsUsed(BitStreamInfo_t *bsi, unsigned char *startBuf, int startOffset);
@@ -479,6 +543,8 @@ void MidSideProc(int x[m_MAX_NCHAN][m_MAX_NSAMP], int nSamps, int mOut[2]);
 void IntensityProcMPEG1(int x[m_MAX_NCHAN][m_MAX_NSAMP], int nSamps, ScaleFactorInfoSub_t *sfis,	CriticalBandInfo_t *cbi, int midSideFlag, int mixFlag, int mOut[2]);
 void IntensityProcMPEG2(int x[m_MAX_NCHAN][m_MAX_NSAMP], int nSamps, ScaleFactorInfoSub_t *sfis, CriticalBandInfo_t *cbi, ScaleFactorJS_t *sfjs, int midSideFlag, int mixFlag, int mOut[2]);
 void FDCT32(int *x, int *d, int offset, int oddBlock, int gb);// __attribute__ ((section (".data")));
+void FDCT32Zero(int *d, int offset, int oddBlock);
+void FDCT32Reduced(int *x, int *d, int offset, int oddBlock, int gb, int rateShift);
 void FreeBuffers();
 int CheckPadBit();
 int UnpackFrameHeader(unsigned char *buf);
@@ -487,15 +553,24 @@ int DecodeHuffman( unsigned char *buf, int *bitOffset, int huffBlockBits, int gr
 int MP3Dequantize( int gr);
 int IMDCT( int gr, int ch);
 int UnpackScaleFactors( unsigned char *buf, int *bitOffset, int bitsAvail, int gr, int ch);
-int Subband(short *pcmBuf);
+int Subband(short *pcmBuf, int nChans);
+int MP2Decode(unsigned char *inbuf, int *bytesLeft, short *outbuf, int fhBytes);
+int IMDCTDownmix(int gr);
 short ClipToShort(int x, int fracBits);
 void RefillBitstreamCache(BitStreamInfo_t *bsi);
 void UnpackSFMPEG1(BitStreamInfo_t *bsi, SideInfoSub_t *sis, ScaleFactorInfoSub_t *sfis, int *scfsi, int gr, ScaleFactorInfoSub_t *sfisGr0);
 void UnpackSFMPEG2(BitStreamInfo_t *bsi, SideInfoSub_t *sis, ScaleFactorInfoSub_t *sfis, int gr, int ch, int modeExt, ScaleFactorJS_t *sfjs);
 int MP3FindFreeSync(unsigned char *buf, unsigned char firstFH[4], int nBytes);
+int MP3ScanSyncWord(unsigned char *buf, int nBytes);
+int MP3CheckSyncFrames(unsigned char *buf, int nBytes);
 void MP3ClearBadFrame( short *outbuf);
+void MP3ConcealUpdate(short *outbuf);
 int DecodeHuffmanPairs(int *xy, int nVals, int tabIdx, int bitsLeft, unsigned char *buf, int bitOffset);
 int DecodeHuffmanQuads(int *vwxy, int nVals, int tabIdx, int bitsLeft, unsigned char *buf, int bitOffset);
+#ifdef MP3_HUFFMAN_LUT
+bool MP3Decoder_BuildHuffmanLUT();
+int DecodeHuffmanPairsLUT(int *xy, int *nVals, int tabIdx, int bitsLeft, unsigned char *buf, int bitOffset);
+#endif
 int DequantBlock(int *inbuf, int *outbuf, int num, int scale);
 void AntiAlias(int *x, int nBfly);
 void WinPrevious(int *xPrev, int *xPrevWin, int btPrev);
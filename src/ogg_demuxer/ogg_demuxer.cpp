@@ -0,0 +1,337 @@
+/*
+ * ogg_demuxer.cpp
+ * Ogg page layer, shared by the FLAC, OPUS and VORBIS decoder
+ * reference https://www.xiph.org/ogg/doc/rfc3533.txt
+ *
+ *  Created on: 19.10.2026
+ *
+ * OGGGetPacket() reads the pages and hands out one packet per call. A packet that lies completely in the input
+ * window is not copied, the codec decodes it in place. Packets that span pages (or the window) are collected in
+ * s_oggPacketBuff. The codec reports the used bytes with OGGPacketUsed(), a packet that is not used up (OPUS code 3,
+ * one frame per call) is handed out again with the next call.
+ */
+#include "ogg_demuxer.h"
+
+// prefer PSRAM
+#define __realloc_heap_psram(ptr, size) \
+    heap_caps_realloc_prefer(ptr, size, 2, MALLOC_CAP_DEFAULT|MALLOC_CAP_SPIRAM, MALLOC_CAP_DEFAULT|MALLOC_CAP_INTERNAL)
+
+// global vars
+uint8_t  *s_oggPacketBuff = NULL;
+uint32_t  s_oggPacketBuffSize = 0;
+uint32_t  s_oggPacketLen = 0;          // bytes collected in s_oggPacketBuff
+uint32_t  s_oggPacketPos = 0;          // bytes of the collected packet used by the codec
+uint32_t  s_oggPendingLen = 0;         // bytes of the handed out packet the codec has not used yet
+bool      s_f_oggPendingInBuff = false;
+bool      s_f_oggPartial = false;      // s_oggPacketBuff holds the head of a packet, the rest follows
+bool      s_f_oggDropRun = false;      // the head of the current packet is lost (resync), skip the rest
+bool      s_f_oggTruncated = false;
+bool      s_f_oggInPage = false;
+bool      s_f_oggInRun = false;        // a segment run is being copied or skipped
+bool      s_f_oggRunEnds = false;      // the current segment run ends with a lacing value < 255
+uint8_t   s_oggSegTable[255];
+uint8_t   s_oggSegCount = 0;
+uint16_t  s_oggSegIdx = 0;
+uint32_t  s_oggRunLeft = 0;            // bytes of the current segment run not read yet
+uint32_t  s_oggSkipLeft = 0;           // bytes of a page of another logical bitstream not skipped yet
+bool      s_f_oggCrcRunning = false;   // the page is larger than the window, the CRC is built while reading
+uint32_t  s_oggCrc = 0;
+uint32_t  s_oggPageCrc = 0;
+uint32_t  s_oggCrcErrors = 0;
+uint32_t  s_oggSerial = 0;
+uint32_t  s_oggPagesSeen = 0;
+bool      s_f_oggBosGroup = false;     // only BOS pages so far, further BOS pages are multiplexed streams
+bool      s_f_oggIgnoreSerial = false;
+uint32_t  s_oggIgnoreSerial = 0;       // chained stream rejected by OGGSkipStream()
+uint32_t  s_oggNewSerial = 0;
+
+//----------------------------------------------------------------------------------------------------------------------
+// polynomial 0x04C11DB7, not reflected
+const uint32_t oggCrcTable[256] = {
+    0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
+    0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61, 0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD,
+    0x4C11DB70, 0x48D0C6C7, 0x4593E01E, 0x4152FDA9, 0x5F15ADAC, 0x5BD4B01B, 0x569796C2, 0x52568B75,
+    0x6A1936C8, 0x6ED82B7F, 0x639B0DA6, 0x675A1011, 0x791D4014, 0x7DDC5DA3, 0x709F7B7A, 0x745E66CD,
+    0x9823B6E0, 0x9CE2AB57, 0x91A18D8E, 0x95609039, 0x8B27C03C, 0x8FE6DD8B, 0x82A5FB52, 0x8664E6E5,
+    0xBE2B5B58, 0xBAEA46EF, 0xB7A96036, 0xB3687D81, 0xAD2F2D84, 0xA9EE3033, 0xA4AD16EA, 0xA06C0B5D,
+    0xD4326D90, 0xD0F37027, 0xDDB056FE, 0xD9714B49, 0xC7361B4C, 0xC3F706FB, 0xCEB42022, 0xCA753D95,
+    0xF23A8028, 0xF6FB9D9F, 0xFBB8BB46, 0xFF79A6F1, 0xE13EF6F4, 0xE5FFEB43, 0xE8BCCD9A, 0xEC7DD02D,
+    0x34867077, 0x30476DC0, 0x3D044B19, 0x39C556AE, 0x278206AB, 0x23431B1C, 0x2E003DC5, 0x2AC12072,
+    0x128E9DCF, 0x164F8078, 0x1B0CA6A1, 0x1FCDBB16, 0x018AEB13, 0x054BF6A4, 0x0808D07D, 0x0CC9CDCA,
+    0x7897AB07, 0x7C56B6B0, 0x71159069, 0x75D48DDE, 0x6B93DDDB, 0x6F52C06C, 0x6211E6B5, 0x66D0FB02,
+    0x5E9F46BF, 0x5A5E5B08, 0x571D7DD1, 0x53DC6066, 0x4D9B3063, 0x495A2DD4, 0x44190B0D, 0x40D816BA,
+    0xACA5C697, 0xA864DB20, 0xA527FDF9, 0xA1E6E04E, 0xBFA1B04B, 0xBB60ADFC, 0xB6238B25, 0xB2E29692,
+    0x8AAD2B2F, 0x8E6C3698, 0x832F1041, 0x87EE0DF6, 0x99A95DF3, 0x9D684044, 0x902B669D, 0x94EA7B2A,
+    0xE0B41DE7, 0xE4750050, 0xE9362689, 0xEDF73B3E, 0xF3B06B3B, 0xF771768C, 0xFA325055, 0xFEF34DE2,
+    0xC6BCF05F, 0xC27DEDE8, 0xCF3ECB31, 0xCBFFD686, 0xD5B88683, 0xD1799B34, 0xDC3ABDED, 0xD8FBA05A,
+    0x690CE0EE, 0x6DCDFD59, 0x608EDB80, 0x644FC637, 0x7A089632, 0x7EC98B85, 0x738AAD5C, 0x774BB0EB,
+    0x4F040D56, 0x4BC510E1, 0x46863638, 0x42472B8F, 0x5C007B8A, 0x58C1663D, 0x558240E4, 0x51435D53,
+    0x251D3B9E, 0x21DC2629, 0x2C9F00F0, 0x285E1D47, 0x36194D42, 0x32D850F5, 0x3F9B762C, 0x3B5A6B9B,
+    0x0315D626, 0x07D4CB91, 0x0A97ED48, 0x0E56F0FF, 0x1011A0FA, 0x14D0BD4D, 0x19939B94, 0x1D528623,
+    0xF12F560E, 0xF5EE4BB9, 0xF8AD6D60, 0xFC6C70D7, 0xE22B20D2, 0xE6EA3D65, 0xEBA91BBC, 0xEF68060B,
+    0xD727BBB6, 0xD3E6A601, 0xDEA580D8, 0xDA649D6F, 0xC423CD6A, 0xC0E2D0DD, 0xCDA1F604, 0xC960EBB3,
+    0xBD3E8D7E, 0xB9FF90C9, 0xB4BCB610, 0xB07DABA7, 0xAE3AFBA2, 0xAAFBE615, 0xA7B8C0CC, 0xA379DD7B,
+    0x9B3660C6, 0x9FF77D71, 0x92B45BA8, 0x9675461F, 0x8832161A, 0x8CF30BAD, 0x81B02D74, 0x857130C3,
+    0x5D8A9099, 0x594B8D2E, 0x5408ABF7, 0x50C9B640, 0x4E8EE645, 0x4A4FFBF2, 0x470CDD2B, 0x43CDC09C,
+    0x7B827D21, 0x7F436096, 0x7200464F, 0x76C15BF8, 0x68860BFD, 0x6C47164A, 0x61043093, 0x65C52D24,
+    0x119B4BE9, 0x155A565E, 0x18197087, 0x1CD86D30, 0x029F3D35, 0x065E2082, 0x0B1D065B, 0x0FDC1BEC,
+    0x3793A651, 0x3352BBE6, 0x3E119D3F, 0x3AD08088, 0x2497D08D, 0x2056CD3A, 0x2D15EBE3, 0x29D4F654,
+    0xC5A92679, 0xC1683BCE, 0xCC2B1D17, 0xC8EA00A0, 0xD6AD50A5, 0xD26C4D12, 0xDF2F6BCB, 0xDBEE767C,
+    0xE3A1CBC1, 0xE760D676, 0xEA23F0AF, 0xEEE2ED18, 0xF0A5BD1D, 0xF464A0AA, 0xF9278673, 0xFDE69BC4,
+    0x89B8FD09, 0x8D79E0BE, 0x803AC667, 0x84FBDBD0, 0x9ABC8BD5, 0x9E7D9662, 0x933EB0BB, 0x97FFAD0C,
+    0xAFB010B1, 0xAB710D06, 0xA6322BDF, 0xA2F33668, 0xBCB4666D, 0xB8757BDA, 0xB5365D03, 0xB1F740B4,
+};
+//----------------------------------------------------------------------------------------------------------------------
+//          O G G   D E M U X E R
+//----------------------------------------------------------------------------------------------------------------------
+static void oggResetPacket(){ // forget everything that belongs to the current page
+    s_oggPacketLen = 0;
+    s_oggPacketPos = 0;
+    s_oggPendingLen = 0;
+    s_f_oggPartial = false;
+    s_f_oggDropRun = false;
+    s_f_oggTruncated = false;
+    s_f_oggInPage = false;
+    s_f_oggInRun = false;
+    s_oggSegCount = 0;
+    s_oggSegIdx = 0;
+    s_oggRunLeft = 0;
+    s_oggSkipLeft = 0;
+    s_f_oggCrcRunning = false;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void OGGDemuxer_ClearBuffer(){ // new logical bitstream, the packet buffer is kept
+    oggResetPacket();
+    s_oggCrcErrors = 0;
+    s_oggSerial = 0;
+    s_oggPagesSeen = 0;
+    s_f_oggBosGroup = false;
+    s_f_oggIgnoreSerial = false;
+    s_oggNewSerial = 0;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void OGGDemuxer_FreeBuffers(){
+    if(s_oggPacketBuff) {free(s_oggPacketBuff); s_oggPacketBuff = NULL;}
+    s_oggPacketBuffSize = 0;
+    OGGDemuxer_ClearBuffer();
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t OGGcrc32(uint32_t crc, const uint8_t *buf, int len){ // initialized with 0, no final xor
+    while(len-- > 0) crc = (crc << 8) ^ oggCrcTable[(crc >> 24) ^ *buf++];
+    return crc;
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t OGGGetCRCErrors(){ // pages with a CRC mismatch since the stream was set up
+    return s_oggCrcErrors;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int OGGFindSyncWord(uint8_t *buf, int nBytes){
+    for(int i = 0; i < nBytes - 4; i++){
+        if(buf[i] == 'O' && buf[i + 1] == 'g' && buf[i + 2] == 'g' && buf[i + 3] == 'S' && buf[i + 4] == 0){ // version 0
+            oggResetPacket(); // a packet continued from the page before is incomplete now
+            return i;
+        }
+    }
+    return ERR_OGG_SYNC_NOT_FOUND;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void OGGSkipStream(){ // the codec of the chained stream is not supported, stay with the current one
+    s_f_oggIgnoreSerial = true;
+    s_oggIgnoreSerial = s_oggNewSerial;
+}
+//----------------------------------------------------------------------------------------------------------------------
+static void oggAppend(const uint8_t *buf, uint32_t n){
+    if(s_oggPacketLen + n > s_oggPacketBuffSize && s_oggPacketBuffSize < OGG_MAX_PACKET_SIZE){
+        uint32_t size = (s_oggPacketLen + n + OGG_PACKET_BUFF_STEP - 1) / OGG_PACKET_BUFF_STEP * OGG_PACKET_BUFF_STEP;
+        if(size > OGG_MAX_PACKET_SIZE) size = OGG_MAX_PACKET_SIZE;
+        uint8_t *tmp = (uint8_t*)__realloc_heap_psram(s_oggPacketBuff, size);
+        if(tmp) {s_oggPacketBuff = tmp; s_oggPacketBuffSize = size;}
+        else log_e("not enough memory for the ogg packet buffer, %lu bytes", (unsigned long)size);
+    }
+    uint32_t room = s_oggPacketBuffSize - s_oggPacketLen;
+    if(n > room){
+        if(!s_f_oggTruncated) log_w("ogg packet too big, truncated to %lu bytes", (unsigned long)s_oggPacketBuffSize);
+        s_f_oggTruncated = true;
+        n = room;
+    }
+    memcpy(s_oggPacketBuff + s_oggPacketLen, buf, n);
+    s_oggPacketLen += n;
+}
+//----------------------------------------------------------------------------------------------------------------------
+static void oggPageEnd(){
+    if(s_f_oggCrcRunning && s_oggCrc != s_oggPageCrc){ // too late to drop the page, its packets are decoded already
+        s_oggCrcErrors++;
+        log_w("ogg page CRC mismatch");
+    }
+    s_f_oggCrcRunning = false;
+    s_f_oggInPage = false;
+}
+//----------------------------------------------------------------------------------------------------------------------
+static int oggParsePage(uint8_t *inbuf, int nBytes, int *pos){ // page header at inbuf[0]
+
+    if(nBytes < 27) return OGG_PARSE_DONE; // end of file
+    if(inbuf[0] != 'O' || inbuf[1] != 'g' || inbuf[2] != 'g' || inbuf[3] != 'S' || inbuf[4] != 0){
+        return ERR_OGG_SYNC_NOT_FOUND;
+    }
+    uint8_t  headerType    = inbuf[5];
+    uint32_t serial        = inbuf[14] + (inbuf[15] << 8) + (inbuf[16] << 16) + ((uint32_t)inbuf[17] << 24);
+    uint32_t pageCrc       = inbuf[22] + (inbuf[23] << 8) + (inbuf[24] << 16) + ((uint32_t)inbuf[25] << 24);
+    uint8_t  pageSegments  = inbuf[26];
+    int      headerSize    = 27 + pageSegments;
+    if(nBytes < headerSize) return OGG_PARSE_DONE; // end of file
+
+    uint32_t bodySize = 0;
+    for(int i = 0; i < pageSegments; i++) bodySize += inbuf[27 + i];
+
+    bool continuedPage = headerType & 0x01; // set: page contains data of a packet continued from the previous page
+    bool firstPage     = headerType & 0x02; // set: this is the first page of a logical bitstream (bos)
+
+    const uint8_t zero[4] = {0, 0, 0, 0};   // the CRC is calculated with the CRC field set to 0
+    uint32_t crc = OGGcrc32(0, inbuf, 22);
+    crc = OGGcrc32(crc, zero, 4);
+    crc = OGGcrc32(crc, inbuf + 26, headerSize - 26);
+    s_f_oggCrcRunning = false;
+    if((uint32_t)nBytes >= headerSize + bodySize){ // the whole page is in the window, check it before using it
+        if(OGGcrc32(crc, inbuf + headerSize, bodySize) != pageCrc){
+            s_oggCrcErrors++;
+            return ERR_OGG_CRC_MISMATCH;
+        }
+    }
+    else{
+        s_f_oggCrcRunning = true;
+        s_oggCrc = crc;
+        s_oggPageCrc = pageCrc;
+    }
+
+    if(!firstPage) s_f_oggBosGroup = false;
+    if(firstPage && s_oggPagesSeen && !s_f_oggBosGroup && !(s_f_oggIgnoreSerial && serial == s_oggIgnoreSerial)){
+        s_f_oggCrcRunning = false;
+        s_oggNewSerial = serial;
+        return OGG_NEW_STREAM; // chained stream, the codec may change
+    }
+    if(s_oggPagesSeen && serial != s_oggSerial){ // other logical bitstream (multiplexed or rejected), skip the page
+        s_f_oggCrcRunning = false;
+        uint32_t n = headerSize + bodySize;
+        if(n > (uint32_t)nBytes) n = nBytes;
+        s_oggSkipLeft = headerSize + bodySize - n;
+        *pos = n;
+        return OGG_PARSE_DONE;
+    }
+    if(!s_oggPagesSeen){
+        s_oggSerial = serial;
+        s_f_oggBosGroup = firstPage;
+    }
+    s_oggPagesSeen++;
+
+    memcpy(s_oggSegTable, inbuf + 27, pageSegments);
+    s_oggSegCount = pageSegments;
+    s_oggSegIdx = 0;
+    if(continuedPage && !s_f_oggPartial) s_f_oggDropRun = true; // the head of the packet was not seen
+    if(!continuedPage && s_f_oggPartial){
+        log_w("ogg packet incomplete, dropped");
+        s_f_oggPartial = false;
+        s_oggPacketLen = 0;
+    }
+    s_f_oggInPage = true;
+    *pos = headerSize;
+    return ERR_OGG_NONE;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int OGGGetPacket(uint8_t *inbuf, int *bytesLeft, uint8_t **packet, int *packetLen){
+    // inbuf[0] is the first byte that is not consumed yet, *bytesLeft is reduced by the consumed bytes
+    // return: ERR_OGG_NONE   *packet and *packetLen are valid, report the used bytes with OGGPacketUsed()
+    //         OGG_PARSE_DONE nothing to decode, call again with the remaining data
+    //         OGG_NEW_STREAM BOS page of a chained stream at inbuf[0], the codec must be determined again
+    //         < 0            error, nothing consumed, resync with OGGFindSyncWord()
+
+    int nBytes = *bytesLeft;
+    int pos = 0;
+
+    if(s_oggPendingLen){ // the codec has not used the whole packet yet
+        *packet = s_f_oggPendingInBuff ? s_oggPacketBuff + s_oggPacketPos : inbuf;
+        *packetLen = s_oggPendingLen;
+        return ERR_OGG_NONE;
+    }
+    if(s_oggSkipLeft){
+        pos = min((uint32_t)nBytes, s_oggSkipLeft);
+        s_oggSkipLeft -= pos;
+        *bytesLeft -= pos;
+        return OGG_PARSE_DONE;
+    }
+
+    while(true){
+        if(s_f_oggInPage && !s_f_oggInRun && s_oggSegIdx >= s_oggSegCount) oggPageEnd();
+        if(!s_f_oggInPage){
+            if(pos > 0) break; // the next page header is read at inbuf[0] of the next call
+            int ret = oggParsePage(inbuf, nBytes, &pos);
+            if(ret != ERR_OGG_NONE) {*bytesLeft -= pos; return ret;}
+            continue;
+        }
+        if(s_f_oggInRun){ // copy (or skip) a packet that spans pages or doesn't fit into the window
+            uint32_t n = min((uint32_t)(nBytes - pos), s_oggRunLeft);
+            if(s_f_oggCrcRunning) s_oggCrc = OGGcrc32(s_oggCrc, inbuf + pos, n);
+            if(!s_f_oggDropRun) oggAppend(inbuf + pos, n);
+            pos += n;
+            s_oggRunLeft -= n;
+            if(s_oggRunLeft) break; // window exhausted
+            s_f_oggInRun = false;
+            if(!s_f_oggRunEnds) continue; // the packet is continued on the next page
+            if(s_f_oggDropRun) {s_f_oggDropRun = false; continue;}
+            s_f_oggPartial = false;
+            s_f_oggTruncated = false;
+            if(!s_oggPacketLen) continue;
+            s_oggPacketPos = 0;
+            s_oggPendingLen = s_oggPacketLen;
+            s_f_oggPendingInBuff = true;
+            *packet = s_oggPacketBuff;
+            *packetLen = s_oggPacketLen;
+            *bytesLeft -= pos;
+            return ERR_OGG_NONE;
+        }
+        // next segment run, that is a packet or a part of it
+        uint32_t runLen = 0;
+        bool     runEnds = false;
+        uint16_t i = s_oggSegIdx;
+        while(i < s_oggSegCount){
+            runLen += s_oggSegTable[i];
+            if(s_oggSegTable[i++] < 255) {runEnds = true; break;}
+        }
+        if(runEnds && !s_f_oggPartial && !s_f_oggDropRun){
+            if(!runLen) {s_oggSegIdx = i; continue;} // empty packet
+            if(runLen <= (uint32_t)(nBytes - pos)){ // zero copy, the bytes are consumed in OGGPacketUsed()
+                s_oggSegIdx = i;
+                s_oggPendingLen = runLen;
+                s_f_oggPendingInBuff = false;
+                *packet = inbuf + pos;
+                *packetLen = runLen;
+                *bytesLeft -= pos;
+                return ERR_OGG_NONE;
+            }
+            if(pos > 0) break; // maybe it fits at inbuf[0] of the next call
+        }
+        s_oggSegIdx = i;
+        s_oggRunLeft = runLen;
+        s_f_oggRunEnds = runEnds;
+        s_f_oggInRun = true;
+        if(!s_f_oggDropRun) s_f_oggPartial = true;
+    }
+    *bytesLeft -= pos;
+    return OGG_PARSE_DONE;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void OGGPacketUsed(uint8_t *packet, int used, int *bytesLeft){
+    // used: bytes of the packet the codec has decoded, the rest is handed out again by OGGGetPacket()
+    if(used <= 0 || (uint32_t)used > s_oggPendingLen) used = s_oggPendingLen;
+    if(s_f_oggPendingInBuff){
+        s_oggPacketPos += used;
+    }
+    else{
+        if(s_f_oggCrcRunning) s_oggCrc = OGGcrc32(s_oggCrc, packet, used);
+        *bytesLeft -= used;
+    }
+    s_oggPendingLen -= used;
+    if(!s_oggPendingLen && s_f_oggPendingInBuff){
+        s_oggPacketLen = 0;
+        s_oggPacketPos = 0;
+    }
+}
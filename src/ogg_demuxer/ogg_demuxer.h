@@ -0,0 +1,33 @@
+/*
+ * ogg_demuxer.h
+ * Ogg page layer, shared by the FLAC, OPUS and VORBIS decoder
+ * reference https://www.xiph.org/ogg/doc/rfc3533.txt
+ *
+ *  Created on: 19.10.2026
+ *
+ *  Restrictions:
+ *  one logical bitstream at a time, pages of other serial numbers are skipped
+ *  packets larger than OGG_MAX_PACKET_SIZE are truncated
+ *
+ */
+#pragma once
+
+#include "Arduino.h"
+
+#define OGG_MAX_PACKET_SIZE  65535 // packet buffer limit, vorbis setup headers can be large
+#define OGG_PACKET_BUFF_STEP  4096 // the packet buffer grows in steps, only packets that span pages are copied
+
+enum : int8_t  {OGG_NEW_STREAM = 101,     // BOS page of a chained stream at pos 0, nothing consumed
+                OGG_PARSE_DONE = 100,     // header or page data consumed, no packet yet
+                ERR_OGG_NONE = 0,         // packet available
+                ERR_OGG_SYNC_NOT_FOUND = -1,
+                ERR_OGG_CRC_MISMATCH = -2};
+
+void     OGGDemuxer_ClearBuffer();
+void     OGGDemuxer_FreeBuffers();
+int      OGGFindSyncWord(uint8_t *buf, int nBytes);
+int      OGGGetPacket(uint8_t *inbuf, int *bytesLeft, uint8_t **packet, int *packetLen);
+void     OGGPacketUsed(uint8_t *packet, int used, int *bytesLeft);
+void     OGGSkipStream();
+uint32_t OGGGetCRCErrors();
+uint32_t OGGcrc32(uint32_t crc, const uint8_t *buf, int len);
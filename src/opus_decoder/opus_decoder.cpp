@@ -12,31 +12,23 @@
 #include "celt.h"
 
 // global vars
-bool      s_f_opusSubsequentPage = false;
-bool      s_f_opusParseOgg = false;
 bool      s_f_newSteamTitle = false;  // streamTitle
-bool      s_f_opusFramePacket = false;
 bool      s_f_opusStereoFlag = false;
 uint8_t   s_opusChannels = 0;
 uint8_t   s_opusCountCode =  0;
 uint16_t  s_opusSamplerate = 0;
-uint32_t  s_opusSegmentLength = 0;
 char     *s_opusChbuf = NULL;
 int32_t   s_opusValidSamples = 0;
 
-uint16_t *s_opusSegmentTable;
-uint8_t   s_opusSegmentTableSize = 0;
-int16_t   s_opusSegmentTableRdPtr = -1;
 int8_t    s_opusError = 0;
 float     s_opusCompressionRatio = 0;
 
 bool OPUSDecoder_AllocateBuffers(){
     const uint32_t CELT_SET_END_BAND_REQUEST = 10012;
     const uint32_t CELT_SET_SIGNALLING_REQUEST = 10016;
-    s_opusChbuf = (char*)malloc(512);
+    if(!s_opusChbuf) s_opusChbuf = (char*)malloc(512);
+    if(!s_opusChbuf) {log_e("CELT not init"); return false;}
     if(!CELTDecoder_AllocateBuffers()) {log_e("CELT not init"); return false;}
-    s_opusSegmentTable = (uint16_t*)malloc(256 * sizeof(uint16_t));
-    if(!s_opusSegmentTable) {log_e("CELT not init"); return false;}
     CELTDecoder_ClearBuffer();
     OPUSDecoder_ClearBuffers();
     s_opusError = celt_decoder_init(2); if(s_opusError < 0) {log_e("CELT not init"); return false;}
@@ -47,25 +39,17 @@ bool OPUSDecoder_AllocateBuffers(){
 }
 void OPUSDecoder_FreeBuffers(){
     if(s_opusChbuf)        {free(s_opusChbuf);        s_opusChbuf = NULL;}
-    if(s_opusSegmentTable) {free(s_opusSegmentTable); s_opusSegmentTable = NULL;}
     CELTDecoder_FreeBuffers();
 }
 void OPUSDecoder_ClearBuffers(){
     if(s_opusChbuf)        memset(s_opusChbuf, 0, 512);
-    if(s_opusSegmentTable) memset(s_opusSegmentTable, 0, 256 * sizeof(int16_t));
 }
 void OPUSsetDefaults(){
-    s_f_opusSubsequentPage = false;
-    s_f_opusParseOgg = false;
     s_f_newSteamTitle = false;  // streamTitle
-    s_f_opusFramePacket = false;
     s_f_opusStereoFlag = false;
     s_opusChannels = 0;
     s_opusSamplerate = 0;
-    s_opusSegmentLength = 0;
     s_opusValidSamples = 0;
-    s_opusSegmentTableSize = 0;
-    s_opusSegmentTableRdPtr = -1;
     s_opusCountCode = 0;
 
     s_opusError = 0;
@@ -74,36 +58,32 @@ void OPUSsetDefaults(){
 //----------------------------------------------------------------------------------------------------------------------
 
 int OPUSDecode(uint8_t *inbuf, int *bytesLeft, short *outbuf){
+    // inbuf is one Ogg packet (see ogg_demuxer), *bytesLeft its length. A packet with more than one frame (code 1, 2, 3) is decoded
+    // frame by frame, *bytesLeft gives back the bytes of the frames that follow, the packet is handed over again with the rest
 
     static uint16_t fs = 0;
     static uint8_t M = 0;
     static uint16_t paddingBytes = 0;
-    uint8_t paddingLength = 0;
+    static uint16_t frameSizes[48];
+    static uint8_t frameIdx = 0;
     static uint16_t samplesPerFrame = 0;
     int ret = ERR_OPUS_NONE;
-    int len = 0;
-
-    if(s_f_opusParseOgg){
-        fs = 0;
-        M = 0;
-        paddingBytes = 0;
-        s_opusCountCode = 0;
-        ret = OPUSparseOGG(inbuf, bytesLeft);
-        if(ret == ERR_OPUS_NONE) return OPUS_PARSE_OGG_DONE; // ok
-        else return ret;  // error
-    }
+    int len = *bytesLeft;
 
     if(s_opusCountCode > 0) goto FramePacking; // more than one frame in the packet
 
-    if(s_f_opusFramePacket){
-        if(s_opusSegmentTableSize > 0){
-            s_opusSegmentTableRdPtr++;
-            s_opusSegmentTableSize--;
-            len = s_opusSegmentTable[s_opusSegmentTableRdPtr];
-        }
-        parseOpusTOC(inbuf[0]);
-        samplesPerFrame = opus_packet_get_samples_per_frame(inbuf, s_opusSamplerate);
+    if(len >= 16 && inbuf[0] == 'O'){ // OpusHead or OpusTags, the TOC byte of an audio packet can't be 'O' (SILK)
+        ret = parseOpusHead(inbuf, len);
+        if(ret == 0) ret = parseOpusComment(inbuf, len);
+        if(ret == 1) {*bytesLeft = 0; return OPUS_PARSE_OGG_DONE;}
+        if(ret < 0) return ret;
     }
+    if(len < 1) return OPUS_PARSE_OGG_DONE; // nothing to decode
+    s_opusValidSamples = 0;
+    s_opusCompressionRatio = (float)(960 * 2) / len;  // const 960 validBytes out
+    parseOpusTOC(inbuf[0]);
+    M = 0; // a new packet, a code 1..3 packet reads its frame lengths first
+    samplesPerFrame = opus_packet_get_samples_per_frame(inbuf, s_opusSamplerate);
 
 FramePacking:            // https://www.tech-invite.com/y65/tinv-ietf-rfc-6716-2.html   3.2. Frame Packing
 
@@ -119,47 +99,22 @@ FramePacking:            // https://www.tech-invite.com/y65/tinv-ietf-rfc-6716-2
             ret = ERR_OPUS_NONE;
             break;
         case 1:  // Code 1: Two Frames in the Packet, Each with Equal Compressed Size
-            log_e("OPUS countCode 1 not supported yet"); vTaskDelay(1000); // todo
-            break;
         case 2:  // Code 2: Two Frames in the Packet, with Different Compressed Sizes
-            log_e("OPUS countCode 2 not supported yet"); vTaskDelay(1000); // todo
-            break;
-        case 3: // Code 3: A Signaled Number of Frames in the Packet
-            if(M == 0){
-                bool v = ((inbuf[1] & 0x80) == 0x80);  // VBR indicator
-                if(v != 0) {log_e("OPUS countCode 3 with VBR not supported yet"); vTaskDelay(1000);} // todo
-                bool p = ((inbuf[1] & 0x40) == 0x40);  // padding bit
-                M = inbuf[1] & 0x3F;           // max framecount
-            //    log_i("v %i, p %i, M %i", v, p, M);
-                *bytesLeft -= 2;
-                len        -= 2;
-                inbuf      += 2;
-
-                if(p){
-                    paddingBytes = 0;
-                    paddingLength = 1;
-
-                    int i = 0;
-                    while(inbuf[i] == 255){
-                        paddingBytes += inbuf[i];
-                        i++;
-                    }
-                    paddingBytes += inbuf[i];
-                    paddingLength += i;
-
-                    *bytesLeft -= paddingLength;
-                    len        -= paddingLength;
-                    inbuf      += paddingLength;
-                }
-                    fs = (len - paddingBytes) / M;
+        case 3:  // Code 3: A Signaled Number of Frames in the Packet
+            if(M == 0){ // first frame, read the frame lengths and the padding in front of it
+                int hdrBytes = parseOpusFramePacking(inbuf, len, frameSizes, &M, &paddingBytes);
+                if(hdrBytes < 0) {ret = ERR_OPUS_DECODER_ASYNC; goto exit;} // damaged packet
+                *bytesLeft -= hdrBytes;
+                inbuf      += hdrBytes;
+                frameIdx = 0;
             }
+            fs = frameSizes[frameIdx++];
             *bytesLeft -= fs;
             ec_dec_init((uint8_t *)inbuf, fs);
             ret = celt_decode_with_ec(inbuf, fs, (int16_t*)outbuf, samplesPerFrame);
             if(ret < 0) goto exit; // celt error
             s_opusValidSamples = ret;
             M--;
-         //   log_i("M %i fs %i spf %i", M, fs, samplesPerFrame);
             ret = ERR_OPUS_NONE;
             if(M == 0) {s_opusCountCode = 0; *bytesLeft -= paddingBytes; paddingBytes = 0; goto exit;}
             return ret;
@@ -171,11 +126,8 @@ FramePacking:            // https://www.tech-invite.com/y65/tinv-ietf-rfc-6716-2
     }
 
 exit:
-    if(s_opusSegmentTableSize== 0){
-        s_opusSegmentTableRdPtr = -1; // back to the parking position
-        s_f_opusFramePacket = false;
-        s_f_opusParseOgg = true;
-    }
+    if(ret < 0) {s_opusCountCode = 0; M = 0;} // the rest of the packet is lost
+    if(s_opusCountCode == 0) *bytesLeft = 0;  // packet done, padding included
     return ret;
 }
 
@@ -263,6 +215,57 @@ int parseOpusTOC(uint8_t TOC_Byte){  // https://www.rfc-editor.org/rfc/rfc6716
     return configNr;
 }
 //----------------------------------------------------------------------------------------------------------------------
+int parseOpusFramePacking(const uint8_t *inbuf, int nBytes, uint16_t *frameSizes, uint8_t *frameCount, uint16_t *paddingBytes){
+    // RFC 6716 3.2.3 .. 3.2.5, code 1, 2 and 3 packets. Returns the bytes in front of the first frame (TOC, frame count,
+    // padding length, frame lengths) or -1 if the packet is damaged. The padding follows the last frame.
+    int  pos = 1;      // TOC byte
+    int  M = 2;        // code 1, 2: two frames
+    int  padding = 0;
+    bool vbr = (s_opusCountCode == 2);
+
+    if(s_opusCountCode == 3){
+        if(nBytes < 2) return -1;
+        vbr = ((inbuf[1] & 0x80) == 0x80);          // VBR indicator
+        bool p = ((inbuf[1] & 0x40) == 0x40);       // padding bit
+        M = inbuf[1] & 0x3F;                        // frame count
+        pos = 2;
+        if(p){ // 255: 254 bytes of padding and one more length byte follows
+            uint8_t b = 255;
+            while(b == 255){
+                if(pos >= nBytes) return -1;
+                b = inbuf[pos++];
+                padding += (b == 255) ? 254 : b;
+            }
+        }
+    }
+    if(M == 0 || M > 48) return -1;
+    if(vbr){ // the lengths of all frames but the last
+        int sum = 0;
+        for(int i = 0; i < M - 1; i++){
+            if(pos >= nBytes) return -1;
+            int fl = inbuf[pos++];
+            if(fl >= 252){
+                if(pos >= nBytes) return -1;
+                fl += 4 * inbuf[pos++];
+            }
+            frameSizes[i] = fl;
+            sum += fl;
+        }
+        int last = nBytes - pos - padding - sum;
+        if(last < 0) return -1;
+        frameSizes[M - 1] = last;
+    }
+    else {
+        int total = nBytes - pos - padding;
+        if(total < 0 || total % M) return -1;
+        for(int i = 0; i < M; i++) frameSizes[i] = total / M;
+    }
+    for(int i = 0; i < M; i++) if(frameSizes[i] > 1275) return -1;
+    *frameCount = M;
+    *paddingBytes = padding;
+    return pos;
+}
+//----------------------------------------------------------------------------------------------------------------------
 int parseOpusComment(uint8_t *inbuf, int nBytes){      // reference https://exiftool.org/TagNames/Vorbis.html#Comments
                                                        // reference https://www.rfc-editor.org/rfc/rfc7845#section-5
     int idx = OPUS_specialIndexOf(inbuf, "OpusTags", 10);
@@ -270,28 +273,34 @@ int parseOpusComment(uint8_t *inbuf, int nBytes){      // reference https://exif
     char* artist = NULL;
     char* title  = NULL;
 
-    uint16_t pos = 8;
+    if(nBytes < 16) return 1; // no comments
+    uint32_t pos = 8;
     uint32_t vendorLength       = *(inbuf + 11) << 24; // lengt of vendor string, e.g. Lavf58.65.101
              vendorLength      += *(inbuf + 10) << 16;
              vendorLength      += *(inbuf +  9) << 8;
              vendorLength      += *(inbuf +  8);
+    if(vendorLength > (uint32_t)nBytes - 16) return 1; // corrupt
     pos += vendorLength + 4;
     uint32_t commentListLength  = *(inbuf + 3 + pos) << 24; // nr. of comment entries
              commentListLength += *(inbuf + 2 + pos) << 16;
              commentListLength += *(inbuf + 1 + pos) << 8;
              commentListLength += *(inbuf + 0 + pos);
     pos += 4;
-    for(int i = 0; i < commentListLength; i++){
+    for(uint32_t i = 0; i < commentListLength; i++){
+        if(pos + 4 > (uint32_t)nBytes) break; // the packet can be truncated (large pictures)
         uint32_t commentStringLen   = *(inbuf + 3 + pos) << 24;
                  commentStringLen  += *(inbuf + 2 + pos) << 16;
                  commentStringLen  += *(inbuf + 1 + pos) << 8;
                  commentStringLen  += *(inbuf + 0 + pos);
         pos += 4;
+        if(commentStringLen > (uint32_t)nBytes - pos) break;
         idx = OPUS_specialIndexOf(inbuf + pos, "artist=", 10);
-        if(idx == 0){ artist = strndup((const char*)(inbuf + pos + 7), commentStringLen - 7);
+        if(idx == 0 && !artist && commentStringLen >= 7){
+            artist = strndup((const char*)(inbuf + pos + 7), min(commentStringLen - 7, (uint32_t)250));
         }
         idx = OPUS_specialIndexOf(inbuf + pos, "title=", 10);
-        if(idx == 0){ title = strndup((const char*)(inbuf + pos + 6), commentStringLen - 6);
+        if(idx == 0 && !title && commentStringLen >= 6){
+            title = strndup((const char*)(inbuf + pos + 6), min(commentStringLen - 6, (uint32_t)250));
         }
         pos += commentStringLen;
     }
@@ -322,6 +331,7 @@ int parseOpusHead(uint8_t *inbuf, int nBytes){  // reference https://wiki.xiph.o
      if(idx != 0) {
         return 0; //is not OpusHead
      }
+    if(nBytes < 19) return ERR_OPUS_DECODER_ASYNC;
     uint8_t  version            = *(inbuf +  8); (void) version;
     uint8_t  channelCount       = *(inbuf +  9); // nr of channels
     uint16_t preSkip            = *(inbuf + 11) << 8;
@@ -345,95 +355,6 @@ int parseOpusHead(uint8_t *inbuf, int nBytes){  // reference https://wiki.xiph.o
     return 1;
 }
 
-//----------------------------------------------------------------------------------------------------------------------
-int OPUSparseOGG(uint8_t *inbuf, int *bytesLeft){  // reference https://www.xiph.org/ogg/doc/rfc3533.txt
-
-    s_f_opusParseOgg = false;
-    int ret = 0;
-    int idx = OPUS_specialIndexOf(inbuf, "OggS", 6);
-    if(idx != 0) return ERR_OPUS_DECODER_ASYNC;
-
-    int16_t segmentTableWrPtr = -1;
-
-    uint8_t  version            = *(inbuf +  4); (void) version;
-    uint8_t  headerType         = *(inbuf +  5); (void) headerType;
-    uint64_t granulePosition    = (uint64_t)*(inbuf + 13) << 56;  // granule_position: an 8 Byte field containing -
-             granulePosition   += (uint64_t)*(inbuf + 12) << 48;  // position information. For an audio stream, it MAY
-             granulePosition   += (uint64_t)*(inbuf + 11) << 40;  // contain the total number of PCM samples encoded
-             granulePosition   += (uint64_t)*(inbuf + 10) << 32;  // after including all frames finished on this page.
-             granulePosition   += *(inbuf +  9) << 24;  // This is a hint for the decoder and gives it some timing
-             granulePosition   += *(inbuf +  8) << 16;  // and position information. A special value of -1 (in two's
-             granulePosition   += *(inbuf +  7) << 8;   // complement) indicates that no packets finish on this page.
-             granulePosition   += *(inbuf +  6); (void) granulePosition;
-    uint32_t bitstreamSerialNr  = *(inbuf + 17) << 24;  // bitstream_serial_number: a 4 Byte field containing the
-             bitstreamSerialNr += *(inbuf + 16) << 16;  // unique serial number by which the logical bitstream
-             bitstreamSerialNr += *(inbuf + 15) << 8;   // is identified.
-             bitstreamSerialNr += *(inbuf + 14); (void) bitstreamSerialNr;
-    uint32_t pageSequenceNr     = *(inbuf + 21) << 24;  // page_sequence_number: a 4 Byte field containing the sequence
-             pageSequenceNr    += *(inbuf + 20) << 16;  // number of the page so the decoder can identify page loss
-             pageSequenceNr    += *(inbuf + 19) << 8;   // This sequence number is increasing on each logical bitstream
-             pageSequenceNr    += *(inbuf + 18); (void) pageSequenceNr;
-    uint32_t CRCchecksum        = *(inbuf + 25) << 24;
-             CRCchecksum       += *(inbuf + 24) << 16;
-             CRCchecksum       += *(inbuf + 23) << 8;
-             CRCchecksum       += *(inbuf + 22); (void) CRCchecksum;
-    uint8_t  pageSegments       = *(inbuf + 26);        // giving the number of segment entries
-
-    // read the segment table (contains pageSegments bytes),  1...251: Length of the frame in bytes,
-    // 255: A second byte is needed.  The total length is first_byte + second byte
-    s_opusSegmentLength = 0;
-    segmentTableWrPtr = -1;
-
-    for(int i = 0; i < pageSegments; i++){
-        int n = *(inbuf + 27 + i);
-        while(*(inbuf + 27 + i) == 255){
-            i++;
-            n+= *(inbuf + 27 + i);
-        }
-        segmentTableWrPtr++;
-        s_opusSegmentTable[segmentTableWrPtr] = n;
-        s_opusSegmentLength += n;
-    }
-    s_opusSegmentTableSize = segmentTableWrPtr + 1;
-    s_opusCompressionRatio = (float)(960 * 2 * pageSegments)/s_opusSegmentLength;  // const 960 validBytes out
-
-    bool     continuedPage = headerType & 0x01; // set: page contains data of a packet continued from the previous page
-    bool     firstPage     = headerType & 0x02; // set: this is the first page of a logical bitstream (bos)
-    bool     lastPage      = headerType & 0x04; // set: this is the last page of a logical bitstream (eos)
-
-    uint16_t headerSize    = pageSegments + 27;
-    (void)continuedPage; (void)lastPage;
-    *bytesLeft -= headerSize;
-
-    if(firstPage || s_f_opusSubsequentPage){ // OpusHead or OggComment may follows
-        ret = parseOpusHead(inbuf + headerSize, s_opusSegmentTable[0]);
-        if(ret == 1) *bytesLeft -= s_opusSegmentTable[0];
-        if(ret < 0){ *bytesLeft -= s_opusSegmentTable[0]; return ret;}
-        ret = parseOpusComment(inbuf + headerSize, s_opusSegmentTable[0]);
-        if(ret == 1) *bytesLeft -= s_opusSegmentTable[0];
-        if(ret < 0){ *bytesLeft -= s_opusSegmentTable[0]; return ret;}
-        s_f_opusParseOgg = true;// goto next page
-    }
-
-    s_f_opusFramePacket = true;
-    if(firstPage) s_f_opusSubsequentPage = true; else s_f_opusSubsequentPage = false;
-
-    return ERR_OPUS_NONE; // no error
-}
-
-//----------------------------------------------------------------------------------------------------------------------
-int OPUSFindSyncWord(unsigned char *buf, int nBytes){
-    // assume we have a ogg wrapper
-    int idx = OPUS_specialIndexOf(buf, "OggS", nBytes);
-    if(idx >= 0){ // Magic Word found
-    //    log_i("OggS found at %i", idx);
-        s_f_opusParseOgg = true;
-        return idx;
-    }
-    log_i("find sync");
-    s_f_opusParseOgg = false;
-    return ERR_OPUS_OGG_SYNC_NOT_FOUND;
-}
 //----------------------------------------------------------------------------------------------------------------------
 int OPUS_specialIndexOf(uint8_t* base, const char* str, int baselen, bool exact){
     int result;  // seek for str in buffer or in header up to baselen, not nullterninated
@@ -16,7 +16,6 @@ enum : int8_t  {OPUS_PARSE_OGG_DONE = 100,
                 ERR_OPUS_NARROW_BAND_UNSUPPORTED = -7,
                 ERR_OPUS_WIDE_BAND_UNSUPPORTED = -8,
                 ERR_OPUS_SUPER_WIDE_BAND_UNSUPPORTED = -9,
-                ERR_OPUS_OGG_SYNC_NOT_FOUND = - 10,
                 ERR_OPUS_CELT_BAD_ARG = -18,
                 ERR_OPUS_CELT_INTERNAL_ERROR = -19,
                 ERR_OPUS_CELT_UNIMPLEMENTED = -20,
@@ -39,11 +38,10 @@ uint8_t  OPUSGetBitsPerSample();
 uint32_t OPUSGetBitRate();
 uint16_t OPUSGetOutputSamps();
 char    *OPUSgetStreamTitle();
-int      OPUSFindSyncWord(unsigned char *buf, int nBytes);
-int      OPUSparseOGG(uint8_t *inbuf, int *bytesLeft);
 int      parseOpusHead(uint8_t *inbuf, int nBytes);
 int      parseOpusComment(uint8_t *inbuf, int nBytes);
 int      parseOpusTOC(uint8_t TOC_Byte);
+int      parseOpusFramePacking(const uint8_t *inbuf, int nBytes, uint16_t *frameSizes, uint8_t *frameCount, uint16_t *paddingBytes);
 int32_t  opus_packet_get_samples_per_frame(const uint8_t *data, int32_t Fs);
 
 // some helper functions
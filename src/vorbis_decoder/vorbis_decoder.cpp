@@ -31,32 +31,15 @@
 
 
 // global vars
-bool      s_f_vorbisParseOgg = false;
 bool      s_f_vorbisNewSteamTitle = false;  // streamTitle
-bool      s_f_vorbisFramePacket = false;
-bool      s_f_oggFirstPage = false;
-bool      s_f_oggContinuedPage = false;
-bool      s_f_oggLastPage = false;
-bool      s_f_parseOggDone = true;
-bool      s_f_lastSegmentTable = false;
-uint16_t  s_identificatonHeaderLength = 0;
-uint16_t  s_commentHeaderLength = 0;
 uint16_t  s_setupHeaderLength = 0;
-uint8_t   s_pageNr = 4;
-uint16_t  s_oggHeaderSize = 0;
 uint8_t   s_vorbisChannels = 0;
 uint16_t  s_vorbisSamplerate = 0;
-uint16_t  s_lastSegmentTableLen = 0;
-uint8_t  *s_lastSegmentTable = NULL;
 uint32_t  s_vorbisBitRate = 0;
-uint32_t  s_vorbisSegmentLength = 0;
 char     *s_vorbisChbuf = NULL;
 int32_t   s_vorbisValidSamples = 0;
 uint8_t   s_vorbisOldMode = 0;
 uint32_t  s_blocksizes[2];
-uint32_t  s_blockPicPos = 0;
-uint32_t  s_blockPicLen = 0;
-uint32_t  s_commentLength = 0;
 
 uint8_t   s_nrOfCodebooks = 0;
 uint8_t   s_nrOfFloors = 0;
@@ -64,12 +47,7 @@ uint8_t   s_nrOfResidues = 0;
 uint8_t   s_nrOfMaps = 0;
 uint8_t   s_nrOfModes = 0;
 
-uint16_t *s_vorbisSegmentTable = NULL;
-uint16_t  s_oggPage3Len = 0; // length of the current audio segment
-uint8_t   s_vorbisSegmentTableSize = 0;
-int16_t   s_vorbisSegmentTableRdPtr = -1;
 int8_t    s_vorbisError = 0;
-float     s_vorbisCompressionRatio = 0;
 
 bitReader_t            s_bitReader;
 
@@ -82,16 +60,13 @@ vorbis_info_mode_t    *s_mode_param = NULL;
 vorbis_dsp_state_t    *s_dsp_state = NULL;
 
 bool VORBISDecoder_AllocateBuffers(){
-    s_vorbisSegmentTable = (uint16_t*)__calloc_heap_psram(256, sizeof(uint16_t));
-    s_vorbisChbuf = (char*)__calloc_heap_psram(256, sizeof(char));
-    s_lastSegmentTable = (uint8_t*)__malloc_heap_psram(1024);
+    if(!s_vorbisChbuf) s_vorbisChbuf = (char*)__calloc_heap_psram(256, sizeof(char));
+    if(!s_vorbisChbuf) {log_e("not enough memory to allocate vorbisdecoder buffers"); return false;}
     VORBISsetDefaults();
     return true;
 }
 void VORBISDecoder_FreeBuffers(){
-    if(s_vorbisSegmentTable) {free(s_vorbisSegmentTable); s_vorbisSegmentTable = NULL;}
     if(s_vorbisChbuf){free(s_vorbisChbuf); s_vorbisChbuf = NULL;}
-    if(s_lastSegmentTable){free(s_lastSegmentTable); s_lastSegmentTable = NULL;}
 
     clearGlobalConfigurations();
 }
@@ -100,28 +75,14 @@ void VORBISDecoder_ClearBuffers(){
     bitReader_clear();
 }
 void VORBISsetDefaults(){
-    s_pageNr = 4;
-    s_f_vorbisParseOgg = false;
     s_f_vorbisNewSteamTitle = false;  // streamTitle
-    s_f_vorbisFramePacket = false;
-    s_f_lastSegmentTable = false;
-    s_f_parseOggDone = false;
-    s_f_oggFirstPage = false;
-    s_f_oggContinuedPage = false;
-    s_f_oggLastPage = false;
     if(s_dsp_state){vorbis_dsp_destroy(s_dsp_state); s_dsp_state = NULL;}
     s_vorbisChannels = 0;
     s_vorbisSamplerate = 0;
     s_vorbisBitRate = 0;
-    s_vorbisSegmentLength = 0;
     s_vorbisValidSamples = 0;
-    s_vorbisSegmentTableSize = 0;
     s_vorbisOldMode = 0xFF;
-    s_vorbisSegmentTableRdPtr = -1;
     s_vorbisError = 0;
-    s_lastSegmentTableLen = 0;
-    s_blockPicPos = 0;
-    s_blockPicLen = 0;
 
     VORBISDecoder_ClearBuffers();
 }
@@ -173,166 +134,46 @@ void clearGlobalConfigurations() { // mode, mapping, floor etc
 //----------------------------------------------------------------------------------------------------------------------
 
 int VORBISDecode(uint8_t *inbuf, int *bytesLeft, short *outbuf){
+    // inbuf is one Ogg packet (see ogg_demuxer), *bytesLeft its length
 
     int ret = 0;
+    int len = *bytesLeft;
+    *bytesLeft = 0; // the packet is used up in any case
+    s_vorbisValidSamples = 0;
 
-    if(s_f_vorbisParseOgg){
-        ret = VORBISparseOGG(inbuf, bytesLeft);
-        return ret;
+    if(len >= 7 && (inbuf[0] & 0x01)){ // header packet: type 1, 3 or 5, followed by 'vorbis'
+        int idx = VORBIS_specialIndexOf(inbuf, "vorbis", 10);
+        if(inbuf[0] == 1){ // identificaton header
+            clearGlobalConfigurations(); // if a new codebook is required, delete the old one
+            if(idx != 1 || len < 30) return ERR_VORBIS_NOT_AUDIO;  // #651
+            ret = parseVorbisFirstPacket(inbuf, len);
+            if(ret < 0) return ERR_VORBIS_BAD_HEADER;
+            return VORBIS_PARSE_OGG_DONE;
+        }
+        if(idx != 1) {log_e("no \"vorbis\" something went wrong %i", len); return ERR_VORBIS_BAD_HEADER;}
+        if(inbuf[0] == 3){ // comment header
+            return parseVorbisComment(inbuf, len);
+        }
+        if(inbuf[0] == 5){ // setup header
+            if(s_dsp_state) clearGlobalConfigurations(); // setup header twice
+            s_setupHeaderLength = len;
+            bitReader_setData(inbuf, len);
+            ret = parseVorbisCodebook();
+            if(ret < 0) return ERR_VORBIS_BAD_HEADER;
+            s_dsp_state = vorbis_dsp_create();
+            return VORBIS_PARSE_OGG_DONE;
+        }
+        return VORBIS_PARSE_OGG_DONE; // unknown header, skip it
     }
 
-    if(s_f_vorbisFramePacket){
-
-        if(s_vorbisSegmentTableSize > 0){
-            int len = 0;
-
-            // With the last segment of a table, we don't know whether it will be continued in the next Ogg page.
-            // So the last segment is saved. s_lastSegmentTableLen specifies the size of the last saved segment.
-            // If the next Ogg Page does not contain a 'continuedPage', the last segment is played first. However,
-            // if 'continuedPage' is set, the first segment of the new page is added to the saved segment and played.
-
-            if(s_lastSegmentTableLen == 0 || s_f_oggContinuedPage || s_f_oggLastPage){
-                s_vorbisSegmentTableRdPtr++;
-                s_vorbisSegmentTableSize--;
-                len = s_vorbisSegmentTable[s_vorbisSegmentTableRdPtr];
-                *bytesLeft -= len;
-            }
-
-            if(s_pageNr == 1){ // identificaton header
-                clearGlobalConfigurations(); // if a new codebook is required, delete the old one
-                int idx = VORBIS_specialIndexOf(inbuf, "vorbis", 10);
-                if(idx == 1){
-                    // log_i("first packet (identification len) %i", len);
-                    s_identificatonHeaderLength = len;
-                    ret = parseVorbisFirstPacket(inbuf, len);
-                    s_blockPicPos += 28;
-                }
-                else{
-                    ret = ERR_VORBIS_NOT_AUDIO;  // #651
-                }
-            }
-            else if(s_pageNr == 2){ // comment header
-                int idx = VORBIS_specialIndexOf(inbuf, "vorbis", 10);
-                s_blockPicPos += 6;
-                if(idx == 1){
-                    // log_i("second packet (comment len) %i", len);
-                    s_commentHeaderLength = len;
-                    ret = parseVorbisComment(inbuf, len);
-                }
-                else{
-                    uint16_t blockLen = len;
-                    // log_i("blockPicLen %i blockLen %i", s_blockPicLen, blockLen);
-                    s_blockPicLen -= blockLen;
-                    ; // commentlength is greater than (one or more) OggS frame(s)
-                }
-                // log_w("s_vorbisSegmentTableSize %d", s_vorbisSegmentTableSize);
-                // Normally the segment table has two entries, the first for comments and the second for the codebooks
-                if(!s_vorbisSegmentTableSize) {;}//there is no further segment for codebooks -> skip it
-                else s_pageNr = 3;
-            }
-            else if(s_pageNr == 3){ // setup header
-                int idx = VORBIS_specialIndexOf(inbuf, "vorbis", 10);
-                s_oggPage3Len = len;
-                if(idx == 1){
-                    // log_i("third packet (setup len) %i", len);
-                    s_setupHeaderLength = len;
-
-                    bitReader_setData(inbuf, len);
-
-                    if(len == 4080){
-                        // that is 16*255 bytes and thus the maximum segment size
-                        // it is possible that there is another block starting with 'OggS' in which there is information
-                        // about codebooks. It is possible that there is another block starting with 'OggS' in which
-                        // there is information about codebooks.
-                        int l = continuedOggPackets(inbuf + s_oggPage3Len, bytesLeft);
-                        *bytesLeft -= l;
-                        s_oggPage3Len += l;
-                        s_setupHeaderLength += l;
-                        bitReader_setData(inbuf,s_oggPage3Len);
-                        log_w("s_oggPage3Len %i", s_oggPage3Len);
-                        s_pageNr++;
-                    }
+    if(!s_dsp_state) return VORBIS_PARSE_OGG_DONE; // audio packet without setup header (joined the stream)
 
-                    ret = parseVorbisCodebook();
-                }
-                else{
-                    log_e("no \"vorbis\" something went wrong %i", len);
-                }
-                s_pageNr = 4;
-                s_dsp_state = vorbis_dsp_create();
-            }
-            else{ // page >= 4
-                if(s_f_parseOggDone){  // first loop after VORBISparseOGG()
-                    if(s_f_oggContinuedPage){
-                        if(s_lastSegmentTableLen > 0 || len > 0){
-                            if(s_lastSegmentTableLen +len > 1024) log_e("continued page too big");
-                            memcpy(s_lastSegmentTable + s_lastSegmentTableLen, inbuf, len);
-                            bitReader_setData(s_lastSegmentTable, s_lastSegmentTableLen + len);
-                            ret = vorbis_dsp_synthesis(s_lastSegmentTable, s_lastSegmentTableLen + len, outbuf);
-                            uint16_t outBuffSize = 2048 * 2;
-                            s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
-                            s_lastSegmentTableLen = 0;
-                            if(!ret && !len) ret = VORBIS_CONTINUE;
-                        }
-                        else{ // s_lastSegmentTableLen is 0 and len is 0
-                            s_vorbisValidSamples = 0;
-                            ret = VORBIS_CONTINUE;
-                        }
-                        s_f_oggContinuedPage = false;
-                    }
-                    else{ // last segment without continued Page
-                        if(s_lastSegmentTableLen){
-                            bitReader_setData(s_lastSegmentTable, s_lastSegmentTableLen);
-                            ret = vorbis_dsp_synthesis(s_lastSegmentTable, s_lastSegmentTableLen, outbuf);
-                            uint16_t outBuffSize = 2048 * 2;
-                            s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
-                            s_lastSegmentTableLen = 0;
-                            if(ret == OV_ENOTAUDIO || ret == 0 ) ret = VORBIS_CONTINUE; // if no error send continue
-                        }
-                        else{
-                            bitReader_setData(inbuf, len);
-                            ret = vorbis_dsp_synthesis(inbuf, len, outbuf);
-                            uint16_t outBuffSize = 2048 * 2;
-                            s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
-                            ret = 0;
-                        }
-                    }
-                }
-                else {  // not s_f_parseOggDone
-                    if(s_vorbisSegmentTableSize || s_f_lastSegmentTable){
-                        //if(s_f_oggLastPage) log_i("last page");
-                        bitReader_setData(inbuf, len);
-                        ret = vorbis_dsp_synthesis(inbuf, len, outbuf);
-                        uint16_t outBuffSize = 2048 * 2;
-                        s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
-                        ret = 0;
-                    }
-                    else{ // last segment
-                        if(len){
-                            memcpy(s_lastSegmentTable, inbuf, len);
-                            s_lastSegmentTableLen = len;
-                            s_vorbisValidSamples = 0;
-                            ret = 0;
-                        }
-                        else{
-                            s_lastSegmentTableLen = 0;
-                            s_vorbisValidSamples = 0;
-                            ret = VORBIS_PARSE_OGG_DONE;
-                        }
-                    }
-                    s_f_oggFirstPage = false;
-                }
-                s_f_parseOggDone = false;
-                if(s_f_oggLastPage && !s_vorbisSegmentTableSize) {VORBISsetDefaults();}
-            }
-            if(s_vorbisSegmentTableSize == 0){
-                s_vorbisSegmentTableRdPtr = -1; // back to the parking position
-                s_f_vorbisFramePacket = false;
-                s_f_vorbisParseOgg = true;
-            }
-        }
-    }
-    return ret;
+    bitReader_setData(inbuf, len);
+    ret = vorbis_dsp_synthesis(inbuf, len, outbuf);
+    if(ret < 0) return ERR_VORBIS_BAD_PACKET; // OV_ENOTAUDIO, OV_EBADPACKET
+    uint16_t outBuffSize = 2048 * 2;
+    s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
+    return ERR_VORBIS_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -426,44 +267,47 @@ int parseVorbisFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identifica
 
 }
 //----------------------------------------------------------------------------------------------------------------------
-int parseVorbisComment(uint8_t *inbuf, int16_t nBytes){      // reference https://xiph.org/vorbis/doc/v-comment.html
+int parseVorbisComment(uint8_t *inbuf, int nBytes){      // reference https://xiph.org/vorbis/doc/v-comment.html
 
     // first bytes are: '.vorbis'
+    if(nBytes < 15) return VORBIS_PARSE_OGG_DONE; // no comments
     uint32_t pos = 7;
     uint32_t vendorLength       = *(inbuf + pos + 3) << 24; // lengt of vendor string, e.g. Xiph.Org libVorbis I 20070622
              vendorLength      += *(inbuf + pos + 2) << 16;
              vendorLength      += *(inbuf + pos + 1) << 8;
              vendorLength      += *(inbuf + pos);
 
-    if(vendorLength > 254){  // guard
+    if(vendorLength > 254 || vendorLength > (uint32_t)nBytes - 15){  // guard
        log_e("vorbis comment too long, vendorLength %i", vendorLength);
-       return 0;
+       return VORBIS_PARSE_OGG_DONE;
     }
 
     memcpy(s_vorbisChbuf, inbuf + 11, vendorLength);
     s_vorbisChbuf[vendorLength] = '\0';
     pos += 4 + vendorLength;
-    s_commentHeaderLength -= (7 + 4 + vendorLength);
 
     // log_i("vendorLength %x", vendorLength);
     // log_i("vendorString %s", s_vorbisChbuf);
 
-    uint8_t nrOfComments = *(inbuf + pos);
+    uint32_t nrOfComments  = *(inbuf + pos + 3) << 24;
+             nrOfComments += *(inbuf + pos + 2) << 16;
+             nrOfComments += *(inbuf + pos + 1) << 8;
+             nrOfComments += *(inbuf + pos);
     // log_i("nrOfComments %i", nrOfComments);
     pos += 4;
-    s_commentHeaderLength -= 4;
 
     int idx = 0;
     char* artist = NULL;
     char* title  = NULL;
     uint32_t commentLength = 0;
-    for(int i = 0; i < nrOfComments; i++){
+    for(uint32_t i = 0; i < nrOfComments; i++){
+        if(pos + 4 > (uint32_t)nBytes) break; // the packet can be truncated (large pictures)
         commentLength  = 0;
         commentLength  = *(inbuf + pos + 3) << 24;
         commentLength += *(inbuf + pos + 2) << 16;
         commentLength += *(inbuf + pos + 1) << 8;
         commentLength += *(inbuf + pos);
-        s_commentLength = commentLength;
+        if(commentLength > (uint32_t)nBytes - pos - 4) break;
 
         uint8_t cl = min((uint32_t)254, commentLength);
         memcpy(s_vorbisChbuf, inbuf + pos +  4, cl);
@@ -472,28 +316,17 @@ int parseVorbisComment(uint8_t *inbuf, int16_t nBytes){      // reference https:
         // log_i("commentLength %i comment %s", commentLength, s_vorbisChbuf);
 
         idx =        VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "artist=", 10);
-        if(idx != 0) VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "ARTIST=", 10);
-        if(idx == 0){ artist = strndup((const char*)(s_vorbisChbuf + 7), commentLength - 7); s_commentLength = 0;}
+        if(idx != 0) idx = VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "ARTIST=", 10);
+        if(idx == 0 && !artist){ artist = strndup((const char*)(s_vorbisChbuf + 7), cl - 7);}
 
         idx =        VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "title=", 10);
-        if(idx != 0) VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "TITLE=", 10);
-        if(idx == 0){ title = strndup((const char*)(s_vorbisChbuf + 6), commentLength - 6); s_commentLength = 0;}
-
-        idx =        VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "metadata_block_picture=", 25);
-        if(idx == 0){
-                    s_blockPicLen = commentLength - 23;
-                    s_blockPicPos += pos + 23;
-                    uint16_t blockPicLenUntilFrameEnd = s_commentHeaderLength - 4 - 23;
-                    log_i("metadata block picture found at pos %i, length %i, first blockLength %i", s_blockPicPos, s_blockPicLen, blockPicLenUntilFrameEnd);
-                    s_blockPicLen -= blockPicLenUntilFrameEnd;
-                    }
+        if(idx != 0) idx = VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "TITLE=", 10);
+        if(idx == 0 && !title){ title = strndup((const char*)(s_vorbisChbuf + 6), cl - 6);}
+
         pos += commentLength + 4;
-        s_commentHeaderLength -= (4 + commentLength);
     }
     if(artist && title){
-        strcpy(s_vorbisChbuf, artist);
-        strcat(s_vorbisChbuf, " - ");
-        strcat(s_vorbisChbuf, title);
+        snprintf(s_vorbisChbuf, 256, "%s - %s", artist, title);
         s_f_vorbisNewSteamTitle = true;
     }
     else if(artist){
@@ -513,7 +346,7 @@ int parseVorbisComment(uint8_t *inbuf, int16_t nBytes){      // reference https:
 int parseVorbisCodebook(){
 
     s_bitReader.headptr += 7;
-    s_bitReader.length = s_oggPage3Len;
+    s_bitReader.length = s_setupHeaderLength;
 
     int i;
     int ret = 0;
@@ -612,139 +445,6 @@ err_out:
     return (OV_EBADHEADER);
 }
 //----------------------------------------------------------------------------------------------------------------------
-int VORBISparseOGG(uint8_t *inbuf, int *bytesLeft){
-                                                           // reference https://www.xiph.org/ogg/doc/rfc3533.txt
-    s_f_vorbisParseOgg = false;
-    int ret = 0; (void)ret;
-
-    int idx = VORBIS_specialIndexOf(inbuf, "OggS", 1024);
-    if(idx != 0){
-        if(s_f_oggContinuedPage) return ERR_VORBIS_DECODER_ASYNC;
-        inbuf += idx;
-        *bytesLeft -= idx;
-        s_blockPicPos += idx;
-    }
-
-    int16_t segmentTableWrPtr = -1;
-
-    uint8_t  version            = *(inbuf +  4); (void) version;
-    uint8_t  headerType         = *(inbuf +  5); (void) headerType;
-    uint64_t granulePosition    = (uint64_t)*(inbuf + 13) << 56;  // granule_position: an 8 Byte field containing -
-             granulePosition   += (uint64_t)*(inbuf + 12) << 48;  // position information. For an audio stream, it MAY
-             granulePosition   += (uint64_t)*(inbuf + 11) << 40;  // contain the total number of PCM samples encoded
-             granulePosition   += (uint64_t)*(inbuf + 10) << 32;  // after including all frames finished on this page.
-             granulePosition   += *(inbuf +  9) << 24;  // This is a hint for the decoder and gives it some timing
-             granulePosition   += *(inbuf +  8) << 16;  // and position information. A special value of -1 (in two's
-             granulePosition   += *(inbuf +  7) << 8;   // complement) indicates that no packets finish on this page.
-             granulePosition   += *(inbuf +  6); (void) granulePosition;
-    uint32_t bitstreamSerialNr  = *(inbuf + 17) << 24;  // bitstream_serial_number: a 4 Byte field containing the
-             bitstreamSerialNr += *(inbuf + 16) << 16;  // unique serial number by which the logical bitstream
-             bitstreamSerialNr += *(inbuf + 15) << 8;   // is identified.
-             bitstreamSerialNr += *(inbuf + 14); (void) bitstreamSerialNr;
-    uint32_t pageSequenceNr     = *(inbuf + 21) << 24;  // page_sequence_number: a 4 Byte field containing the sequence
-             pageSequenceNr    += *(inbuf + 20) << 16;  // number of the page so the decoder can identify page loss
-             pageSequenceNr    += *(inbuf + 19) << 8;   // This sequence number is increasing on each logical bitstream
-             pageSequenceNr    += *(inbuf + 18); (void) pageSequenceNr;
-    uint32_t CRCchecksum        = *(inbuf + 25) << 24;
-             CRCchecksum       += *(inbuf + 24) << 16;
-             CRCchecksum       += *(inbuf + 23) << 8;
-             CRCchecksum       += *(inbuf + 22); (void) CRCchecksum;
-    uint8_t  pageSegments       = *(inbuf + 26);        // giving the number of segment entries
-
-    // read the segment table (contains pageSegments bytes),  1...251: Length of the frame in bytes,
-    // 255: A second byte is needed.  The total length is first_byte + second byte
-    s_vorbisSegmentLength = 0;
-    segmentTableWrPtr = -1;
-
-    for(int i = 0; i < pageSegments; i++){
-        int n = *(inbuf + 27 + i);
-        while(*(inbuf + 27 + i) == 255){
-            i++;
-            if(i == pageSegments) break;
-            n+= *(inbuf + 27 + i);
-        }
-        segmentTableWrPtr++;
-        s_vorbisSegmentTable[segmentTableWrPtr] = n;
-        s_vorbisSegmentLength += n;
-    }
-    s_vorbisSegmentTableSize = segmentTableWrPtr + 1;
-    s_vorbisCompressionRatio = (float)(960 * 2 * pageSegments)/s_vorbisSegmentLength;  // const 960 validBytes out
-
-    bool     continuedPage = headerType & 0x01; // set: page contains data of a packet continued from the previous page
-    bool     firstPage     = headerType & 0x02; // set: this is the first page of a logical bitstream (bos)
-    bool     lastPage      = headerType & 0x04; // set: this is the last page of a logical bitstream (eos)
-
-    uint16_t headerSize    = pageSegments + 27;
-
-    // log_i("headerSize %i, s_vorbisSegmentLength %i, s_vorbisSegmentTableSize %i", headerSize, s_vorbisSegmentLength, s_vorbisSegmentTableSize);
-    if(firstPage || continuedPage || lastPage){
-    // log_w("firstPage %i  continuedPage %i  lastPage %i", firstPage, continuedPage, lastPage);
-    }
-
-    *bytesLeft -= headerSize;
-    s_blockPicPos += headerSize;
-    if(s_pageNr < 4 && !continuedPage) s_pageNr++;
-
-    s_f_oggFirstPage = firstPage;
-    s_f_oggContinuedPage = continuedPage;
-    s_f_oggLastPage = lastPage;
-    s_oggHeaderSize = headerSize;
-
-    if(firstPage) s_pageNr = 1;
-    s_f_vorbisFramePacket = true;
-    s_f_parseOggDone = true;
-
-    return VORBIS_PARSE_OGG_DONE; // no error
-}
-//----------------------------------------------------------------------------------------------------------------------
-uint16_t continuedOggPackets(uint8_t *inbuf, int *bytesLeft){
-
-    // skip OggS header to pageSegments
-    // log_w("%c%c%c%c", *(inbuf+0), *(inbuf+1), *(inbuf+2), *(inbuf+3));
-    uint16_t segmentLength = 0;
-    uint8_t  headerType    = *(inbuf +  5);
-    uint8_t  pageSegments  = *(inbuf + 26);        // giving the number of segment entries
-
-    for(int i = 0; i < pageSegments; i++){
-        int n = *(inbuf + 27 + i);
-        while(*(inbuf + 27 + i) == 255){
-            i++;
-            if(i == pageSegments) break;
-            n+= *(inbuf + 27 + i);
-        }
-        segmentLength += n;
-    }
-    uint16_t headerSize = pageSegments + 27;
-    bool continuedPage = headerType & 0x01;
-
-    if(continuedPage){
-
-    //  codebook data are in 2 ogg packets
-    //  codebook data must no be interrupted by oggPH (ogg page header)
-    //  therefore shift codebook data2 left (oggPH size times) whith memmove
-    //  |oggPH| codebook data 1 |oggPH| codebook data 2 |oggPH|
-    //  |oppPH| codebook data 1 + 2              |unused|occPH|
-
-        memmove(inbuf , inbuf + headerSize, segmentLength);
-        return segmentLength + headerSize;
-    }
-
-    return 0;
-}
-//----------------------------------------------------------------------------------------------------------------------
-int VORBISFindSyncWord(unsigned char *buf, int nBytes){
-    // assume we have a ogg wrapper
-    int idx = VORBIS_specialIndexOf(buf, "OggS", nBytes);
-    if(idx >= 0){ // Magic Word found
-    //    log_i("OggS found at %i", idx);
-        s_f_vorbisParseOgg = true;
-        return idx;
-    }
-    // log_i("find sync");
-    s_f_vorbisParseOgg = false;
-    return ERR_VORBIS_OGG_SYNC_NOT_FOUND;
-}
-//---------------------------------------------------------------------------------------------------------------------
 int vorbis_book_unpack(codebook_t *s) {
     char   *lengthlist = NULL;
     uint8_t quantvals = 0;
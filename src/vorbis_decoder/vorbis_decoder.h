@@ -62,7 +62,6 @@ enum : int8_t  {VORBIS_CONTINUE = 110,
                 ERR_VORBIS_INVALID_SAMPLERATE = -2,
                 ERR_VORBIS_EXTRA_CHANNELS_UNSUPPORTED = -3,
                 ERR_VORBIS_DECODER_ASYNC = -4,
-                ERR_VORBIS_OGG_SYNC_NOT_FOUND = - 5,
                 ERR_VORBIS_BAD_HEADER = -6,
                 ERR_VORBIS_NOT_AUDIO = -7,
                 ERR_VORBIS_BAD_PACKET = -8
@@ -228,12 +227,9 @@ uint8_t  VORBISGetBitsPerSample();
 uint32_t VORBISGetBitRate();
 uint16_t VORBISGetOutputSamps();
 char    *VORBISgetStreamTitle();
-int      VORBISFindSyncWord(unsigned char *buf, int nBytes);
-int      VORBISparseOGG(uint8_t *inbuf, int *bytesLeft);
-int      parseVorbisComment(uint8_t *inbuf, int16_t nBytes);
+int      parseVorbisComment(uint8_t *inbuf, int nBytes);
 int      parseVorbisCodebook();
 int      parseVorbisFirstPacket(uint8_t *inbuf, int16_t nBytes);
-uint16_t continuedOggPackets(uint8_t *inbuf, int *bytesLeft);
 int      vorbis_book_unpack(codebook_t *s);
 uint32_t decpack(int32_t entry, int32_t used_entry, uint8_t quantvals, codebook_t *b, int maptype);
 int      oggpack_eop();